@@ -161,12 +161,13 @@ void frDrawBodyLines(const frBody *b, float thick, Color color) {
                  FR_DRAW_CIRCLE_SEGMENT_COUNT,
                  color);
     } else if (frGetShapeType(s) == FR_SHAPE_POLYGON) {
-        const frVertices *vertices = frGetPolygonVertices(s);
+        const frVector2 *vertices = frGetPolygonVertices(s);
 
-        for (int j = vertices->count - 1, i = 0; i < vertices->count;
-             j = i, i++) {
-            frVector2 v1 = frVector2Transform(vertices->data[j], tx);
-            frVector2 v2 = frVector2Transform(vertices->data[i], tx);
+        int vertexCount = frGetPolygonVertexCount(s);
+
+        for (int j = vertexCount - 1, i = 0; i < vertexCount; j = i, i++) {
+            frVector2 v1 = frVector2Transform(vertices[j], tx);
+            frVector2 v2 = frVector2Transform(vertices[i], tx);
 
             v1 = frVector2UnitsToPixels(v1);
             v2 = frVector2UnitsToPixels(v2);
@@ -56,9 +56,9 @@ static const float CELL_SIZE = 2.0f, DELTA_TIME = 1.0f / TARGET_FPS;
 
 /* Private Variables ======================================================= */
 
-static frSpatialHash *hash;
+static frWorld *world;
 
-static frBody *bodies[MAX_OBJECT_COUNT];
+static frBody *bodies[MAX_OBJECT_COUNT], *queryResult[MAX_OBJECT_COUNT];
 
 static Color primaryColor, secondaryColor;
 
@@ -71,8 +71,6 @@ static void DeinitExample(void);
 static void DrawCursorBounds(void);
 static frAABB GetCursorBounds(void);
 
-static bool OnHashQuery(frContextNode ctx);
-
 /* Public Functions ======================================================== */
 
 int main(void) {
@@ -101,7 +99,7 @@ int main(void) {
 /* Private Functions ======================================================= */
 
 static void InitExample(void) {
-    hash = frCreateSpatialHash(CELL_SIZE);
+    world = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
 
     primaryColor = ColorAlpha(LIGHTGRAY, 0.35f);
     secondaryColor = ColorAlpha(LIME, 0.85f);
@@ -120,8 +118,12 @@ static void InitExample(void) {
                               0.35f * GetRandomValue(1, 3)));
 
         frSetBodyAngle(bodies[i], DEG2RAD * GetRandomValue(0, 360));
+
+        frAddBodyToWorld(world, bodies[i]);
     }
 
+    frStepWorld(world, DELTA_TIME);
+
     HideCursor();
 
 #ifdef PLATFORM_WEB
@@ -134,15 +136,16 @@ static void InitExample(void) {
 
 static void UpdateExample(void) {
     {
-        frClearSpatialHash(hash);
-
-        for (int i = 0; i < MAX_OBJECT_COUNT; i++) {
+        for (int i = 0; i < MAX_OBJECT_COUNT; i++)
             frSetBodyUserData(bodies[i], (void *) &primaryColor);
 
-            frInsertIntoSpatialHash(hash, frGetBodyAABB(bodies[i]), i);
-        }
+        int queryCount = frQueryWorldAABB(world,
+                                          GetCursorBounds(),
+                                          queryResult,
+                                          MAX_OBJECT_COUNT);
 
-        frQuerySpatialHash(hash, GetCursorBounds(), OnHashQuery, NULL);
+        for (int i = 0; i < queryCount; i++)
+            frSetBodyUserData(queryResult[i], (void *) &secondaryColor);
     }
 
     {
@@ -170,10 +173,7 @@ static void UpdateExample(void) {
 }
 
 static void DeinitExample(void) {
-    for (int i = 0; i < MAX_OBJECT_COUNT; i++)
-        frReleaseBody(bodies[i]);
-
-    frReleaseSpatialHash(hash);
+    frReleaseWorld(world);
 }
 
 static void DrawCursorBounds(void) {
@@ -208,10 +208,4 @@ static frAABB GetCursorBounds(void) {
         .width = frPixelsToUnits(CURSOR_SIZE_IN_PIXELS),
         .height = frPixelsToUnits(CURSOR_SIZE_IN_PIXELS)
     };
-}
-
-static bool OnHashQuery(frContextNode ctx) {
-    frSetBodyUserData(bodies[ctx.id], (void *) &secondaryColor);
-
-    return true;
 }
\ No newline at end of file
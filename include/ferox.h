@@ -41,15 +41,42 @@ extern "C" {
 // clang-format off
 
 #ifndef FR_GEOMETRY_MAX_VERTEX_COUNT
-    /* Defines the maximum number of vertices for a convex polygon. */
+    /* 
+        Defines the maximum number of vertices for a convex polygon. 
+        ('polygon' collision shapes only allocate what they actually use.)
+    */
     #define FR_GEOMETRY_MAX_VERTEX_COUNT  8
 #endif
 
+#ifndef FR_GEOMETRY_MAX_CHAIN_CONTACT_COUNT
+    /* 
+        Defines the maximum number of contact points gathered from 
+        the line segments of a 'chain' collision shape (or the rectangles 
+        of a 'tilemap' collision shape), before they are reduced to 
+        the contact points of a single collision.
+    */
+    #define FR_GEOMETRY_MAX_CHAIN_CONTACT_COUNT  8
+#endif
+
+#ifndef FR_GEOMETRY_MAX_TILE_RECT_SIZE
+    /* 
+        Defines the maximum number of tiles along each side of 
+        the rectangles that the solid tiles of a 'tilemap' collision shape
+        are merged into, which bounds the cost of changing a tile.
+    */
+    #define FR_GEOMETRY_MAX_TILE_RECT_SIZE  16
+#endif
+
 #ifndef FR_GEOMETRY_PIXELS_PER_UNIT
     /* Defines how many pixels represent a unit of length (meter). */
     #define FR_GEOMETRY_PIXELS_PER_UNIT   32.0f
 #endif
 
+#ifndef FR_PARTICLE_ITERATION_COUNT
+    /* Defines the iteration count for the contacts of particles. */
+    #define FR_PARTICLE_ITERATION_COUNT   2
+#endif
+
 #ifndef FR_WORLD_BAUMGARTE_FACTOR
     /* Defines the 'bias factor' for the Baumgarte stabilization scheme. */
     #define FR_WORLD_BAUMGARTE_FACTOR     0.2f
@@ -75,6 +102,29 @@ extern "C" {
     #define FR_WORLD_MAX_OBJECT_COUNT     2048
 #endif
 
+#ifndef FR_WORLD_RAYCAST_PACKET_SIZE
+    /* Defines the number of rays tested together in a batched raycast. */
+    #define FR_WORLD_RAYCAST_PACKET_SIZE  8
+#endif
+
+#ifndef FR_WORLD_SLEEP_ANGULAR_THRESHOLD
+    /* Defines the angular speed below which a body can fall asleep. */
+    #define FR_WORLD_SLEEP_ANGULAR_THRESHOLD  0.05f
+#endif
+
+#ifndef FR_WORLD_SLEEP_LINEAR_THRESHOLD
+    /* Defines the linear speed below which a body can fall asleep. */
+    #define FR_WORLD_SLEEP_LINEAR_THRESHOLD   0.05f
+#endif
+
+#ifndef FR_WORLD_SLEEP_TIME
+    /* 
+        Defines how long (in seconds) every body of an island must stay 
+        below the sleep thresholds before the island falls asleep.
+    */
+    #define FR_WORLD_SLEEP_TIME           0.5f
+#endif
+
 // clang-format on
 
 /* Macros =================================================================> */
@@ -149,6 +199,11 @@ typedef struct frContextNode_ {
     void *ctx;
 } frContextNode;
 
+/* <========================================================= [src/baking.c] */
+
+/* A structure that represents the convex pieces baked from a bitmap. */
+typedef struct frBakedShape_ frBakedShape;
+
 /* <==================================================== [src/broad_phase.c] */
 
 /* A structure that represents a spatial hash. */
@@ -157,6 +212,18 @@ typedef struct frSpatialHash_ frSpatialHash;
 /* A callback function type for `frQuerySpatialHash()`. */
 typedef bool (*frHashQueryFunc)(frContextNode ctxNode);
 
+/* <====================================================== [src/character.c] */
+
+/* A structure that represents a kinematic character controller. */
+typedef struct frCharacter_ frCharacter;
+
+/* An enumeration that represents the ground state of a character. */
+typedef enum frCharacterState_ {
+    FR_CHARACTER_AIRBORNE,
+    FR_CHARACTER_GROUNDED,
+    FR_CHARACTER_SLIDING
+} frCharacterState;
+
 /* <====================================================== [src/collision.c] */
 
 /* A structure that represents a contact point. */
@@ -204,7 +271,12 @@ typedef struct frRaycastHit_ {
 typedef enum frShapeType_ {
     FR_SHAPE_UNKNOWN,
     FR_SHAPE_CIRCLE,
-    FR_SHAPE_POLYGON
+    FR_SHAPE_POLYGON,
+    FR_SHAPE_CAPSULE,
+    FR_SHAPE_CHAIN,
+    FR_SHAPE_HEIGHTFIELD,
+    FR_SHAPE_TILEMAP,
+    FR_SHAPE_COMPOUND
 } frShapeType;
 
 /* 
@@ -223,6 +295,17 @@ typedef struct frVertices_ {
     int count;
 } frVertices;
 
+/* <======================================================= [src/particle.c] */
+
+/* A structure that represents a group of lightweight, non-rotating circles. */
+typedef struct frParticleSystem_ frParticleSystem;
+
+/* An enumeration that represents how particles and rigid bodies interact. */
+typedef enum frParticleCoupling_ {
+    FR_PARTICLE_COUPLING_ONE_WAY,
+    FR_PARTICLE_COUPLING_TWO_WAY
+} frParticleCoupling;
+
 /* <===================================================== [src/rigid_body.c] */
 
 /* An enumeration that represents the type of a rigid body. */
@@ -255,6 +338,62 @@ typedef struct frTransform_ {
     float angle;
 } frTransform;
 
+/* 
+    A structure that represents the motion data of rigid bodies 
+    for the constraint solver, stored as a structure of arrays.
+*/
+typedef struct frSolverBodies_ {
+    frVector2 *positions, *velocities;
+    float *angularVelocities;
+    float *inverseMasses, *inverseInertias;
+    int count, capacity;
+} frSolverBodies;
+
+/* A structure that represents a contact point of a contact constraint. */
+typedef struct frContactConstraintPoint_ {
+    frVector2 relPosition1, relPosition2;
+    frVector2 relNormal1, relNormal2;
+    float normalMass, tangentMass;
+    float bias;
+    float normalScalar, tangentScalar;
+} frContactConstraintPoint;
+
+/* 
+    A structure that represents a collision between two solver bodies,
+    prepared for the iterations of the constraint solver.
+*/
+typedef struct frContactConstraint_ {
+    int firstIndex, secondIndex;
+    frVector2 normal, tangent;
+    float friction;
+    int count;
+    frContactConstraintPoint points[2];
+} frContactConstraint;
+
+/* 
+    A structure that represents up to four contact constraints, stored 
+    side by side as a structure of arrays, none of which share a body 
+    whose velocity can be changed by the constraints.
+*/
+typedef struct frContactBatch_ {
+    int indices[4];
+    int firstIndices[4], secondIndices[4];
+    float inverseMass1[4], inverseMass2[4];
+    float inverseInertia1[4], inverseInertia2[4];
+    float normalX[4], normalY[4];
+    float tangentX[4], tangentY[4];
+    float friction[4];
+    struct {
+        float relPosition1X[4], relPosition1Y[4];
+        float relPosition2X[4], relPosition2Y[4];
+        float relNormal1X[4], relNormal1Y[4];
+        float relNormal2X[4], relNormal2Y[4];
+        float normalMass[4], tangentMass[4];
+        float bias[4];
+        float normalScalar[4], tangentScalar[4];
+    } points[2];
+} frContactBatch;
+
 /* <========================================================== [src/world.c] */
 
 /* A structure that represents a pair of two rigid bodies. */
@@ -273,8 +412,63 @@ typedef struct frCollisionHandler_ {
 /* A callback function type for `frComputeRaycastForWorld()`. */
 typedef void (*frRaycastQueryFunc)(frRaycastHit raycastHit, void *ctx);
 
+/* A callback function type for filtering the bodies found by a query. */
+typedef bool (*frBodyFilterFunc)(const frBody *b, void *ctx);
+
+/* An enumeration that represents the falloff of a radial impulse. */
+typedef enum frFalloffType_ {
+    FR_FALLOFF_NONE,
+    FR_FALLOFF_LINEAR,
+    FR_FALLOFF_QUADRATIC
+} frFalloffType;
+
 /* Public Function Prototypes =============================================> */
 
+/* <========================================================= [src/baking.c] */
+
+/* 
+    Bakes the pixels of the `width` x `height` `alpha` mask whose values 
+    are greater than `threshold` into convex pieces: the outer boundary of 
+    each 4-connected group of pixels is traced, simplified within 
+    `tolerance` (in pixels), then decomposed into convex pieces that can 
+    be used as 'polygon' collision shapes. (Holes are filled.)
+*/
+frBakedShape *frBakeBitmap(const unsigned char *alpha,
+                           int width,
+                           int height,
+                           unsigned char threshold,
+                           float tolerance);
+
+/* Releases the memory allocated for `b`. */
+void frReleaseBakedShape(frBakedShape *b);
+
+/* Returns the number of convex pieces in `b`. */
+int frGetBakedShapePieceCount(const frBakedShape *b);
+
+/* 
+    Returns the vertices of the `i`-th convex piece in `b`, 
+    relative to the position of the piece.
+*/
+const frVertices *frGetBakedShapePiece(const frBakedShape *b, int i);
+
+/* 
+    Returns the position of the `i`-th convex piece in `b`, 
+    relative to the center of the bitmap.
+*/
+frVector2 frGetBakedShapePiecePosition(const frBakedShape *b, int i);
+
+/* 
+    Writes `b` to `buffer` as a binary blob if `size` is large enough, 
+    then returns the size of the blob (in bytes).
+*/
+size_t frSaveBakedShape(const frBakedShape *b, void *buffer, size_t size);
+
+/* 
+    Loads the convex pieces from the binary blob of `size` bytes 
+    in `buffer`, which was written by `frSaveBakedShape()`.
+*/
+frBakedShape *frLoadBakedShape(const void *buffer, size_t size);
+
 /* <==================================================== [src/broad_phase.c] */
 
 /* Creates a new spatial hash with the given `cellSize`. */
@@ -289,15 +483,89 @@ void frClearSpatialHash(frSpatialHash *sh);
 /* Returns the cell size of `sh`. */
 float frGetSpatialHashCellSize(const frSpatialHash *sh);
 
+/* 
+    Returns the bounds of all non-empty cells in `sh`, 
+    or an empty AABB if `sh` is empty.
+*/
+frAABB frGetSpatialHashBounds(frSpatialHash *sh);
+
 /* Inserts a `key`-`value` pair into `sh`. */
 void frInsertIntoSpatialHash(frSpatialHash *sh, frAABB key, int value);
 
+/* 
+    Removes a `key`-`value` pair from `sh`, where `key` must be the same AABB 
+    that `value` was inserted with.
+*/
+void frRemoveFromSpatialHash(frSpatialHash *sh, frAABB key, int value);
+
 /* Query `sh` for any objects that overlap the given `aabb`. */
 void frQuerySpatialHash(frSpatialHash *sh,
                         frAABB aabb,
                         frHashQueryFunc func,
                         void *userData);
 
+/* 
+    Query `sh` for any objects that are likely to intersect the given `ray`,
+    visiting the cells along `ray` in order; `func` may shorten 
+    `ray->maxDistance` to end the traversal early, or make it negative 
+    to end the traversal immediately.
+*/
+void frQuerySpatialHashRay(frSpatialHash *sh,
+                           frRay *ray,
+                           frHashQueryFunc func,
+                           void *userData);
+
+/* 
+    Query `sh` for any objects around `point`, visiting the cells ring by ring
+    outward until no unvisited cell lies within `*maxDistance` of `point`; 
+    `func` may shorten `*maxDistance` to end the traversal early, or make it 
+    negative to end the traversal immediately.
+*/
+void frQuerySpatialHashNearest(frSpatialHash *sh,
+                               frVector2 point,
+                               float *maxDistance,
+                               frHashQueryFunc func,
+                               void *userData);
+
+/* <====================================================== [src/character.c] */
+
+/* 
+    Creates a character controller for the kinematic body `b`, which must 
+    be added to a world before `frMoveCharacter()` is called.
+*/
+frCharacter *frCreateCharacter(frBody *b);
+
+/* Releases the memory allocated for `c`, but not for its body. */
+void frReleaseCharacter(frCharacter *c);
+
+/* Returns the body of `c`. */
+frBody *frGetCharacterBody(const frCharacter *c);
+
+/* Returns the ground state of `c` after its last move. */
+frCharacterState frGetCharacterState(const frCharacter *c);
+
+/* Returns the body that `c` stood on (or slid on) after its last move. */
+frBody *frGetCharacterGround(const frCharacter *c);
+
+/* Returns the normal of the ground below `c` after its last move. */
+frVector2 frGetCharacterGroundNormal(const frCharacter *c);
+
+/* Sets the `mass` that `c` uses to push dynamic bodies. */
+void frSetCharacterMass(frCharacter *c, float mass);
+
+/* 
+    Sets the maximum angle (in radians) of a slope that `c` can walk on,
+    measured from the direction opposite to gravity.
+*/
+void frSetCharacterMaxSlopeAngle(frCharacter *c, float angle);
+
+/* 
+    Moves `c` by `displacement` over the time step `dt`, sliding along 
+    the surfaces on the way and pushing the dynamic bodies in the way, 
+    then returns the displacement actually made.
+*/
+frVector2 frMoveCharacter(frCharacter *c, frVector2 displacement, float dt);
+
 /* <====================================================== [src/collision.c] */
 
 /* 
@@ -306,17 +574,127 @@ void frQuerySpatialHash(frSpatialHash *sh,
 */
 bool frComputeCollision(frBody *b1, frBody *b2, frCollision *collision);
 
+/* 
+    Checks whether `s1` with the transform `tx1` and `s2` with the transform 
+    `tx2` are colliding, then stores the collision information to `collision`.
+*/
+bool frComputeShapeCollision(const frShape *s1,
+                             frTransform tx1,
+                             const frShape *s2,
+                             frTransform tx2,
+                             frCollision *collision);
+
 /* Casts a `ray` against `b`. */
 bool frComputeRaycast(const frBody *b, frRay ray, frRaycastHit *raycastHit);
 
+/* 
+    Casts a `ray` against `s` with the transform `tx`, 
+    assuming that the direction of `ray` is already normalized.
+*/
+bool frComputeShapeRaycast(const frShape *s,
+                           frTransform tx,
+                           frRay ray,
+                           frRaycastHit *raycastHit);
+
+/* 
+    Computes the distance between `b1` and `b2`, then stores 
+    the closest points on `b1` and `b2` to `p1` and `p2`.
+*/
+float frComputeDistance(const frBody *b1,
+                        const frBody *b2,
+                        frVector2 *p1,
+                        frVector2 *p2);
+
+/* 
+    Computes the distance between `s1` with the transform `tx1` and `s2` 
+    with the transform `tx2`, then stores the closest points 
+    on `s1` and `s2` to `p1` and `p2`.
+*/
+float frComputeShapeDistance(const frShape *s1,
+                             frTransform tx1,
+                             const frShape *s2,
+                             frTransform tx2,
+                             frVector2 *p1,
+                             frVector2 *p2);
+
+/* 
+    Sweeps `s1` with the transform `tx1` along `translation` against `s2`
+    with the transform `tx2`, then stores the information about 
+    the first time of impact to `raycastHit`.
+*/
+bool frComputeShapeCast(const frShape *s1,
+                        frTransform tx1,
+                        frVector2 translation,
+                        const frShape *s2,
+                        frTransform tx2,
+                        frRaycastHit *raycastHit);
+
+/* 
+    Returns the index of the vertex of `s` with the transform `tx`
+    farthest along `v`, or `-1` if `s` is not a 'polygon' collision shape.
+*/
+int frGetPolygonSupportIndex(const frShape *s, frTransform tx, frVector2 v);
+
 /* <======================================================= [src/geometry.c] */
 
 /* Creates a 'circle' collision shape. */
 frShape *frCreateCircle(frMaterial material, float radius);
 
+/* 
+    Creates a 'capsule' collision shape, which is the set of points within 
+    `radius` of a line segment of `length` that lies along the y-axis.
+*/
+frShape *frCreateCapsule(frMaterial material, float length, float radius);
+
+/* 
+    Creates a 'chain' collision shape, which connects `count` `vertices` 
+    with one-sided line segments (and the last vertex to the first one 
+    if `loop` is `true`), each of which only collides on its right side; 
+    for vertices given from left to right, the line segments collide 
+    with anything above them.
+*/
+frShape *frCreateChain(frMaterial material,
+                       const frVector2 *vertices,
+                       int count,
+                       bool loop);
+
+/* 
+    Creates a 'heightfield' collision shape, which is a 'chain' collision 
+    shape whose `count` vertices are placed `spacing` apart along 
+    the x-axis, with the given `heights` above (along -y) the x-axis.
+*/
+frShape *frCreateHeightfield(frMaterial material,
+                             const float *heights,
+                             int count,
+                             float spacing);
+
 /* Creates a 'rectangle' collision shape. */
 frShape *frCreateRectangle(frMaterial material, float width, float height);
 
+/* 
+    Creates a 'tilemap' collision shape from a `width` by `height` grid 
+    of square tiles with the given `tileSize`, where the tile at column `x` 
+    and row `y` covers the area from `(x, y) * tileSize` to 
+    `(x + 1, y + 1) * tileSize` and is solid if `tiles[y * width + x]` 
+    is `true`.
+*/
+frShape *frCreateTilemap(frMaterial material,
+                         const bool *tiles,
+                         int width,
+                         int height,
+                         float tileSize);
+
+/* 
+    Creates a 'compound' collision shape from `count` child `shapes`, each 
+    placed at the position and the angle of its `offset`, where the mass of 
+    each child shape comes from its own density and the friction and 
+    the restitution of `material` apply to the whole shape.
+*/
+frShape *frCreateCompound(frMaterial material,
+                          frShape **shapes,
+                          const frTransform *offsets,
+                          int count);
+
 /* Creates a 'convex polygon' collision shape. */
 frShape *frCreatePolygon(frMaterial material, const frVertices *vertices);
 
@@ -353,14 +731,142 @@ frAABB frGetShapeAABB(const frShape *s, frTransform tx);
 /* Returns the radius of `s`, assuming `s` is a 'circle' collision shape. */
 float frGetCircleRadius(const frShape *s);
 
+/* 
+    Returns the length of the line segment of `s`, 
+    assuming `s` is a 'capsule' collision shape.
+*/
+float frGetCapsuleLength(const frShape *s);
+
+/* Returns the radius of `s`, assuming `s` is a 'capsule' collision shape. */
+float frGetCapsuleRadius(const frShape *s);
+
+/* 
+    Returns the number of vertices of `s`, 
+    assuming `s` is a 'chain' or 'heightfield' collision shape.
+*/
+int frGetChainVertexCount(const frShape *s);
+
+/* 
+    Returns the vertices of `s`, 
+    assuming `s` is a 'chain' or 'heightfield' collision shape.
+*/
+const frVector2 *frGetChainVertices(const frShape *s);
+
+/* 
+    Returns the number of line segments of `s`, 
+    assuming `s` is a 'chain' or 'heightfield' collision shape.
+*/
+int frGetChainSegmentCount(const frShape *s);
+
+/* 
+    Returns the normals of the line segments of `s`, where the `i`-th 
+    line segment goes from the `i`-th vertex to the next vertex, 
+    assuming `s` is a 'chain' or 'heightfield' collision shape.
+*/
+const frVector2 *frGetChainNormals(const frShape *s);
+
+/* 
+    Query `s` for the line segments whose bounding boxes overlap `aabb`
+    (in the local space of `s`) in ascending order, assuming `s` is 
+    a 'chain' or 'heightfield' collision shape.
+*/
+void frQueryChainSegments(const frShape *s,
+                          frAABB aabb,
+                          frHashQueryFunc func,
+                          void *userData);
+
+/* 
+    Returns the number of columns of `s`, 
+    assuming `s` is a 'tilemap' collision shape.
+*/
+int frGetTilemapWidth(const frShape *s);
+
+/* 
+    Returns the number of rows of `s`, 
+    assuming `s` is a 'tilemap' collision shape.
+*/
+int frGetTilemapHeight(const frShape *s);
+
+/* 
+    Returns the size of each tile of `s`, 
+    assuming `s` is a 'tilemap' collision shape.
+*/
+float frGetTilemapTileSize(const frShape *s);
+
+/* 
+    Returns `true` if the tile at column `x` and row `y` of `s` is solid, 
+    assuming `s` is a 'tilemap' collision shape.
+*/
+bool frGetTilemapTile(const frShape *s, int x, int y);
+
+/* 
+    Returns the bounds (in the local space of `s`) of the rectangle of 
+    solid tiles with the given `i`ndex, which is the index of its top-left 
+    tile, assuming `s` is a 'tilemap' collision shape.
+*/
+frAABB frGetTilemapRect(const frShape *s, int i);
+
+/* 
+    Returns the 'polygon' collision shape of the rectangle of solid tiles 
+    with the given `i`ndex, whose origin lies at the center of 
+    the rectangle, assuming `s` is a 'tilemap' collision shape.
+*/
+const frShape *frGetTilemapRectShape(const frShape *s, int i);
+
+/* 
+    Query `s` for the rectangles of solid tiles that overlap `aabb` 
+    (in the local space of `s`) by looking up the tiles under `aabb`, 
+    assuming `s` is a 'tilemap' collision shape.
+*/
+void frQueryTilemapRects(const frShape *s,
+                         frAABB aabb,
+                         frHashQueryFunc func,
+                         void *userData);
+
+/* 
+    Returns the number of child shapes of `s`, 
+    assuming `s` is a 'compound' collision shape.
+*/
+int frGetCompoundChildCount(const frShape *s);
+
+/* 
+    Returns the child shape with the given `i`ndex of `s`, 
+    assuming `s` is a 'compound' collision shape.
+*/
+const frShape *frGetCompoundChild(const frShape *s, int i);
+
+/* 
+    Returns the transform of the child shape with the given `i`ndex of `s` 
+    with the transform `tx`, assuming `s` is a 'compound' collision shape.
+*/
+frTransform frGetCompoundChildTransform(const frShape *s,
+                                        frTransform tx,
+                                        int i);
+
+/* 
+    Query `s` for the child shapes whose bounding boxes overlap `aabb` 
+    (in the local space of `s`) in ascending order, assuming `s` is 
+    a 'compound' collision shape.
+*/
+void frQueryCompoundChildren(const frShape *s,
+                             frAABB aabb,
+                             frHashQueryFunc func,
+                             void *userData);
+
 /* 
     Returns a vertex with the given `i`ndex of `s`, 
     assuming `s` is a 'polygon' collision shape. 
 */
 frVector2 frGetPolygonVertex(const frShape *s, int i);
 
+/* 
+    Returns the number of vertices of `s`, 
+    assuming `s` is a 'polygon' collision shape.
+*/
+int frGetPolygonVertexCount(const frShape *s);
+
 /* Returns the vertices of `s`, assuming `s` is a 'polygon' collision shape. */
-const frVertices *frGetPolygonVertices(const frShape *s);
+const frVector2 *frGetPolygonVertices(const frShape *s);
 
 /* 
     Returns a normal with the given `i`ndex of `s`, 
@@ -369,7 +875,7 @@ const frVertices *frGetPolygonVertices(const frShape *s);
 frVector2 frGetPolygonNormal(const frShape *s, int i);
 
 /* Returns the normals of `s`, assuming `s` is a 'polygon' collision shape. */
-const frVertices *frGetPolygonNormals(const frShape *s);
+const frVector2 *frGetPolygonNormals(const frShape *s);
 
 /* Sets the type of `s` to `type`. */
 void frSetShapeType(frShape *s, frShapeType type);
@@ -389,6 +895,12 @@ void frSetShapeRestitution(frShape *s, float restitution);
 /* Sets the `radius` of `s`, assuming `s` is a 'circle' collision shape. */
 void frSetCircleRadius(frShape *s, float radius);
 
+/* 
+    Sets the `length` of the line segment and the `radius` of `s`, 
+    assuming `s` is a 'capsule' collision shape.
+*/
+void frSetCapsuleDimensions(frShape *s, float length, float radius);
+
 /* 
     Sets the `width` and `height` of `s`, assuming `s` is a 'rectangle'
     collision shape.
@@ -398,6 +910,79 @@ void frSetRectangleDimensions(frShape *s, float width, float height);
 /* Sets the `vertices` of `s`, assuming `s` is a 'polygon' collision shape. */
 void frSetPolygonVertices(frShape *s, const frVertices *vertices);
 
+/* 
+    Makes the tile at column `x` and row `y` of `s` `solid` (or empty), 
+    assuming `s` is a 'tilemap' collision shape.
+*/
+void frSetTilemapTile(frShape *s, int x, int y, bool solid);
+
+/* <======================================================= [src/particle.c] */
+
+/* 
+    Creates a particle system that can hold up to `capacity` particles 
+    made of `material`.
+*/
+frParticleSystem *frCreateParticleSystem(frMaterial material, int capacity);
+
+/* Releases the memory allocated for `ps`. */
+void frReleaseParticleSystem(frParticleSystem *ps);
+
+/* 
+    Adds a particle with the given `position`, `velocity` and `radius` 
+    to `ps`, then returns its ID (or `-1` if `ps` is full).
+*/
+int frAddParticle(frParticleSystem *ps,
+                  frVector2 position,
+                  frVector2 velocity,
+                  float radius);
+
+/* 
+    Removes the particle with the given `id` from `ps`, 
+    moving the last particle of `ps` into its place.
+*/
+void frRemoveParticle(frParticleSystem *ps, int id);
+
+/* Erases all particles from `ps`. */
+void frClearParticles(frParticleSystem *ps);
+
+/* Returns the number of particles in `ps`. */
+int frGetParticleCount(const frParticleSystem *ps);
+
+/* 
+    Returns the current index of the particle with the given `id` in `ps`,
+    or `-1` if there is no such particle. (The particles are reordered 
+    by each step, but their IDs stay the same.)
+*/
+int frGetParticleIndex(const frParticleSystem *ps, int id);
+
+/* 
+    Returns the positions of all particles in `ps`, in the order 
+    of their current indices.
+*/
+const frVector2 *frGetParticlePositions(const frParticleSystem *ps);
+
+/* Returns the velocities of all particles in `ps`. */
+const frVector2 *frGetParticleVelocities(const frParticleSystem *ps);
+
+/* Returns the radii of all particles in `ps`. */
+const float *frGetParticleRadii(const frParticleSystem *ps);
+
+/* Returns how the particles in `ps` interact with rigid bodies. */
+frParticleCoupling frGetParticleCoupling(const frParticleSystem *ps);
+
+/* Sets how the particles in `ps` interact with rigid bodies. */
+void frSetParticleCoupling(frParticleSystem *ps, frParticleCoupling coupling);
+
+/* Sets the `v`elocity of the particle with the given `id` in `ps`. */
+void frSetParticleVelocity(frParticleSystem *ps, int id, frVector2 v);
+
+/* 
+    Proceeds the simulation of `ps` over the time step `dt`, 
+    pushing the particles out of the rigid bodies in `w` 
+    (and the rigid bodies away from the particles).
+*/
+void frStepParticleSystem(frParticleSystem *ps, frWorld *w, float dt);
+
 /* <===================================================== [src/rigid_body.c] */
 
 /* Creates a rigid body at `position`. */
@@ -460,6 +1045,12 @@ frAABB frGetBodyAABB(const frBody *b);
 /* Returns the user data of `b`. */
 void *frGetBodyUserData(const frBody *b);
 
+/* Returns the world that `b` has been added to. */
+frWorld *frGetBodyWorld(const frBody *b);
+
+/* Checks if `b` is sleeping. */
+bool frIsBodySleeping(const frBody *b);
+
 /* Sets the `type` of `b`. */
 void frSetBodyType(frBody *b, frBodyType type);
 
@@ -493,9 +1084,30 @@ void frSetBodyAngularVelocity(frBody *b, float angularVelocity);
 /* Sets the user data of `b` to `userData`. */
 void frSetBodyUserData(frBody *b, void *userData);
 
+/* 
+    Sets the world of `b` to `w`. This will be called by `w` 
+    when `b` has been added to or removed from `w`.
+*/
+void frSetBodyWorld(frBody *b, frWorld *w);
+
+/* 
+    Puts `b` to sleep if `sleeping` is `true`, or wakes `b` up otherwise.
+    Only a dynamic body can fall asleep, and its velocities are cleared.
+*/
+void frSetBodySleeping(frBody *b, bool sleeping);
+
 /* Checks if the given `point` lies inside `b`. */
 bool frBodyContainsPoint(const frBody *b, frVector2 point);
 
+/* 
+    Checks whether each of the first `n` `points` lies inside `b`, then 
+    stores the results to `results` and returns the number of points inside.
+*/
+int frBodyContainsPoints(const frBody *b,
+                         const frVector2 *points,
+                         int n,
+                         bool *results);
+
 /* Clears accumulated forces on `b`. */
 void frClearBodyForces(frBody *b);
 
@@ -508,8 +1120,23 @@ void frApplyGravityToBody(frBody *b, frVector2 g);
 /* Applies an `impulse` at a `point` on `b`. */
 void frApplyImpulseToBody(frBody *b, frVector2 point, frVector2 impulse);
 
-/* Applies accumulated impulses to `b1` and `b2`. */
-void frApplyAccumulatedImpulses(frBody *b1, frBody *b2, frCollision *collision);
+/* Applies the accumulated impulses of `constraint` to the bodies in `sb`. */
+void frApplyAccumulatedImpulses(frSolverBodies *sb,
+                                const frContactConstraint *constraint);
+
+/* Copies the motion data of `b` to the `i`-th body of `sb`. */
+void frGatherSolverBody(frSolverBodies *sb, int i, const frBody *b);
+
+/* 
+    Packs the contact constraint at `index` of `constraints` into 
+    the `lane`-th lane of `batch`, along with the inverse masses 
+    of its bodies in `sb`.
+*/
+void frPackCollisionBatch(frContactBatch *batch,
+                          int lane,
+                          const frSolverBodies *sb,
+                          const frContactConstraint *constraints,
+                          int index);
 
 /* 
     Calculates the acceleration of `b` from the accumulated forces,
@@ -524,11 +1151,48 @@ void frIntegrateForBodyVelocity(frBody *b, float dt);
 */
 void frIntegrateForBodyPosition(frBody *b, float dt);
 
-/* Resolves the collision between `b1` and `b2`. */
-void frResolveCollision(frBody *b1,
-                        frBody *b2,
-                        frCollision *collision,
-                        float inverseDt);
+/* 
+    Updates the sleep timer of `b` with `dt`, which is reset to zero 
+    while `b` moves faster than the sleep thresholds, then returns it.
+*/
+float frUpdateBodySleepTime(frBody *b, float dt);
+
+/* 
+    Prepares the collision between the bodies at `i1` and `i2` of `sb` 
+    for the constraint solver, then stores the result to `constraint`.
+*/
+void frPrepareCollision(const frSolverBodies *sb,
+                        int i1,
+                        int i2,
+                        const frCollision *collision,
+                        float inverseDt,
+                        frContactConstraint *constraint);
+
+/* Resolves the collision of `constraint` between the bodies in `sb`. */
+void frResolveCollision(frSolverBodies *sb, frContactConstraint *constraint);
+
+/* 
+    Resolves the collisions of every lane of `batch` at once, 
+    between the bodies in `sb`.
+*/
+void frResolveCollisionBatch(frSolverBodies *sb, frContactBatch *batch);
+
+/* 
+    Copies the effective masses and the accumulated impulses 
+    of `constraint` back to `collision`.
+*/
+void frSaveAccumulatedImpulses(const frContactConstraint *constraint,
+                               frCollision *collision);
+
+/* 
+    Copies the accumulated impulses of every lane of `batch` back to
+    the contact constraints in `constraints` they were packed from.
+*/
+void frUnpackCollisionBatch(const frContactBatch *batch,
+                            frContactConstraint *constraints);
+
+/* Copies the velocities of the `i`-th body of `sb` back to `b`. */
+void frScatterSolverBody(const frSolverBodies *sb, int i, frBody *b);
 
 /* <========================================================== [src/timer.c] */
 
@@ -555,6 +1219,15 @@ bool frAddBodyToWorld(frWorld *w, frBody *b);
 /* Removes a rigid `b`ody from `w`. */
 bool frRemoveBodyFromWorld(frWorld *w, frBody *b);
 
+/* 
+    Adds `ps` to `w`, so that `ps` is simulated along with the rigid bodies 
+    of `w` (and released along with `w`).
+*/
+bool frAddParticleSystemToWorld(frWorld *w, frParticleSystem *ps);
+
+/* Removes `ps` from `w`. */
+bool frRemoveParticleSystemFromWorld(frWorld *w, frParticleSystem *ps);
+
 /* Checks if the given `b`ody is in `w`. */
 bool frIsBodyInWorld(const frWorld *w, frBody *b);
 
@@ -567,6 +1240,21 @@ int frGetBodyCountInWorld(const frWorld *w);
 /* Returns the gravity acceleration vector of `w`. */
 frVector2 frGetWorldGravity(const frWorld *w);
 
+/* 
+    Notifies `w` that the transform or the shape of `b` has changed,
+    so that the broad phase of `w` can be updated before the next query.
+*/
+void frInvalidateBodyInWorld(frWorld *w, const frBody *b);
+
+/* 
+    Returns the total number of times that the entries of a body 
+    in the spatial hash of `w` have been updated after moving.
+*/
+int frGetWorldHashUpdateCount(const frWorld *w);
+
+/* Returns the number of islands that were solved during the last step of `w`. */
+int frGetWorldIslandCount(const frWorld *w);
+
 /* Sets the collision event `handler` of `w`. */
 void frSetWorldCollisionHandler(frWorld *w, frCollisionHandler handler);
 
@@ -584,13 +1272,184 @@ void frUpdateWorld(frWorld *w, float dt);
 
 /* 
     Casts a `ray` against all objects in `w`, 
-    then calls `func` for each object that collides with `ray`. 
+    then calls `func` for each object that collides with `ray`,
+    in the order of the cells visited along `ray`.
 */
 void frComputeWorldRaycast(frWorld *w,
                            frRay ray,
                            frRaycastQueryFunc func,
                            void *userData);
 
+/* 
+    Casts a `ray` against all objects in `w`, then stores the information
+    about the closest hit to `raycastHit`.
+*/
+bool frComputeWorldRaycastClosest(frWorld *w,
+                                  frRay ray,
+                                  frRaycastHit *raycastHit);
+
+/* 
+    Casts a `ray` against all objects in `w` until any of them is hit,
+    then stores the information about that hit to `raycastHit`.
+*/
+bool frComputeWorldRaycastAny(frWorld *w,
+                              frRay ray,
+                              frRaycastHit *raycastHit);
+
+/* 
+    Sweeps `s` with the transform `tx` along `translation` against 
+    all objects in `w` that pass `filter` (which may be `NULL`), then 
+    stores the information about the first time of impact to `raycastHit`.
+*/
+bool frComputeWorldShapeCast(frWorld *w,
+                             const frShape *s,
+                             frTransform tx,
+                             frVector2 translation,
+                             frBodyFilterFunc filter,
+                             void *userData,
+                             frRaycastHit *raycastHit);
+
+/* 
+    Casts each of the first `n` `rays` against all objects in `w`, 
+    then stores the information about its closest hit to `hits`,
+    and returns the number of rays that hit anything.
+*/
+int frComputeWorldRaycastBatch(frWorld *w,
+                               const frRay *rays,
+                               int n,
+                               frRaycastHit *hits);
+
+/* 
+    Finds all bodies in `w` whose AABBs overlap `aabb`, then stores 
+    up to `maxCount` of them to `bodies` and returns their number.
+*/
+int frQueryWorldAABB(frWorld *w, frAABB aabb, frBody **bodies, int maxCount);
+
+/* 
+    Finds all bodies in `w` that contain `point`, then stores 
+    up to `maxCount` of them to `bodies` and returns their number.
+*/
+int frQueryWorldPoint(frWorld *w,
+                      frVector2 point,
+                      frBody **bodies,
+                      int maxCount);
+
+/* 
+    Finds all bodies in `w` that overlap `s` with the transform `tx`, 
+    then stores up to `maxCount` of them to `bodies` and returns their number.
+*/
+int frQueryWorldShape(frWorld *w,
+                      const frShape *s,
+                      frTransform tx,
+                      frBody **bodies,
+                      int maxCount);
+
+/* 
+    Finds all bodies in `w` within `distance` of `s` with the transform `tx`,
+    then stores up to `maxCount` of them to `bodies` and returns their number.
+*/
+int frQueryWorldWithinDistance(frWorld *w,
+                               const frShape *s,
+                               frTransform tx,
+                               float distance,
+                               frBody **bodies,
+                               int maxCount);
+
+/* 
+    Finds a body in `w` containing each of the first `n` `points`, then 
+    stores it (or `NULL` if there is none) to `bodies` and returns 
+    the number of points inside any body.
+*/
+int frQueryWorldPoints(frWorld *w,
+                       const frVector2 *points,
+                       int n,
+                       frBody **bodies);
+
+/* 
+    Finds up to `k` bodies in `w` closest to `point` that pass `filter`
+    (which may be `NULL`), then stores them to `bodies` in order of 
+    increasing distance and returns their number.
+*/
+int frQueryWorldNearest(frWorld *w,
+                        frVector2 point,
+                        int k,
+                        frBodyFilterFunc filter,
+                        void *userData,
+                        frBody **bodies);
+
+/* 
+    Adds a watcher for the region `aabb` to `w`, which sees every body 
+    whose AABB overlaps `aabb`, then returns its ID,
+    or `-1` if no more watchers can be added.
+*/
+int frAddWatcherToWorld(frWorld *w, frAABB aabb);
+
+/* Removes the watcher with the given `id` from `w`. */
+bool frRemoveWatcherFromWorld(frWorld *w, int id);
+
+/* 
+    Sets the region of the watcher with the given `id` in `w` to `aabb`, 
+    then updates its enter and leave sets.
+*/
+bool frSetWatcherAABB(frWorld *w, int id, frAABB aabb);
+
+/* 
+    Returns the bodies that have entered the watcher with the given `id` 
+    in `w` since its events were last cleared, and stores their number
+    to `count`.
+*/
+frBody *const *frGetWatcherEnterSet(const frWorld *w, int id, int *count);
+
+/* 
+    Returns the bodies that have left the watcher with the given `id` 
+    in `w` since its events were last cleared, and stores their number
+    to `count`.
+*/
+frBody *const *frGetWatcherLeaveSet(const frWorld *w, int id, int *count);
+
+/* Clears the enter and leave sets of the watcher with the given `id` in `w`. */
+void frClearWatcherEvents(frWorld *w, int id);
+
+/* Checks if `b` is visible to the watcher with the given `id` in `w`. */
+bool frIsBodyInWatcher(const frWorld *w, int id, frBody *b);
+
+/* 
+    Applies an impulse of `magnitude` pointing away from `center` to each 
+    dynamic body in `w` within `radius` of `center` that passes `filter` 
+    (which may be `NULL`), scaled down by `falloff` over the distance; 
+    if `occlusion` is `true`, the bodies behind static bodies are shielded.
+    Returns the number of bodies affected.
+*/
+int frApplyRadialImpulse(frWorld *w,
+                         frVector2 center,
+                         float radius,
+                         float magnitude,
+                         frFalloffType falloff,
+                         bool occlusion,
+                         frBodyFilterFunc filter,
+                         void *userData);
+
+/* 
+    Predicts the path of `s` launched from `position` with `velocity` 
+    under the gravity of `w` (scaled by `gravityScale`) for up to `maxSteps`
+    steps of `dt`, sweeping it against the static bodies (and the kinematic
+    bodies as well, if `kinematic` is `true`) in `w`. Stores the positions
+    along the path to `path`, which must have room for `maxSteps + 1` points, 
+    and the information about the first impact (if any) to `raycastHit`, 
+    whose `distance` is measured along the path, then returns 
+    the number of points stored.
+*/
+int frPredictTrajectory(frWorld *w,
+                        const frShape *s,
+                        frVector2 position,
+                        frVector2 velocity,
+                        float gravityScale,
+                        float dt,
+                        int maxSteps,
+                        bool kinematic,
+                        frVector2 *path,
+                        frRaycastHit *raycastHit);
+
 /* Inline Functions =======================================================> */
 
 /* Adds `v1` and `v2`. */
@@ -0,0 +1,871 @@
+/* 
+    Copyright (c) 2021-2024 Jaedeok Kim <jdeokkim@protonmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a 
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation 
+    the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+    and/or sell copies of the Software, and to permit persons to whom the 
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included 
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Includes ===============================================================> */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "ferox.h"
+
+#include "external/ferox_utils.h"
+
+/* Typedefs ===============================================================> */
+
+/* 
+    A structure that represents a convex piece of a baked outline,
+    along with its position relative to the center of the bitmap.
+*/
+typedef struct frBakedPiece_ {
+    frVertices vertices;
+    frVector2 position;
+} frBakedPiece;
+
+/* A structure that represents the convex pieces baked from a bitmap. */
+struct frBakedShape_ {
+    frBakedPiece *pieces;
+    int count;
+};
+
+/* 
+    A structure that represents a convex piece of a traced outline,
+    with the indices of its vertices in the outline.
+*/
+typedef struct frOutlinePiece_ {
+    int indices[FR_GEOMETRY_MAX_VERTEX_COUNT];
+    int count;
+} frOutlinePiece;
+
+/* A dynamic array of points on a traced outline. */
+typedef frDynArray(frVector2) frOutlineArray;
+
+/* A dynamic array of convex pieces of a traced outline. */
+typedef frDynArray(frOutlinePiece) frOutlinePieceArray;
+
+/* Constants ==============================================================> */
+
+/* The magic number at the start of a baked shape blob. */
+static const unsigned char BAKED_SHAPE_MAGIC[4] = { 'F', 'R', 'B', 'K' };
+
+/* The version of the baked shape blob format. */
+static const unsigned char BAKED_SHAPE_VERSION = 1;
+
+/* The size of the header of a baked shape blob, in bytes. */
+static const size_t BAKED_SHAPE_HEADER_SIZE = 9;
+
+/* Private Function Prototypes ============================================> */
+
+/* 
+    Returns `true` if the pixel at (`x`, `y`) belongs to
+    the connected component with the given `label`.
+*/
+static bool frIsComponentPixel(const int *labels,
+                               int width,
+                               int height,
+                               int x,
+                               int y,
+                               int label);
+
+/* 
+    Assigns `label` to every solid pixel connected to (`x`, `y`),
+    using `stack` as a scratch buffer of `width * height` elements.
+*/
+static void frFillComponent(const unsigned char *alpha,
+                            unsigned char threshold,
+                            int *labels,
+                            int *stack,
+                            int width,
+                            int height,
+                            int x,
+                            int y,
+                            int label);
+
+/* 
+    Traces the outer boundary of the connected component whose first
+    pixel (in scan order) is at (`x`, `y`), then stores the corners
+    of the boundary in `outline`.
+*/
+static void frTraceOutline(const int *labels,
+                           int width,
+                           int height,
+                           int x,
+                           int y,
+                           frOutlineArray *outline);
+
+/* 
+    Simplifies the closed `outline` with the Ramer-Douglas-Peucker
+    algorithm, using `keep` as a scratch buffer.
+*/
+static void frSimplifyOutline(frOutlineArray *outline,
+                              bool *keep,
+                              float tolerance);
+
+/* 
+    Marks the points between the `i`-th and the `j`-th points of
+    the closed `outline` that must be kept within `tolerance`.
+*/
+static void frSimplifyOutlineRange(const frVector2 *points,
+                                   int count,
+                                   bool *keep,
+                                   int i,
+                                   int j,
+                                   float tolerance);
+
+/* 
+    Decomposes the simple, counter-clockwise `outline` into convex pieces
+    with the ear clipping and the Hertel-Mehlhorn algorithm.
+*/
+static void frDecomposeOutline(const frOutlineArray *outline,
+                               frOutlinePieceArray *pieces);
+
+/* 
+    Returns `true` if the ear (`a`, `b`, `c`) of the polygon formed by
+    the `count` remaining `indices` contains no other vertices.
+*/
+static bool frIsOutlineEar(const frVector2 *points,
+                           const int *indices,
+                           int count,
+                           int a,
+                           int b,
+                           int c);
+
+/* 
+    Merges `p1` and `p2` into `result` if they share an edge
+    and the merged piece is convex.
+*/
+static bool frMergeOutlinePieces(const frVector2 *points,
+                                 const frOutlinePiece *p1,
+                                 const frOutlinePiece *p2,
+                                 frOutlinePiece *result);
+
+/* Returns the cross product of (`b` - `a`) and (`c` - `b`). */
+static double frGetOutlineTurn(frVector2 a, frVector2 b, frVector2 c);
+
+/* Writes `value` to `buffer` in little-endian byte order. */
+static void frWriteUint32(unsigned char *buffer, uint32_t value);
+
+/* Reads a 32-bit unsigned integer in little-endian byte order. */
+static uint32_t frReadUint32(const unsigned char *buffer);
+
+/* Writes `value` to `buffer` in little-endian byte order. */
+static void frWriteFloat(unsigned char *buffer, float value);
+
+/* Reads a 32-bit floating-point number in little-endian byte order. */
+static float frReadFloat(const unsigned char *buffer);
+
+/* Public Functions =======================================================> */
+
+/* 
+    Bakes the pixels of the `width` x `height` `alpha` mask whose values
+    are greater than `threshold` into convex pieces: the outer boundary of
+    each 4-connected group of pixels is traced, simplified within
+    `tolerance` (in pixels), then decomposed into convex pieces that can
+    be used as 'polygon' collision shapes. (Holes are filled.)
+*/
+frBakedShape *frBakeBitmap(const unsigned char *alpha,
+                           int width,
+                           int height,
+                           unsigned char threshold,
+                           float tolerance) {
+    if (alpha == NULL || width <= 0 || height <= 0) return NULL;
+
+    int pixelCount = width * height;
+
+    int *labels = malloc(2 * pixelCount * sizeof *labels);
+    bool *keep = NULL;
+
+    if (labels == NULL) return NULL;
+
+    int *stack = labels + pixelCount;
+
+    for (int i = 0; i < pixelCount; i++)
+        labels[i] = -1;
+
+    frOutlineArray outline = { .buffer = NULL };
+    frOutlinePieceArray outlinePieces = { .buffer = NULL };
+
+    frDynArray(frBakedPiece) pieces = { .buffer = NULL };
+
+    frInitDynArray(outline);
+    frInitDynArray(outlinePieces);
+    frInitDynArray(pieces);
+
+    frVector2 center = { .x = 0.5f * width, .y = 0.5f * height };
+
+    for (int y = 0, label = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (alpha[y * width + x] <= threshold || labels[y * width + x] >= 0)
+                continue;
+
+            frFillComponent(alpha,
+                            threshold,
+                            labels,
+                            stack,
+                            width,
+                            height,
+                            x,
+                            y,
+                            label++);
+
+            frTraceOutline(labels, width, height, x, y, &outline);
+
+            int count = frGetDynArrayLength(outline);
+
+            bool *newKeep = realloc(keep, count * sizeof *newKeep);
+
+            if (newKeep == NULL) continue;
+
+            keep = newKeep;
+
+            frSimplifyOutline(&outline, keep, tolerance);
+
+            frDecomposeOutline(&outline, &outlinePieces);
+
+            for (int i = 0; i < frGetDynArrayLength(outlinePieces); i++) {
+                frOutlinePiece outlinePiece = frGetDynArrayValue(outlinePieces,
+                                                                 i);
+
+                frBakedPiece piece = { .vertices = { .count = 0 } };
+
+                float twiceAreaSum = 0.0f;
+
+                frVector2 centroid = frStructZero(frVector2);
+
+                for (int j = 0; j < outlinePiece.count; j++) {
+                    frVector2 v = frGetDynArrayValue(outline,
+                                                     outlinePiece.indices[j]);
+
+                    piece.vertices.data[j] = frVector2PixelsToUnits(
+                        frVector2Subtract(v, center));
+                }
+
+                piece.vertices.count = outlinePiece.count;
+
+                for (int j = 1; j < piece.vertices.count - 1; j++) {
+                    frVector2 v1 = piece.vertices.data[0];
+                    frVector2 v2 = piece.vertices.data[j];
+                    frVector2 v3 = piece.vertices.data[j + 1];
+
+                    float twiceArea = frVector2Cross(frVector2Subtract(v2, v1),
+                                                     frVector2Subtract(v3, v1));
+
+                    centroid = frVector2Add(
+                        centroid,
+                        frVector2ScalarMultiply(
+                            frVector2Add(v1, frVector2Add(v2, v3)),
+                            twiceArea / 3.0f));
+
+                    twiceAreaSum += twiceArea;
+                }
+
+                if (twiceAreaSum == 0.0f) continue;
+
+                // NOTE: Each piece is centered at its own centroid.
+                piece.position = frVector2ScalarMultiply(centroid,
+                                                         1.0f / twiceAreaSum);
+
+                for (int j = 0; j < piece.vertices.count; j++)
+                    piece.vertices.data[j] = frVector2Subtract(
+                        piece.vertices.data[j], piece.position);
+
+                frDynArrayPush(pieces, piece);
+            }
+        }
+    }
+
+    free(labels), free(keep);
+
+    frReleaseDynArray(outline);
+    frReleaseDynArray(outlinePieces);
+
+    frBakedShape *result = NULL;
+
+    int count = frGetDynArrayLength(pieces);
+
+    if (count > 0) {
+        result = malloc(sizeof *result + count * sizeof *(result->pieces));
+
+        if (result != NULL) {
+            result->pieces = (frBakedPiece *) (result + 1);
+            result->count = count;
+
+            for (int i = 0; i < count; i++)
+                result->pieces[i] = frGetDynArrayValue(pieces, i);
+        }
+    }
+
+    frReleaseDynArray(pieces);
+
+    return result;
+}
+
+/* Releases the memory allocated for `b`. */
+void frReleaseBakedShape(frBakedShape *b) {
+    free(b);
+}
+
+/* Returns the number of convex pieces in `b`. */
+int frGetBakedShapePieceCount(const frBakedShape *b) {
+    return (b != NULL) ? b->count : 0;
+}
+
+/* 
+    Returns the vertices of the `i`-th convex piece in `b`,
+    relative to the position of the piece.
+*/
+const frVertices *frGetBakedShapePiece(const frBakedShape *b, int i) {
+    return (b != NULL && i >= 0 && i < b->count) ? &b->pieces[i].vertices
+                                                 : NULL;
+}
+
+/* 
+    Returns the position of the `i`-th convex piece in `b`,
+    relative to the center of the bitmap.
+*/
+frVector2 frGetBakedShapePiecePosition(const frBakedShape *b, int i) {
+    return (b != NULL && i >= 0 && i < b->count) ? b->pieces[i].position
+                                                 : frStructZero(frVector2);
+}
+
+/* 
+    Writes `b` to `buffer` as a binary blob if `size` is large enough,
+    then returns the size of the blob (in bytes).
+*/
+size_t frSaveBakedShape(const frBakedShape *b, void *buffer, size_t size) {
+    if (b == NULL) return 0;
+
+    size_t result = BAKED_SHAPE_HEADER_SIZE;
+
+    for (int i = 0; i < b->count; i++)
+        result += 1 + (2 + 2 * b->pieces[i].vertices.count) * sizeof(float);
+
+    if (buffer == NULL || size < result) return result;
+
+    unsigned char *ptr = buffer;
+
+    memcpy(ptr, BAKED_SHAPE_MAGIC, sizeof BAKED_SHAPE_MAGIC);
+
+    ptr[4] = BAKED_SHAPE_VERSION;
+
+    frWriteUint32(ptr + 5, (uint32_t) b->count);
+
+    ptr += BAKED_SHAPE_HEADER_SIZE;
+
+    for (int i = 0; i < b->count; i++) {
+        const frBakedPiece *piece = &b->pieces[i];
+
+        *(ptr++) = (unsigned char) piece->vertices.count;
+
+        frWriteFloat(ptr, piece->position.x), ptr += sizeof(float);
+        frWriteFloat(ptr, piece->position.y), ptr += sizeof(float);
+
+        for (int j = 0; j < piece->vertices.count; j++) {
+            frWriteFloat(ptr, piece->vertices.data[j].x), ptr += sizeof(float);
+            frWriteFloat(ptr, piece->vertices.data[j].y), ptr += sizeof(float);
+        }
+    }
+
+    return result;
+}
+
+/* 
+    Loads the convex pieces from the binary blob of `size` bytes
+    in `buffer`, which was written by `frSaveBakedShape()`.
+*/
+frBakedShape *frLoadBakedShape(const void *buffer, size_t size) {
+    if (buffer == NULL || size < BAKED_SHAPE_HEADER_SIZE) return NULL;
+
+    const unsigned char *ptr = buffer, *end = ptr + size;
+
+    if (memcmp(ptr, BAKED_SHAPE_MAGIC, sizeof BAKED_SHAPE_MAGIC) != 0
+        || ptr[4] != BAKED_SHAPE_VERSION)
+        return NULL;
+
+    uint32_t count = frReadUint32(ptr + 5);
+
+    ptr += BAKED_SHAPE_HEADER_SIZE;
+
+    // NOTE: Each piece takes at least 1 + 8 * 4 bytes (a triangle).
+    if (count == 0
+        || count > (size - BAKED_SHAPE_HEADER_SIZE) / (1 + 8 * sizeof(float)))
+        return NULL;
+
+    frBakedShape *result = malloc(sizeof *result
+                                  + count * sizeof *(result->pieces));
+
+    if (result == NULL) return NULL;
+
+    result->pieces = (frBakedPiece *) (result + 1);
+    result->count = (int) count;
+
+    for (uint32_t i = 0; i < count; i++) {
+        frBakedPiece *piece = &result->pieces[i];
+
+        if (end - ptr < 1) goto error;
+
+        int vertexCount = *(ptr++);
+
+        if (vertexCount < 3 || vertexCount > FR_GEOMETRY_MAX_VERTEX_COUNT
+            || (size_t) (end - ptr)
+                   < (2 + 2 * vertexCount) * sizeof(float))
+            goto error;
+
+        piece->position.x = frReadFloat(ptr), ptr += sizeof(float);
+        piece->position.y = frReadFloat(ptr), ptr += sizeof(float);
+
+        for (int j = 0; j < vertexCount; j++) {
+            piece->vertices.data[j].x = frReadFloat(ptr), ptr += sizeof(float);
+            piece->vertices.data[j].y = frReadFloat(ptr), ptr += sizeof(float);
+        }
+
+        piece->vertices.count = vertexCount;
+    }
+
+    return result;
+
+error:
+    free(result);
+
+    return NULL;
+}
+
+/* Private Functions ======================================================> */
+
+/* 
+    Returns `true` if the pixel at (`x`, `y`) belongs to
+    the connected component with the given `label`.
+*/
+static bool frIsComponentPixel(const int *labels,
+                               int width,
+                               int height,
+                               int x,
+                               int y,
+                               int label) {
+    return (x >= 0 && x < width && y >= 0 && y < height)
+           && labels[y * width + x] == label;
+}
+
+/* 
+    Assigns `label` to every solid pixel connected to (`x`, `y`),
+    using `stack` as a scratch buffer of `width * height` elements.
+*/
+static void frFillComponent(const unsigned char *alpha,
+                            unsigned char threshold,
+                            int *labels,
+                            int *stack,
+                            int width,
+                            int height,
+                            int x,
+                            int y,
+                            int label) {
+    int top = 0;
+
+    labels[y * width + x] = label, stack[top++] = y * width + x;
+
+    // NOTE: Each pixel is labeled before it is pushed, so `top <= w * h`.
+    while (top > 0) {
+        int i = stack[--top], px = i % width, py = i / width;
+
+        const int neighbors[4][2] = {
+            { px - 1, py }, { px + 1, py }, { px, py - 1 }, { px, py + 1 }
+        };
+
+        for (int j = 0; j < 4; j++) {
+            int nx = neighbors[j][0], ny = neighbors[j][1];
+
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+
+            int k = ny * width + nx;
+
+            if (alpha[k] <= threshold || labels[k] >= 0) continue;
+
+            labels[k] = label, stack[top++] = k;
+        }
+    }
+}
+
+/* 
+    Traces the outer boundary of the connected component whose first
+    pixel (in scan order) is at (`x`, `y`), then stores the corners
+    of the boundary in `outline`.
+*/
+static void frTraceOutline(const int *labels,
+                           int width,
+                           int height,
+                           int x,
+                           int y,
+                           frOutlineArray *outline) {
+    int label = labels[y * width + x];
+
+    frSetDynArrayLength(*outline, 0);
+
+    /*
+        NOTE: The boundary is walked along the edges between the pixels,
+        keeping the component on the right, starting from the top-left
+        corner of its first pixel, where the boundary always turns.
+    */
+    int cx = x, cy = y, dx = 1, dy = 0;
+
+    frDynArrayPush(*outline, ((frVector2) { .x = cx, .y = cy }));
+
+    for (;;) {
+        cx += dx, cy += dy;
+
+        int rx = -dy, ry = dx;
+
+        bool aheadRight = frIsComponentPixel(labels,
+                                             width,
+                                             height,
+                                             cx + (dx + rx - 1) / 2,
+                                             cy + (dy + ry - 1) / 2,
+                                             label);
+        bool aheadLeft = frIsComponentPixel(labels,
+                                            width,
+                                            height,
+                                            cx + (dx - rx - 1) / 2,
+                                            cy + (dy - ry - 1) / 2,
+                                            label);
+
+        int ndx = dx, ndy = dy;
+
+        if (!aheadRight) ndx = rx, ndy = ry;
+        else if (aheadLeft) ndx = -rx, ndy = -ry;
+
+        if (cx == x && cy == y && ndx == 1 && ndy == 0) break;
+
+        if (ndx != dx || ndy != dy)
+            frDynArrayPush(*outline, ((frVector2) { .x = cx, .y = cy }));
+
+        dx = ndx, dy = ndy;
+    }
+}
+
+/* 
+    Simplifies the closed `outline` with the Ramer-Douglas-Peucker
+    algorithm, using `keep` as a scratch buffer.
+*/
+static void frSimplifyOutline(frOutlineArray *outline,
+                              bool *keep,
+                              float tolerance) {
+    frVector2 *points = outline->buffer;
+
+    int count = frGetDynArrayLength(*outline);
+
+    if (count <= 3 || tolerance <= 0.0f) return;
+
+    /*
+        NOTE: A closed outline is split at its first point and
+        the point farthest from it, then each half is simplified.
+    */
+    int farthestIndex = 0;
+
+    float maxDistanceSqr = 0.0f;
+
+    for (int i = 1; i < count; i++) {
+        float distanceSqr = frVector2DistanceSqr(points[0], points[i]);
+
+        if (maxDistanceSqr < distanceSqr)
+            maxDistanceSqr = distanceSqr, farthestIndex = i;
+    }
+
+    for (int i = 0; i < count; i++)
+        keep[i] = false;
+
+    keep[0] = keep[farthestIndex] = true;
+
+    frSimplifyOutlineRange(points, count, keep, 0, farthestIndex, tolerance);
+    frSimplifyOutlineRange(points,
+                           count,
+                           keep,
+                           farthestIndex,
+                           count,
+                           tolerance);
+
+    int newCount = 0;
+
+    for (int i = 0; i < count; i++)
+        if (keep[i]) points[newCount++] = points[i];
+
+    frSetDynArrayLength(*outline, newCount);
+}
+
+/* 
+    Marks the points between the `i`-th and the `j`-th points of
+    the closed `outline` that must be kept within `tolerance`.
+*/
+static void frSimplifyOutlineRange(const frVector2 *points,
+                                   int count,
+                                   bool *keep,
+                                   int i,
+                                   int j,
+                                   float tolerance) {
+    if (j - i < 2) return;
+
+    frVector2 v1 = points[i], v2 = points[j % count];
+
+    frVector2 edge = frVector2Subtract(v2, v1);
+
+    float edgeLengthSqr = frVector2MagnitudeSqr(edge);
+
+    int farthestIndex = -1;
+
+    float maxDistance = tolerance;
+
+    for (int k = i + 1; k < j; k++) {
+        frVector2 v = frVector2Subtract(points[k], v1);
+
+        float t = (edgeLengthSqr > 0.0f)
+                      ? frVector2Dot(v, edge) / edgeLengthSqr
+                      : 0.0f;
+
+        if (t < 0.0f) t = 0.0f;
+        else if (t > 1.0f) t = 1.0f;
+
+        float distance = frVector2Magnitude(
+            frVector2Subtract(v, frVector2ScalarMultiply(edge, t)));
+
+        if (maxDistance < distance) maxDistance = distance, farthestIndex = k;
+    }
+
+    if (farthestIndex < 0) return;
+
+    keep[farthestIndex] = true;
+
+    frSimplifyOutlineRange(points, count, keep, i, farthestIndex, tolerance);
+    frSimplifyOutlineRange(points, count, keep, farthestIndex, j, tolerance);
+}
+
+/* 
+    Decomposes the simple, counter-clockwise `outline` into convex pieces
+    with the ear clipping and the Hertel-Mehlhorn algorithm.
+*/
+static void frDecomposeOutline(const frOutlineArray *outline,
+                               frOutlinePieceArray *pieces) {
+    const frVector2 *points = outline->buffer;
+
+    int count = frGetDynArrayLength(*outline);
+
+    frSetDynArrayLength(*pieces, 0);
+
+    if (count < 3) return;
+
+    int *indices = malloc(count * sizeof *indices);
+
+    if (indices == NULL) return;
+
+    double twiceArea = 0.0;
+
+    for (int j = count - 1, i = 0; i < count; j = i, i++)
+        twiceArea += (double) points[j].x * points[i].y
+                     - (double) points[i].x * points[j].y;
+
+    // NOTE: The outline is made counter-clockwise (with the y-axis up).
+    for (int i = 0; i < count; i++)
+        indices[i] = (twiceArea > 0.0) ? i : (count - 1) - i;
+
+    for (int i = 0, n = count, attempts = 0; n >= 3 && attempts < n;) {
+        int a = indices[(i + n - 1) % n], b = indices[i],
+            c = indices[(i + 1) % n];
+
+        double turn = frGetOutlineTurn(points[a], points[b], points[c]);
+
+        if (turn > 0.0 && !frIsOutlineEar(points, indices, n, a, b, c)) {
+            i = (i + 1) % n, attempts++;
+
+            continue;
+        }
+
+        // NOTE: Collinear (or degenerate) vertices are removed without a piece.
+        if (turn > 0.0) {
+            frOutlinePiece piece = { .indices = { a, b, c }, .count = 3 };
+
+            frDynArrayPush(*pieces, piece);
+        } else if (turn < 0.0) {
+            i = (i + 1) % n, attempts++;
+
+            continue;
+        }
+
+        for (int j = i; j < n - 1; j++)
+            indices[j] = indices[j + 1];
+
+        n--, attempts = 0;
+
+        if (i >= n) i = 0;
+    }
+
+    free(indices);
+
+    /*
+        NOTE: Each pair of pieces sharing an edge (a diagonal made by
+        the ear clipping) is merged while the merged piece stays convex
+        and fits in `FR_GEOMETRY_MAX_VERTEX_COUNT` vertices.
+    */
+    for (bool merged = true; merged;) {
+        merged = false;
+
+        for (int i = 0; i < frGetDynArrayLength(*pieces); i++) {
+            for (int j = i + 1; j < frGetDynArrayLength(*pieces); j++) {
+                frOutlinePiece piece;
+
+                if (!frMergeOutlinePieces(points,
+                                          &frGetDynArrayValue(*pieces, i),
+                                          &frGetDynArrayValue(*pieces, j),
+                                          &piece))
+                    continue;
+
+                int lastIndex = frGetDynArrayLength(*pieces) - 1;
+
+                frGetDynArrayValue(*pieces, i) = piece;
+                frGetDynArrayValue(*pieces, j) = frGetDynArrayValue(*pieces,
+                                                                    lastIndex);
+
+                frSetDynArrayLength(*pieces, lastIndex);
+
+                merged = true, j--;
+            }
+        }
+    }
+}
+
+/* 
+    Returns `true` if the ear (`a`, `b`, `c`) of the polygon formed by
+    the `count` remaining `indices` contains no other vertices.
+*/
+static bool frIsOutlineEar(const frVector2 *points,
+                           const int *indices,
+                           int count,
+                           int a,
+                           int b,
+                           int c) {
+    frVector2 v1 = points[a], v2 = points[b], v3 = points[c];
+
+    for (int i = 0; i < count; i++) {
+        int k = indices[i];
+
+        if (k == a || k == b || k == c) continue;
+
+        frVector2 v = points[k];
+
+        // NOTE: An outline may touch itself at a corner.
+        if (frVector2DistanceSqr(v, v1) == 0.0f
+            || frVector2DistanceSqr(v, v2) == 0.0f
+            || frVector2DistanceSqr(v, v3) == 0.0f)
+            continue;
+
+        if (frGetOutlineTurn(v1, v2, v) >= 0.0
+            && frGetOutlineTurn(v2, v3, v) >= 0.0
+            && frGetOutlineTurn(v3, v1, v) >= 0.0)
+            return false;
+    }
+
+    return true;
+}
+
+/* 
+    Merges `p1` and `p2` into `result` if they share an edge
+    and the merged piece is convex.
+*/
+static bool frMergeOutlinePieces(const frVector2 *points,
+                                 const frOutlinePiece *p1,
+                                 const frOutlinePiece *p2,
+                                 frOutlinePiece *result) {
+    for (int i = 0; i < p1->count; i++) {
+        int u = p1->indices[i], v = p1->indices[(i + 1) % p1->count];
+
+        for (int j = 0; j < p2->count; j++) {
+            if (p2->indices[j] != v || p2->indices[(j + 1) % p2->count] != u)
+                continue;
+
+            int indices[2 * FR_GEOMETRY_MAX_VERTEX_COUNT], count = 0;
+
+            // NOTE: `p1` from `v` to `u`, then `p2` without `v` and `u`.
+            for (int k = 1; k <= p1->count; k++)
+                indices[count++] = p1->indices[(i + k) % p1->count];
+
+            for (int k = 2; k < p2->count; k++)
+                indices[count++] = p2->indices[(j + k) % p2->count];
+
+            result->count = 0;
+
+            for (int k = 0; k < count; k++) {
+                double turn = frGetOutlineTurn(
+                    points[indices[(k + count - 1) % count]],
+                    points[indices[k]],
+                    points[indices[(k + 1) % count]]);
+
+                if (turn < 0.0) return false;
+                else if (turn == 0.0) continue;
+
+                if (result->count >= FR_GEOMETRY_MAX_VERTEX_COUNT) return false;
+
+                result->indices[result->count++] = indices[k];
+            }
+
+            return result->count >= 3;
+        }
+    }
+
+    return false;
+}
+
+/* Returns the cross product of (`b` - `a`) and (`c` - `b`). */
+static double frGetOutlineTurn(frVector2 a, frVector2 b, frVector2 c) {
+    return ((double) b.x - a.x) * ((double) c.y - b.y)
+           - ((double) b.y - a.y) * ((double) c.x - b.x);
+}
+
+/* Writes `value` to `buffer` in little-endian byte order. */
+static void frWriteUint32(unsigned char *buffer, uint32_t value) {
+    for (int i = 0; i < 4; i++)
+        buffer[i] = (unsigned char) (value >> (8 * i));
+}
+
+/* Reads a 32-bit unsigned integer in little-endian byte order. */
+static uint32_t frReadUint32(const unsigned char *buffer) {
+    uint32_t result = 0;
+
+    for (int i = 0; i < 4; i++)
+        result |= (uint32_t) buffer[i] << (8 * i);
+
+    return result;
+}
+
+/* Writes `value` to `buffer` in little-endian byte order. */
+static void frWriteFloat(unsigned char *buffer, float value) {
+    uint32_t bits;
+
+    memcpy(&bits, &value, sizeof bits);
+
+    frWriteUint32(buffer, bits);
+}
+
+/* Reads a 32-bit floating-point number in little-endian byte order. */
+static float frReadFloat(const unsigned char *buffer) {
+    uint32_t bits = frReadUint32(buffer);
+
+    float result;
+
+    memcpy(&result, &bits, sizeof result);
+
+    return result;
+}
@@ -47,10 +47,50 @@ typedef struct frSpatialHashEntry_ {
 struct frSpatialHash_ {
     frSpatialHashEntry *entries;
     float cellSize, inverseCellSize;
+    frVector2i minCell, maxCell;
+    bool boundsOutdated;
     frDynArray(int) queryResult;
     frBitArray indexSet;
 };
 
+/* Constants ==============================================================> */
+
+/* The largest absolute value of a cell coordinate in a spatial hash. */
+static const float CELL_POSITION_LIMIT = 1073741824.0f;
+
+/* Private Function Prototypes ============================================> */
+
+/* Compares two `int` values, for `qsort()`. */
+static int frCompareIndices(const void *x, const void *y);
+
+/* Returns the position of the cell in `sh` that contains `v`. */
+static frVector2i frGetCellPosition(const frSpatialHash *sh, frVector2 v);
+
+/* Resets the bounds of all non-empty cells in `sh`. */
+static void frResetCellBounds(frSpatialHash *sh);
+
+/* 
+    Recomputes the bounds of all non-empty cells in `sh` if they have 
+    become too large, releasing the cells that have become empty.
+*/
+static void frUpdateCellBounds(frSpatialHash *sh);
+
+/* 
+    Calls `func` with `userData` for each object in the cell at `position`
+    that has not yet been found by the current query, until `func` ends 
+    the traversal by making `*maxDistance` negative.
+*/
+static void frVisitCell(frSpatialHash *sh,
+                        frVector2i position,
+                        const float *maxDistance,
+                        frHashQueryFunc func,
+                        void *userData);
+
+/* Returns the distance between `point` and the cell at `position` in `sh`. */
+static float frGetCellDistance(const frSpatialHash *sh,
+                               frVector2i position,
+                               frVector2 point);
+
 /* Public Functions =======================================================> */
 
 /* Creates a new spatial hash with the given `cellSize`. */
@@ -66,6 +106,8 @@ frSpatialHash *frCreateSpatialHash(float cellSize) {
 
     frInitDynArray(sh->queryResult);
 
+    frResetCellBounds(sh);
+
     return sh;
 }
 
@@ -88,6 +130,8 @@ void frClearSpatialHash(frSpatialHash *sh) {
 
     for (int i = 0; i < hmlen(sh->entries); i++)
         frSetDynArrayLength(sh->entries[i].value, 0);
+
+    frResetCellBounds(sh);
 }
 
 /* Returns the cell size of `sh`. */
@@ -95,20 +139,46 @@ float frGetSpatialHashCellSize(const frSpatialHash *sh) {
     return (sh != NULL) ? sh->cellSize : 0.0f;
 }
 
+/* 
+    Returns the bounds of all non-empty cells in `sh`, 
+    or an empty AABB if `sh` is empty.
+*/
+frAABB frGetSpatialHashBounds(frSpatialHash *sh) {
+    if (sh == NULL) return frStructZero(frAABB);
+
+    frUpdateCellBounds(sh);
+
+    if (sh->minCell.x > sh->maxCell.x || sh->minCell.y > sh->maxCell.y)
+        return frStructZero(frAABB);
+
+    return (frAABB) {
+        .x = sh->minCell.x * sh->cellSize,
+        .y = sh->minCell.y * sh->cellSize,
+        .width = ((sh->maxCell.x - sh->minCell.x) + 1) * sh->cellSize,
+        .height = ((sh->maxCell.y - sh->minCell.y) + 1) * sh->cellSize
+    };
+}
+
 /* Inserts a `key`-`value` pair into `sh`. */
 void frInsertIntoSpatialHash(frSpatialHash *sh, frAABB key, int value) {
     if (sh == NULL) return;
 
-    float inverseCellSize = sh->inverseCellSize;
+    frVector2i minCell = frGetCellPosition(sh,
+                                           (frVector2) { .x = key.x,
+                                                         .y = key.y });
+
+    frVector2i maxCell = frGetCellPosition(
+        sh,
+        (frVector2) { .x = key.x + key.width, .y = key.y + key.height });
 
-    int minX = key.x * inverseCellSize;
-    int minY = key.y * inverseCellSize;
+    if (sh->minCell.x > minCell.x) sh->minCell.x = minCell.x;
+    if (sh->minCell.y > minCell.y) sh->minCell.y = minCell.y;
 
-    int maxX = (key.x + key.width) * inverseCellSize;
-    int maxY = (key.y + key.height) * inverseCellSize;
+    if (sh->maxCell.x < maxCell.x) sh->maxCell.x = maxCell.x;
+    if (sh->maxCell.y < maxCell.y) sh->maxCell.y = maxCell.y;
 
-    for (int y = minY; y <= maxY; y++)
-        for (int x = minX; x <= maxX; x++) {
+    for (int y = minCell.y; y <= maxCell.y; y++)
+        for (int x = minCell.x; x <= maxCell.x; x++) {
             frVector2i key = { .x = x, .y = y };
 
             frSpatialHashEntry *entry = hmgetp_null(sh->entries, key);
@@ -126,6 +196,52 @@ void frInsertIntoSpatialHash(frSpatialHash *sh, frAABB key, int value) {
         }
 }
 
+/* 
+    Removes a `key`-`value` pair from `sh`, where `key` must be the same AABB 
+    that `value` was inserted with.
+*/
+void frRemoveFromSpatialHash(frSpatialHash *sh, frAABB key, int value) {
+    if (sh == NULL) return;
+
+    frVector2i minCell = frGetCellPosition(sh,
+                                           (frVector2) { .x = key.x,
+                                                         .y = key.y });
+
+    frVector2i maxCell = frGetCellPosition(
+        sh,
+        (frVector2) { .x = key.x + key.width, .y = key.y + key.height });
+
+    for (int y = minCell.y; y <= maxCell.y; y++)
+        for (int x = minCell.x; x <= maxCell.x; x++) {
+            frVector2i key = { .x = x, .y = y };
+
+            frSpatialHashEntry *entry = hmgetp_null(sh->entries, key);
+
+            if (entry == NULL) continue;
+
+            int lastIndex = frGetDynArrayLength(entry->value) - 1;
+
+            for (int i = 0; i <= lastIndex; i++)
+                if (frGetDynArrayValue(entry->value, i) == value) {
+                    frDynArraySwap(int, entry->value, i, lastIndex);
+
+                    frSetDynArrayLength(entry->value, lastIndex);
+
+                    break;
+                }
+
+            /*
+                NOTE: The bounds of `sh` only need to shrink when a cell 
+                on their edge becomes empty, and they are recomputed lazily 
+                by the next query that walks through the empty cells.
+            */
+            if (frGetDynArrayLength(entry->value) == 0
+                && (x == sh->minCell.x || x == sh->maxCell.x
+                    || y == sh->minCell.y || y == sh->maxCell.y))
+                sh->boundsOutdated = true;
+        }
+}
+
 /* Query `sh` for any objects that are likely to overlap the given `aabb`. */
 void frQuerySpatialHash(frSpatialHash *sh,
                         frAABB aabb,
@@ -133,40 +249,56 @@ void frQuerySpatialHash(frSpatialHash *sh,
                         void *userData) {
     if (sh == NULL) return;
 
-    float inverseCellSize = sh->inverseCellSize;
+    frVector2i minCell = frGetCellPosition(sh,
+                                           (frVector2) { .x = aabb.x,
+                                                         .y = aabb.y });
+
+    frVector2i maxCell = frGetCellPosition(
+        sh,
+        (frVector2) { .x = aabb.x + aabb.width, .y = aabb.y + aabb.height });
 
-    int minX = aabb.x * inverseCellSize;
-    int minY = aabb.y * inverseCellSize;
+    /* NOTE: Cells outside of the bounds of `sh` are always empty. */
+    if (minCell.x < sh->minCell.x) minCell.x = sh->minCell.x;
+    if (minCell.y < sh->minCell.y) minCell.y = sh->minCell.y;
 
-    int maxX = (aabb.x + aabb.width) * inverseCellSize;
-    int maxY = (aabb.y + aabb.height) * inverseCellSize;
+    if (maxCell.x > sh->maxCell.x) maxCell.x = sh->maxCell.x;
+    if (maxCell.y > sh->maxCell.y) maxCell.y = sh->maxCell.y;
 
     frSetDynArrayLength(sh->queryResult, 0);
 
-    for (int y = minY; y <= maxY; y++)
-        for (int x = minX; x <= maxX; x++) {
+    for (int y = minCell.y; y <= maxCell.y; y++)
+        for (int x = minCell.x; x <= maxCell.x; x++) {
             frVector2i key = { .x = x, .y = y };
 
             frSpatialHashEntry *entry = hmgetp_null(sh->entries, key);
 
             if (entry == NULL) continue;
 
-            for (int i = 0; i < frGetDynArrayLength(entry->value); i++)
-                frDynArrayPush(sh->queryResult,
-                               frGetDynArrayValue(entry->value, i));
+            for (int i = 0; i < frGetDynArrayLength(entry->value); i++) {
+                int value = frGetDynArrayValue(entry->value, i);
+
+                if (frBitArrayGet(sh->indexSet, value)) continue;
+
+                frBitArraySet(sh->indexSet, value);
+
+                frDynArrayPush(sh->queryResult, value);
+            }
         }
 
     {
-        frBitArrayClear(sh->indexSet, FR_WORLD_MAX_OBJECT_COUNT);
-
+        /*
+            NOTE: Only the bits that have actually been set are cleared here,
+            so that the cost of a query depends on the number of objects 
+            found, not on `FR_WORLD_MAX_OBJECT_COUNT`.
+        */
         for (int i = 0; i < frGetDynArrayLength(sh->queryResult); i++)
-            frBitArraySet(sh->indexSet, frGetDynArrayValue(sh->queryResult, i));
+            frBitArrayUnset(sh->indexSet,
+                            frGetDynArrayValue(sh->queryResult, i));
 
-        frSetDynArrayLength(sh->queryResult, 0);
-
-        for (int i = 0; i < FR_WORLD_MAX_OBJECT_COUNT; i++)
-            if (frBitArrayGet(sh->indexSet, i))
-                frDynArrayPush(sh->queryResult, i);
+        qsort(sh->queryResult.buffer,
+              frGetDynArrayLength(sh->queryResult),
+              sizeof *(sh->queryResult.buffer),
+              frCompareIndices);
     }
 
     /*
@@ -177,3 +309,316 @@ void frQuerySpatialHash(frSpatialHash *sh,
         func((frContextNode) { .id = frGetDynArrayValue(sh->queryResult, i),
                                .ctx = userData });
 }
+
+/* 
+    Query `sh` for any objects that are likely to intersect the given `ray`,
+    visiting the cells along `ray` in order with a 2D DDA; `func` may shorten
+    `ray->maxDistance` to end the traversal early, or make it negative 
+    to end the traversal immediately.
+*/
+void frQuerySpatialHashRay(frSpatialHash *sh,
+                           frRay *ray,
+                           frHashQueryFunc func,
+                           void *userData) {
+    if (sh == NULL || ray == NULL || func == NULL) return;
+
+    frUpdateCellBounds(sh);
+
+    if (sh->minCell.x > sh->maxCell.x || sh->minCell.y > sh->maxCell.y) return;
+
+    frVector2 direction = frVector2Normalize(ray->direction);
+
+    if (direction.x == 0.0f && direction.y == 0.0f) return;
+
+    /*
+        NOTE: The ray is clipped against the bounds of all non-empty cells
+        first, so that the traversal never visits cells that cannot contain
+        any objects, even when `ray->maxDistance` is `FLT_MAX`.
+    */
+
+    float minDistance = 0.0f, maxDistance = ray->maxDistance;
+
+    {
+        float minBounds[2] = { sh->minCell.x * sh->cellSize,
+                               sh->minCell.y * sh->cellSize };
+
+        float maxBounds[2] = { (sh->maxCell.x + 1) * sh->cellSize,
+                               (sh->maxCell.y + 1) * sh->cellSize };
+
+        float origin[2] = { ray->origin.x, ray->origin.y };
+        float dir[2] = { direction.x, direction.y };
+
+        for (int i = 0; i < 2; i++) {
+            if (dir[i] == 0.0f) {
+                if (origin[i] < minBounds[i] || origin[i] > maxBounds[i])
+                    return;
+
+                continue;
+            }
+
+            float inverseDir = 1.0f / dir[i];
+
+            float t1 = (minBounds[i] - origin[i]) * inverseDir;
+            float t2 = (maxBounds[i] - origin[i]) * inverseDir;
+
+            if (t1 > t2) {
+                float t = t1;
+
+                t1 = t2, t2 = t;
+            }
+
+            if (minDistance < t1) minDistance = t1;
+            if (maxDistance > t2) maxDistance = t2;
+
+            if (minDistance > maxDistance) return;
+        }
+    }
+
+    frVector2i cell = frGetCellPosition(
+        sh,
+        frVector2Add(ray->origin,
+                     frVector2ScalarMultiply(direction, minDistance)));
+
+    /* NOTE: Rounding errors may leave `cell` just outside of the bounds. */
+    cell.x = (cell.x < sh->minCell.x) ? sh->minCell.x : cell.x;
+    cell.x = (cell.x > sh->maxCell.x) ? sh->maxCell.x : cell.x;
+
+    cell.y = (cell.y < sh->minCell.y) ? sh->minCell.y : cell.y;
+    cell.y = (cell.y > sh->maxCell.y) ? sh->maxCell.y : cell.y;
+
+    frVector2i step = { .x = (direction.x > 0.0f) - (direction.x < 0.0f),
+                        .y = (direction.y > 0.0f) - (direction.y < 0.0f) };
+
+    frVector2 deltaDistance = {
+        .x = (step.x != 0) ? fabsf(sh->cellSize / direction.x) : FLT_MAX,
+        .y = (step.y != 0) ? fabsf(sh->cellSize / direction.y) : FLT_MAX
+    };
+
+    frVector2 nextDistance = {
+        .x = (step.x != 0) ? (((cell.x + (step.x > 0)) * sh->cellSize)
+                              - ray->origin.x)
+                                 / direction.x
+                           : FLT_MAX,
+        .y = (step.y != 0) ? (((cell.y + (step.y > 0)) * sh->cellSize)
+                              - ray->origin.y)
+                                 / direction.y
+                           : FLT_MAX
+    };
+
+    frSetDynArrayLength(sh->queryResult, 0);
+
+    for (;;) {
+        if (cell.x < sh->minCell.x || cell.x > sh->maxCell.x
+            || cell.y < sh->minCell.y || cell.y > sh->maxCell.y)
+            break;
+
+        frVisitCell(sh, cell, &ray->maxDistance, func, userData);
+
+        float enterDistance = fminf(nextDistance.x, nextDistance.y);
+
+        /*
+            NOTE: `func` may have shortened `ray->maxDistance`, in which case
+            the cells beyond that distance are not worth visiting.
+        */
+        if (enterDistance > fminf(ray->maxDistance, maxDistance)) break;
+
+        if (nextDistance.x < nextDistance.y) {
+            nextDistance.x += deltaDistance.x, cell.x += step.x;
+        } else {
+            nextDistance.y += deltaDistance.y, cell.y += step.y;
+        }
+    }
+
+    for (int i = 0; i < frGetDynArrayLength(sh->queryResult); i++)
+        frBitArrayUnset(sh->indexSet, frGetDynArrayValue(sh->queryResult, i));
+}
+
+/* 
+    Query `sh` for any objects around `point`, visiting the cells ring by ring
+    outward until no unvisited cell lies within `*maxDistance` of `point`; 
+    `func` may shorten `*maxDistance` to end the traversal early, or make it 
+    negative to end the traversal immediately.
+*/
+void frQuerySpatialHashNearest(frSpatialHash *sh,
+                               frVector2 point,
+                               float *maxDistance,
+                               frHashQueryFunc func,
+                               void *userData) {
+    if (sh == NULL || maxDistance == NULL || func == NULL) return;
+
+    frUpdateCellBounds(sh);
+
+    if (sh->minCell.x > sh->maxCell.x || sh->minCell.y > sh->maxCell.y) return;
+
+    frVector2i center = frGetCellPosition(sh, point);
+
+    /* NOTE: The rings that do not reach the bounds of `sh` are all empty. */
+    int radius = 0;
+
+    if (radius < sh->minCell.x - center.x) radius = sh->minCell.x - center.x;
+    if (radius < center.x - sh->maxCell.x) radius = center.x - sh->maxCell.x;
+    if (radius < sh->minCell.y - center.y) radius = sh->minCell.y - center.y;
+    if (radius < center.y - sh->maxCell.y) radius = center.y - sh->maxCell.y;
+
+    frSetDynArrayLength(sh->queryResult, 0);
+
+    for (; *maxDistance >= 0.0f; radius++) {
+        frVector2i minCell = { .x = center.x - radius, .y = center.y - radius };
+        frVector2i maxCell = { .x = center.x + radius, .y = center.y + radius };
+
+        /* 
+            NOTE: The rings inside the current one already cover 
+            every non-empty cell of `sh`.
+        */
+        if (minCell.x < sh->minCell.x && minCell.y < sh->minCell.y
+            && maxCell.x > sh->maxCell.x && maxCell.y > sh->maxCell.y)
+            break;
+
+        if (radius > 0) {
+            /*
+                NOTE: No cell in the current ring lies closer to `point`
+                than the boundary of the rings inside it.
+            */
+            float minDistance = fminf(
+                fminf(point.x - (minCell.x + 1) * sh->cellSize,
+                      maxCell.x * sh->cellSize - point.x),
+                fminf(point.y - (minCell.y + 1) * sh->cellSize,
+                      maxCell.y * sh->cellSize - point.y));
+
+            if (minDistance > *maxDistance) break;
+        }
+
+        int minY = (minCell.y > sh->minCell.y) ? minCell.y : sh->minCell.y;
+        int maxY = (maxCell.y < sh->maxCell.y) ? maxCell.y : sh->maxCell.y;
+
+        for (int y = minY; y <= maxY && *maxDistance >= 0.0f; y++) {
+            int minX = minCell.x, maxX = maxCell.x, stepX = maxX - minX;
+
+            /* NOTE: Only the top and bottom rows span the whole ring. */
+            if (y == minCell.y || y == maxCell.y) {
+                if (minX < sh->minCell.x) minX = sh->minCell.x;
+                if (maxX > sh->maxCell.x) maxX = sh->maxCell.x;
+
+                stepX = 1;
+            }
+
+            for (int x = minX; x <= maxX; x += stepX) {
+                if (x < sh->minCell.x || x > sh->maxCell.x) continue;
+
+                frVector2i position = { .x = x, .y = y };
+
+                if (frGetCellDistance(sh, position, point) > *maxDistance)
+                    continue;
+
+                frVisitCell(sh, position, maxDistance, func, userData);
+
+                if (*maxDistance < 0.0f) break;
+            }
+        }
+    }
+
+    for (int i = 0; i < frGetDynArrayLength(sh->queryResult); i++)
+        frBitArrayUnset(sh->indexSet, frGetDynArrayValue(sh->queryResult, i));
+}
+
+/* Private Functions ======================================================> */
+
+/* Compares two `int` values, for `qsort()`. */
+static int frCompareIndices(const void *x, const void *y) {
+    int lhs = *(const int *) x, rhs = *(const int *) y;
+
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/* Returns the position of the cell in `sh` that contains `v`. */
+static frVector2i frGetCellPosition(const frSpatialHash *sh, frVector2 v) {
+    float x = floorf(v.x * sh->inverseCellSize);
+    float y = floorf(v.y * sh->inverseCellSize);
+
+    // NOTE: Converting an out-of-range `float` to `int` is undefined!
+    x = fminf(fmaxf(x, -CELL_POSITION_LIMIT), CELL_POSITION_LIMIT);
+    y = fminf(fmaxf(y, -CELL_POSITION_LIMIT), CELL_POSITION_LIMIT);
+
+    return (frVector2i) { .x = (int) x, .y = (int) y };
+}
+
+/* Resets the bounds of all non-empty cells in `sh`. */
+static void frResetCellBounds(frSpatialHash *sh) {
+    sh->minCell = (frVector2i) { .x = INT_MAX, .y = INT_MAX };
+    sh->maxCell = (frVector2i) { .x = INT_MIN, .y = INT_MIN };
+
+    sh->boundsOutdated = false;
+}
+
+/* 
+    Recomputes the bounds of all non-empty cells in `sh` if they have 
+    become too large, releasing the cells that have become empty.
+*/
+static void frUpdateCellBounds(frSpatialHash *sh) {
+    if (!sh->boundsOutdated) return;
+
+    frResetCellBounds(sh);
+
+    // NOTE: `hmdel()` moves the last entry into the slot of the deleted one.
+    for (int i = hmlen(sh->entries) - 1; i >= 0; i--) {
+        frVector2i key = sh->entries[i].key;
+
+        if (frGetDynArrayLength(sh->entries[i].value) == 0) {
+            frReleaseDynArray(sh->entries[i].value);
+
+            (void) hmdel(sh->entries, key);
+
+            continue;
+        }
+
+        if (sh->minCell.x > key.x) sh->minCell.x = key.x;
+        if (sh->minCell.y > key.y) sh->minCell.y = key.y;
+
+        if (sh->maxCell.x < key.x) sh->maxCell.x = key.x;
+        if (sh->maxCell.y < key.y) sh->maxCell.y = key.y;
+    }
+}
+
+/* 
+    Calls `func` with `userData` for each object in the cell at `position`
+    that has not yet been found by the current query, until `func` ends 
+    the traversal by making `*maxDistance` negative.
+*/
+static void frVisitCell(frSpatialHash *sh,
+                        frVector2i position,
+                        const float *maxDistance,
+                        frHashQueryFunc func,
+                        void *userData) {
+    frSpatialHashEntry *entry = hmgetp_null(sh->entries, position);
+
+    if (entry == NULL) return;
+
+    for (int i = 0; i < frGetDynArrayLength(entry->value); i++) {
+        int value = frGetDynArrayValue(entry->value, i);
+
+        if (frBitArrayGet(sh->indexSet, value)) continue;
+
+        frBitArraySet(sh->indexSet, value);
+
+        frDynArrayPush(sh->queryResult, value);
+
+        func((frContextNode) { .id = value, .ctx = userData });
+
+        if (*maxDistance < 0.0f) return;
+    }
+}
+
+/* Returns the distance between `point` and the cell at `position` in `sh`. */
+static float frGetCellDistance(const frSpatialHash *sh,
+                               frVector2i position,
+                               frVector2 point) {
+    float minX = position.x * sh->cellSize, minY = position.y * sh->cellSize;
+
+    float deltaX = fmaxf(fmaxf(minX - point.x, point.x - (minX + sh->cellSize)),
+                         0.0f);
+
+    float deltaY = fmaxf(fmaxf(minY - point.y, point.y - (minY + sh->cellSize)),
+                         0.0f);
+
+    return sqrtf((deltaX * deltaX) + (deltaY * deltaY));
+}
@@ -0,0 +1,285 @@
+/* 
+    Copyright (c) 2021-2024 Jaedeok Kim <jdeokkim@protonmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a 
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation 
+    the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+    and/or sell copies of the Software, and to permit persons to whom the 
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included 
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Includes ===============================================================> */
+
+#include "ferox.h"
+
+/* Typedefs ===============================================================> */
+
+/* A structure that represents a kinematic character controller. */
+struct frCharacter_ {
+    frBody *body;
+    float mass;
+    float maxSlopeCos;
+    frCharacterState state;
+    frBody *ground;
+    frVector2 groundNormal;
+};
+
+/* Constants ==============================================================> */
+
+/* The maximum number of sweeps for each call to `frMoveCharacter()`. */
+static const int CHARACTER_MAX_ITERATION_COUNT = 4;
+
+/* 
+    The distance that a character keeps from other bodies, which must be
+    larger than the gap left by `frComputeShapeCast()`, so that a character
+    can slide along a surface without hitting it over and over again.
+*/
+static const float CHARACTER_SKIN_WIDTH = 0.02f;
+
+/* 
+    The distance below a character that is checked for the ground
+    when the character has not hit anything while moving.
+*/
+static const float CHARACTER_GROUND_PROBE_DISTANCE = 0.05f;
+
+/* The default maximum angle of a slope that a character can walk on. */
+static const float CHARACTER_DEFAULT_MAX_SLOPE_ANGLE = 0.25f * M_PI;
+
+/* Private Function Prototypes ============================================> */
+
+/* 
+    A callback function for `frComputeWorldShapeCast()`
+    that will be called during `frMoveCharacter()`.
+*/
+static bool frCharacterBodyFilter(const frBody *b, void *ctx);
+
+/* 
+    Updates the ground state of `c` with the given `normal` of a surface
+    that belongs to `b`, where `up` is the direction opposite to gravity.
+*/
+static void frUpdateCharacterGround(frCharacter *c,
+                                    frBody *b,
+                                    frVector2 normal,
+                                    frVector2 up);
+
+/* Public Functions =======================================================> */
+
+/* 
+    Creates a character controller for the kinematic body `b`, which must
+    be added to a world before `frMoveCharacter()` is called.
+*/
+frCharacter *frCreateCharacter(frBody *b) {
+    if (b == NULL || frGetBodyType(b) != FR_BODY_KINEMATIC) return NULL;
+
+    frCharacter *result = calloc(1, sizeof *result);
+
+    result->body = b;
+
+    result->mass = frGetShapeMass(frGetBodyShape(b));
+
+    if (result->mass <= 0.0f) result->mass = 1.0f;
+
+    result->maxSlopeCos = cosf(CHARACTER_DEFAULT_MAX_SLOPE_ANGLE);
+
+    result->state = FR_CHARACTER_AIRBORNE;
+
+    return result;
+}
+
+/* Releases the memory allocated for `c`, but not for its body. */
+void frReleaseCharacter(frCharacter *c) {
+    free(c);
+}
+
+/* Returns the body of `c`. */
+frBody *frGetCharacterBody(const frCharacter *c) {
+    return (c != NULL) ? c->body : NULL;
+}
+
+/* Returns the ground state of `c` after its last move. */
+frCharacterState frGetCharacterState(const frCharacter *c) {
+    return (c != NULL) ? c->state : FR_CHARACTER_AIRBORNE;
+}
+
+/* Returns the body that `c` stood on (or slid on) after its last move. */
+frBody *frGetCharacterGround(const frCharacter *c) {
+    return (c != NULL) ? c->ground : NULL;
+}
+
+/* Returns the normal of the ground below `c` after its last move. */
+frVector2 frGetCharacterGroundNormal(const frCharacter *c) {
+    return (c != NULL) ? c->groundNormal : frStructZero(frVector2);
+}
+
+/* Sets the `mass` that `c` uses to push dynamic bodies. */
+void frSetCharacterMass(frCharacter *c, float mass) {
+    if (c != NULL && mass > 0.0f) c->mass = mass;
+}
+
+/* 
+    Sets the maximum angle (in radians) of a slope that `c` can walk on,
+    measured from the direction opposite to gravity.
+*/
+void frSetCharacterMaxSlopeAngle(frCharacter *c, float angle) {
+    if (c != NULL) c->maxSlopeCos = cosf(angle);
+}
+
+/* 
+    Moves `c` by `displacement` over the time step `dt`, sliding along
+    the surfaces on the way and pushing the dynamic bodies in the way,
+    then returns the displacement actually made.
+*/
+frVector2 frMoveCharacter(frCharacter *c, frVector2 displacement, float dt) {
+    if (c == NULL || dt <= 0.0f) return frStructZero(frVector2);
+
+    frWorld *w = frGetBodyWorld(c->body);
+
+    if (w == NULL) return frStructZero(frVector2);
+
+    c->state = FR_CHARACTER_AIRBORNE;
+    c->ground = NULL, c->groundNormal = frStructZero(frVector2);
+
+    frVector2 up = frVector2Normalize(frVector2Negate(frGetWorldGravity(w)));
+
+    if (up.x == 0.0f && up.y == 0.0f) up.y = -1.0f;
+
+    const frShape *s = frGetBodyShape(c->body);
+
+    frTransform tx = frGetBodyTransform(c->body);
+
+    frVector2 startPosition = tx.position, remaining = displacement;
+
+    for (int i = 0; i < CHARACTER_MAX_ITERATION_COUNT; i++) {
+        float remainingLength = frVector2Magnitude(remaining);
+
+        if (remainingLength <= 0.0f) break;
+
+        frRaycastHit raycastHit = { .distance = 0.0f };
+
+        if (!frComputeWorldShapeCast(w,
+                                     s,
+                                     tx,
+                                     remaining,
+                                     frCharacterBodyFilter,
+                                     c,
+                                     &raycastHit)) {
+            tx.position = frVector2Add(tx.position, remaining);
+
+            break;
+        }
+
+        frVector2 direction = frVector2ScalarMultiply(remaining,
+                                                      1.0f / remainingLength);
+
+        float approachCos = -frVector2Dot(direction, raycastHit.normal);
+
+        /*
+            NOTE: `c` stops short of the surface, so that it stays
+            `CHARACTER_SKIN_WIDTH` away from the surface along its normal.
+        */
+        float distance = raycastHit.distance;
+
+        if (approachCos > 0.0f) distance -= CHARACTER_SKIN_WIDTH / approachCos;
+
+        if (distance < 0.0f) distance = 0.0f;
+
+        tx.position = frVector2Add(tx.position,
+                                   frVector2ScalarMultiply(direction,
+                                                           distance));
+
+        remaining = frVector2ScalarMultiply(direction,
+                                            remainingLength - distance);
+
+        frUpdateCharacterGround(c, raycastHit.body, raycastHit.normal, up);
+
+        float normalSpeed = frVector2Dot(remaining, raycastHit.normal);
+
+        if (frGetBodyType(raycastHit.body) == FR_BODY_DYNAMIC
+            && normalSpeed < 0.0f) {
+            frVector2 impulse = frVector2ScalarMultiply(raycastHit.normal,
+                                                        c->mass * normalSpeed
+                                                            / dt);
+
+            frApplyImpulseToBody(raycastHit.body, raycastHit.point, impulse);
+        }
+
+        /* NOTE: The part of `remaining` going into the surface is removed. */
+        if (normalSpeed < 0.0f)
+            remaining = frVector2Subtract(
+                remaining,
+                frVector2ScalarMultiply(raycastHit.normal, normalSpeed));
+
+        /*
+            NOTE: `frComputeShapeCast()` cannot see any other bodies
+            while `c` is overlapping one, so the rest of `remaining`,
+            which no longer goes into the surface, is applied at once.
+        */
+        if (raycastHit.inside) {
+            tx.position = frVector2Add(tx.position, remaining);
+
+            break;
+        }
+    }
+
+    if (c->state != FR_CHARACTER_GROUNDED
+        && frVector2Dot(displacement, up) <= 0.0f) {
+        frRaycastHit raycastHit = { .distance = 0.0f };
+
+        if (frComputeWorldShapeCast(
+                w,
+                s,
+                tx,
+                frVector2ScalarMultiply(up, -CHARACTER_GROUND_PROBE_DISTANCE),
+                frCharacterBodyFilter,
+                c,
+                &raycastHit))
+            frUpdateCharacterGround(c, raycastHit.body, raycastHit.normal, up);
+    }
+
+    frSetBodyPosition(c->body, tx.position);
+
+    return frVector2Subtract(tx.position, startPosition);
+}
+
+/* Private Functions ======================================================> */
+
+/* 
+    A callback function for `frComputeWorldShapeCast()`
+    that will be called during `frMoveCharacter()`.
+*/
+static bool frCharacterBodyFilter(const frBody *b, void *ctx) {
+    return b != ((const frCharacter *) ctx)->body;
+}
+
+/* 
+    Updates the ground state of `c` with the given `normal` of a surface
+    that belongs to `b`, where `up` is the direction opposite to gravity.
+*/
+static void frUpdateCharacterGround(frCharacter *c,
+                                    frBody *b,
+                                    frVector2 normal,
+                                    frVector2 up) {
+    float slopeCos = frVector2Dot(normal, up);
+
+    if (slopeCos >= c->maxSlopeCos) {
+        c->state = FR_CHARACTER_GROUNDED;
+    } else if (slopeCos > 0.0f && c->state != FR_CHARACTER_GROUNDED) {
+        c->state = FR_CHARACTER_SLIDING;
+    } else {
+        return;
+    }
+
+    c->ground = b, c->groundNormal = normal;
+}
@@ -33,14 +33,525 @@ typedef struct frEdge_ {
     int count;
 } frEdge;
 
+/* 
+    A structure that represents a vertex of a simplex 
+    in the Minkowski difference of two convex shapes.
+*/
+typedef struct frSimplexVertex_ {
+    frVector2 point1, point2, point;
+    int index1, index2;
+    float weight;
+} frSimplexVertex;
+
+/* 
+    A structure that represents a simplex (a point, a line segment or 
+    a triangle) for the GJK (Gilbert-Johnson-Keerthi) algorithm.
+*/
+typedef struct frSimplex_ {
+    frSimplexVertex vertices[3];
+    int count;
+} frSimplex;
+
+/* 
+    A structure that represents a convex collision shape 
+    (or a line segment of a 'chain' collision shape) for the GJK algorithm.
+*/
+typedef struct frShapeProxy_ {
+    const frShape *shape;
+    frTransform tx;
+    frVector2 position, vertices[2];
+    float radius;
+} frShapeProxy;
+
+/* 
+    A structure that represents a contact point between a line segment 
+    of a 'chain' collision shape (or a rectangle of solid tiles of 
+    a 'tilemap' collision shape) and another collision shape, along with 
+    the direction from the line segment to the other collision shape.
+*/
+typedef struct frChainContact_ {
+    frVector2 direction;
+    frContact contact;
+} frChainContact;
+
+/*
+    A structure that represents the context data 
+    for `frChainHashQueryCallback()`.
+*/
+typedef struct frChainHashQueryCtx_ {
+    const frShape *chain;
+    frTransform chainTx;
+    const frShape *shape;
+    frTransform tx;
+    frChainContact contacts[FR_GEOMETRY_MAX_CHAIN_CONTACT_COUNT];
+    int count;
+} frChainHashQueryCtx;
+
+/*
+    A structure that represents the context data 
+    for `frChainRaycastHashQueryCallback()`.
+*/
+typedef struct frChainRaycastHashQueryCtx_ {
+    const frShape *chain;
+    frRay ray;
+    int index;
+} frChainRaycastHashQueryCtx;
+
+/*
+    A structure that represents the context data 
+    for `frChainDistanceHashQueryCallback()`.
+*/
+typedef struct frChainDistanceHashQueryCtx_ {
+    const frShape *chain;
+    frTransform chainTx;
+    const frShapeProxy *proxy;
+    frVector2 point1, point2;
+    float distance;
+    int count;
+} frChainDistanceHashQueryCtx;
+
+/*
+    A structure that represents the context data 
+    for `frChainCastHashQueryCallback()`.
+*/
+typedef struct frChainCastHashQueryCtx_ {
+    const frShape *chain;
+    frTransform chainTx;
+    const frShapeProxy *proxy;
+    frVector2 translation;
+    frRaycastHit raycastHit;
+    bool hit;
+} frChainCastHashQueryCtx;
+
+/*
+    A structure that represents the context data 
+    for `frTilemapHashQueryCallback()`.
+*/
+typedef struct frTilemapHashQueryCtx_ {
+    const frShape *tilemap;
+    frTransform tilemapTx;
+    const frShape *shape;
+    frTransform tx;
+    frChainContact contacts[FR_GEOMETRY_MAX_CHAIN_CONTACT_COUNT];
+    int count;
+} frTilemapHashQueryCtx;
+
+/*
+    A structure that represents the context data 
+    for `frTilemapDistanceHashQueryCallback()`.
+*/
+typedef struct frTilemapDistanceHashQueryCtx_ {
+    const frShape *tilemap;
+    frTransform tilemapTx;
+    const frShape *shape;
+    frTransform tx;
+    frVector2 point1, point2;
+    float distance;
+} frTilemapDistanceHashQueryCtx;
+
+/*
+    A structure that represents the context data 
+    for `frTilemapCastHashQueryCallback()`.
+*/
+typedef struct frTilemapCastHashQueryCtx_ {
+    const frShape *tilemap;
+    frTransform tilemapTx;
+    const frShape *shape;
+    frTransform tx;
+    frVector2 translation;
+    frRaycastHit raycastHit;
+    bool hit;
+} frTilemapCastHashQueryCtx;
+
+/*
+    A structure that represents the context data 
+    for `frCompoundHashQueryCallback()`.
+*/
+typedef struct frCompoundHashQueryCtx_ {
+    const frShape *compound;
+    frTransform compoundTx;
+    const frShape *shape;
+    frTransform tx;
+    bool compoundFirst;
+    frChainContact contacts[FR_GEOMETRY_MAX_CHAIN_CONTACT_COUNT];
+    int count;
+} frCompoundHashQueryCtx;
+
+/*
+    A structure that represents the context data 
+    for `frCompoundCastHashQueryCallback()`.
+*/
+typedef struct frCompoundCastHashQueryCtx_ {
+    const frShape *compound;
+    frTransform compoundTx;
+    const frShape *shape;
+    frTransform tx;
+    frVector2 translation;
+    bool compoundFirst;
+    frRaycastHit raycastHit;
+    bool hit;
+} frCompoundCastHashQueryCtx;
+
+/* Constants ==============================================================> */
+
+/* 
+    The maximum number of vertices for which `frGetPolygonSupportIndex()` 
+    simply checks every vertex of a convex polygon.
+*/
+static const int SUPPORT_LINEAR_SEARCH_LIMIT = 4;
+
+/* The maximum number of iterations for the GJK algorithm. */
+static const int GJK_MAX_ITERATION_COUNT = 20;
+
+/* 
+    The distance that `frComputeShapeCast()` keeps between 
+    two collision shapes at the time of impact.
+*/
+static const float SHAPE_CAST_TARGET_DISTANCE = 0.005f;
+
+/* 
+    The maximum sine of the angle between two line segments 
+    at which the line segments are considered to be parallel.
+*/
+static const float CAPSULE_PARALLEL_TOLERANCE = 0.05f;
+
+/* 
+    The distance between two line segments at (or below) which 
+    the line segments are considered to be crossing each other.
+*/
+static const float CAPSULE_CROSSING_TOLERANCE = 1e-4f;
+
+/* 
+    The amount by which the separation along the normal of a 'capsule' 
+    collision shape must exceed the separation along each normal of 
+    a 'polygon' collision shape, for the line segment of the former 
+    to be chosen as the reference edge.
+*/
+static const float CAPSULE_REFERENCE_EDGE_BIAS = 0.005f;
+
+/* 
+    The maximum value of one minus the cosine of the angle between 
+    the direction of a contact and the normal of a line segment of 
+    a 'chain' collision shape, at which the contact is on the line segment
+    itself rather than on one of its endpoints.
+*/
+static const float CHAIN_FACE_NORMAL_TOLERANCE = 0.0025f;
+
+/* 
+    The minimum sine of the angle at which two line segments of 
+    a 'chain' collision shape must turn away from their front sides 
+    for the vertex shared between them to be exposed.
+*/
+static const float CHAIN_CONVEX_VERTEX_TOLERANCE = 0.01f;
+
+/* 
+    The minimum cosine of the angle between the direction of the deepest 
+    contact with a 'chain' collision shape and the direction of another 
+    contact, at which both contacts are merged into one contact manifold.
+*/
+static const float CHAIN_MANIFOLD_NORMAL_TOLERANCE = 0.9f;
+
+/* 
+    The minimum distance between the two contact points of a contact 
+    manifold with a 'chain' collision shape.
+*/
+static const float CHAIN_MANIFOLD_MIN_DISTANCE = 0.005f;
+
+/* 
+    The amount by which the separation along the normal of a line segment 
+    of a 'chain' collision shape must exceed the separation along each 
+    normal of a 'polygon' collision shape, for the line segment to be 
+    chosen as the reference edge.
+*/
+static const float CHAIN_REFERENCE_EDGE_BIAS = 0.005f;
+
 /* Private Function Prototypes ============================================> */
 
+/* 
+    A callback function for `frQueryChainSegments()` 
+    that will be called during `frComputeCollisionChain()`.
+*/
+static bool frChainHashQueryCallback(frContextNode ctxNode);
+
+/* 
+    A callback function for `frQueryChainSegments()` 
+    that will be called during `frComputeShapeRaycast()`.
+*/
+static bool frChainRaycastHashQueryCallback(frContextNode ctxNode);
+
+/* 
+    A callback function for `frQueryChainSegments()` 
+    that will be called during `frComputeChainDistance()`.
+*/
+static bool frChainDistanceHashQueryCallback(frContextNode ctxNode);
+
+/* 
+    A callback function for `frQueryChainSegments()` 
+    that will be called during `frComputeChainCast()`.
+*/
+static bool frChainCastHashQueryCallback(frContextNode ctxNode);
+
+/* 
+    A callback function for `frQueryTilemapRects()` 
+    that will be called during `frComputeCollisionTilemap()`.
+*/
+static bool frTilemapHashQueryCallback(frContextNode ctxNode);
+
+/* 
+    A callback function for `frQueryTilemapRects()` 
+    that will be called during `frComputeTilemapDistance()`.
+*/
+static bool frTilemapDistanceHashQueryCallback(frContextNode ctxNode);
+
+/* 
+    A callback function for `frQueryTilemapRects()` 
+    that will be called during `frComputeTilemapCast()`.
+*/
+static bool frTilemapCastHashQueryCallback(frContextNode ctxNode);
+
+/* 
+    A callback function for `frQueryCompoundChildren()` 
+    that will be called during `frComputeCollisionCompound()`.
+*/
+static bool frCompoundHashQueryCallback(frContextNode ctxNode);
+
+/* 
+    A callback function for `frQueryCompoundChildren()` 
+    that will be called during `frComputeCompoundCast()`.
+*/
+static bool frCompoundCastHashQueryCallback(frContextNode ctxNode);
+
+/* 
+    Adds `contact` to the first `count` elements of `contacts`, replacing 
+    the shallowest contact if there is no more room for `contact`.
+*/
+static void frAddChainContact(frChainContact *contacts,
+                              int *count,
+                              frChainContact contact);
+
+/* 
+    Returns `true` if `direction` lies within the range of directions 
+    from `startLimit` through `normal` to `endLimit`, where `normal` is 
+    the normal of a line segment of a 'chain' collision shape.
+*/
+static bool frCheckChainDirection(frVector2 direction,
+                                  frVector2 normal,
+                                  frVector2 startLimit,
+                                  frVector2 endLimit);
+
+/* 
+    Sweeps `s` with the transform `tx` along `translation` against 
+    the front sides of the line segments of `chain` with the transform 
+    `chainTx`, then stores the information about the first time of impact 
+    to `raycastHit`, assuming `s` and `chain` are not overlapping.
+*/
+static bool frComputeChainCast(const frShape *s,
+                               frTransform tx,
+                               frVector2 translation,
+                               const frShape *chain,
+                               frTransform chainTx,
+                               frRaycastHit *raycastHit);
+
+/* 
+    Computes the distance between `chain` with the transform `chainTx` 
+    and `s` with the transform `tx`, then stores the closest points 
+    on `chain` and `s` to `p1` and `p2`.
+*/
+static float frComputeChainDistance(const frShape *chain,
+                                    frTransform chainTx,
+                                    const frShape *s,
+                                    frTransform tx,
+                                    frVector2 *p1,
+                                    frVector2 *p2);
+
+/* 
+    Checks whether `s1` and `s2` are colliding, assuming either `s1` or 
+    `s2` is a 'chain' or 'heightfield' collision shape, then stores 
+    the collision information to `collision`.
+*/
+static bool frComputeCollisionChain(const frShape *s1,
+                                    frTransform tx1,
+                                    const frShape *s2,
+                                    frTransform tx2,
+                                    frCollision *collision);
+
+/* 
+    Checks whether `poly` with the transform `polyTx` is colliding with 
+    the front side of the line segment from `v1` to `v2` with the given 
+    `normal`, assuming `poly` is a 'polygon' collision shape and 
+    the direction of the collision must lie within the range from 
+    `startLimit` through `normal` to `endLimit`, then stores the collision 
+    information to `collision`, with the direction from the line segment 
+    to `poly`.
+*/
+static bool frComputeCollisionChainPoly(frVector2 v1,
+                                        frVector2 v2,
+                                        frVector2 normal,
+                                        frVector2 startLimit,
+                                        frVector2 endLimit,
+                                        const frShape *poly,
+                                        frTransform polyTx,
+                                        frCollision *collision);
+
+/* 
+    Checks whether `s1` and `s2` are colliding, assuming either `s1` or 
+    `s2` is a 'tilemap' collision shape, then stores the collision 
+    information to `collision`.
+*/
+static bool frComputeCollisionTilemap(const frShape *s1,
+                                      frTransform tx1,
+                                      const frShape *s2,
+                                      frTransform tx2,
+                                      frCollision *collision);
+
+/* 
+    Casts a `ray` against the solid tiles of `tilemap` with the transform 
+    `tx`, by stepping through the tiles along `ray` one at a time.
+*/
+static bool frComputeTilemapRaycast(const frShape *tilemap,
+                                    frTransform tx,
+                                    frRay ray,
+                                    frRaycastHit *raycastHit);
+
+/* 
+    Sweeps `s` with the transform `tx` along `translation` against 
+    `tilemap` with the transform `tilemapTx`, then stores the information 
+    about the first time of impact to `raycastHit`, assuming `s` and 
+    `tilemap` are not overlapping.
+*/
+static bool frComputeTilemapCast(const frShape *s,
+                                 frTransform tx,
+                                 frVector2 translation,
+                                 const frShape *tilemap,
+                                 frTransform tilemapTx,
+                                 frRaycastHit *raycastHit);
+
+/* 
+    Computes the distance between `tilemap` with the transform `tilemapTx` 
+    and `s` with the transform `tx`, then stores the closest points 
+    on `tilemap` and `s` to `p1` and `p2`.
+*/
+static float frComputeTilemapDistance(const frShape *tilemap,
+                                      frTransform tilemapTx,
+                                      const frShape *s,
+                                      frTransform tx,
+                                      frVector2 *p1,
+                                      frVector2 *p2);
+
 /* 
     Clips `e` so that the dot product of each vertex in `e` 
     and `v` is greater than or equal to `dot`.
 */
 static bool frClipEdge(frEdge *e, frVector2 v, float dot);
 
+/* 
+    Checks whether `s1` and `s2` are colliding, assuming either `s1` or 
+    `s2` is a 'compound' collision shape, then stores the collision 
+    information to `collision`.
+*/
+static bool frComputeCollisionCompound(const frShape *s1,
+                                       frTransform tx1,
+                                       const frShape *s2,
+                                       frTransform tx2,
+                                       frCollision *collision);
+
+/* 
+    Casts a `ray` against the child shapes of `compound` with 
+    the transform `tx`, then stores the information about the closest hit 
+    to `raycastHit`.
+*/
+static bool frComputeCompoundRaycast(const frShape *compound,
+                                     frTransform tx,
+                                     frRay ray,
+                                     frRaycastHit *raycastHit);
+
+/* 
+    Sweeps `s1` with the transform `tx1` along `translation` against `s2`
+    with the transform `tx2`, assuming either `s1` or `s2` is a 'compound' 
+    collision shape and `s1` and `s2` are not overlapping, then stores 
+    the information about the first time of impact to `raycastHit`.
+*/
+static bool frComputeCompoundCast(const frShape *s1,
+                                  frTransform tx1,
+                                  frVector2 translation,
+                                  const frShape *s2,
+                                  frTransform tx2,
+                                  frRaycastHit *raycastHit);
+
+/* 
+    Computes the distance between `compound` with the transform 
+    `compoundTx` and `s` with the transform `tx`, then stores the closest 
+    points on `compound` and `s` to `p1` and `p2`.
+*/
+static float frComputeCompoundDistance(const frShape *compound,
+                                       frTransform compoundTx,
+                                       const frShape *s,
+                                       frTransform tx,
+                                       frVector2 *p1,
+                                       frVector2 *p2);
+
+/* 
+    Checks whether `s1` and `s2` are colliding, assuming `s1` and `s2` 
+    are 'capsule' (or 'circle') collision shapes and at least one of them 
+    is a 'capsule' collision shape, then stores the collision information 
+    to `collision`.
+*/
+static bool frComputeCollisionCapsules(const frShape *s1,
+                                       frTransform tx1,
+                                       const frShape *s2,
+                                       frTransform tx2,
+                                       frCollision *collision);
+
+/* 
+    Checks whether `s1` and `s2` are colliding,
+    assuming `s1` is a 'capsule' collision shape and `s2` is a 'polygon' 
+    collision shape, then stores the collision information to `collision`.
+*/
+static bool frComputeCollisionCapsulePoly(const frShape *s1,
+                                          frTransform tx1,
+                                          const frShape *s2,
+                                          frTransform tx2,
+                                          frCollision *collision);
+
+/* 
+    Checks whether the line segment from `p1` to `q1` with `radius1` and 
+    the line segment from `p2` to `q2` with `radius2` are colliding, 
+    then stores the collision information to `collision`.
+*/
+static bool frComputeCollisionSegments(frVector2 p1,
+                                       frVector2 q1,
+                                       float radius1,
+                                       frVector2 p2,
+                                       frVector2 q2,
+                                       float radius2,
+                                       frCollision *collision);
+
+/* 
+    Checks whether the line segment from `v1` to `v2` with `radius` and 
+    `poly` with the transform `polyTx` are colliding, assuming `poly` is 
+    a 'polygon' collision shape, then stores the collision information 
+    to `collision`, with the direction from the line segment to `poly`.
+*/
+static bool frComputeCollisionSegmentPoly(frVector2 v1,
+                                          frVector2 v2,
+                                          float radius,
+                                          const frShape *poly,
+                                          frTransform polyTx,
+                                          frCollision *collision);
+
+/* 
+    Checks whether `s` with the transform `tx` is colliding with the front 
+    side of the line segment from `v1` to `v2` with the given `normal`, 
+    ignoring its endpoints, then stores the collision information 
+    to `collision`, with the direction from the line segment to `s`.
+*/
+static bool frComputeCollisionSegmentFace(frVector2 v1,
+                                          frVector2 v2,
+                                          frVector2 normal,
+                                          const frShape *s,
+                                          frTransform tx,
+                                          frCollision *collision);
+
 /* 
     Checks whether `s1` and `s2` are colliding,
     assuming `s1` and `s2` are 'circle' collision shapes,
@@ -81,16 +592,72 @@ static bool frComputeIntersectionCircleLine(frVector2 center,
                                             frVector2 direction,
                                             float *distance);
 
-/* Computes the intersection of two lines. */
-static bool frComputeIntersectionLines(frVector2 origin1,
-                                       frVector2 direction1,
-                                       frVector2 origin2,
-                                       frVector2 direction2,
-                                       float *distance);
+/* 
+    Finds the closest points between the line segment from `p1` to `q1` 
+    and the line segment from `p2` to `q2`, then stores their positions 
+    along each line segment (from `0` to `1`) to `f1` and `f2`.
+*/
+static void frComputeSegmentClosestPoints(frVector2 p1,
+                                          frVector2 q1,
+                                          frVector2 p2,
+                                          frVector2 q2,
+                                          float *f1,
+                                          float *f2);
+
+/* 
+    Sweeps `proxy1` along `translation` against `proxy2`, then stores 
+    the information about the first time of impact to `raycastHit`, 
+    assuming `proxy1` and `proxy2` are not overlapping.
+*/
+static bool frComputeProxyCast(const frShapeProxy *proxy1,
+                               frVector2 translation,
+                               const frShapeProxy *proxy2,
+                               frRaycastHit *raycastHit);
+
+/* 
+    Computes the distance between `proxy1` and `proxy2`, then stores 
+    the closest points on `proxy1` and `proxy2` to `p1` and `p2`.
+*/
+static float frComputeProxyDistance(const frShapeProxy *proxy1,
+                                    const frShapeProxy *proxy2,
+                                    frVector2 *p1,
+                                    frVector2 *p2);
+
+/* 
+    Updates `simplex` to the smallest sub-simplex that contains 
+    the point closest to the origin, along with its barycentric weights.
+*/
+static void frSolveSimplex(frSimplex *simplex);
 
 /* Returns the edge of `s` that is most perpendicular to `v`. */
 static frEdge frGetContactEdge(const frShape *s, frTransform tx, frVector2 v);
 
+/* Returns the AABB of `aabb` in the local space of the transform `tx`. */
+static frAABB frGetLocalAABB(frAABB aabb, frTransform tx);
+
+/* 
+    Returns the point of `proxy` farthest along `v`, ignoring its radius, 
+    then stores its index to `index`.
+*/
+static frVector2 frGetProxySupportPoint(const frShapeProxy *proxy,
+                                        frVector2 v,
+                                        int *index);
+
+/* Returns the proxy of the line segment from `v1` to `v2`. */
+static frShapeProxy frGetSegmentProxy(frVector2 v1, frVector2 v2);
+
+/* Returns the proxy of `s` with the transform `tx`. */
+static frShapeProxy frGetShapeProxy(const frShape *s, frTransform tx);
+
+/* 
+    Returns the point of `s` farthest along `v`, ignoring the radius of
+    a 'circle' or 'capsule' collision shape, then stores its index to `index`.
+*/
+static frVector2 frGetShapeSupportPoint(const frShape *s,
+                                        frTransform tx,
+                                        frVector2 v,
+                                        int *index);
+
 /* 
     Finds the axis of minimum penetration from `s1` to `s2`,
     then returns its index.
@@ -101,9 +668,52 @@ static int frGetSeparatingAxisIndex(const frShape *s1,
                                     frTransform tx2,
                                     float *depth);
 
-/* Returns the index of the vertex farthest along `v`. */
-static int
-frGetSupportPointIndex(const frVertices *vertices, frTransform tx, frVector2 v);
+/* 
+    Returns the radius of `s` around its core, which is a point for 
+    a 'circle' collision shape, a line segment for a 'capsule' collision 
+    shape and the shape itself for a 'polygon' collision shape.
+*/
+static float frGetShapeCoreRadius(const frShape *s);
+
+/* 
+    Computes the endpoints of the line segment of `s` with the transform
+    `tx`, treating a 'circle' collision shape as a zero-length line segment.
+*/
+static void frGetShapeSegment(const frShape *s,
+                              frTransform tx,
+                              frVector2 *v1,
+                              frVector2 *v2);
+
+/* 
+    Returns the index of the vertex farthest along `v` by climbing 
+    the 'hill' formed by the `vertices` of a convex polygon, 
+    or `-1` if the search has failed.
+*/
+static int frGetSupportPointIndexHill(const frVector2 *vertices,
+                                      int vertexCount,
+                                      frVector2 v);
+
+/* 
+    Returns the transform of the rectangle of solid tiles with the given 
+    `i`ndex, assuming `tilemap` is a 'tilemap' collision shape with 
+    the transform `tx`.
+*/
+static frTransform frGetTilemapRectTransform(const frShape *tilemap,
+                                             frTransform tx,
+                                             int i);
+
+/* Returns `true` if `s` is a 'chain' or 'heightfield' collision shape. */
+static bool frIsChainShape(const frShape *s);
+
+/* 
+    Reduces the first `count` elements of `contacts` to the contact points 
+    of a single collision, then stores the collision information to 
+    `collision`, with the opposite direction if `flip` is `true`.
+*/
+static void frReduceChainContacts(const frChainContact *contacts,
+                                  int count,
+                                  bool flip,
+                                  frCollision *collision);
 
 /* Public Functions =======================================================> */
 
@@ -114,22 +724,46 @@ frGetSupportPointIndex(const frVertices *vertices, frTransform tx, frVector2 v);
 bool frComputeCollision(frBody *b1, frBody *b2, frCollision *collision) {
     if (b1 == NULL || b2 == NULL) return false;
 
-    const frShape *s1 = frGetBodyShape(b1);
-    frTransform tx1 = frGetBodyTransform(b1);
+    return frComputeShapeCollision(frGetBodyShape(b1),
+                                   frGetBodyTransform(b1),
+                                   frGetBodyShape(b2),
+                                   frGetBodyTransform(b2),
+                                   collision);
+}
 
-    const frShape *s2 = frGetBodyShape(b2);
-    frTransform tx2 = frGetBodyTransform(b2);
+/* 
+    Checks whether `s1` with the transform `tx1` and `s2` with the transform 
+    `tx2` are colliding, then stores the collision information to `collision`.
+*/
+bool frComputeShapeCollision(const frShape *s1,
+                             frTransform tx1,
+                             const frShape *s2,
+                             frTransform tx2,
+                             frCollision *collision) {
+    if (s1 == NULL || s2 == NULL) return false;
 
     frShapeType type1 = frGetShapeType(s1);
     frShapeType type2 = frGetShapeType(s2);
 
-    if (type1 == FR_SHAPE_CIRCLE && type2 == FR_SHAPE_CIRCLE)
+    if (type1 == FR_SHAPE_COMPOUND || type2 == FR_SHAPE_COMPOUND)
+        return frComputeCollisionCompound(s1, tx1, s2, tx2, collision);
+    else if (type1 == FR_SHAPE_TILEMAP || type2 == FR_SHAPE_TILEMAP)
+        return frComputeCollisionTilemap(s1, tx1, s2, tx2, collision);
+    else if (frIsChainShape(s1) || frIsChainShape(s2))
+        return frComputeCollisionChain(s1, tx1, s2, tx2, collision);
+    else if (type1 == FR_SHAPE_CIRCLE && type2 == FR_SHAPE_CIRCLE)
         return frComputeCollisionCircles(s1, tx1, s2, tx2, collision);
     else if ((type1 == FR_SHAPE_CIRCLE && type2 == FR_SHAPE_POLYGON)
              || (type1 == FR_SHAPE_POLYGON && type2 == FR_SHAPE_CIRCLE))
         return frComputeCollisionCirclePoly(s1, tx1, s2, tx2, collision);
     else if (type1 == FR_SHAPE_POLYGON && type2 == FR_SHAPE_POLYGON)
         return frComputeCollisionPolys(s1, tx1, s2, tx2, collision);
+    else if ((type1 == FR_SHAPE_CAPSULE && type2 == FR_SHAPE_POLYGON)
+             || (type1 == FR_SHAPE_POLYGON && type2 == FR_SHAPE_CAPSULE))
+        return frComputeCollisionCapsulePoly(s1, tx1, s2, tx2, collision);
+    else if ((type1 == FR_SHAPE_CAPSULE || type1 == FR_SHAPE_CIRCLE)
+             && (type2 == FR_SHAPE_CAPSULE || type2 == FR_SHAPE_CIRCLE))
+        return frComputeCollisionCapsules(s1, tx1, s2, tx2, collision);
     else
         return false;
 }
@@ -140,120 +774,2276 @@ bool frComputeRaycast(const frBody *b, frRay ray, frRaycastHit *raycastHit) {
 
     ray.direction = frVector2Normalize(ray.direction);
 
-    const frShape *s = frGetBodyShape(b);
-    frTransform tx = frGetBodyTransform(b);
+    bool result = frComputeShapeRaycast(frGetBodyShape(b),
+                                        frGetBodyTransform(b),
+                                        ray,
+                                        raycastHit);
 
-    frShapeType type = frGetShapeType(s);
+    if (raycastHit != NULL) raycastHit->body = (frBody *) b;
+
+    return result;
+}
+
+/* 
+    Casts a `ray` against `s` with the transform `tx`, 
+    assuming that the direction of `ray` is already normalized.
+*/
+bool frComputeShapeRaycast(const frShape *s,
+                           frTransform tx,
+                           frRay ray,
+                           frRaycastHit *raycastHit) {
+    if (s == NULL) return false;
 
-    float distance = FLT_MAX;
+    frShapeType type = frGetShapeType(s);
 
     if (type == FR_SHAPE_CIRCLE) {
+        float radius = frGetCircleRadius(s), distance = FLT_MAX;
+
         bool intersects = frComputeIntersectionCircleLine(tx.position,
-                                                          frGetCircleRadius(s),
+                                                          radius,
                                                           ray.origin,
                                                           ray.direction,
                                                           &distance);
 
-        bool result = (distance >= 0.0f) && (distance <= ray.maxDistance);
+        bool inside = frVector2MagnitudeSqr(
+                          frVector2Subtract(ray.origin, tx.position))
+                      < (radius * radius);
+
+        bool result = !inside && intersects && (distance <= ray.maxDistance);
 
         if (raycastHit != NULL) {
-            raycastHit->body = (frBody *) b;
+            raycastHit->inside = inside;
+
+            if (!result) return false;
 
             raycastHit->point = frVector2Add(
                 ray.origin, frVector2ScalarMultiply(ray.direction, distance));
 
-            raycastHit->normal = frVector2LeftNormal(
-                frVector2Subtract(ray.origin, raycastHit->point));
+            raycastHit->normal = frVector2Normalize(
+                frVector2Subtract(raycastHit->point, tx.position));
 
             raycastHit->distance = distance;
-            raycastHit->inside = (distance < 0.0f);
         }
 
         return result;
     } else if (type == FR_SHAPE_POLYGON) {
-        const frVertices *vertices = frGetPolygonVertices(s);
+        const frVector2 *vertices = frGetPolygonVertices(s);
+        const frVector2 *normals = frGetPolygonNormals(s);
+
+        int vertexCount = frGetPolygonVertexCount(s), edgeIndex = -1;
+
+        /*
+            NOTE: The ray is clipped against the half-plane of each edge 
+            in the local space of `s`, where `minDistance` and `maxDistance`
+            are the distances at which the ray enters and leaves `s`.
+        */
+
+        frVector2 origin = frVector2Subtract(ray.origin, tx.position);
+
+        origin = (frVector2) {
+            .x = origin.x * tx.rotation.cos_ + origin.y * tx.rotation.sin_,
+            .y = origin.y * tx.rotation.cos_ - origin.x * tx.rotation.sin_
+        };
 
-        int intersectionCount = 0;
+        frVector2 direction = {
+            .x = ray.direction.x * tx.rotation.cos_
+                 + ray.direction.y * tx.rotation.sin_,
+            .y = ray.direction.y * tx.rotation.cos_
+                 - ray.direction.x * tx.rotation.sin_
+        };
+
+        float minDistance = 0.0f, maxDistance = ray.maxDistance;
+
+        bool inside = true, result = true;
+
+        for (int i = 0; i < vertexCount; i++) {
+            float numerator = frVector2Dot(
+                normals[i], frVector2Subtract(vertices[i], origin));
+
+            float denominator = frVector2Dot(normals[i], direction);
+
+            if (numerator < 0.0f) inside = false;
+
+            if (denominator == 0.0f) {
+                if (numerator < 0.0f) result = false;
+
+                continue;
+            }
+
+            float distance = numerator / denominator;
+
+            if (denominator < 0.0f) {
+                if (minDistance < distance)
+                    minDistance = distance, edgeIndex = i;
+            } else {
+                if (maxDistance > distance) maxDistance = distance;
+            }
+
+            if (minDistance > maxDistance) result = false;
+        }
+
+        result = result && !inside && (edgeIndex >= 0);
+
+        if (raycastHit != NULL) {
+            raycastHit->inside = inside;
+
+            if (!result) return false;
+
+            raycastHit->point = frVector2Add(
+                ray.origin,
+                frVector2ScalarMultiply(ray.direction, minDistance));
+
+            raycastHit->normal = frVector2RotateTx(normals[edgeIndex], tx);
+
+            raycastHit->distance = minDistance;
+        }
+
+        return result;
+    } else if (type == FR_SHAPE_CAPSULE) {
+        float halfLength = 0.5f * frGetCapsuleLength(s);
+        float radius = frGetCapsuleRadius(s);
+
+        // NOTE: The line segment of `s` lies along the y-axis in local space.
+        frVector2 origin = frVector2Rotate(frVector2Subtract(ray.origin,
+                                                             tx.position),
+                                           -tx.angle);
+
+        frVector2 direction = frVector2Rotate(ray.direction, -tx.angle);
+
+        float deltaY = origin.y - fminf(fmaxf(origin.y, -halfLength),
+                                        halfLength);
+
+        bool inside = (origin.x * origin.x) + (deltaY * deltaY)
+                      < (radius * radius);
 
         float minDistance = FLT_MAX;
 
-        for (int j = vertices->count - 1, i = 0; i < vertices->count;
-             j = i, i++) {
-            frVector2 v1 = frVector2Transform(vertices->data[i], tx);
-            frVector2 v2 = frVector2Transform(vertices->data[j], tx);
+        frVector2 normal = frStructZero(frVector2);
 
-            frVector2 edgeVector = frVector2Subtract(v1, v2);
+        bool sideHit = false;
 
-            bool intersects = frComputeIntersectionLines(ray.origin,
-                                                         ray.direction,
-                                                         v2,
-                                                         edgeVector,
-                                                         &distance);
+        /*
+            NOTE: The ray enters `s` either through one of the two sides 
+            parallel to its line segment, or through one of its two
+            half-circles, which are tested as full circles.
+        */
+        if (fabsf(origin.x) >= radius && origin.x * direction.x < 0.0f) {
+            float side = (origin.x > 0.0f) ? radius : -radius;
 
-            if (intersects && distance <= ray.maxDistance) {
-                if (minDistance > distance) {
-                    minDistance = distance;
+            float distance = (side - origin.x) / direction.x;
 
-                    if (raycastHit != NULL) {
-                        raycastHit->point =
-                            frVector2Add(ray.origin,
-                                         frVector2ScalarMultiply(ray.direction,
-                                                                 minDistance));
+            float y = origin.y + direction.y * distance;
 
-                        raycastHit->normal = frVector2LeftNormal(edgeVector);
-                    }
-                }
+            if (y >= -halfLength && y <= halfLength) {
+                minDistance = distance, sideHit = true;
 
-                intersectionCount++;
+                normal = (frVector2) { .x = (side > 0.0f) ? 1.0f : -1.0f };
             }
         }
 
-        if (raycastHit != NULL) {
-            raycastHit->body = (frBody *) b;
-            raycastHit->inside = (intersectionCount & 1);
-        }
+        for (int i = 0; i < 2 && !sideHit; i++) {
+            frVector2 center = { .y = (i == 0) ? -halfLength : halfLength };
+
+            float distance = FLT_MAX;
+
+            if (!frComputeIntersectionCircleLine(center,
+                                                 radius,
+                                                 origin,
+                                                 direction,
+                                                 &distance))
+                continue;
+
+            if (minDistance > distance)
+                minDistance = distance,
+                normal = frVector2Normalize(frVector2Subtract(
+                    frVector2Add(origin,
+                                 frVector2ScalarMultiply(direction, distance)),
+                    center));
+        }
+
+        bool result = !inside && (minDistance < FLT_MAX)
+                      && (minDistance <= ray.maxDistance);
+
+        if (raycastHit != NULL) {
+            raycastHit->inside = inside;
+
+            if (!result) return false;
+
+            raycastHit->point = frVector2Add(
+                ray.origin,
+                frVector2ScalarMultiply(ray.direction, minDistance));
+
+            raycastHit->normal = frVector2RotateTx(normal, tx);
+
+            raycastHit->distance = minDistance;
+        }
+
+        return result;
+    } else if (frIsChainShape(s)) {
+        frVector2 origin = frVector2Subtract(ray.origin, tx.position);
+
+        origin = (frVector2) {
+            .x = origin.x * tx.rotation.cos_ + origin.y * tx.rotation.sin_,
+            .y = origin.y * tx.rotation.cos_ - origin.x * tx.rotation.sin_
+        };
+
+        frVector2 direction = {
+            .x = ray.direction.x * tx.rotation.cos_
+                 + ray.direction.y * tx.rotation.sin_,
+            .y = ray.direction.y * tx.rotation.cos_
+                 - ray.direction.x * tx.rotation.sin_
+        };
+
+        frChainRaycastHashQueryCtx queryCtx = {
+            .chain = s,
+            .ray = { .origin = origin,
+                     .direction = direction,
+                     .maxDistance = ray.maxDistance },
+            .index = -1
+        };
+
+        frVector2 endpoint = frVector2Add(
+            origin, frVector2ScalarMultiply(direction, ray.maxDistance));
+
+        frQueryChainSegments(s,
+                             (frAABB) { .x = fminf(origin.x, endpoint.x),
+                                        .y = fminf(origin.y, endpoint.y),
+                                        .width = fabsf(endpoint.x - origin.x),
+                                        .height = fabsf(endpoint.y
+                                                        - origin.y) },
+                             frChainRaycastHashQueryCallback,
+                             &queryCtx);
+
+        bool result = (queryCtx.index >= 0);
+
+        if (raycastHit != NULL) {
+            // NOTE: 'chain' collision shapes have no insides to start from.
+            raycastHit->inside = false;
+
+            if (!result) return false;
+
+            raycastHit->distance = queryCtx.ray.maxDistance;
+
+            raycastHit->point = frVector2Add(
+                ray.origin,
+                frVector2ScalarMultiply(ray.direction,
+                                        raycastHit->distance));
+
+            raycastHit->normal = frVector2RotateTx(
+                frGetChainNormals(s)[queryCtx.index], tx);
+        }
+
+        return result;
+    } else if (type == FR_SHAPE_TILEMAP) {
+        return frComputeTilemapRaycast(s, tx, ray, raycastHit);
+    } else if (type == FR_SHAPE_COMPOUND) {
+        return frComputeCompoundRaycast(s, tx, ray, raycastHit);
+    } else {
+        return false;
+    }
+}
+
+/* 
+    Computes the distance between `b1` and `b2`, then stores 
+    the closest points on `b1` and `b2` to `p1` and `p2`.
+*/
+float frComputeDistance(const frBody *b1,
+                        const frBody *b2,
+                        frVector2 *p1,
+                        frVector2 *p2) {
+    if (b1 == NULL || b2 == NULL) return FLT_MAX;
+
+    return frComputeShapeDistance(frGetBodyShape(b1),
+                                  frGetBodyTransform(b1),
+                                  frGetBodyShape(b2),
+                                  frGetBodyTransform(b2),
+                                  p1,
+                                  p2);
+}
+
+/* 
+    Computes the distance between `s1` with the transform `tx1` and `s2` 
+    with the transform `tx2`, then stores the closest points 
+    on `s1` and `s2` to `p1` and `p2`.
+*/
+float frComputeShapeDistance(const frShape *s1,
+                             frTransform tx1,
+                             const frShape *s2,
+                             frTransform tx2,
+                             frVector2 *p1,
+                             frVector2 *p2) {
+    if (s1 == NULL || s2 == NULL) return FLT_MAX;
+
+    frShapeType type1 = frGetShapeType(s1);
+    frShapeType type2 = frGetShapeType(s2);
+
+    if (type1 == FR_SHAPE_COMPOUND || type2 == FR_SHAPE_COMPOUND) {
+        return (type1 == FR_SHAPE_COMPOUND)
+                   ? frComputeCompoundDistance(s1, tx1, s2, tx2, p1, p2)
+                   : frComputeCompoundDistance(s2, tx2, s1, tx1, p2, p1);
+    }
+
+    if (type1 == FR_SHAPE_TILEMAP || type2 == FR_SHAPE_TILEMAP) {
+        // NOTE: Static collision shapes are never measured against each other.
+        if ((type1 == FR_SHAPE_TILEMAP || frIsChainShape(s1))
+            && (type2 == FR_SHAPE_TILEMAP || frIsChainShape(s2)))
+            return FLT_MAX;
+
+        return (type1 == FR_SHAPE_TILEMAP)
+                   ? frComputeTilemapDistance(s1, tx1, s2, tx2, p1, p2)
+                   : frComputeTilemapDistance(s2, tx2, s1, tx1, p2, p1);
+    }
+
+    if (frIsChainShape(s1) || frIsChainShape(s2)) {
+        // NOTE: 'chain' collision shapes have no insides to measure from.
+        if (frIsChainShape(s1) && frIsChainShape(s2)) return FLT_MAX;
+
+        return frIsChainShape(s1)
+                   ? frComputeChainDistance(s1, tx1, s2, tx2, p1, p2)
+                   : frComputeChainDistance(s2, tx2, s1, tx1, p2, p1);
+    }
+
+    frShapeProxy proxy1 = frGetShapeProxy(s1, tx1);
+    frShapeProxy proxy2 = frGetShapeProxy(s2, tx2);
+
+    return frComputeProxyDistance(&proxy1, &proxy2, p1, p2);
+}
+
+/* 
+    Sweeps `s1` with the transform `tx1` along `translation` against `s2`
+    with the transform `tx2`, then stores the information about 
+    the first time of impact to `raycastHit`.
+*/
+bool frComputeShapeCast(const frShape *s1,
+                        frTransform tx1,
+                        frVector2 translation,
+                        const frShape *s2,
+                        frTransform tx2,
+                        frRaycastHit *raycastHit) {
+    if (s1 == NULL || s2 == NULL) return false;
+
+    if (frComputeShapeCollision(s1, tx1, s2, tx2, NULL)) {
+        if (raycastHit != NULL) {
+            frCollision collision = { .count = 0 };
+
+            /*
+                NOTE: The contact points of `s1` and `s2` may not be found 
+                even when they are overlapping, so `translation` is used 
+                as a fallback for the normal.
+            */
+            if (frComputeShapeCollision(s1, tx1, s2, tx2, &collision)
+                && collision.count > 0) {
+                raycastHit->point = collision.contacts[0].point;
+                raycastHit->normal = frVector2Negate(collision.direction);
+            } else {
+                raycastHit->point = tx1.position;
+                raycastHit->normal = frVector2Negate(
+                    frVector2Normalize(translation));
+            }
+
+            raycastHit->distance = 0.0f;
+            raycastHit->inside = true;
+        }
+
+        return true;
+    }
+
+    if (frGetShapeType(s1) == FR_SHAPE_COMPOUND
+        || frGetShapeType(s2) == FR_SHAPE_COMPOUND)
+        return frComputeCompoundCast(s1, tx1, translation, s2, tx2, raycastHit);
+
+    if (frGetShapeType(s2) == FR_SHAPE_TILEMAP)
+        return frComputeTilemapCast(s1, tx1, translation, s2, tx2, raycastHit);
+    else if (frIsChainShape(s2))
+        return frComputeChainCast(s1, tx1, translation, s2, tx2, raycastHit);
+
+    /*
+        NOTE: Sweeping a 'chain' (or 'tilemap') collision shape along 
+        `translation` is the same as sweeping `s2` along the opposite of 
+        `translation`.
+    */
+    if (frGetShapeType(s1) == FR_SHAPE_TILEMAP || frIsChainShape(s1)) {
+        bool result = (frGetShapeType(s1) == FR_SHAPE_TILEMAP)
+                          ? frComputeTilemapCast(s2,
+                                                 tx2,
+                                                 frVector2Negate(translation),
+                                                 s1,
+                                                 tx1,
+                                                 raycastHit)
+                          : frComputeChainCast(s2,
+                                               tx2,
+                                               frVector2Negate(translation),
+                                               s1,
+                                               tx1,
+                                               raycastHit);
+
+        if (!result) return false;
+
+        if (raycastHit != NULL) {
+            raycastHit->point = frVector2Add(
+                raycastHit->point,
+                frVector2ScalarMultiply(translation,
+                                        raycastHit->distance
+                                            / frVector2Magnitude(translation)));
+
+            raycastHit->normal = frVector2Negate(raycastHit->normal);
+        }
+
+        return true;
+    }
+
+    frShapeProxy proxy1 = frGetShapeProxy(s1, tx1);
+    frShapeProxy proxy2 = frGetShapeProxy(s2, tx2);
+
+    return frComputeProxyCast(&proxy1, translation, &proxy2, raycastHit);
+}
+
+/* 
+    Returns the index of the vertex of `s` with the transform `tx`
+    farthest along `v`, or `-1` if `s` is not a 'polygon' collision shape.
+*/
+int frGetPolygonSupportIndex(const frShape *s, frTransform tx, frVector2 v) {
+    const frVector2 *vertices = frGetPolygonVertices(s);
+
+    int vertexCount = frGetPolygonVertexCount(s);
+
+    if (vertexCount <= 0) return -1;
+
+    // NOTE: Rotates `v` through `-tx.angle`, using the cached values.
+    v = (frVector2) { .x = v.x * tx.rotation.cos_ + v.y * tx.rotation.sin_,
+                      .y = v.y * tx.rotation.cos_ - v.x * tx.rotation.sin_ };
+
+    if (vertexCount > SUPPORT_LINEAR_SEARCH_LIMIT) {
+        int result = frGetSupportPointIndexHill(vertices, vertexCount, v);
+
+        if (result >= 0) return result;
+    }
+
+    float maxDot = -FLT_MAX;
+
+    int maxIndex = -1;
+
+    for (int i = 0; i < vertexCount; i++) {
+        float dot = frVector2Dot(vertices[i], v);
+
+        if (maxDot < dot) maxDot = dot, maxIndex = i;
+    }
+
+    return maxIndex;
+}
+
+/* Private Functions ======================================================> */
+
+/* 
+    A callback function for `frQueryChainSegments()` 
+    that will be called during `frComputeCollisionChain()`.
+*/
+static bool frChainHashQueryCallback(frContextNode ctxNode) {
+    frChainHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    const frShape *chain = queryCtx->chain;
+
+    const frVector2 *vertices = frGetChainVertices(chain);
+    const frVector2 *normals = frGetChainNormals(chain);
+
+    int vertexCount = frGetChainVertexCount(chain);
+    int segmentCount = frGetChainSegmentCount(chain);
+
+    int i = ctxNode.id;
+
+    frVector2 v1 = frVector2Transform(vertices[i], queryCtx->chainTx);
+    frVector2 v2 = frVector2Transform(vertices[(i + 1) % vertexCount],
+                                      queryCtx->chainTx);
+
+    frVector2 normal = frVector2RotateTx(normals[i], queryCtx->chainTx);
+
+    // NOTE: The line segments only collide with shapes in front of them.
+    if (frVector2Dot(frVector2Subtract(queryCtx->tx.position, v1), normal)
+        < 0.0f)
+        return true;
+
+    frVector2 tangent = frVector2LeftNormal(normal);
+
+    /*
+        NOTE: The direction of a contact may turn from `normal` toward 
+        each endpoint of the line segment, up to the normal of the next 
+        line segment if the endpoint sticks out of the chain, or up to 
+        the tangent of the line segment if the endpoint is free; otherwise 
+        it must not turn at all, so that nothing catches on the 'ghost' 
+        vertices between the line segments.
+    */
+    frVector2 startLimit = frVector2Negate(tangent), endLimit = tangent;
+
+    bool loop = (segmentCount == vertexCount);
+
+    int prevIndex = loop ? (i + segmentCount - 1) % segmentCount : i - 1;
+    int nextIndex = loop ? (i + 1) % segmentCount : i + 1;
+
+    if (prevIndex >= 0) {
+        frVector2 prevNormal = frVector2RotateTx(normals[prevIndex],
+                                                 queryCtx->chainTx);
+
+        startLimit = (frVector2Dot(prevNormal, tangent)
+                      < -CHAIN_CONVEX_VERTEX_TOLERANCE)
+                         ? prevNormal
+                         : normal;
+    }
+
+    if (nextIndex < segmentCount) {
+        frVector2 nextNormal = frVector2RotateTx(normals[nextIndex],
+                                                 queryCtx->chainTx);
+
+        endLimit = (frVector2Dot(nextNormal, tangent)
+                    > CHAIN_CONVEX_VERTEX_TOLERANCE)
+                       ? nextNormal
+                       : normal;
+    }
+
+    frCollision collision = { .count = 0 };
+
+    if (frGetShapeType(queryCtx->shape) == FR_SHAPE_POLYGON) {
+        if (!frComputeCollisionChainPoly(v1,
+                                         v2,
+                                         normal,
+                                         startLimit,
+                                         endLimit,
+                                         queryCtx->shape,
+                                         queryCtx->tx,
+                                         &collision))
+            return true;
+    } else {
+        frVector2 p, q;
+
+        frGetShapeSegment(queryCtx->shape, queryCtx->tx, &p, &q);
+
+        if (!frComputeCollisionSegments(v1,
+                                        v2,
+                                        0.0f,
+                                        p,
+                                        q,
+                                        frGetShapeCoreRadius(queryCtx->shape),
+                                        &collision))
+            return true;
+
+        frVector2 direction = collision.direction;
+
+        if (!frCheckChainDirection(direction, normal, startLimit, endLimit)) {
+            frVector2 limit = (frVector2Dot(direction, tangent) < 0.0f)
+                                  ? startLimit
+                                  : endLimit;
+
+            /*
+                NOTE: If the endpoint sticks out of the chain, the contact 
+                is on the front side of the next line segment instead,
+                unless the line segment of the shape has already crossed 
+                this line segment.
+            */
+            if (frVector2Dot(direction, normal) > 0.0f
+                && (limit.x != normal.x || limit.y != normal.y))
+                return true;
+
+            collision.count = 0;
+
+            if (!frComputeCollisionSegmentFace(v1,
+                                               v2,
+                                               normal,
+                                               queryCtx->shape,
+                                               queryCtx->tx,
+                                               &collision))
+                return true;
+        }
+    }
+
+    for (int j = 0; j < collision.count; j++)
+        frAddChainContact(
+            queryCtx->contacts,
+            &queryCtx->count,
+            (frChainContact) {
+                .direction = collision.direction,
+                .contact = { .id = (i << 1) | j,
+                             .depth = collision.contacts[j].depth,
+                             .point = collision.contacts[j].point } });
+
+    return true;
+}
+
+/* 
+    A callback function for `frQueryChainSegments()` 
+    that will be called during `frComputeShapeRaycast()`.
+*/
+static bool frChainRaycastHashQueryCallback(frContextNode ctxNode) {
+    frChainRaycastHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    const frShape *chain = queryCtx->chain;
+
+    int vertexCount = frGetChainVertexCount(chain);
+
+    int i = ctxNode.id;
+
+    frVector2 v1 = frGetChainVertices(chain)[i];
+    frVector2 v2 = frGetChainVertices(chain)[(i + 1) % vertexCount];
+
+    frVector2 normal = frGetChainNormals(chain)[i];
+
+    float denominator = frVector2Dot(normal, queryCtx->ray.direction);
+
+    // NOTE: The ray can only hit the front side of the line segment.
+    if (denominator >= 0.0f) return true;
+
+    float distance = frVector2Dot(normal,
+                                  frVector2Subtract(v1, queryCtx->ray.origin))
+                     / denominator;
+
+    if (distance < 0.0f || distance > queryCtx->ray.maxDistance) return true;
+
+    frVector2 point = frVector2Add(
+        queryCtx->ray.origin,
+        frVector2ScalarMultiply(queryCtx->ray.direction, distance));
+
+    frVector2 edgeVector = frVector2Subtract(v2, v1);
+
+    float t = frVector2Dot(frVector2Subtract(point, v1), edgeVector);
+
+    if (t < 0.0f || t > frVector2MagnitudeSqr(edgeVector)) return true;
+
+    // NOTE: Only the closest hit so far is kept.
+    queryCtx->ray.maxDistance = distance, queryCtx->index = i;
+
+    return true;
+}
+
+/* 
+    A callback function for `frQueryChainSegments()` 
+    that will be called during `frComputeChainDistance()`.
+*/
+static bool frChainDistanceHashQueryCallback(frContextNode ctxNode) {
+    frChainDistanceHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    const frShape *chain = queryCtx->chain;
+
+    int vertexCount = frGetChainVertexCount(chain);
+
+    int i = ctxNode.id;
+
+    frShapeProxy proxy = frGetSegmentProxy(
+        frVector2Transform(frGetChainVertices(chain)[i], queryCtx->chainTx),
+        frVector2Transform(frGetChainVertices(chain)[(i + 1) % vertexCount],
+                           queryCtx->chainTx));
+
+    frVector2 p1, p2;
+
+    float distance = frComputeProxyDistance(&proxy, queryCtx->proxy, &p1, &p2);
+
+    if (queryCtx->distance > distance)
+        queryCtx->distance = distance,
+        queryCtx->point1 = p1, queryCtx->point2 = p2;
+
+    queryCtx->count++;
+
+    return true;
+}
+
+/* 
+    A callback function for `frQueryChainSegments()` 
+    that will be called during `frComputeChainCast()`.
+*/
+static bool frChainCastHashQueryCallback(frContextNode ctxNode) {
+    frChainCastHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    const frShape *chain = queryCtx->chain;
+
+    int vertexCount = frGetChainVertexCount(chain);
+
+    int i = ctxNode.id;
+
+    frVector2 v1 = frVector2Transform(frGetChainVertices(chain)[i],
+                                      queryCtx->chainTx);
+    frVector2 v2 = frVector2Transform(
+        frGetChainVertices(chain)[(i + 1) % vertexCount], queryCtx->chainTx);
+
+    frVector2 normal = frVector2RotateTx(frGetChainNormals(chain)[i],
+                                         queryCtx->chainTx);
+
+    /*
+        NOTE: The line segment can only be hit from its front side,
+        by a collision shape moving toward it.
+    */
+    if (frVector2Dot(queryCtx->translation, normal) >= 0.0f
+        || frVector2Dot(frVector2Subtract(queryCtx->proxy->position, v1),
+                        normal)
+               < 0.0f)
+        return true;
+
+    frShapeProxy proxy = frGetSegmentProxy(v1, v2);
+
+    frRaycastHit raycastHit = { .distance = 0.0f };
+
+    if (!frComputeProxyCast(queryCtx->proxy,
+                            queryCtx->translation,
+                            &proxy,
+                            &raycastHit))
+        return true;
+
+    if (!queryCtx->hit || queryCtx->raycastHit.distance > raycastHit.distance)
+        queryCtx->raycastHit = raycastHit, queryCtx->hit = true;
+
+    return true;
+}
+
+/* 
+    A callback function for `frQueryTilemapRects()` 
+    that will be called during `frComputeCollisionTilemap()`.
+*/
+static bool frTilemapHashQueryCallback(frContextNode ctxNode) {
+    frTilemapHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    const frShape *tilemap = queryCtx->tilemap;
+
+    int i = ctxNode.id;
+
+    frCollision collision = { .count = 0 };
+
+    if (!frComputeShapeCollision(frGetTilemapRectShape(tilemap, i),
+                                 frGetTilemapRectTransform(tilemap,
+                                                           queryCtx->tilemapTx,
+                                                           i),
+                                 queryCtx->shape,
+                                 queryCtx->tx,
+                                 &collision)
+        || collision.count <= 0)
+        return true;
+
+    frTransform tilemapTx = queryCtx->tilemapTx;
+
+    frVector2 direction = {
+        .x = collision.direction.x * tilemapTx.rotation.cos_
+             + collision.direction.y * tilemapTx.rotation.sin_,
+        .y = collision.direction.y * tilemapTx.rotation.cos_
+             - collision.direction.x * tilemapTx.rotation.sin_
+    };
+
+    frVector2 point = frVector2Subtract(collision.contacts[0].point,
+                                        tilemapTx.position);
+
+    point = (frVector2) {
+        .x = point.x * tilemapTx.rotation.cos_
+             + point.y * tilemapTx.rotation.sin_,
+        .y = point.y * tilemapTx.rotation.cos_
+             - point.x * tilemapTx.rotation.sin_
+    };
+
+    float tileSize = frGetTilemapTileSize(tilemap);
+
+    frAABB rect = frGetTilemapRect(tilemap, i);
+
+    int width = frGetTilemapWidth(tilemap);
+
+    int minColumn = i % width, minRow = i / width;
+
+    int maxColumn = minColumn + (int) roundf(rect.width / tileSize) - 1;
+    int maxRow = minRow + (int) roundf(rect.height / tileSize) - 1;
+
+    int column = (int) floorf(point.x / tileSize);
+    int row = (int) floorf(point.y / tileSize);
+
+    column = (column < minColumn) ? minColumn : column;
+    column = (column > maxColumn) ? maxColumn : column;
+
+    row = (row < minRow) ? minRow : row;
+    row = (row > maxRow) ? maxRow : row;
+
+    /*
+        NOTE: A face of the rectangle that is covered by the solid tiles 
+        next to it is inside the tilemap, so any contact that pushes 
+        the shape out through that face would make it catch on 
+        the 'seams' between the rectangles.
+    */
+    if (fabsf(direction.x) >= fabsf(direction.y))
+        column = (direction.x > 0.0f) ? maxColumn + 1 : minColumn - 1;
+    else
+        row = (direction.y > 0.0f) ? maxRow + 1 : minRow - 1;
+
+    if (frGetTilemapTile(tilemap, column, row)) return true;
+
+    for (int j = 0; j < collision.count; j++)
+        frAddChainContact(
+            queryCtx->contacts,
+            &queryCtx->count,
+            (frChainContact) {
+                .direction = collision.direction,
+                .contact = { .id = (i << 1) | j,
+                             .depth = collision.contacts[j].depth,
+                             .point = collision.contacts[j].point } });
+
+    return true;
+}
+
+/* 
+    A callback function for `frQueryTilemapRects()` 
+    that will be called during `frComputeTilemapDistance()`.
+*/
+static bool frTilemapDistanceHashQueryCallback(frContextNode ctxNode) {
+    frTilemapDistanceHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    frVector2 p1, p2;
+
+    float distance = frComputeShapeDistance(
+        frGetTilemapRectShape(queryCtx->tilemap, ctxNode.id),
+        frGetTilemapRectTransform(queryCtx->tilemap,
+                                  queryCtx->tilemapTx,
+                                  ctxNode.id),
+        queryCtx->shape,
+        queryCtx->tx,
+        &p1,
+        &p2);
+
+    if (queryCtx->distance > distance)
+        queryCtx->distance = distance,
+        queryCtx->point1 = p1, queryCtx->point2 = p2;
+
+    return true;
+}
+
+/* 
+    A callback function for `frQueryTilemapRects()` 
+    that will be called during `frComputeTilemapCast()`.
+*/
+static bool frTilemapCastHashQueryCallback(frContextNode ctxNode) {
+    frTilemapCastHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    frRaycastHit raycastHit = { .distance = 0.0f };
+
+    if (!frComputeShapeCast(queryCtx->shape,
+                            queryCtx->tx,
+                            queryCtx->translation,
+                            frGetTilemapRectShape(queryCtx->tilemap,
+                                                  ctxNode.id),
+                            frGetTilemapRectTransform(queryCtx->tilemap,
+                                                      queryCtx->tilemapTx,
+                                                      ctxNode.id),
+                            &raycastHit))
+        return true;
+
+    if (!queryCtx->hit || queryCtx->raycastHit.distance > raycastHit.distance)
+        queryCtx->raycastHit = raycastHit, queryCtx->hit = true;
+
+    return true;
+}
+
+/* 
+    A callback function for `frQueryCompoundChildren()` 
+    that will be called during `frComputeCollisionCompound()`.
+*/
+static bool frCompoundHashQueryCallback(frContextNode ctxNode) {
+    frCompoundHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    int i = ctxNode.id;
+
+    const frShape *child = frGetCompoundChild(queryCtx->compound, i);
+
+    frTransform childTx = frGetCompoundChildTransform(queryCtx->compound,
+                                                      queryCtx->compoundTx,
+                                                      i);
+
+    frCollision collision = { .count = 0 };
+
+    // NOTE: The direction of `collision` must go from `s1` to `s2`.
+    if (queryCtx->compoundFirst) {
+        if (!frComputeShapeCollision(child,
+                                     childTx,
+                                     queryCtx->shape,
+                                     queryCtx->tx,
+                                     &collision))
+            return true;
+    } else {
+        if (!frComputeShapeCollision(queryCtx->shape,
+                                     queryCtx->tx,
+                                     child,
+                                     childTx,
+                                     &collision))
+            return true;
+    }
+
+    for (int j = 0; j < collision.count; j++)
+        frAddChainContact(
+            queryCtx->contacts,
+            &queryCtx->count,
+            (frChainContact) {
+                .direction = collision.direction,
+                .contact = { .id = (i << 1) | j,
+                             .depth = collision.contacts[j].depth,
+                             .point = collision.contacts[j].point } });
+
+    return true;
+}
+
+/* 
+    A callback function for `frQueryCompoundChildren()` 
+    that will be called during `frComputeCompoundCast()`.
+*/
+static bool frCompoundCastHashQueryCallback(frContextNode ctxNode) {
+    frCompoundCastHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    const frShape *child = frGetCompoundChild(queryCtx->compound, ctxNode.id);
+
+    frTransform childTx = frGetCompoundChildTransform(queryCtx->compound,
+                                                      queryCtx->compoundTx,
+                                                      ctxNode.id);
+
+    frRaycastHit raycastHit = { .distance = 0.0f };
+
+    if (!(queryCtx->compoundFirst
+              ? frComputeShapeCast(child,
+                                   childTx,
+                                   queryCtx->translation,
+                                   queryCtx->shape,
+                                   queryCtx->tx,
+                                   &raycastHit)
+              : frComputeShapeCast(queryCtx->shape,
+                                   queryCtx->tx,
+                                   queryCtx->translation,
+                                   child,
+                                   childTx,
+                                   &raycastHit)))
+        return true;
+
+    if (!queryCtx->hit || queryCtx->raycastHit.distance > raycastHit.distance)
+        queryCtx->raycastHit = raycastHit, queryCtx->hit = true;
+
+    return true;
+}
+
+/* 
+    Adds `contact` to the first `count` elements of `contacts`, replacing 
+    the shallowest contact if there is no more room for `contact`.
+*/
+static void frAddChainContact(frChainContact *contacts,
+                              int *count,
+                              frChainContact contact) {
+    if (*count < FR_GEOMETRY_MAX_CHAIN_CONTACT_COUNT) {
+        contacts[(*count)++] = contact;
+
+        return;
+    }
+
+    // NOTE: The shallowest contact makes room for a deeper one.
+    int minIndex = 0;
+
+    for (int i = 1; i < *count; i++)
+        if (contacts[minIndex].contact.depth > contacts[i].contact.depth)
+            minIndex = i;
+
+    if (contacts[minIndex].contact.depth < contact.contact.depth)
+        contacts[minIndex] = contact;
+}
+
+/* 
+    Returns `true` if `direction` lies within the range of directions 
+    from `startLimit` through `normal` to `endLimit`, where `normal` is 
+    the normal of a line segment of a 'chain' collision shape.
+*/
+static bool frCheckChainDirection(frVector2 direction,
+                                  frVector2 normal,
+                                  frVector2 startLimit,
+                                  frVector2 endLimit) {
+    if (frVector2Dot(direction, normal) >= 1.0f - CHAIN_FACE_NORMAL_TOLERANCE)
+        return true;
+
+    // NOTE: The tangent of each limit points toward the end of its segment.
+    if (frVector2Dot(direction, frVector2LeftNormal(normal)) < 0.0f)
+        return frVector2Dot(direction, frVector2LeftNormal(startLimit))
+               >= 0.0f;
+    else
+        return frVector2Dot(direction, frVector2LeftNormal(endLimit)) <= 0.0f;
+}
+
+/* 
+    Clips `e` so that the dot product of each vertex in `e` 
+    and `v` is greater than or equal to `dot`. 
+*/
+static bool frClipEdge(frEdge *e, frVector2 v, float dot) {
+    e->count = 0;
+
+    float dot1 = frVector2Dot(e->data[0], v) - dot;
+    float dot2 = frVector2Dot(e->data[1], v) - dot;
+
+    if (dot1 >= 0.0f && dot2 >= 0.0f) {
+        e->count = 2;
+
+        return true;
+    } else {
+        frVector2 edgeVector = frVector2Subtract(e->data[1], e->data[0]);
+
+        frVector2 midPoint = frVector2Add(
+            e->data[0],
+            frVector2ScalarMultiply(edgeVector, (dot1 / (dot1 - dot2))));
+
+        if (dot1 > 0.0f && dot2 < 0.0f) {
+            e->data[1] = midPoint, e->count = 2;
+
+            return true;
+        } else if (dot1 < 0.0f && dot2 > 0.0f) {
+            e->data[0] = e->data[1], e->data[1] = midPoint, e->count = 2;
+
+            return true;
+        } else {
+            return false;
+        }
+    }
+}
+
+/* 
+    Sweeps `s` with the transform `tx` along `translation` against 
+    the front sides of the line segments of `chain` with the transform 
+    `chainTx`, then stores the information about the first time of impact 
+    to `raycastHit`, assuming `s` and `chain` are not overlapping.
+*/
+static bool frComputeChainCast(const frShape *s,
+                               frTransform tx,
+                               frVector2 translation,
+                               const frShape *chain,
+                               frTransform chainTx,
+                               frRaycastHit *raycastHit) {
+    frShapeProxy proxy = frGetShapeProxy(s, tx);
+
+    frAABB aabb = frGetShapeAABB(s, tx);
+
+    // NOTE: Only the line segments near the path of `s` can be hit.
+    {
+        float minX = aabb.x + fminf(translation.x, 0.0f);
+        float minY = aabb.y + fminf(translation.y, 0.0f);
+
+        aabb.width += fabsf(translation.x), aabb.height += fabsf(translation.y);
+
+        aabb.x = minX, aabb.y = minY;
+    }
+
+    frChainCastHashQueryCtx queryCtx = { .chain = chain,
+                                         .chainTx = chainTx,
+                                         .proxy = &proxy,
+                                         .translation = translation };
+
+    frQueryChainSegments(chain,
+                         frGetLocalAABB(aabb, chainTx),
+                         frChainCastHashQueryCallback,
+                         &queryCtx);
+
+    if (queryCtx.hit && raycastHit != NULL) *raycastHit = queryCtx.raycastHit;
+
+    return queryCtx.hit;
+}
+
+/* 
+    Computes the distance between `chain` with the transform `chainTx` 
+    and `s` with the transform `tx`, then stores the closest points 
+    on `chain` and `s` to `p1` and `p2`.
+*/
+static float frComputeChainDistance(const frShape *chain,
+                                    frTransform chainTx,
+                                    const frShape *s,
+                                    frTransform tx,
+                                    frVector2 *p1,
+                                    frVector2 *p2) {
+    frShapeProxy proxy = frGetShapeProxy(s, tx);
+
+    frAABB aabb = frGetShapeAABB(s, tx);
+
+    frChainDistanceHashQueryCtx queryCtx = { .chain = chain,
+                                             .chainTx = chainTx,
+                                             .proxy = &proxy };
+
+    /*
+        NOTE: Every line segment within `margin` of `s` overlaps `aabb`
+        grown by `margin`, so the search area keeps growing until 
+        the closest line segment is found within it (or until there are
+        no more line segments left to search).
+    */
+    float margin = fmaxf(aabb.width, aabb.height);
+
+    for (;;) {
+        queryCtx.distance = FLT_MAX, queryCtx.count = 0;
+
+        frAABB searchAABB = { .x = aabb.x - margin,
+                              .y = aabb.y - margin,
+                              .width = aabb.width + 2.0f * margin,
+                              .height = aabb.height + 2.0f * margin };
+
+        frQueryChainSegments(chain,
+                             frGetLocalAABB(searchAABB, chainTx),
+                             frChainDistanceHashQueryCallback,
+                             &queryCtx);
+
+        if (queryCtx.distance <= margin
+            || queryCtx.count >= frGetChainSegmentCount(chain))
+            break;
+
+        margin *= 2.0f;
+    }
+
+    if (p1 != NULL) *p1 = queryCtx.point1;
+    if (p2 != NULL) *p2 = queryCtx.point2;
+
+    return queryCtx.distance;
+}
+
+/* 
+    Checks whether `s1` and `s2` are colliding, assuming either `s1` or 
+    `s2` is a 'compound' collision shape, then stores the collision 
+    information to `collision`.
+*/
+static bool frComputeCollisionCompound(const frShape *s1,
+                                       frTransform tx1,
+                                       const frShape *s2,
+                                       frTransform tx2,
+                                       frCollision *collision) {
+    bool compoundFirst = (frGetShapeType(s1) == FR_SHAPE_COMPOUND);
+
+    frCompoundHashQueryCtx queryCtx = {
+        .compound = compoundFirst ? s1 : s2,
+        .compoundTx = compoundFirst ? tx1 : tx2,
+        .shape = compoundFirst ? s2 : s1,
+        .tx = compoundFirst ? tx2 : tx1,
+        .compoundFirst = compoundFirst
+    };
+
+    // NOTE: Only the child shapes near the other shape are tested.
+    frQueryCompoundChildren(queryCtx.compound,
+                            frGetLocalAABB(frGetShapeAABB(queryCtx.shape,
+                                                          queryCtx.tx),
+                                           queryCtx.compoundTx),
+                            frCompoundHashQueryCallback,
+                            &queryCtx);
+
+    if (queryCtx.count <= 0) return false;
+
+    if (collision != NULL)
+        frReduceChainContacts(queryCtx.contacts,
+                              queryCtx.count,
+                              false,
+                              collision);
+
+    return true;
+}
+
+/* 
+    Casts a `ray` against the child shapes of `compound` with 
+    the transform `tx`, then stores the information about the closest hit 
+    to `raycastHit`.
+*/
+static bool frComputeCompoundRaycast(const frShape *compound,
+                                     frTransform tx,
+                                     frRay ray,
+                                     frRaycastHit *raycastHit) {
+    frRaycastHit result = { .distance = 0.0f };
+
+    bool hit = false;
+
+    for (int i = 0; i < frGetCompoundChildCount(compound); i++) {
+        frRaycastHit childHit = { .distance = 0.0f };
+
+        bool childResult = frComputeShapeRaycast(
+            frGetCompoundChild(compound, i),
+            frGetCompoundChildTransform(compound, tx, i),
+            ray,
+            &childHit);
+
+        // NOTE: A ray that starts inside any child shape cannot hit anything.
+        if (childHit.inside) {
+            if (raycastHit != NULL) raycastHit->inside = true;
+
+            return false;
+        }
+
+        if (!childResult) continue;
+
+        result = childHit, hit = true;
+
+        // NOTE: Only the closest hit so far is kept.
+        ray.maxDistance = childHit.distance;
+    }
+
+    if (raycastHit != NULL) {
+        raycastHit->inside = false;
+
+        if (!hit) return false;
+
+        raycastHit->point = result.point;
+        raycastHit->normal = result.normal;
+
+        raycastHit->distance = result.distance;
+    }
+
+    return hit;
+}
+
+/* 
+    Sweeps `s1` with the transform `tx1` along `translation` against `s2`
+    with the transform `tx2`, assuming either `s1` or `s2` is a 'compound' 
+    collision shape and `s1` and `s2` are not overlapping, then stores 
+    the information about the first time of impact to `raycastHit`.
+*/
+static bool frComputeCompoundCast(const frShape *s1,
+                                  frTransform tx1,
+                                  frVector2 translation,
+                                  const frShape *s2,
+                                  frTransform tx2,
+                                  frRaycastHit *raycastHit) {
+    bool compoundFirst = (frGetShapeType(s1) == FR_SHAPE_COMPOUND);
+
+    frCompoundCastHashQueryCtx queryCtx = {
+        .compound = compoundFirst ? s1 : s2,
+        .compoundTx = compoundFirst ? tx1 : tx2,
+        .shape = compoundFirst ? s2 : s1,
+        .tx = compoundFirst ? tx2 : tx1,
+        .translation = translation,
+        .compoundFirst = compoundFirst
+    };
+
+    /*
+        NOTE: Only the child shapes near the path of the other shape 
+        (relative to the 'compound' collision shape) can be hit.
+    */
+    frVector2 relativeTranslation = compoundFirst
+                                        ? frVector2Negate(translation)
+                                        : translation;
+
+    frAABB aabb = frGetShapeAABB(queryCtx.shape, queryCtx.tx);
+
+    {
+        float minX = aabb.x + fminf(relativeTranslation.x, 0.0f);
+        float minY = aabb.y + fminf(relativeTranslation.y, 0.0f);
+
+        aabb.width += fabsf(relativeTranslation.x);
+        aabb.height += fabsf(relativeTranslation.y);
+
+        aabb.x = minX, aabb.y = minY;
+    }
+
+    frQueryCompoundChildren(queryCtx.compound,
+                            frGetLocalAABB(aabb, queryCtx.compoundTx),
+                            frCompoundCastHashQueryCallback,
+                            &queryCtx);
+
+    if (queryCtx.hit && raycastHit != NULL) *raycastHit = queryCtx.raycastHit;
+
+    return queryCtx.hit;
+}
+
+/* 
+    Computes the distance between `compound` with the transform 
+    `compoundTx` and `s` with the transform `tx`, then stores the closest 
+    points on `compound` and `s` to `p1` and `p2`.
+*/
+static float frComputeCompoundDistance(const frShape *compound,
+                                       frTransform compoundTx,
+                                       const frShape *s,
+                                       frTransform tx,
+                                       frVector2 *p1,
+                                       frVector2 *p2) {
+    float result = FLT_MAX;
+
+    for (int i = 0; i < frGetCompoundChildCount(compound); i++) {
+        frVector2 point1, point2;
+
+        float distance = frComputeShapeDistance(
+            frGetCompoundChild(compound, i),
+            frGetCompoundChildTransform(compound, compoundTx, i),
+            s,
+            tx,
+            &point1,
+            &point2);
+
+        if (result <= distance) continue;
+
+        result = distance;
+
+        if (p1 != NULL) *p1 = point1;
+        if (p2 != NULL) *p2 = point2;
+    }
+
+    return result;
+}
+
+/* 
+    Checks whether `s1` and `s2` are colliding, assuming either `s1` or 
+    `s2` is a 'chain' or 'heightfield' collision shape, then stores 
+    the collision information to `collision`.
+*/
+static bool frComputeCollisionChain(const frShape *s1,
+                                    frTransform tx1,
+                                    const frShape *s2,
+                                    frTransform tx2,
+                                    frCollision *collision) {
+    bool chainFirst = frIsChainShape(s1);
+
+    // NOTE: 'chain' collision shapes have no insides to collide with.
+    if (chainFirst && frIsChainShape(s2)) return false;
+
+    frChainHashQueryCtx queryCtx = { .chain = chainFirst ? s1 : s2,
+                                     .chainTx = chainFirst ? tx1 : tx2,
+                                     .shape = chainFirst ? s2 : s1,
+                                     .tx = chainFirst ? tx2 : tx1 };
+
+    frQueryChainSegments(queryCtx.chain,
+                         frGetLocalAABB(frGetShapeAABB(queryCtx.shape,
+                                                       queryCtx.tx),
+                                        queryCtx.chainTx),
+                         frChainHashQueryCallback,
+                         &queryCtx);
+
+    if (queryCtx.count <= 0) return false;
+
+    if (collision != NULL)
+        frReduceChainContacts(queryCtx.contacts,
+                              queryCtx.count,
+                              !chainFirst,
+                              collision);
+
+    return true;
+}
+
+/* 
+    Checks whether `poly` with the transform `polyTx` is colliding with 
+    the front side of the line segment from `v1` to `v2` with the given 
+    `normal`, assuming `poly` is a 'polygon' collision shape and 
+    the direction of the collision must lie within the range from 
+    `startLimit` through `normal` to `endLimit`, then stores the collision 
+    information to `collision`, with the direction from the line segment 
+    to `poly`.
+*/
+static bool frComputeCollisionChainPoly(frVector2 v1,
+                                        frVector2 v2,
+                                        frVector2 normal,
+                                        frVector2 startLimit,
+                                        frVector2 endLimit,
+                                        const frShape *poly,
+                                        frTransform polyTx,
+                                        frCollision *collision) {
+    const frVector2 *vertices = frGetPolygonVertices(poly);
+    const frVector2 *normals = frGetPolygonNormals(poly);
+
+    int vertexCount = frGetPolygonVertexCount(poly);
+
+    float edgeDepth = -FLT_MAX;
+
+    for (int i = 0; i < vertexCount; i++) {
+        frVector2 vertex = frVector2Transform(vertices[i], polyTx);
+
+        float depth = -frVector2Dot(frVector2Subtract(vertex, v1), normal);
+
+        if (edgeDepth < depth) edgeDepth = depth;
+    }
+
+    if (edgeDepth < 0.0f) return false;
+
+    /*
+        NOTE: The normals of `poly` that do not lie within the limits
+        are left out of the SAT (Separating Axis Theorem), as if they
+        were not there at all.
+    */
+    float polyDepth = FLT_MAX;
+
+    int polyIndex = -1;
+
+    for (int i = 0; i < vertexCount; i++) {
+        frVector2 polyNormal = frVector2RotateTx(normals[i], polyTx);
+
+        if (!frCheckChainDirection(frVector2Negate(polyNormal),
+                                   normal,
+                                   startLimit,
+                                   endLimit))
+            continue;
+
+        frVector2 vertex = frVector2Transform(vertices[i], polyTx);
+
+        float depth = -fminf(
+            frVector2Dot(frVector2Subtract(v1, vertex), polyNormal),
+            frVector2Dot(frVector2Subtract(v2, vertex), polyNormal));
+
+        if (depth < 0.0f) return false;
+
+        if (polyDepth > depth) polyDepth = depth, polyIndex = i;
+    }
+
+    if (polyIndex < 0 || edgeDepth <= polyDepth + CHAIN_REFERENCE_EDGE_BIAS)
+        return frComputeCollisionSegmentFace(v1,
+                                             v2,
+                                             normal,
+                                             poly,
+                                             polyTx,
+                                             collision);
+
+    // NOTE: The edge of `poly` is the reference edge.
+    frVector2 polyNormal = frVector2RotateTx(normals[polyIndex], polyTx);
+
+    frVector2 refVertex1 = frVector2Transform(
+        vertices[(polyIndex + vertexCount - 1) % vertexCount], polyTx);
+    frVector2 refVertex2 = frVector2Transform(vertices[polyIndex], polyTx);
+
+    frVector2 refEdgeVector = frVector2Normalize(
+        frVector2Subtract(refVertex2, refVertex1));
+
+    frEdge incEdge = { .data = { v1, v2, v1 },
+                       .indices = { 0, 1 },
+                       .count = 2 };
+
+    if (!frClipEdge(&incEdge,
+                    refEdgeVector,
+                    frVector2Dot(refVertex1, refEdgeVector)))
+        return false;
+
+    if (!frClipEdge(&incEdge,
+                    frVector2Negate(refEdgeVector),
+                    -frVector2Dot(refVertex2, refEdgeVector)))
+        return false;
+
+    int count = 0;
+
+    for (int i = 0; i < 2; i++) {
+        float depth = -frVector2Dot(
+            frVector2Subtract(incEdge.data[i], refVertex2), polyNormal);
+
+        if (depth < 0.0f) continue;
+
+        collision->contacts[count].id = 2 + i;
+        collision->contacts[count].point = incEdge.data[i];
+        collision->contacts[count].depth = depth;
+
+        count++;
+    }
+
+    if (count <= 0) return false;
+
+    if (count == 1) collision->contacts[1] = collision->contacts[0];
+
+    collision->direction = frVector2Negate(polyNormal);
+    collision->count = count;
+
+    return true;
+}
+
+/* 
+    Checks whether `s1` and `s2` are colliding, assuming either `s1` or 
+    `s2` is a 'tilemap' collision shape, then stores the collision 
+    information to `collision`.
+*/
+static bool frComputeCollisionTilemap(const frShape *s1,
+                                      frTransform tx1,
+                                      const frShape *s2,
+                                      frTransform tx2,
+                                      frCollision *collision) {
+    bool tilemapFirst = (frGetShapeType(s1) == FR_SHAPE_TILEMAP);
+
+    const frShape *other = tilemapFirst ? s2 : s1;
+
+    // NOTE: Static collision shapes never collide with each other.
+    if (frGetShapeType(other) == FR_SHAPE_TILEMAP || frIsChainShape(other))
+        return false;
+
+    frTilemapHashQueryCtx queryCtx = { .tilemap = tilemapFirst ? s1 : s2,
+                                       .tilemapTx = tilemapFirst ? tx1 : tx2,
+                                       .shape = other,
+                                       .tx = tilemapFirst ? tx2 : tx1 };
+
+    frQueryTilemapRects(queryCtx.tilemap,
+                        frGetLocalAABB(frGetShapeAABB(queryCtx.shape,
+                                                      queryCtx.tx),
+                                       queryCtx.tilemapTx),
+                        frTilemapHashQueryCallback,
+                        &queryCtx);
+
+    if (queryCtx.count <= 0) return false;
+
+    if (collision != NULL)
+        frReduceChainContacts(queryCtx.contacts,
+                              queryCtx.count,
+                              !tilemapFirst,
+                              collision);
+
+    return true;
+}
+
+/* 
+    Casts a `ray` against the solid tiles of `tilemap` with the transform 
+    `tx`, by stepping through the tiles along `ray` one at a time.
+*/
+static bool frComputeTilemapRaycast(const frShape *tilemap,
+                                    frTransform tx,
+                                    frRay ray,
+                                    frRaycastHit *raycastHit) {
+    frVector2 origin = frVector2Subtract(ray.origin, tx.position);
+
+    origin = (frVector2) {
+        .x = origin.x * tx.rotation.cos_ + origin.y * tx.rotation.sin_,
+        .y = origin.y * tx.rotation.cos_ - origin.x * tx.rotation.sin_
+    };
+
+    frVector2 direction = {
+        .x = ray.direction.x * tx.rotation.cos_
+             + ray.direction.y * tx.rotation.sin_,
+        .y = ray.direction.y * tx.rotation.cos_
+             - ray.direction.x * tx.rotation.sin_
+    };
+
+    if (raycastHit != NULL) raycastHit->inside = false;
+
+    if (direction.x == 0.0f && direction.y == 0.0f) return false;
+
+    int width = frGetTilemapWidth(tilemap);
+    int height = frGetTilemapHeight(tilemap);
+
+    float tileSize = frGetTilemapTileSize(tilemap);
+
+    /*
+        NOTE: The ray is clipped against the bounds of `tilemap` first,
+        keeping the axis of the face that the ray enters through.
+    */
+    float minDistance = 0.0f, maxDistance = ray.maxDistance;
+
+    int axis = -1;
+
+    {
+        float maxBounds[2] = { width * tileSize, height * tileSize };
+
+        float start[2] = { origin.x, origin.y };
+        float dir[2] = { direction.x, direction.y };
+
+        for (int i = 0; i < 2; i++) {
+            if (dir[i] == 0.0f) {
+                if (start[i] < 0.0f || start[i] > maxBounds[i])
+                    return false;
+
+                continue;
+            }
+
+            float inverseDir = 1.0f / dir[i];
+
+            float t1 = -start[i] * inverseDir;
+            float t2 = (maxBounds[i] - start[i]) * inverseDir;
+
+            if (t1 > t2) {
+                float t = t1;
+
+                t1 = t2, t2 = t;
+            }
+
+            if (minDistance < t1) minDistance = t1, axis = i;
+            if (maxDistance > t2) maxDistance = t2;
+
+            if (minDistance > maxDistance) return false;
+        }
+    }
+
+    float inverseTileSize = 1.0f / tileSize;
+
+    int column = (int) floorf((origin.x + direction.x * minDistance)
+                              * inverseTileSize);
+    int row = (int) floorf((origin.y + direction.y * minDistance)
+                           * inverseTileSize);
+
+    /* NOTE: Rounding errors may leave the tile just outside of the bounds. */
+    column = (column < 0) ? 0 : column;
+    column = (column > width - 1) ? width - 1 : column;
+
+    row = (row < 0) ? 0 : row;
+    row = (row > height - 1) ? height - 1 : row;
+
+    // NOTE: A ray that starts inside a solid tile cannot hit anything.
+    if (axis < 0 && frGetTilemapTile(tilemap, column, row)) {
+        if (raycastHit != NULL) raycastHit->inside = true;
+
+        return false;
+    }
+
+    int stepX = (direction.x > 0.0f) - (direction.x < 0.0f);
+    int stepY = (direction.y > 0.0f) - (direction.y < 0.0f);
+
+    frVector2 deltaDistance = {
+        .x = (stepX != 0) ? fabsf(tileSize / direction.x) : FLT_MAX,
+        .y = (stepY != 0) ? fabsf(tileSize / direction.y) : FLT_MAX
+    };
+
+    frVector2 nextDistance = {
+        .x = (stepX != 0) ? (((column + (stepX > 0)) * tileSize) - origin.x)
+                                / direction.x
+                          : FLT_MAX,
+        .y = (stepY != 0) ? (((row + (stepY > 0)) * tileSize) - origin.y)
+                                / direction.y
+                          : FLT_MAX
+    };
+
+    float distance = minDistance;
+
+    for (;;) {
+        if (column < 0 || column >= width || row < 0 || row >= height
+            || distance > maxDistance)
+            return false;
+
+        if (frGetTilemapTile(tilemap, column, row)) break;
+
+        if (nextDistance.x < nextDistance.y) {
+            distance = nextDistance.x, axis = 0;
+
+            nextDistance.x += deltaDistance.x, column += stepX;
+        } else {
+            distance = nextDistance.y, axis = 1;
+
+            nextDistance.y += deltaDistance.y, row += stepY;
+        }
+    }
+
+    if (raycastHit != NULL) {
+        frVector2 normal = (axis == 0)
+                               ? (frVector2) { .x = (float) -stepX }
+                               : (frVector2) { .y = (float) -stepY };
+
+        raycastHit->point = frVector2Add(
+            ray.origin, frVector2ScalarMultiply(ray.direction, distance));
+
+        raycastHit->normal = frVector2RotateTx(normal, tx);
+
+        raycastHit->distance = distance;
+    }
+
+    return true;
+}
+
+/* 
+    Sweeps `s` with the transform `tx` along `translation` against 
+    `tilemap` with the transform `tilemapTx`, then stores the information 
+    about the first time of impact to `raycastHit`, assuming `s` and 
+    `tilemap` are not overlapping.
+*/
+static bool frComputeTilemapCast(const frShape *s,
+                                 frTransform tx,
+                                 frVector2 translation,
+                                 const frShape *tilemap,
+                                 frTransform tilemapTx,
+                                 frRaycastHit *raycastHit) {
+    frAABB aabb = frGetShapeAABB(s, tx);
+
+    // NOTE: Only the rectangles near the path of `s` can be hit.
+    {
+        float minX = aabb.x + fminf(translation.x, 0.0f);
+        float minY = aabb.y + fminf(translation.y, 0.0f);
+
+        aabb.width += fabsf(translation.x), aabb.height += fabsf(translation.y);
+
+        aabb.x = minX, aabb.y = minY;
+    }
+
+    frTilemapCastHashQueryCtx queryCtx = { .tilemap = tilemap,
+                                           .tilemapTx = tilemapTx,
+                                           .shape = s,
+                                           .tx = tx,
+                                           .translation = translation };
+
+    frQueryTilemapRects(tilemap,
+                        frGetLocalAABB(aabb, tilemapTx),
+                        frTilemapCastHashQueryCallback,
+                        &queryCtx);
+
+    if (queryCtx.hit && raycastHit != NULL) *raycastHit = queryCtx.raycastHit;
+
+    return queryCtx.hit;
+}
+
+/* 
+    Computes the distance between `tilemap` with the transform `tilemapTx` 
+    and `s` with the transform `tx`, then stores the closest points 
+    on `tilemap` and `s` to `p1` and `p2`.
+*/
+static float frComputeTilemapDistance(const frShape *tilemap,
+                                      frTransform tilemapTx,
+                                      const frShape *s,
+                                      frTransform tx,
+                                      frVector2 *p1,
+                                      frVector2 *p2) {
+    frAABB aabb = frGetShapeAABB(s, tx);
+
+    frTilemapDistanceHashQueryCtx queryCtx = { .tilemap = tilemap,
+                                               .tilemapTx = tilemapTx,
+                                               .shape = s,
+                                               .tx = tx };
+
+    float maxX = frGetTilemapWidth(tilemap) * frGetTilemapTileSize(tilemap);
+    float maxY = frGetTilemapHeight(tilemap) * frGetTilemapTileSize(tilemap);
+
+    // NOTE: See `frComputeChainDistance()` for how the search area grows.
+    float margin = fmaxf(fmaxf(aabb.width, aabb.height),
+                         frGetTilemapTileSize(tilemap));
+
+    for (;;) {
+        queryCtx.distance = FLT_MAX;
+
+        frAABB searchAABB = frGetLocalAABB(
+            (frAABB) { .x = aabb.x - margin,
+                       .y = aabb.y - margin,
+                       .width = aabb.width + 2.0f * margin,
+                       .height = aabb.height + 2.0f * margin },
+            tilemapTx);
+
+        frQueryTilemapRects(tilemap,
+                            searchAABB,
+                            frTilemapDistanceHashQueryCallback,
+                            &queryCtx);
+
+        if (queryCtx.distance <= margin
+            || (searchAABB.x <= 0.0f && searchAABB.y <= 0.0f
+                && searchAABB.x + searchAABB.width >= maxX
+                && searchAABB.y + searchAABB.height >= maxY))
+            break;
+
+        margin *= 2.0f;
+    }
+
+    if (p1 != NULL) *p1 = queryCtx.point1;
+    if (p2 != NULL) *p2 = queryCtx.point2;
+
+    return queryCtx.distance;
+}
+
+/* 
+    Checks whether `s1` and `s2` are colliding, assuming `s1` and `s2` 
+    are 'capsule' (or 'circle') collision shapes and at least one of them 
+    is a 'capsule' collision shape, then stores the collision information 
+    to `collision`.
+*/
+static bool frComputeCollisionCapsules(const frShape *s1,
+                                       frTransform tx1,
+                                       const frShape *s2,
+                                       frTransform tx2,
+                                       frCollision *collision) {
+    frVector2 p1, q1, p2, q2;
+
+    frGetShapeSegment(s1, tx1, &p1, &q1);
+    frGetShapeSegment(s2, tx2, &p2, &q2);
+
+    return frComputeCollisionSegments(p1,
+                                      q1,
+                                      frGetShapeCoreRadius(s1),
+                                      p2,
+                                      q2,
+                                      frGetShapeCoreRadius(s2),
+                                      collision);
+}
+
+/* 
+    Checks whether `s1` and `s2` are colliding,
+    assuming `s1` is a 'capsule' collision shape and `s2` is a 'polygon' 
+    collision shape, then stores the collision information to `collision`.
+*/
+static bool frComputeCollisionCapsulePoly(const frShape *s1,
+                                          frTransform tx1,
+                                          const frShape *s2,
+                                          frTransform tx2,
+                                          frCollision *collision) {
+    bool capsuleFirst = (frGetShapeType(s1) == FR_SHAPE_CAPSULE);
+
+    const frShape *capsule = capsuleFirst ? s1 : s2;
+
+    frVector2 v1, v2;
+
+    frGetShapeSegment(capsule, capsuleFirst ? tx1 : tx2, &v1, &v2);
+
+    if (!frComputeCollisionSegmentPoly(v1,
+                                       v2,
+                                       frGetCapsuleRadius(capsule),
+                                       capsuleFirst ? s2 : s1,
+                                       capsuleFirst ? tx2 : tx1,
+                                       collision))
+        return false;
+
+    if (collision != NULL && !capsuleFirst)
+        collision->direction = frVector2Negate(collision->direction);
+
+    return true;
+}
+
+/* 
+    Checks whether the line segment from `p1` to `q1` with `radius1` and 
+    the line segment from `p2` to `q2` with `radius2` are colliding, 
+    then stores the collision information to `collision`.
+*/
+static bool frComputeCollisionSegments(frVector2 p1,
+                                       frVector2 q1,
+                                       float radius1,
+                                       frVector2 p2,
+                                       frVector2 q2,
+                                       float radius2,
+                                       frCollision *collision) {
+    float radiusSum = radius1 + radius2, f1, f2;
+
+    frComputeSegmentClosestPoints(p1, q1, p2, q2, &f1, &f2);
+
+    frVector2 edgeVector1 = frVector2Subtract(q1, p1);
+    frVector2 edgeVector2 = frVector2Subtract(q2, p2);
+
+    frVector2 closestPoint1 = frVector2Add(
+        p1, frVector2ScalarMultiply(edgeVector1, f1));
+
+    frVector2 closestPoint2 = frVector2Add(
+        p2, frVector2ScalarMultiply(edgeVector2, f2));
+
+    frVector2 direction = frVector2Subtract(closestPoint2, closestPoint1);
+
+    float magnitudeSqr = frVector2MagnitudeSqr(direction);
+
+    if (radiusSum * radiusSum < magnitudeSqr) return false;
+
+    if (collision == NULL) return true;
+
+    float magnitude = sqrtf(magnitudeSqr);
+
+    if (magnitude > CAPSULE_CROSSING_TOLERANCE) {
+        direction = frVector2ScalarMultiply(direction, 1.0f / magnitude);
+    } else {
+        /*
+            NOTE: The line segments of `s1` and `s2` are crossing, so 
+            the normal of either line segment along which they are
+            separated the most is used instead, where `magnitude` becomes
+            the (negative) separation along that normal.
+        */
+        direction = (frVector2) { .y = 1.0f }, magnitude = -FLT_MAX;
+
+        for (int i = 0; i < 4; i++) {
+            frVector2 edgeVector = (i < 2) ? edgeVector1 : edgeVector2;
+
+            if (frVector2MagnitudeSqr(edgeVector) <= 0.0f) continue;
+
+            frVector2 normal = frVector2LeftNormal(edgeVector);
+
+            if (i & 1) normal = frVector2Negate(normal);
+
+            float separation = fminf(frVector2Dot(p2, normal),
+                                     frVector2Dot(q2, normal))
+                               - fmaxf(frVector2Dot(p1, normal),
+                                       frVector2Dot(q1, normal));
+
+            if (magnitude < separation)
+                direction = normal, magnitude = separation;
+        }
+    }
+
+    collision->direction = direction;
+
+    float edgeLength1 = frVector2Magnitude(edgeVector1);
+    float edgeLength2 = frVector2Magnitude(edgeVector2);
+
+    if (edgeLength1 > 0.0f && edgeLength2 > 0.0f
+        && magnitude > CAPSULE_CROSSING_TOLERANCE
+        && fabsf(frVector2Cross(edgeVector1, edgeVector2))
+               < CAPSULE_PARALLEL_TOLERANCE * (edgeLength1 * edgeLength2)) {
+        /*
+            NOTE: The line segments of `s1` and `s2` are almost parallel,
+            so the line segment of `s2` is clipped against the ends of 
+            the line segment of `s1` to find up to two contact points.
+        */
+        frVector2 edgeDirection = frVector2ScalarMultiply(edgeVector1,
+                                                          1.0f / edgeLength1);
+
+        frVector2 edgeNormal = frVector2LeftNormal(edgeVector1);
+
+        if (frVector2Dot(edgeNormal, direction) < 0.0f)
+            edgeNormal = frVector2Negate(edgeNormal);
+
+        frEdge incEdge = { .data = { p2, q2 },
+                           .indices = { 0, 1 },
+                           .count = 2 };
+
+        if (frClipEdge(&incEdge,
+                       edgeDirection,
+                       frVector2Dot(p1, edgeDirection))
+            && frClipEdge(&incEdge,
+                          frVector2Negate(edgeDirection),
+                          -frVector2Dot(q1, edgeDirection))) {
+            int count = 0;
+
+            for (int i = 0; i < incEdge.count; i++) {
+                float separation = frVector2Dot(
+                    frVector2Subtract(incEdge.data[i], p1), edgeNormal);
+
+                if (separation > radiusSum) continue;
+
+                collision->contacts[count].id = incEdge.indices[i];
+
+                collision->contacts[count].point = frVector2Subtract(
+                    incEdge.data[i],
+                    frVector2ScalarMultiply(edgeNormal,
+                                            separation - radius1));
+
+                collision->contacts[count].depth = radiusSum - separation;
+
+                count++;
+            }
+
+            if (count > 0) {
+                if (count == 1)
+                    collision->contacts[1] = collision->contacts[0];
+
+                collision->direction = edgeNormal;
+                collision->count = count;
+
+                return true;
+            }
+        }
+    }
+
+    collision->contacts[0].id = 0;
+
+    collision->contacts[0].point = frVector2Add(
+        closestPoint1, frVector2ScalarMultiply(direction, radius1));
+
+    collision->contacts[0].depth = radiusSum - magnitude;
+
+    collision->contacts[1] = collision->contacts[0];
+
+    collision->count = 1;
+
+    return true;
+}
+
+/* 
+    Checks whether the line segment from `v1` to `v2` with `radius` and 
+    `poly` with the transform `polyTx` are colliding, assuming `poly` is 
+    a 'polygon' collision shape, then stores the collision information 
+    to `collision`, with the direction from the line segment to `poly`.
+*/
+static bool frComputeCollisionSegmentPoly(frVector2 v1,
+                                          frVector2 v2,
+                                          float radius,
+                                          const frShape *poly,
+                                          frTransform polyTx,
+                                          frCollision *collision) {
+    const frVector2 *vertices = frGetPolygonVertices(poly);
+    const frVector2 *normals = frGetPolygonNormals(poly);
+
+    int vertexCount = frGetPolygonVertexCount(poly);
+
+    // NOTE: The line segment is transformed to the local space of `poly`.
+    v1 = frVector2Rotate(frVector2Subtract(v1, polyTx.position),
+                         -polyTx.angle);
+    v2 = frVector2Rotate(frVector2Subtract(v2, polyTx.position),
+                         -polyTx.angle);
+
+    frVector2 edgeVector = frVector2Subtract(v2, v1);
+
+    frVector2 edgeNormal = frVector2LeftNormal(edgeVector);
+
+    /*
+        NOTE: This will find the axis of minimum penetration among 
+        the normals of the 'polygon' collision shape and the normals of 
+        the line segment, ignoring the radius until the very end.
+    */
+    float maxPolyDot = -FLT_MAX, minEdgeDot = FLT_MAX, maxEdgeDot = -FLT_MAX;
+
+    int polyIndex = -1;
+
+    for (int i = 0; i < vertexCount; i++) {
+        float dot = fminf(
+            frVector2Dot(normals[i], frVector2Subtract(v1, vertices[i])),
+            frVector2Dot(normals[i], frVector2Subtract(v2, vertices[i])));
+
+        if (dot > radius) return false;
+
+        if (maxPolyDot < dot) maxPolyDot = dot, polyIndex = i;
+
+        float edgeDot = frVector2Dot(edgeNormal,
+                                     frVector2Subtract(vertices[i], v1));
+
+        if (minEdgeDot > edgeDot) minEdgeDot = edgeDot;
+        if (maxEdgeDot < edgeDot) maxEdgeDot = edgeDot;
+    }
+
+    if (polyIndex < 0) return false;
+
+    // NOTE: `edgeNormal` should point from the line segment to `poly`.
+    float maxSegmentDot = minEdgeDot;
+
+    if (-maxEdgeDot > minEdgeDot)
+        edgeNormal = frVector2Negate(edgeNormal), maxSegmentDot = -maxEdgeDot;
+
+    if (maxSegmentDot > radius) return false;
+
+    frVector2 direction = frStructZero(frVector2);
+
+    bool vertexContact = false;
+
+    /*
+        NOTE: Even when the line segment and the 'polygon' collision shape
+        do not overlap, they might still be farther than `radius` apart 
+        near the vertices, which is checked here with their closest points.
+    */
+    if (maxPolyDot > 0.0f || maxSegmentDot > 0.0f) {
+        float minDistanceSqr = FLT_MAX, f1 = 0.0f, f2 = 0.0f;
+
+        frVector2 closestPoint1 = v1, closestPoint2 = vertices[0];
+
+        for (int j = vertexCount - 1, i = 0; i < vertexCount; j = i, i++) {
+            float edgeF1, edgeF2;
+
+            frComputeSegmentClosestPoints(v1,
+                                          v2,
+                                          vertices[j],
+                                          vertices[i],
+                                          &edgeF1,
+                                          &edgeF2);
+
+            frVector2 point1 = frVector2Add(
+                v1, frVector2ScalarMultiply(edgeVector, edgeF1));
+
+            frVector2 point2 = frVector2Add(
+                vertices[j],
+                frVector2ScalarMultiply(frVector2Subtract(vertices[i],
+                                                          vertices[j]),
+                                        edgeF2));
+
+            float distanceSqr = frVector2DistanceSqr(point1, point2);
+
+            if (minDistanceSqr > distanceSqr) {
+                minDistanceSqr = distanceSqr;
+
+                closestPoint1 = point1, closestPoint2 = point2;
+
+                f1 = edgeF1, f2 = edgeF2;
+            }
+        }
+
+        if (radius * radius < minDistanceSqr) return false;
+
+        if (collision == NULL) return true;
+
+        /*
+            NOTE: The closest points are both vertices, so the normal 
+            is not the normal of any edge and only one contact is found.
+        */
+        if ((f1 == 0.0f || f1 == 1.0f) && (f2 == 0.0f || f2 == 1.0f)) {
+            float distance = sqrtf(minDistanceSqr);
+
+            direction = frVector2ScalarMultiply(
+                frVector2Subtract(closestPoint2, closestPoint1),
+                1.0f / distance);
+
+            collision->contacts[0].id = (3 << 16);
+
+            collision->contacts[0].point = frVector2Transform(
+                frVector2Add(closestPoint1,
+                             frVector2ScalarMultiply(direction, radius)),
+                polyTx);
+
+            collision->contacts[0].depth = radius - distance;
+
+            collision->contacts[1] = collision->contacts[0];
+
+            collision->count = 1;
+
+            vertexContact = true;
+        }
+    } else if (collision == NULL) {
+        return true;
+    }
+
+    if (!vertexContact) {
+        frEdge incEdge;
+
+        frVector2 refVertex1, refVertex2, refNormal;
+
+        bool refEdgeFlipped = (maxSegmentDot
+                               > maxPolyDot + CAPSULE_REFERENCE_EDGE_BIAS);
+
+        int refIndex = polyIndex;
+
+        if (refEdgeFlipped) {
+            // NOTE: The line segment of `capsule` is the reference edge.
+            float minDot = FLT_MAX;
+
+            int incIndex = 0;
+
+            for (int i = 0; i < vertexCount; i++) {
+                float dot = frVector2Dot(normals[i], edgeNormal);
+
+                if (minDot > dot) minDot = dot, incIndex = i;
+            }
+
+            int prevIndex = (incIndex > 0) ? incIndex - 1 : vertexCount - 1;
+
+            incEdge = (frEdge) { .data = { vertices[prevIndex],
+                                           vertices[incIndex] },
+                                 .indices = { prevIndex, incIndex },
+                                 .count = 2 };
+
+            refVertex1 = v1, refVertex2 = v2, refNormal = edgeNormal;
+
+            refIndex = 0;
+        } else {
+            int prevIndex = (polyIndex > 0) ? polyIndex - 1 : vertexCount - 1;
+
+            incEdge = (frEdge) { .data = { v1, v2 },
+                                 .indices = { 0, 1 },
+                                 .count = 2 };
+
+            refVertex1 = vertices[prevIndex], refVertex2 = vertices[polyIndex];
+            refNormal = normals[polyIndex];
+        }
+
+        frVector2 refEdgeVector = frVector2Normalize(
+            frVector2Subtract(refVertex2, refVertex1));
+
+        int count = 0;
+
+        if (frClipEdge(&incEdge,
+                       refEdgeVector,
+                       frVector2Dot(refVertex1, refEdgeVector))
+            && frClipEdge(&incEdge,
+                          frVector2Negate(refEdgeVector),
+                          -frVector2Dot(refVertex2, refEdgeVector))) {
+            unsigned int contactIdMask = (refEdgeFlipped << 16)
+                                         | (refIndex << 8);
+
+            for (int i = 0; i < incEdge.count; i++) {
+                float separation = frVector2Dot(
+                    frVector2Subtract(incEdge.data[i], refVertex1),
+                    refNormal);
+
+                if (separation > radius) continue;
+
+                collision->contacts[count].id = contactIdMask
+                                                | incEdge.indices[i];
+
+                /*
+                    NOTE: Each contact point lies on the surface of
+                    `capsule`, or on the edge of `poly`, whichever 
+                    is the incident edge.
+                */
+                collision->contacts[count].point = frVector2Transform(
+                    refEdgeFlipped
+                        ? incEdge.data[i]
+                        : frVector2Subtract(
+                              incEdge.data[i],
+                              frVector2ScalarMultiply(refNormal, radius)),
+                    polyTx);
+
+                collision->contacts[count].depth = radius - separation;
+
+                count++;
+            }
+        }
+
+        if (count == 0) {
+            /*
+                NOTE: The incident edge does not reach the reference edge 
+                after clipping, so the deepest endpoint of the line segment
+                is used as the only contact point.
+            */
+            float dot1 = frVector2Dot(normals[polyIndex],
+                                      frVector2Subtract(v1,
+                                                        vertices[polyIndex]));
+            float dot2 = frVector2Dot(normals[polyIndex],
+                                      frVector2Subtract(v2,
+                                                        vertices[polyIndex]));
+
+            frVector2 vertex = (dot1 < dot2) ? v1 : v2;
+
+            collision->contacts[0].id = (2 << 16);
+
+            collision->contacts[0].point = frVector2Transform(
+                frVector2Subtract(vertex,
+                                  frVector2ScalarMultiply(normals[polyIndex],
+                                                          radius)),
+                polyTx);
+
+            collision->contacts[0].depth = radius - fminf(dot1, dot2);
+
+            refEdgeFlipped = false, refNormal = normals[polyIndex];
+
+            count = 1;
+        }
+
+        if (count == 1) collision->contacts[1] = collision->contacts[0];
+
+        collision->count = count;
+
+        // NOTE: `direction` should point from the line segment to `poly`.
+        direction = refEdgeFlipped ? refNormal : frVector2Negate(refNormal);
+    }
+
+    collision->direction = frVector2RotateTx(direction, polyTx);
+
+    return true;
+}
+
+/* 
+    Checks whether `s` with the transform `tx` is colliding with the front 
+    side of the line segment from `v1` to `v2` with the given `normal`, 
+    ignoring its endpoints, then stores the collision information 
+    to `collision`, with the direction from the line segment to `s`.
+*/
+static bool frComputeCollisionSegmentFace(frVector2 v1,
+                                          frVector2 v2,
+                                          frVector2 normal,
+                                          const frShape *s,
+                                          frTransform tx,
+                                          frCollision *collision) {
+    frEdge incEdge;
+
+    float radius = frGetShapeCoreRadius(s);
+
+    if (frGetShapeType(s) == FR_SHAPE_POLYGON) {
+        incEdge = frGetContactEdge(s, tx, frVector2Negate(normal));
+    } else {
+        frVector2 p, q;
+
+        frGetShapeSegment(s, tx, &p, &q);
+
+        incEdge = (frEdge) { .data = { p, q, p },
+                             .indices = { 0, 1 },
+                             .count = 2 };
+    }
+
+    frVector2 tangent = frVector2Normalize(frVector2Subtract(v2, v1));
 
-        return (!(raycastHit->inside) && (intersectionCount > 0));
-    } else {
+    if (!frClipEdge(&incEdge, tangent, frVector2Dot(v1, tangent)))
         return false;
-    }
-}
 
-/* Private Functions ======================================================> */
+    if (!frClipEdge(&incEdge,
+                    frVector2Negate(tangent),
+                    -frVector2Dot(v2, tangent)))
+        return false;
 
-/* 
-    Clips `e` so that the dot product of each vertex in `e` 
-    and `v` is greater than or equal to `dot`. 
-*/
-static bool frClipEdge(frEdge *e, frVector2 v, float dot) {
-    e->count = 0;
+    int count = 0;
 
-    float dot1 = frVector2Dot(e->data[0], v) - dot;
-    float dot2 = frVector2Dot(e->data[1], v) - dot;
+    for (int i = 0; i < 2; i++) {
+        // NOTE: A 'circle' collision shape has only one point to check.
+        if (i > 0
+            && frVector2MagnitudeSqr(frVector2Subtract(incEdge.data[1],
+                                                       incEdge.data[0]))
+                   <= FLT_EPSILON)
+            break;
 
-    if (dot1 >= 0.0f && dot2 >= 0.0f) {
-        e->count = 2;
+        float depth = radius
+                      - frVector2Dot(frVector2Subtract(incEdge.data[i], v1),
+                                     normal);
 
-        return true;
-    } else {
-        frVector2 edgeVector = frVector2Subtract(e->data[1], e->data[0]);
+        if (depth < 0.0f) continue;
 
-        frVector2 midPoint = frVector2Add(
-            e->data[0],
-            frVector2ScalarMultiply(edgeVector, (dot1 / (dot1 - dot2))));
+        collision->contacts[count].id = i;
 
-        if (dot1 > 0.0f && dot2 < 0.0f) {
-            e->data[1] = midPoint, e->count = 2;
+        collision->contacts[count].point = frVector2Subtract(
+            incEdge.data[i], frVector2ScalarMultiply(normal, radius));
 
-            return true;
-        } else if (dot1 < 0.0f && dot2 > 0.0f) {
-            e->data[0] = e->data[1], e->data[1] = midPoint, e->count = 2;
+        collision->contacts[count].depth = depth;
 
-            return true;
-        } else {
-            return false;
-        }
+        count++;
     }
+
+    if (count <= 0) return false;
+
+    if (count == 1) collision->contacts[1] = collision->contacts[0];
+
+    collision->direction = normal;
+    collision->count = count;
+
+    return true;
 }
 
 /* 
@@ -318,8 +3108,10 @@ static bool frComputeCollisionCirclePoly(const frShape *s1,
         circleTx = tx2, polyTx = tx1;
     }
 
-    const frVertices *vertices = frGetPolygonVertices(poly);
-    const frVertices *normals = frGetPolygonNormals(poly);
+    const frVector2 *vertices = frGetPolygonVertices(poly);
+    const frVector2 *normals = frGetPolygonNormals(poly);
+
+    int vertexCount = frGetPolygonVertexCount(poly);
 
     /*
         NOTE: `txCenter` refers to the center of the 'circle' collision shape
@@ -337,10 +3129,9 @@ static bool frComputeCollisionCirclePoly(const frShape *s1,
         NOTE: This will find the edge of the 'polygon' collision shape
         closest to the center of the 'circle' collision shape.
     */
-    for (int j = vertices->count - 1, i = 0; i < vertices->count; j = i, i++) {
-        float dot = frVector2Dot(normals->data[i],
-                                 frVector2Subtract(txCenter,
-                                                   vertices->data[i]));
+    for (int i = 0; i < vertexCount; i++) {
+        float dot = frVector2Dot(normals[i],
+                                 frVector2Subtract(txCenter, vertices[i]));
 
         if (dot > radius) return false;
 
@@ -358,7 +3149,7 @@ static bool frComputeCollisionCirclePoly(const frShape *s1,
     if (maxDot < 0.0f) {
         if (collision != NULL) {
             collision->direction = frVector2Negate(
-                frVector2RotateTx(normals->data[maxIndex], polyTx));
+                frVector2RotateTx(normals[maxIndex], polyTx));
 
             if (frVector2Dot(deltaPosition, collision->direction) < 0.0f)
                 collision->direction = frVector2Negate(collision->direction);
@@ -374,10 +3165,10 @@ static bool frComputeCollisionCirclePoly(const frShape *s1,
             collision->count = 1;
         }
     } else {
-        frVector2 v1 = (maxIndex > 0) ? vertices->data[maxIndex - 1]
-                                      : vertices->data[vertices->count - 1];
+        frVector2 v1 = (maxIndex > 0) ? vertices[maxIndex - 1]
+                                      : vertices[vertexCount - 1];
 
-        frVector2 v2 = vertices->data[maxIndex];
+        frVector2 v2 = vertices[maxIndex];
 
         frVector2 edgeVector = frVector2Subtract(v2, v1);
 
@@ -426,7 +3217,7 @@ static bool frComputeCollisionCirclePoly(const frShape *s1,
 
             if (collision != NULL) {
                 collision->direction = frVector2Negate(
-                    frVector2RotateTx(normals->data[maxIndex], polyTx));
+                    frVector2RotateTx(normals[maxIndex], polyTx));
 
                 if (frVector2Dot(deltaPosition, collision->direction) < 0.0f)
                     collision->direction = frVector2Negate(
@@ -484,8 +3275,6 @@ static bool frComputeCollisionPolys(const frShape *s1,
 
         frEdge refEdge = e1, incEdge = e2;
 
-        frTransform refTx = tx1, incTx = tx2;
-
         frVector2 edgeVector1 = frVector2Subtract(e1.data[1], e1.data[0]);
         frVector2 edgeVector2 = frVector2Subtract(e2.data[1], e2.data[0]);
 
@@ -496,7 +3285,6 @@ static bool frComputeCollisionPolys(const frShape *s1,
 
         if (fabsf(edgeDot1) > fabsf(edgeDot2)) {
             refEdge = e2, incEdge = e1;
-            refTx = tx2, incTx = tx1;
 
             refEdgeFlipped = true;
         }
@@ -575,89 +3363,436 @@ static bool frComputeIntersectionCircleLine(frVector2 center,
     return (dot >= 0.0f && baseSqr >= 0.0f);
 }
 
-/* Computes the intersection of two lines. */
-static bool frComputeIntersectionLines(frVector2 origin1,
-                                       frVector2 direction1,
-                                       frVector2 origin2,
-                                       frVector2 direction2,
-                                       float *distance) {
-    float rXs = frVector2Cross(direction1, direction2);
+/* 
+    Finds the closest points between the line segment from `p1` to `q1` 
+    and the line segment from `p2` to `q2`, then stores their positions 
+    along each line segment (from `0` to `1`) to `f1` and `f2`.
+*/
+static void frComputeSegmentClosestPoints(frVector2 p1,
+                                          frVector2 q1,
+                                          frVector2 p2,
+                                          frVector2 q2,
+                                          float *f1,
+                                          float *f2) {
+    // NOTE: "Real-Time Collision Detection" by Christer Ericson, p. 149.
+    frVector2 d1 = frVector2Subtract(q1, p1), d2 = frVector2Subtract(q2, p2);
+    frVector2 r = frVector2Subtract(p1, p2);
+
+    float a = frVector2Dot(d1, d1), e = frVector2Dot(d2, d2);
+    float f = frVector2Dot(d2, r);
+
+    float s = 0.0f, t = 0.0f;
+
+    if (a <= FLT_EPSILON && e <= FLT_EPSILON) {
+        s = t = 0.0f;
+    } else if (a <= FLT_EPSILON) {
+        s = 0.0f, t = fminf(fmaxf(f / e, 0.0f), 1.0f);
+    } else {
+        float c = frVector2Dot(d1, r);
 
-    frVector2 qp = frVector2Subtract(origin2, origin1);
+        if (e <= FLT_EPSILON) {
+            t = 0.0f, s = fminf(fmaxf(-c / a, 0.0f), 1.0f);
+        } else {
+            float b = frVector2Dot(d1, d2), denominator = a * e - b * b;
 
-    float qpXs = frVector2Cross(qp, direction2);
-    float qpXr = frVector2Cross(qp, direction1);
+            // NOTE: If the line segments are parallel, any `s` will do.
+            if (denominator > 0.0f)
+                s = fminf(fmaxf((b * f - c * e) / denominator, 0.0f), 1.0f);
 
-    if (rXs != 0.0f) {
-        float inverseRxS = 1.0f / rXs;
+            t = (b * s + f) / e;
 
-        float t = qpXs * inverseRxS, u = qpXr * inverseRxS;
+            if (t < 0.0f)
+                t = 0.0f, s = fminf(fmaxf(-c / a, 0.0f), 1.0f);
+            else if (t > 1.0f)
+                t = 1.0f, s = fminf(fmaxf((b - c) / a, 0.0f), 1.0f);
+        }
+    }
 
-        if ((t >= 0.0f && t <= 1.0f) && (u >= 0.0f && u <= 1.0f)) {
-            if (distance != NULL) *distance = t;
+    *f1 = s, *f2 = t;
+}
 
-            return true;
+/* 
+    Sweeps `proxy1` along `translation` against `proxy2`, then stores 
+    the information about the first time of impact to `raycastHit`, 
+    assuming `proxy1` and `proxy2` are not overlapping.
+*/
+static bool frComputeProxyCast(const frShapeProxy *proxy1,
+                               frVector2 translation,
+                               const frShapeProxy *proxy2,
+                               frRaycastHit *raycastHit) {
+    /*
+        NOTE: Sweeping `proxy1` along `translation` is the same as casting 
+        a ray from the origin along `translation` against the Minkowski 
+        difference `proxy2 - proxy1`, which is done here with the GJK-based ray 
+        casting algorithm by Gino van den Bergen.
+    */
+
+    float radius = proxy1->radius + proxy2->radius;
+
+    frSimplex simplex = { .count = 0 };
+
+    frVector2 point = frStructZero(frVector2), normal = frStructZero(frVector2);
+
+    frVector2 v;
+
+    {
+        int index1, index2;
+
+        frVector2 direction = frVector2Subtract(proxy1->position,
+                                                proxy2->position);
+
+        point = frGetProxySupportPoint(proxy2, direction, &index2);
+
+        v = frVector2Subtract(
+            frGetProxySupportPoint(proxy1, frVector2Negate(direction), &index1),
+            point);
+    }
+
+    float targetDistance = radius + SHAPE_CAST_TARGET_DISTANCE, t = 0.0f;
+
+    for (int i = 0; i < GJK_MAX_ITERATION_COUNT; i++) {
+        float magnitude = frVector2Magnitude(v);
+
+        if (magnitude - targetDistance <= 0.25f * SHAPE_CAST_TARGET_DISTANCE)
+            break;
+
+        frSimplexVertex *vertex = &simplex.vertices[simplex.count];
+
+        vertex->point1 = frGetProxySupportPoint(proxy1,
+                                                frVector2Negate(v),
+                                                &vertex->index1);
+
+        vertex->point2 = frGetProxySupportPoint(proxy2,
+                                                v,
+                                                &vertex->index2);
+
+        frVector2 w = frVector2Subtract(
+            frVector2ScalarMultiply(translation, t),
+            frVector2Subtract(vertex->point2, vertex->point1));
+
+        float vDotW = frVector2Dot(v, w) - targetDistance * magnitude;
+        float vDotR = frVector2Dot(v, translation);
+
+        // NOTE: The ray can be advanced up to the plane of `v` and `w`.
+        if (vDotW > 0.0f) {
+            if (vDotR >= 0.0f) return false;
+
+            t -= vDotW / vDotR;
+
+            if (t > 1.0f) return false;
+
+            normal = v;
+
+            // NOTE: The simplex is rebuilt around the new ray position.
+            simplex.vertices[0] = *vertex, simplex.count = 0;
+
+            vertex = &simplex.vertices[0];
         }
 
-        return false;
+        vertex->point = frVector2Subtract(
+            frVector2ScalarMultiply(translation, t),
+            frVector2Subtract(vertex->point2, vertex->point1));
+
+        simplex.count++;
+
+        frSolveSimplex(&simplex);
+
+        v = frStructZero(frVector2), point = frStructZero(frVector2);
+
+        for (int j = 0; j < simplex.count; j++) {
+            v = frVector2Add(
+                v,
+                frVector2ScalarMultiply(simplex.vertices[j].point,
+                                        simplex.vertices[j].weight));
+
+            point = frVector2Add(
+                point,
+                frVector2ScalarMultiply(simplex.vertices[j].point2,
+                                        simplex.vertices[j].weight));
+        }
+
+        // NOTE: The cores of `proxy1` and `proxy2` are overlapping.
+        if (simplex.count == 3) break;
+    }
+
+    if (raycastHit != NULL) {
+        if (frVector2MagnitudeSqr(v) > FLT_EPSILON * FLT_EPSILON) normal = v;
+
+        if (frVector2MagnitudeSqr(normal) <= 0.0f)
+            normal = frVector2Negate(translation);
+
+        raycastHit->normal = frVector2Normalize(normal);
+
+        raycastHit->point = frVector2Add(
+            point,
+            frVector2ScalarMultiply(raycastHit->normal,
+                                    proxy2->radius));
+
+        raycastHit->distance = t * frVector2Magnitude(translation);
+        raycastHit->inside = false;
+    }
+
+    return true;
+}
+
+/* 
+    Computes the distance between `proxy1` and `proxy2`, then stores 
+    the closest points on `proxy1` and `proxy2` to `p1` and `p2`.
+*/
+static float frComputeProxyDistance(const frShapeProxy *proxy1,
+                                    const frShapeProxy *proxy2,
+                                    frVector2 *p1,
+                                    frVector2 *p2) {
+    frSimplex simplex = { .count = 1 };
+
+    {
+        frSimplexVertex *vertex = &simplex.vertices[0];
+
+        frVector2 direction = frVector2Subtract(proxy2->position,
+                                                proxy1->position);
+
+        vertex->point1 = frGetProxySupportPoint(proxy1,
+                                                direction,
+                                                &vertex->index1);
+
+        vertex->point2 = frGetProxySupportPoint(proxy2,
+                                                frVector2Negate(direction),
+                                                &vertex->index2);
+
+        vertex->point = frVector2Subtract(vertex->point2, vertex->point1);
+        vertex->weight = 1.0f;
+    }
+
+    /*
+        NOTE: The simplex lives in the Minkowski difference 
+        `proxy2 - proxy1`, so the distance between `proxy1` and `proxy2` 
+        is the distance from the origin to the closest point of 
+        that difference.
+    */
+    for (int i = 0; i < GJK_MAX_ITERATION_COUNT; i++) {
+        frSimplex oldSimplex = simplex;
+
+        frSolveSimplex(&simplex);
+
+        if (simplex.count == 3) break;
+
+        frVector2 direction;
+
+        if (simplex.count == 1) {
+            direction = frVector2Negate(simplex.vertices[0].point);
+        } else {
+            frVector2 edgeVector = frVector2Subtract(
+                simplex.vertices[1].point, simplex.vertices[0].point);
+
+            float sign = frVector2Cross(
+                edgeVector, frVector2Negate(simplex.vertices[0].point));
+
+            direction = (sign > 0.0f)
+                            ? (frVector2) { .x = -edgeVector.y,
+                                            .y = edgeVector.x }
+                            : (frVector2) { .x = edgeVector.y,
+                                            .y = -edgeVector.x };
+        }
+
+        // NOTE: The origin lies on the simplex, so they touch.
+        if (frVector2MagnitudeSqr(direction) < FLT_EPSILON * FLT_EPSILON)
+            break;
+
+        frSimplexVertex *vertex = &simplex.vertices[simplex.count];
+
+        vertex->point1 = frGetProxySupportPoint(proxy1,
+                                                frVector2Negate(direction),
+                                                &vertex->index1);
+
+        vertex->point2 = frGetProxySupportPoint(proxy2,
+                                                direction,
+                                                &vertex->index2);
+
+        vertex->point = frVector2Subtract(vertex->point2, vertex->point1);
+
+        bool duplicate = false;
+
+        // NOTE: A vertex that is already in the simplex means no progress.
+        for (int j = 0; j < oldSimplex.count; j++)
+            if (oldSimplex.vertices[j].index1 == vertex->index1
+                && oldSimplex.vertices[j].index2 == vertex->index2) {
+                duplicate = true;
+
+                break;
+            }
+
+        if (duplicate) break;
+
+        simplex.count++;
+    }
+
+    frVector2 closestPoint1 = frStructZero(frVector2);
+    frVector2 closestPoint2 = frStructZero(frVector2);
+
+    for (int i = 0; i < simplex.count; i++) {
+        const frSimplexVertex *vertex = &simplex.vertices[i];
+
+        closestPoint1 = frVector2Add(
+            closestPoint1,
+            frVector2ScalarMultiply(vertex->point1, vertex->weight));
+
+        closestPoint2 = frVector2Add(
+            closestPoint2,
+            frVector2ScalarMultiply(vertex->point2, vertex->weight));
+    }
+
+    if (simplex.count == 3) closestPoint2 = closestPoint1;
+
+    float distance = frVector2Distance(closestPoint1, closestPoint2);
+
+    float radius1 = proxy1->radius;
+    float radius2 = proxy2->radius;
+
+    // NOTE: The radii of 'circle' and 'capsule' shapes are applied last.
+    if (distance > radius1 + radius2 && distance > FLT_EPSILON) {
+        frVector2 direction = frVector2ScalarMultiply(
+            frVector2Subtract(closestPoint2, closestPoint1), 1.0f / distance);
+
+        closestPoint1 = frVector2Add(
+            closestPoint1, frVector2ScalarMultiply(direction, radius1));
+
+        closestPoint2 = frVector2Subtract(
+            closestPoint2, frVector2ScalarMultiply(direction, radius2));
+
+        distance -= radius1 + radius2;
     } else {
-        if (qpXr != 0.0f) return 0;
+        closestPoint1 = closestPoint2 = frVector2ScalarMultiply(
+            frVector2Add(closestPoint1, closestPoint2), 0.5f);
 
-        float rDr = frVector2Dot(direction1, direction1);
-        float sDr = frVector2Dot(direction2, direction1);
+        distance = 0.0f;
+    }
+
+    if (p1 != NULL) *p1 = closestPoint1;
+    if (p2 != NULL) *p2 = closestPoint2;
+
+    return distance;
+}
 
-        float inverseRdR = 1.0f / rDr;
+/* 
+    Updates `simplex` to the smallest sub-simplex that contains 
+    the point closest to the origin, along with its barycentric weights.
+*/
+static void frSolveSimplex(frSimplex *simplex) {
+    frSimplexVertex *vertices = simplex->vertices;
 
-        float qpDr = frVector2Dot(qp, direction1);
+    if (simplex->count == 1) {
+        vertices[0].weight = 1.0f;
+    } else if (simplex->count == 2) {
+        frVector2 w1 = vertices[0].point, w2 = vertices[1].point;
 
-        float k, t0 = qpDr * inverseRdR, t1 = t0 + sDr * inverseRdR;
+        frVector2 e12 = frVector2Subtract(w2, w1);
 
-        if (sDr < 0.0f) k = t0, t0 = t1, t1 = k;
+        float d12_1 = frVector2Dot(w2, e12), d12_2 = -frVector2Dot(w1, e12);
 
-        if ((t0 < 0.0f && t1 == 0.0f) || (t0 == 1.0f && t1 > 1.0f)) {
-            if (distance != NULL) *distance = (t0 == 1.0f);
+        if (d12_2 <= 0.0f) {
+            vertices[0].weight = 1.0f, simplex->count = 1;
+        } else if (d12_1 <= 0.0f) {
+            vertices[1].weight = 1.0f, simplex->count = 1;
+
+            vertices[0] = vertices[1];
+        } else {
+            float inverseSum = 1.0f / (d12_1 + d12_2);
 
-            return 1;
+            vertices[0].weight = d12_1 * inverseSum;
+            vertices[1].weight = d12_2 * inverseSum;
         }
+    } else if (simplex->count == 3) {
+        frVector2 w1 = vertices[0].point, w2 = vertices[1].point,
+                  w3 = vertices[2].point;
+
+        frVector2 e12 = frVector2Subtract(w2, w1);
+        frVector2 e13 = frVector2Subtract(w3, w1);
+        frVector2 e23 = frVector2Subtract(w3, w2);
+
+        float d12_1 = frVector2Dot(w2, e12), d12_2 = -frVector2Dot(w1, e12);
+        float d13_1 = frVector2Dot(w3, e13), d13_2 = -frVector2Dot(w1, e13);
+        float d23_1 = frVector2Dot(w3, e23), d23_2 = -frVector2Dot(w2, e23);
+
+        float n123 = frVector2Cross(e12, e13);
+
+        float d123_1 = n123 * frVector2Cross(w2, w3);
+        float d123_2 = n123 * frVector2Cross(w3, w1);
+        float d123_3 = n123 * frVector2Cross(w1, w2);
+
+        /*
+            NOTE: Each branch below checks one of the Voronoi regions 
+            of the triangle (three vertices, three edges and the interior).
+        */
+        if (d12_2 <= 0.0f && d13_2 <= 0.0f) {
+            vertices[0].weight = 1.0f, simplex->count = 1;
+        } else if (d12_1 > 0.0f && d12_2 > 0.0f && d123_3 <= 0.0f) {
+            float inverseSum = 1.0f / (d12_1 + d12_2);
+
+            vertices[0].weight = d12_1 * inverseSum;
+            vertices[1].weight = d12_2 * inverseSum;
+
+            simplex->count = 2;
+        } else if (d13_1 > 0.0f && d13_2 > 0.0f && d123_2 <= 0.0f) {
+            float inverseSum = 1.0f / (d13_1 + d13_2);
+
+            vertices[0].weight = d13_1 * inverseSum;
+            vertices[2].weight = d13_2 * inverseSum;
+
+            vertices[1] = vertices[2], simplex->count = 2;
+        } else if (d12_1 <= 0.0f && d23_2 <= 0.0f) {
+            vertices[1].weight = 1.0f, simplex->count = 1;
+
+            vertices[0] = vertices[1];
+        } else if (d13_1 <= 0.0f && d23_1 <= 0.0f) {
+            vertices[2].weight = 1.0f, simplex->count = 1;
+
+            vertices[0] = vertices[2];
+        } else if (d23_1 > 0.0f && d23_2 > 0.0f && d123_1 <= 0.0f) {
+            float inverseSum = 1.0f / (d23_1 + d23_2);
+
+            vertices[1].weight = d23_1 * inverseSum;
+            vertices[2].weight = d23_2 * inverseSum;
+
+            vertices[0] = vertices[2], simplex->count = 2;
+        } else {
+            float inverseSum = 1.0f / (d123_1 + d123_2 + d123_3);
 
-        return (t1 >= 0.0f && t0 <= 1.0f);
+            vertices[0].weight = d123_1 * inverseSum;
+            vertices[1].weight = d123_2 * inverseSum;
+            vertices[2].weight = d123_3 * inverseSum;
+        }
     }
 }
 
 /* Returns the edge of `s` that is most perpendicular to `v`. */
 static frEdge frGetContactEdge(const frShape *s, frTransform tx, frVector2 v) {
-    const frVertices *vertices = frGetPolygonVertices(s);
+    const frVector2 *vertices = frGetPolygonVertices(s);
+
+    int vertexCount = frGetPolygonVertexCount(s);
 
-    int supportIndex = frGetSupportPointIndex(vertices, tx, v);
+    int supportIndex = frGetPolygonSupportIndex(s, tx, v);
 
-    int prevIndex = (supportIndex == 0) ? vertices->count - 1
-                                        : supportIndex - 1;
-    int nextIndex = (supportIndex == vertices->count - 1) ? 0
-                                                          : supportIndex + 1;
+    int prevIndex = (supportIndex == 0) ? vertexCount - 1 : supportIndex - 1;
+    int nextIndex = (supportIndex == vertexCount - 1) ? 0 : supportIndex + 1;
 
     frVector2 prevEdgeVector = frVector2Normalize(
-        frVector2Subtract(vertices->data[supportIndex],
-                          vertices->data[prevIndex]));
+        frVector2Subtract(vertices[supportIndex], vertices[prevIndex]));
 
     frVector2 nextEdgeVector = frVector2Normalize(
-        frVector2Subtract(vertices->data[supportIndex],
-                          vertices->data[nextIndex]));
+        frVector2Subtract(vertices[supportIndex], vertices[nextIndex]));
 
     v = frVector2Rotate(v, -tx.angle);
 
-    frVector2 supportVertex = frVector2Transform(vertices->data[supportIndex],
-                                                 tx);
+    frVector2 supportVertex = frVector2Transform(vertices[supportIndex], tx);
 
     if (frVector2Dot(prevEdgeVector, v) < frVector2Dot(nextEdgeVector, v)) {
-        frVector2 prevVertex = frVector2Transform(vertices->data[prevIndex],
-                                                  tx);
+        frVector2 prevVertex = frVector2Transform(vertices[prevIndex], tx);
 
         return (frEdge) { .data = { prevVertex, supportVertex, supportVertex },
                           .indices = { prevIndex, supportIndex },
                           .count = 2 };
     } else {
-        frVector2 nextVertex = frVector2Transform(vertices->data[nextIndex],
-                                                  tx);
+        frVector2 nextVertex = frVector2Transform(vertices[nextIndex], tx);
 
         return (frEdge) { .data = { supportVertex, nextVertex, supportVertex },
                           .indices = { supportIndex, nextIndex },
@@ -665,33 +3800,64 @@ static frEdge frGetContactEdge(const frShape *s, frTransform tx, frVector2 v) {
     }
 }
 
+/* Returns the AABB of `aabb` in the local space of the transform `tx`. */
+static frAABB frGetLocalAABB(frAABB aabb, frTransform tx) {
+    frVector2 minVertex = { .x = FLT_MAX, .y = FLT_MAX };
+    frVector2 maxVertex = { .x = -FLT_MAX, .y = -FLT_MAX };
+
+    for (int i = 0; i < 4; i++) {
+        frVector2 v = frVector2Subtract(
+            (frVector2) { .x = aabb.x + ((i & 1) ? aabb.width : 0.0f),
+                          .y = aabb.y + ((i & 2) ? aabb.height : 0.0f) },
+            tx.position);
+
+        v = (frVector2) {
+            .x = v.x * tx.rotation.cos_ + v.y * tx.rotation.sin_,
+            .y = v.y * tx.rotation.cos_ - v.x * tx.rotation.sin_
+        };
+
+        if (minVertex.x > v.x) minVertex.x = v.x;
+        if (minVertex.y > v.y) minVertex.y = v.y;
+
+        if (maxVertex.x < v.x) maxVertex.x = v.x;
+        if (maxVertex.y < v.y) maxVertex.y = v.y;
+    }
+
+    return (frAABB) { .x = minVertex.x,
+                      .y = minVertex.y,
+                      .width = maxVertex.x - minVertex.x,
+                      .height = maxVertex.y - minVertex.y };
+}
+
 /* Finds the axis of minimum penetration, then returns its index. */
 static int frGetSeparatingAxisIndex(const frShape *s1,
                                     frTransform tx1,
                                     const frShape *s2,
                                     frTransform tx2,
                                     float *depth) {
-    const frVertices *vertices1 = frGetPolygonVertices(s1);
-    const frVertices *vertices2 = frGetPolygonVertices(s2);
+    const frVector2 *vertices1 = frGetPolygonVertices(s1);
+    const frVector2 *vertices2 = frGetPolygonVertices(s2);
 
-    const frVertices *normals1 = frGetPolygonNormals(s1);
+    const frVector2 *normals1 = frGetPolygonNormals(s1);
+
+    int vertexCount1 = frGetPolygonVertexCount(s1);
 
     float maxDepth = -FLT_MAX;
 
     int maxIndex = -1;
 
-    for (int i = 0; i < normals1->count; i++) {
-        frVector2 vertex = frVector2Transform(vertices1->data[i], tx1);
-        frVector2 normal = frVector2RotateTx(normals1->data[i], tx1);
+    for (int i = 0; i < vertexCount1; i++) {
+        frVector2 vertex = frVector2Transform(vertices1[i], tx1);
+        frVector2 normal = frVector2RotateTx(normals1[i], tx1);
 
-        int supportIndex = frGetSupportPointIndex(vertices2,
+        int supportIndex = frGetPolygonSupportIndex(s2,
                                                   tx2,
                                                   frVector2Negate(normal));
 
         if (supportIndex < 0) return supportIndex;
 
-        frVector2 supportPoint =
-            frVector2Transform(vertices2->data[supportIndex], tx2);
+        frVector2 supportPoint = frVector2Transform(vertices2[supportIndex],
+                                                    tx2);
 
         float depth = frVector2Dot(normal,
                                    frVector2Subtract(supportPoint, vertex));
@@ -704,21 +3870,230 @@ static int frGetSeparatingAxisIndex(const frShape *s1,
     return maxIndex;
 }
 
-/* Returns the index of the vertex farthest along `v`. */
-static int frGetSupportPointIndex(const frVertices *vertices,
-                                  frTransform tx,
-                                  frVector2 v) {
-    float maxDot = -FLT_MAX;
+/* 
+    Returns the radius of `s` around its core, which is a point for 
+    a 'circle' collision shape, a line segment for a 'capsule' collision 
+    shape and the shape itself for a 'polygon' collision shape.
+*/
+static float frGetShapeCoreRadius(const frShape *s) {
+    switch (frGetShapeType(s)) {
+        case FR_SHAPE_CIRCLE:
+            return frGetCircleRadius(s);
 
-    int maxIndex = -1;
+        case FR_SHAPE_CAPSULE:
+            return frGetCapsuleRadius(s);
 
-    v = frVector2Rotate(v, -tx.angle);
+        default:
+            return 0.0f;
+    }
+}
 
-    for (int i = 0; i < vertices->count; i++) {
-        float dot = frVector2Dot(vertices->data[i], v);
+/* 
+    Computes the endpoints of the line segment of `s` with the transform
+    `tx`, treating a 'circle' collision shape as a zero-length line segment.
+*/
+static void frGetShapeSegment(const frShape *s,
+                              frTransform tx,
+                              frVector2 *v1,
+                              frVector2 *v2) {
+    if (frGetShapeType(s) == FR_SHAPE_CAPSULE) {
+        float halfLength = 0.5f * frGetCapsuleLength(s);
+
+        *v1 = frVector2Transform((frVector2) { .y = -halfLength }, tx);
+        *v2 = frVector2Transform((frVector2) { .y = halfLength }, tx);
+    } else {
+        *v1 = *v2 = tx.position;
+    }
+}
 
-        if (maxDot < dot) maxDot = dot, maxIndex = i;
+/* 
+    Returns the point of `s` farthest along `v`, ignoring the radius of
+    a 'circle' or 'capsule' collision shape, then stores its index to `index`.
+*/
+static frVector2 frGetShapeSupportPoint(const frShape *s,
+                                        frTransform tx,
+                                        frVector2 v,
+                                        int *index) {
+    if (frGetShapeType(s) == FR_SHAPE_POLYGON) {
+        *index = frGetPolygonSupportIndex(s, tx, v);
+
+        return frVector2Transform(frGetPolygonVertices(s)[*index], tx);
+    } else if (frGetShapeType(s) == FR_SHAPE_CAPSULE) {
+        frVector2 v1, v2;
+
+        frGetShapeSegment(s, tx, &v1, &v2);
+
+        *index = (frVector2Dot(v2, v) > frVector2Dot(v1, v));
+
+        return (*index > 0) ? v2 : v1;
+    } else {
+        *index = 0;
+
+        return tx.position;
     }
+}
 
-    return maxIndex;
+/* 
+    Returns the point of `proxy` farthest along `v`, ignoring its radius, 
+    then stores its index to `index`.
+*/
+static frVector2 frGetProxySupportPoint(const frShapeProxy *proxy,
+                                        frVector2 v,
+                                        int *index) {
+    if (proxy->shape != NULL)
+        return frGetShapeSupportPoint(proxy->shape, proxy->tx, v, index);
+
+    *index = (frVector2Dot(proxy->vertices[1], v)
+              > frVector2Dot(proxy->vertices[0], v));
+
+    return proxy->vertices[*index];
+}
+
+/* Returns the proxy of the line segment from `v1` to `v2`. */
+static frShapeProxy frGetSegmentProxy(frVector2 v1, frVector2 v2) {
+    return (frShapeProxy) {
+        .position = frVector2ScalarMultiply(frVector2Add(v1, v2), 0.5f),
+        .vertices = { v1, v2 }
+    };
+}
+
+/* Returns the proxy of `s` with the transform `tx`. */
+static frShapeProxy frGetShapeProxy(const frShape *s, frTransform tx) {
+    return (frShapeProxy) { .shape = s,
+                            .tx = tx,
+                            .position = tx.position,
+                            .radius = frGetShapeCoreRadius(s) };
+}
+
+/* 
+    Returns the index of the vertex farthest along `v` by climbing 
+    the 'hill' formed by the `vertices` of a convex polygon, 
+    or `-1` if the search has failed.
+*/
+static int frGetSupportPointIndexHill(const frVector2 *vertices,
+                                      int vertexCount,
+                                      frVector2 v) {
+    /*
+        NOTE: The dot products of `v` and the vertices of a convex polygon
+        rise and fall exactly once around the polygon, so the hilltop 
+        can be found by binary search, using the direction of the edges 
+        adjacent to each sampled vertex.
+
+        http://geomalgorithms.com/a14-_extreme_pts.html
+    */
+
+#define frGetVertexDot(i)  frVector2Dot(vertices[(i) % vertexCount], v)
+
+    int a = 0, b = vertexCount;
+
+    float dotA = frGetVertexDot(0);
+
+    bool upA = (frGetVertexDot(1) > dotA);
+
+    if (!upA && !(frGetVertexDot(vertexCount - 1) > dotA)) return 0;
+
+    for (;;) {
+        int c = (a + b) >> 1;
+
+        float dotC = frGetVertexDot(c);
+
+        bool upC = (frGetVertexDot(c + 1) > dotC);
+
+        if (!upC && !(frGetVertexDot(c - 1) > dotC)) return c;
+
+        if (upA) {
+            if (!upC || dotA > dotC) b = c;
+            else a = c, dotA = dotC, upA = upC;
+        } else {
+            if (upC || dotA >= dotC) a = c, dotA = dotC, upA = upC;
+            else b = c;
+        }
+
+        if (b <= a + 1) return -1;
+    }
+
+#undef frGetVertexDot
+}
+
+/* 
+    Returns the transform of the rectangle of solid tiles with the given 
+    `i`ndex, assuming `tilemap` is a 'tilemap' collision shape with 
+    the transform `tx`.
+*/
+static frTransform frGetTilemapRectTransform(const frShape *tilemap,
+                                             frTransform tx,
+                                             int i) {
+    frAABB rect = frGetTilemapRect(tilemap, i);
+
+    tx.position = frVector2Transform(
+        (frVector2) { .x = rect.x + 0.5f * rect.width,
+                      .y = rect.y + 0.5f * rect.height },
+        tx);
+
+    return tx;
+}
+
+/* Returns `true` if `s` is a 'chain' or 'heightfield' collision shape. */
+static bool frIsChainShape(const frShape *s) {
+    frShapeType type = frGetShapeType(s);
+
+    return (type == FR_SHAPE_CHAIN || type == FR_SHAPE_HEIGHTFIELD);
+}
+
+/* 
+    Reduces the first `count` elements of `contacts` to the contact points 
+    of a single collision, then stores the collision information to 
+    `collision`, with the opposite direction if `flip` is `true`.
+*/
+static void frReduceChainContacts(const frChainContact *contacts,
+                                  int count,
+                                  bool flip,
+                                  frCollision *collision) {
+    int index1 = 0, index2 = -1;
+
+    for (int i = 1; i < count; i++)
+        if (contacts[index1].contact.depth < contacts[i].contact.depth)
+            index1 = i;
+
+    frVector2 direction = contacts[index1].direction;
+
+    /*
+        NOTE: The contacts from all line segments (or rectangles) are 
+        reduced to the deepest contact and the farthest contact from it 
+        in roughly the same direction.
+    */
+    float maxDistanceSqr = CHAIN_MANIFOLD_MIN_DISTANCE
+                           * CHAIN_MANIFOLD_MIN_DISTANCE;
+
+    for (int i = 0; i < count; i++) {
+        if (i == index1
+            || frVector2Dot(contacts[i].direction, direction)
+                   < CHAIN_MANIFOLD_NORMAL_TOLERANCE)
+            continue;
+
+        float distanceSqr = frVector2MagnitudeSqr(
+            frVector2Subtract(contacts[i].contact.point,
+                              contacts[index1].contact.point));
+
+        if (maxDistanceSqr < distanceSqr)
+            maxDistanceSqr = distanceSqr, index2 = i;
+    }
+
+    collision->direction = flip ? frVector2Negate(direction) : direction;
+
+    collision->contacts[0].id = contacts[index1].contact.id;
+    collision->contacts[0].point = contacts[index1].contact.point;
+    collision->contacts[0].depth = contacts[index1].contact.depth;
+
+    if (index2 >= 0) {
+        collision->contacts[1].id = contacts[index2].contact.id;
+        collision->contacts[1].point = contacts[index2].contact.point;
+        collision->contacts[1].depth = contacts[index2].contact.depth;
+
+        collision->count = 2;
+    } else {
+        collision->contacts[1] = collision->contacts[0];
+
+        collision->count = 1;
+    }
 }
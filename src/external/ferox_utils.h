@@ -29,6 +29,15 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* NOTE: The SSE2 code paths can be disabled by defining `FR_NO_SIMD`. */
+#if !defined(FR_NO_SIMD)                                 \
+    && (defined(__SSE2__) || defined(_M_X64)             \
+        || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define FR_USE_SSE2
+
+    #include <emmintrin.h>
+#endif
+
 /* Macros =================================================================> */
 
 /* Creates a bit array with `n` bits. */
@@ -51,6 +60,10 @@
 #define frBitArraySet(ba, i)  \
     ((ba)[(i)] = 1)
 
+/* Unsets the `i`-th bit of `ba`. */
+#define frBitArrayUnset(ba, i)  \
+    ((ba)[(i)] = 0)
+
 /* ========================================================================> */
 
 #define DSA_INIT_CAPACITY  8
@@ -26,14 +26,53 @@
 
 /* Typedefs ===============================================================> */
 
+/* 
+    A structure that represents a rectangle of solid tiles 
+    in a 'tilemap' collision shape.
+*/
+typedef struct frTileRect_ {
+    int width, height;
+    frShape *shape;
+} frTileRect;
+
+/* 
+    A structure that represents a child shape of a 'compound' collision 
+    shape, along with its transform relative to the 'compound' shape.
+*/
+typedef struct frCompoundChild_ {
+    const frShape *shape;
+    frTransform tx;
+} frCompoundChild;
+
 /* A union that represents the internal data of a collision shape. */
 typedef union frShapeData_ {
     struct {
         float radius;
     } circle;
     struct {
-        frVertices vertices, normals;
+        float halfLength, radius;
+    } capsule;
+    struct {
+        frVector2 *vertices, *normals;
+        int count, capacity;
     } polygon;
+    struct {
+        frVector2 *vertices, *normals;
+        frAABB *nodes;
+        int count, segmentCount, leafCount;
+        float spacing;
+    } chain;
+    struct {
+        frTileRect *rects;
+        int *owners;
+        int width, height;
+        float tileSize;
+    } tilemap;
+    struct {
+        frCompoundChild *children;
+        frAABB *nodes;
+        int count, leafCount;
+    } compound;
 } frShapeData;
 
 /* 
@@ -49,19 +88,88 @@ struct frShape_ {
 
 /* Private Function Prototypes ============================================> */
 
+/* 
+    Allocates a 'chain' (or 'heightfield') collision shape for `count` 
+    vertices, then connects the `vertices` with line segments, one after 
+    another (and the last one to the first one if `loop` is `true`).
+*/
+static frShape *frAllocateChain(frShapeType type,
+                                const frVector2 *vertices,
+                                int count,
+                                bool loop);
+
+/* 
+    Builds the inner nodes of a complete binary tree of bounding boxes 
+    with `leafCount` leaves, whose leaves are already stored in `nodes`.
+*/
+static void frBuildAABBTree(frAABB *nodes, int leafCount);
+
+/* 
+    Query a complete binary tree of bounding boxes with `leafCount` leaves
+    for the leaves that overlap `aabb`, in ascending order.
+*/
+static void frQueryAABBTree(const frAABB *nodes,
+                            int leafCount,
+                            frAABB aabb,
+                            frHashQueryFunc func,
+                            void *userData);
+
+/* Returns `true` if `s` is a 'chain' or 'heightfield' collision shape. */
+static bool frIsChainShape(const frShape *s);
+
+/* 
+    Merges the solid tiles of `s` that are given by `tiles` into 
+    rectangles, by extending each rectangle to the right first 
+    and then downward, assuming `s` is a 'tilemap' collision shape.
+*/
+static void frMergeTilemapTiles(frShape *s, const bool *tiles);
+
+/* 
+    Adds a rectangle of solid tiles to `s`, whose top-left tile is at 
+    column `x` and row `y`, assuming `s` is a 'tilemap' collision shape.
+*/
+static void frAddTilemapRect(frShape *s, int x, int y, int width, int height);
+
+/* 
+    Removes the rectangle of solid tiles with the given `i`ndex from `s`,
+    assuming `s` is a 'tilemap' collision shape.
+*/
+static void frRemoveTilemapRect(frShape *s, int i);
+
 /* 
     Computes the convex hull for the given `input` points 
     with the gift wrapping (a.k.a. Jarvis march) algorithm.
 */
 static void frJarvisMarch(const frVertices *input, frVertices *output);
 
+/* 
+    Allocates a collision shape, along with the storage for 
+    `vertexCount` vertices and normals right after the shape itself.
+*/
+static frShape *frAllocateShape(int vertexCount);
+
+/* Releases the memory allocated for the type-specific data of `s`. */
+static void frReleaseShapeData(frShape *s);
+
+/* 
+    Makes sure that `s` has enough storage for `vertexCount` vertices and
+    normals, assuming `s` is a 'polygon' collision shape.
+*/
+static bool frReservePolygonStorage(frShape *s, int vertexCount);
+
+/* 
+    Sets the vertices of `s` to the given convex `hull`,
+    assuming `s` is a 'polygon' collision shape.
+*/
+static void frSetPolygonHull(frShape *s, const frVertices *hull);
+
 /* Public Functions =======================================================> */
 
 /* Creates a 'circle' collision shape. */
 frShape *frCreateCircle(frMaterial material, float radius) {
     if (radius <= 0.0f) return NULL;
 
-    frShape *result = calloc(1, sizeof *result);
+    frShape *result = frAllocateShape(0);
 
     result->type = FR_SHAPE_CIRCLE;
     result->material = material;
@@ -71,11 +179,82 @@ frShape *frCreateCircle(frMaterial material, float radius) {
     return result;
 }
 
+/* 
+    Creates a 'capsule' collision shape, which is the set of points within 
+    `radius` of a line segment of `length` that lies along the y-axis.
+*/
+frShape *frCreateCapsule(frMaterial material, float length, float radius) {
+    if (length <= 0.0f || radius <= 0.0f) return NULL;
+
+    frShape *result = frAllocateShape(0);
+
+    result->type = FR_SHAPE_CAPSULE;
+    result->material = material;
+
+    frSetCapsuleDimensions(result, length, radius);
+
+    return result;
+}
+
+/* 
+    Creates a 'chain' collision shape, which connects `count` `vertices` 
+    with one-sided line segments (and the last vertex to the first one 
+    if `loop` is `true`), each of which only collides on its right side; 
+    for vertices given from left to right, the line segments collide 
+    with anything above them.
+*/
+frShape *frCreateChain(frMaterial material,
+                       const frVector2 *vertices,
+                       int count,
+                       bool loop) {
+    if (vertices == NULL || count < 2 || (loop && count < 3)) return NULL;
+
+    frShape *result = frAllocateChain(FR_SHAPE_CHAIN, vertices, count, loop);
+
+    if (result != NULL) result->material = material;
+
+    return result;
+}
+
+/* 
+    Creates a 'heightfield' collision shape, which is a 'chain' collision 
+    shape whose `count` vertices are placed `spacing` apart along 
+    the x-axis, with the given `heights` above (along -y) the x-axis.
+*/
+frShape *frCreateHeightfield(frMaterial material,
+                             const float *heights,
+                             int count,
+                             float spacing) {
+    if (heights == NULL || count < 2 || spacing <= 0.0f) return NULL;
+
+    frVector2 *vertices = malloc(count * sizeof *vertices);
+
+    if (vertices == NULL) return NULL;
+
+    for (int i = 0; i < count; i++)
+        vertices[i] = (frVector2) { .x = i * spacing, .y = -heights[i] };
+
+    frShape *result = frAllocateChain(FR_SHAPE_HEIGHTFIELD,
+                                      vertices,
+                                      count,
+                                      false);
+
+    free(vertices);
+
+    if (result == NULL) return NULL;
+
+    result->material = material;
+
+    result->data.chain.spacing = spacing;
+
+    return result;
+}
+
 /* Creates a 'rectangle' collision shape. */
 frShape *frCreateRectangle(frMaterial material, float width, float height) {
     if (width <= 0.0f || height <= 0.0f) return NULL;
 
-    frShape *result = calloc(1, sizeof *result);
+    frShape *result = frAllocateShape(4);
 
     result->type = FR_SHAPE_POLYGON;
     result->material = material;
@@ -94,22 +273,149 @@ frShape *frCreateRectangle(frMaterial material, float width, float height) {
     return result;
 }
 
+/* 
+    Creates a 'tilemap' collision shape from a `width` by `height` grid 
+    of square tiles with the given `tileSize`, where the tile at column `x` 
+    and row `y` covers the area from `(x, y) * tileSize` to 
+    `(x + 1, y + 1) * tileSize` and is solid if `tiles[y * width + x]` 
+    is `true`.
+*/
+frShape *frCreateTilemap(frMaterial material,
+                         const bool *tiles,
+                         int width,
+                         int height,
+                         float tileSize) {
+    if (tiles == NULL || width <= 0 || height <= 0 || tileSize <= 0.0f)
+        return NULL;
+
+    int tileCount = width * height;
+
+    /*
+        NOTE: The rectangles are stored at the index of their top-left 
+        tiles, right before the index of the rectangle that each tile
+        belongs to, in a single block that is never resized.
+    */
+    frTileRect *rects = calloc(tileCount, sizeof *rects + sizeof(int));
+
+    if (rects == NULL) return NULL;
+
+    frShape *result = frAllocateShape(0);
+
+    result->type = FR_SHAPE_TILEMAP;
+    result->material = material;
+
+    result->data.tilemap.rects = rects;
+    result->data.tilemap.owners = (int *) (rects + tileCount);
+
+    result->data.tilemap.width = width;
+    result->data.tilemap.height = height;
+
+    result->data.tilemap.tileSize = tileSize;
+
+    for (int i = 0; i < tileCount; i++)
+        result->data.tilemap.owners[i] = -1;
+
+    frMergeTilemapTiles(result, tiles);
+
+    return result;
+}
+
+/* 
+    Creates a 'compound' collision shape from `count` child `shapes`, each 
+    placed at the position and the angle of its `offset`, where the mass of 
+    each child shape comes from its own density and the friction and 
+    the restitution of `material` apply to the whole shape.
+*/
+frShape *frCreateCompound(frMaterial material,
+                          frShape **shapes,
+                          const frTransform *offsets,
+                          int count) {
+    if (shapes == NULL || offsets == NULL || count <= 0) return NULL;
+
+    // NOTE: Only convex collision shapes can be the children.
+    for (int i = 0; i < count; i++) {
+        frShapeType type = frGetShapeType(shapes[i]);
+
+        if (type != FR_SHAPE_CIRCLE && type != FR_SHAPE_POLYGON
+            && type != FR_SHAPE_CAPSULE)
+            return NULL;
+    }
+
+    int leafCount = 1;
+
+    while (leafCount < count)
+        leafCount <<= 1;
+
+    /*
+        NOTE: The children and the nodes of the tree are stored 
+        in a single block, which is never resized.
+    */
+    frCompoundChild *children = malloc(count * sizeof *children
+                                       + (2 * leafCount) * sizeof(frAABB));
+
+    if (children == NULL) return NULL;
+
+    frShape *result = frAllocateShape(0);
+
+    result->type = FR_SHAPE_COMPOUND;
+    result->material = material;
+
+    result->data.compound.children = children;
+    result->data.compound.nodes = (frAABB *) (children + count);
+
+    result->data.compound.count = count;
+    result->data.compound.leafCount = leafCount;
+
+    frAABB *nodes = result->data.compound.nodes;
+
+    for (int i = 0; i < leafCount; i++) {
+        if (i >= count) {
+            nodes[leafCount + i] = (frAABB) { .width = -1.0f };
+
+            continue;
+        }
+
+        frTransform tx = { .position = offsets[i].position,
+                           .rotation = { .sin_ = sinf(offsets[i].angle),
+                                         .cos_ = cosf(offsets[i].angle) },
+                           .angle = offsets[i].angle };
+
+        children[i] = (frCompoundChild) { .shape = shapes[i], .tx = tx };
+
+        nodes[leafCount + i] = frGetShapeAABB(shapes[i], tx);
+
+        result->area += frGetShapeArea(shapes[i]);
+    }
+
+    frBuildAABBTree(nodes, leafCount);
+
+    return result;
+}
+
 /* Creates a 'convex polygon' collision shape. */
 frShape *frCreatePolygon(frMaterial material, const frVertices *vertices) {
     if (vertices == NULL || vertices->count <= 0) return NULL;
 
-    frShape *result = calloc(1, sizeof *result);
+    frVertices hull = { .count = 0 };
+
+    frJarvisMarch(vertices, &hull);
+
+    frShape *result = frAllocateShape(hull.count);
 
     result->type = FR_SHAPE_POLYGON;
     result->material = material;
 
-    frSetPolygonVertices(result, vertices);
+    frSetPolygonHull(result, &hull);
 
     return result;
 }
 
 /* Releases the memory allocated by `s`. */
 void frReleaseShape(frShape *s) {
+    if (s == NULL) return;
+
+    frReleaseShapeData(s);
+
     free(s);
 }
 
@@ -145,26 +451,85 @@ float frGetShapeArea(const frShape *s) {
 
 /* Returns the mass of `s`. */
 float frGetShapeMass(const frShape *s) {
-    return (s != NULL) ? s->material.density * s->area : 0.0f;
+    if (s == NULL) return 0.0f;
+
+    if (s->type == FR_SHAPE_COMPOUND) {
+        float result = 0.0f;
+
+        for (int i = 0; i < s->data.compound.count; i++)
+            result += frGetShapeMass(s->data.compound.children[i].shape);
+
+        return result;
+    }
+
+    return s->material.density * s->area;
 }
 
 /* Returns the moment of inertia of `s`. */
 float frGetShapeInertia(const frShape *s) {
-    if (s == NULL || s->material.density <= 0.0f) return 0.0f;
+    if (s == NULL) return 0.0f;
+
+    if (s->type == FR_SHAPE_COMPOUND) {
+        float result = 0.0f;
+
+        /*
+            NOTE: The moment of inertia of each child shape is moved from 
+            its own origin to the origin of `s` with the parallel axis 
+            theorem, since a body always rotates around its position.
+        */
+        for (int i = 0; i < s->data.compound.count; i++) {
+            const frCompoundChild *child = &s->data.compound.children[i];
+
+            result += frGetShapeInertia(child->shape)
+                      + frGetShapeMass(child->shape)
+                            * frVector2MagnitudeSqr(child->tx.position);
+        }
+
+        return result;
+    }
+
+    if (s->material.density <= 0.0f) return 0.0f;
 
     if (s->type == FR_SHAPE_CIRCLE) {
         float radius = s->data.circle.radius;
 
         return 0.5f * frGetShapeMass(s) * (radius * radius);
+    } else if (s->type == FR_SHAPE_CAPSULE) {
+        float halfLength = s->data.capsule.halfLength;
+        float radius = s->data.capsule.radius;
+
+        float rectMass = s->material.density
+                         * (4.0f * halfLength * radius);
+        float circleMass = s->material.density * (M_PI * (radius * radius));
+
+        /*
+            NOTE: The two half-circles are moved from the center of `s` 
+            to the ends of its line segment with the parallel axis theorem,
+            where `centroid` is the distance from the center of each 
+            half-circle to its centroid.
+        */
+        float centroid = (4.0f * radius) / (3.0f * M_PI);
+
+        float rectInertia = rectMass
+                            * (4.0f * (halfLength * halfLength)
+                               + 4.0f * (radius * radius))
+                            / 12.0f;
+
+        float circleInertia = circleMass
+                              * (0.5f * (radius * radius)
+                                 + (halfLength * halfLength)
+                                 + 2.0f * halfLength * centroid);
+
+        return rectInertia + circleInertia;
     } else if (s->type == FR_SHAPE_POLYGON) {
         float numerator = 0.0f, denominator = 0.0f;
 
-        int vertexCount = s->data.polygon.vertices.count;
+        int vertexCount = s->data.polygon.count;
 
         // NOTE: https://en.wikipedia.org/wiki/List_of_moments_of_inertia
         for (int j = vertexCount - 1, i = 0; i < vertexCount; j = i, i++) {
-            frVector2 v1 = s->data.polygon.vertices.data[j];
-            frVector2 v2 = s->data.polygon.vertices.data[i];
+            frVector2 v1 = s->data.polygon.vertices[j];
+            frVector2 v2 = s->data.polygon.vertices[i];
 
             float cross = frVector2Cross(v1, v2),
                   dotSum = (frVector2Dot(v1, v1) + frVector2Dot(v1, v2)
@@ -189,13 +554,61 @@ frAABB frGetShapeAABB(const frShape *s, frTransform tx) {
             result.y = tx.position.y - s->data.circle.radius;
 
             result.width = result.height = 2.0f * s->data.circle.radius;
-        } else if (s->type == FR_SHAPE_POLYGON) {
+        } else if (s->type == FR_SHAPE_CAPSULE) {
+            float radius = s->data.capsule.radius;
+
+            frVector2 v1 = frVector2Transform(
+                (frVector2) { .y = -s->data.capsule.halfLength }, tx);
+
+            frVector2 v2 = frVector2Transform(
+                (frVector2) { .y = s->data.capsule.halfLength }, tx);
+
+            result.x = fminf(v1.x, v2.x) - radius;
+            result.y = fminf(v1.y, v2.y) - radius;
+
+            result.width = fabsf(v2.x - v1.x) + 2.0f * radius;
+            result.height = fabsf(v2.y - v1.y) + 2.0f * radius;
+        } else if (s->type == FR_SHAPE_POLYGON || frIsChainShape(s)) {
+            const frVector2 *vertices = (s->type == FR_SHAPE_POLYGON)
+                                            ? s->data.polygon.vertices
+                                            : s->data.chain.vertices;
+
+            int vertexCount = (s->type == FR_SHAPE_POLYGON)
+                                  ? s->data.polygon.count
+                                  : s->data.chain.count;
+
+            frVector2 minVertex = { .x = FLT_MAX, .y = FLT_MAX };
+            frVector2 maxVertex = { .x = -FLT_MAX, .y = -FLT_MAX };
+
+            for (int i = 0; i < vertexCount; i++) {
+                frVector2 v = frVector2Transform(vertices[i], tx);
+
+                if (minVertex.x > v.x) minVertex.x = v.x;
+                if (minVertex.y > v.y) minVertex.y = v.y;
+
+                if (maxVertex.x < v.x) maxVertex.x = v.x;
+                if (maxVertex.y < v.y) maxVertex.y = v.y;
+            }
+
+            result.x = minVertex.x;
+            result.y = minVertex.y;
+
+            result.width = maxVertex.x - minVertex.x;
+            result.height = maxVertex.y - minVertex.y;
+        } else if (s->type == FR_SHAPE_TILEMAP) {
+            float tileSize = s->data.tilemap.tileSize;
+
+            float width = s->data.tilemap.width * tileSize;
+            float height = s->data.tilemap.height * tileSize;
+
             frVector2 minVertex = { .x = FLT_MAX, .y = FLT_MAX };
             frVector2 maxVertex = { .x = -FLT_MAX, .y = -FLT_MAX };
 
-            for (int i = 0; i < s->data.polygon.vertices.count; i++) {
-                frVector2 v =
-                    frVector2Transform(s->data.polygon.vertices.data[i], tx);
+            for (int i = 0; i < 4; i++) {
+                frVector2 v = frVector2Transform(
+                    (frVector2) { .x = (i & 1) ? width : 0.0f,
+                                  .y = (i & 2) ? height : 0.0f },
+                    tx);
 
                 if (minVertex.x > v.x) minVertex.x = v.x;
                 if (minVertex.y > v.y) minVertex.y = v.y;
@@ -207,6 +620,29 @@ frAABB frGetShapeAABB(const frShape *s, frTransform tx) {
             result.x = minVertex.x;
             result.y = minVertex.y;
 
+            result.width = maxVertex.x - minVertex.x;
+            result.height = maxVertex.y - minVertex.y;
+        } else if (s->type == FR_SHAPE_COMPOUND) {
+            frVector2 minVertex = { .x = FLT_MAX, .y = FLT_MAX };
+            frVector2 maxVertex = { .x = -FLT_MAX, .y = -FLT_MAX };
+
+            for (int i = 0; i < s->data.compound.count; i++) {
+                frAABB aabb = frGetShapeAABB(
+                    s->data.compound.children[i].shape,
+                    frGetCompoundChildTransform(s, tx, i));
+
+                if (minVertex.x > aabb.x) minVertex.x = aabb.x;
+                if (minVertex.y > aabb.y) minVertex.y = aabb.y;
+
+                if (maxVertex.x < aabb.x + aabb.width)
+                    maxVertex.x = aabb.x + aabb.width;
+                if (maxVertex.y < aabb.y + aabb.height)
+                    maxVertex.y = aabb.y + aabb.height;
+            }
+
+            result.x = minVertex.x;
+            result.y = minVertex.y;
+
             result.width = maxVertex.x - minVertex.x;
             result.height = maxVertex.y - minVertex.y;
         }
@@ -221,21 +657,310 @@ float frGetCircleRadius(const frShape *s) {
                                                   : 0.0f;
 }
 
+/* 
+    Returns the length of the line segment of `s`, 
+    assuming `s` is a 'capsule' collision shape.
+*/
+float frGetCapsuleLength(const frShape *s) {
+    return (frGetShapeType(s) == FR_SHAPE_CAPSULE)
+               ? 2.0f * s->data.capsule.halfLength
+               : 0.0f;
+}
+
+/* Returns the radius of `s`, assuming `s` is a 'capsule' collision shape. */
+float frGetCapsuleRadius(const frShape *s) {
+    return (frGetShapeType(s) == FR_SHAPE_CAPSULE) ? s->data.capsule.radius
+                                                   : 0.0f;
+}
+
+/* 
+    Returns the number of vertices of `s`, 
+    assuming `s` is a 'chain' or 'heightfield' collision shape.
+*/
+int frGetChainVertexCount(const frShape *s) {
+    return frIsChainShape(s) ? s->data.chain.count : 0;
+}
+
+/* 
+    Returns the vertices of `s`, 
+    assuming `s` is a 'chain' or 'heightfield' collision shape.
+*/
+const frVector2 *frGetChainVertices(const frShape *s) {
+    return frIsChainShape(s) ? s->data.chain.vertices : NULL;
+}
+
+/* 
+    Returns the number of line segments of `s`, 
+    assuming `s` is a 'chain' or 'heightfield' collision shape.
+*/
+int frGetChainSegmentCount(const frShape *s) {
+    return frIsChainShape(s) ? s->data.chain.segmentCount : 0;
+}
+
+/* 
+    Returns the normals of the line segments of `s`, where the `i`-th 
+    line segment goes from the `i`-th vertex to the next vertex, 
+    assuming `s` is a 'chain' or 'heightfield' collision shape.
+*/
+const frVector2 *frGetChainNormals(const frShape *s) {
+    return frIsChainShape(s) ? s->data.chain.normals : NULL;
+}
+
+/* 
+    Query `s` for the line segments whose bounding boxes overlap `aabb`
+    (in the local space of `s`) in ascending order, assuming `s` is 
+    a 'chain' or 'heightfield' collision shape.
+*/
+void frQueryChainSegments(const frShape *s,
+                          frAABB aabb,
+                          frHashQueryFunc func,
+                          void *userData) {
+    if (!frIsChainShape(s) || func == NULL) return;
+
+    if (s->type == FR_SHAPE_HEIGHTFIELD) {
+        const frVector2 *vertices = s->data.chain.vertices;
+
+        /*
+            NOTE: The vertices of a 'heightfield' collision shape are
+            evenly spaced, so the line segments below `aabb` are found
+            without any search at all.
+        */
+        float inverseSpacing = 1.0f / s->data.chain.spacing;
+
+        float lastIndex = s->data.chain.segmentCount - 1;
+
+        float minIndex = floorf(aabb.x * inverseSpacing);
+        float maxIndex = floorf((aabb.x + aabb.width) * inverseSpacing);
+
+        if (maxIndex < 0.0f || minIndex > lastIndex) return;
+
+        minIndex = fmaxf(minIndex, 0.0f), maxIndex = fminf(maxIndex, lastIndex);
+
+        for (int i = (int) minIndex; i <= (int) maxIndex; i++) {
+            frVector2 v1 = vertices[i], v2 = vertices[i + 1];
+
+            if (fmaxf(v1.y, v2.y) < aabb.y
+                || fminf(v1.y, v2.y) > aabb.y + aabb.height)
+                continue;
+
+            func((frContextNode) { .id = i, .ctx = userData });
+        }
+
+        return;
+    }
+
+    // NOTE: The bounding boxes of the line segments form a binary tree.
+    frQueryAABBTree(s->data.chain.nodes,
+                    s->data.chain.leafCount,
+                    aabb,
+                    func,
+                    userData);
+}
+
+/* 
+    Returns the number of columns of `s`, 
+    assuming `s` is a 'tilemap' collision shape.
+*/
+int frGetTilemapWidth(const frShape *s) {
+    return (frGetShapeType(s) == FR_SHAPE_TILEMAP) ? s->data.tilemap.width
+                                                   : 0;
+}
+
+/* 
+    Returns the number of rows of `s`, 
+    assuming `s` is a 'tilemap' collision shape.
+*/
+int frGetTilemapHeight(const frShape *s) {
+    return (frGetShapeType(s) == FR_SHAPE_TILEMAP) ? s->data.tilemap.height
+                                                   : 0;
+}
+
+/* 
+    Returns the size of each tile of `s`, 
+    assuming `s` is a 'tilemap' collision shape.
+*/
+float frGetTilemapTileSize(const frShape *s) {
+    return (frGetShapeType(s) == FR_SHAPE_TILEMAP) ? s->data.tilemap.tileSize
+                                                   : 0.0f;
+}
+
+/* 
+    Returns `true` if the tile at column `x` and row `y` of `s` is solid, 
+    assuming `s` is a 'tilemap' collision shape.
+*/
+bool frGetTilemapTile(const frShape *s, int x, int y) {
+    if (frGetShapeType(s) != FR_SHAPE_TILEMAP || x < 0
+        || x >= s->data.tilemap.width || y < 0 || y >= s->data.tilemap.height)
+        return false;
+
+    return s->data.tilemap.owners[y * s->data.tilemap.width + x] >= 0;
+}
+
+/* 
+    Returns the bounds (in the local space of `s`) of the rectangle of 
+    solid tiles with the given `i`ndex, which is the index of its top-left 
+    tile, assuming `s` is a 'tilemap' collision shape.
+*/
+frAABB frGetTilemapRect(const frShape *s, int i) {
+    if (frGetTilemapRectShape(s, i) == NULL) return frStructZero(frAABB);
+
+    int width = s->data.tilemap.width;
+
+    float tileSize = s->data.tilemap.tileSize;
+
+    return (frAABB) { .x = (i % width) * tileSize,
+                      .y = (i / width) * tileSize,
+                      .width = s->data.tilemap.rects[i].width * tileSize,
+                      .height = s->data.tilemap.rects[i].height * tileSize };
+}
+
+/* 
+    Returns the 'polygon' collision shape of the rectangle of solid tiles 
+    with the given `i`ndex, whose origin lies at the center of 
+    the rectangle, assuming `s` is a 'tilemap' collision shape.
+*/
+const frShape *frGetTilemapRectShape(const frShape *s, int i) {
+    if (frGetShapeType(s) != FR_SHAPE_TILEMAP || i < 0
+        || i >= s->data.tilemap.width * s->data.tilemap.height)
+        return NULL;
+
+    return s->data.tilemap.rects[i].shape;
+}
+
+/* 
+    Query `s` for the rectangles of solid tiles that overlap `aabb` 
+    (in the local space of `s`) by looking up the tiles under `aabb`, 
+    assuming `s` is a 'tilemap' collision shape.
+*/
+void frQueryTilemapRects(const frShape *s,
+                         frAABB aabb,
+                         frHashQueryFunc func,
+                         void *userData) {
+    if (frGetShapeType(s) != FR_SHAPE_TILEMAP || func == NULL) return;
+
+    int width = s->data.tilemap.width, height = s->data.tilemap.height;
+
+    float inverseTileSize = 1.0f / s->data.tilemap.tileSize;
+
+    float minX = floorf(aabb.x * inverseTileSize);
+    float minY = floorf(aabb.y * inverseTileSize);
+
+    float maxX = floorf((aabb.x + aabb.width) * inverseTileSize);
+    float maxY = floorf((aabb.y + aabb.height) * inverseTileSize);
+
+    if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height)
+        return;
+
+    int minColumn = (int) fmaxf(minX, 0.0f);
+    int minRow = (int) fmaxf(minY, 0.0f);
+
+    int maxColumn = (int) fminf(maxX, width - 1);
+    int maxRow = (int) fminf(maxY, height - 1);
+
+    for (int y = minRow; y <= maxRow; y++)
+        for (int x = minColumn; x <= maxColumn; x++) {
+            int owner = s->data.tilemap.owners[y * width + x];
+
+            if (owner < 0) continue;
+
+            /*
+                NOTE: Each rectangle is only reported at the first of its 
+                tiles under `aabb`, so that no rectangle is reported twice 
+                without having to remember the rectangles reported so far.
+            */
+            if (x != ((minColumn > owner % width) ? minColumn : owner % width)
+                || y != ((minRow > owner / width) ? minRow : owner / width))
+                continue;
+
+            func((frContextNode) { .id = owner, .ctx = userData });
+        }
+}
+
+/* 
+    Returns the number of child shapes of `s`, 
+    assuming `s` is a 'compound' collision shape.
+*/
+int frGetCompoundChildCount(const frShape *s) {
+    return (frGetShapeType(s) == FR_SHAPE_COMPOUND) ? s->data.compound.count
+                                                    : 0;
+}
+
+/* 
+    Returns the child shape with the given `i`ndex of `s`, 
+    assuming `s` is a 'compound' collision shape.
+*/
+const frShape *frGetCompoundChild(const frShape *s, int i) {
+    if (frGetShapeType(s) != FR_SHAPE_COMPOUND || i < 0
+        || i >= s->data.compound.count)
+        return NULL;
+
+    return s->data.compound.children[i].shape;
+}
+
+/* 
+    Returns the transform of the child shape with the given `i`ndex of `s` 
+    with the transform `tx`, assuming `s` is a 'compound' collision shape.
+*/
+frTransform frGetCompoundChildTransform(const frShape *s,
+                                        frTransform tx,
+                                        int i) {
+    if (frGetShapeType(s) != FR_SHAPE_COMPOUND || i < 0
+        || i >= s->data.compound.count)
+        return tx;
+
+    frTransform childTx = s->data.compound.children[i].tx;
+
+    return (frTransform) {
+        .position = frVector2Transform(childTx.position, tx),
+        .rotation = { .sin_ = tx.rotation.sin_ * childTx.rotation.cos_
+                              + tx.rotation.cos_ * childTx.rotation.sin_,
+                      .cos_ = tx.rotation.cos_ * childTx.rotation.cos_
+                              - tx.rotation.sin_ * childTx.rotation.sin_ },
+        .angle = tx.angle + childTx.angle
+    };
+}
+
+/* 
+    Query `s` for the child shapes whose bounding boxes overlap `aabb` 
+    (in the local space of `s`) in ascending order, assuming `s` is 
+    a 'compound' collision shape.
+*/
+void frQueryCompoundChildren(const frShape *s,
+                             frAABB aabb,
+                             frHashQueryFunc func,
+                             void *userData) {
+    if (frGetShapeType(s) != FR_SHAPE_COMPOUND || func == NULL) return;
+
+    frQueryAABBTree(s->data.compound.nodes,
+                    s->data.compound.leafCount,
+                    aabb,
+                    func,
+                    userData);
+}
+
 /* 
     Returns a vertex with the given `i`ndex of `s`, 
     assuming `s` is a 'polygon' collision shape.
 */
 frVector2 frGetPolygonVertex(const frShape *s, int i) {
     if (frGetShapeType(s) != FR_SHAPE_POLYGON || i < 0
-        || i >= s->data.polygon.vertices.count)
+        || i >= s->data.polygon.count)
         return frStructZero(frVector2);
 
-    return s->data.polygon.vertices.data[i];
+    return s->data.polygon.vertices[i];
+}
+
+/* 
+    Returns the number of vertices of `s`, 
+    assuming `s` is a 'polygon' collision shape.
+*/
+int frGetPolygonVertexCount(const frShape *s) {
+    return (frGetShapeType(s) == FR_SHAPE_POLYGON) ? s->data.polygon.count : 0;
 }
 
 /* Returns the vertices of `s`, assuming `s` is a 'polygon' collision shape. */
-const frVertices *frGetPolygonVertices(const frShape *s) {
-    return (frGetShapeType(s) == FR_SHAPE_POLYGON) ? &(s->data.polygon.vertices)
+const frVector2 *frGetPolygonVertices(const frShape *s) {
+    return (frGetShapeType(s) == FR_SHAPE_POLYGON) ? s->data.polygon.vertices
                                                    : NULL;
 }
 
@@ -245,21 +970,31 @@ const frVertices *frGetPolygonVertices(const frShape *s) {
 */
 frVector2 frGetPolygonNormal(const frShape *s, int i) {
     if (frGetShapeType(s) != FR_SHAPE_POLYGON || i < 0
-        || i >= s->data.polygon.normals.count)
+        || i >= s->data.polygon.count)
         return frStructZero(frVector2);
 
-    return s->data.polygon.normals.data[i];
+    return s->data.polygon.normals[i];
 }
 
 /* Returns the normals of `s`, assuming `s` is a 'polygon' collision shape. */
-const frVertices *frGetPolygonNormals(const frShape *s) {
-    return (frGetShapeType(s) == FR_SHAPE_POLYGON) ? &(s->data.polygon.normals)
+const frVector2 *frGetPolygonNormals(const frShape *s) {
+    return (frGetShapeType(s) == FR_SHAPE_POLYGON) ? s->data.polygon.normals
                                                    : NULL;
 }
 
 /* Sets the type of `s` to `type`. */
 void frSetShapeType(frShape *s, frShapeType type) {
-    if (s != NULL) s->type = type;
+    if (s == NULL || s->type == type) return;
+
+    /*
+        NOTE: The members of `s->data` overlap each other, so the data 
+        of the old type must not be mistaken for that of the new type.
+    */
+    frReleaseShapeData(s);
+
+    s->data = frStructZero(frShapeData);
+
+    s->type = type;
 }
 
 /* Sets the `material` of `s`. */
@@ -291,12 +1026,29 @@ void frSetCircleRadius(frShape *s, float radius) {
     s->area = M_PI * (radius * radius);
 }
 
+/* 
+    Sets the `length` of the line segment and the `radius` of `s`, 
+    assuming `s` is a 'capsule' collision shape.
+*/
+void frSetCapsuleDimensions(frShape *s, float length, float radius) {
+    if (s == NULL || s->type != FR_SHAPE_CAPSULE || length <= 0.0f
+        || radius <= 0.0f)
+        return;
+
+    s->data.capsule.halfLength = 0.5f * length;
+    s->data.capsule.radius = radius;
+
+    s->area = (2.0f * radius) * length + M_PI * (radius * radius);
+}
+
 /* 
     Sets the `width` and `height` of `s`, assuming `s` is a 'rectangle'
     collision shape.
 */
 void frSetRectangleDimensions(frShape *s, float width, float height) {
-    if (s == NULL || width <= 0.0f || height <= 0.0f) return;
+    if (s == NULL || s->type != FR_SHAPE_POLYGON || width <= 0.0f
+        || height <= 0.0f)
+        return;
 
     float halfWidth = 0.5f * width, halfHeight = 0.5f * height;
 
@@ -312,48 +1064,186 @@ void frSetRectangleDimensions(frShape *s, float width, float height) {
 
 /* Sets the `vertices` of `s`, assuming `s` is a 'polygon' collision shape. */
 void frSetPolygonVertices(frShape *s, const frVertices *vertices) {
-    if (s == NULL || vertices == NULL || vertices->count <= 0) return;
+    if (s == NULL || s->type != FR_SHAPE_POLYGON || vertices == NULL
+        || vertices->count <= 0)
+        return;
 
-    frVertices newVertices = { .count = 0 };
+    frVertices hull = { .count = 0 };
 
-    frJarvisMarch(vertices, &newVertices);
+    frJarvisMarch(vertices, &hull);
 
-    {
-        s->data.polygon.vertices.count = newVertices.count;
-        s->data.polygon.normals.count = newVertices.count;
+    if (!frReservePolygonStorage(s, hull.count)) return;
 
-        for (int i = 0; i < newVertices.count; i++)
-            s->data.polygon.vertices.data[i] = newVertices.data[i];
+    frSetPolygonHull(s, &hull);
+}
 
-        for (int j = newVertices.count - 1, i = 0; i < newVertices.count;
-             j = i, i++)
-            s->data.polygon.normals.data[i] = frVector2LeftNormal(
-                frVector2Subtract(s->data.polygon.vertices.data[i],
-                                  s->data.polygon.vertices.data[j]));
-    }
+/* 
+    Makes the tile at column `x` and row `y` of `s` `solid` (or empty), 
+    assuming `s` is a 'tilemap' collision shape.
+*/
+void frSetTilemapTile(frShape *s, int x, int y, bool solid) {
+    if (frGetShapeType(s) != FR_SHAPE_TILEMAP || x < 0
+        || x >= s->data.tilemap.width || y < 0 || y >= s->data.tilemap.height)
+        return;
 
-    float twiceAreaSum = 0.0f;
+    int width = s->data.tilemap.width;
 
-    for (int i = 0; i < s->data.polygon.vertices.count - 1; i++) {
-        /*
-            NOTE: Divides the convex hull into multiple triangles,
-            then computes the area for each triangle.
-        */
+    int owner = s->data.tilemap.owners[y * width + x];
 
-        float twiceArea = frVector2Cross(
-            frVector2Subtract(s->data.polygon.vertices.data[i],
-                              s->data.polygon.vertices.data[0]),
-            frVector2Subtract(s->data.polygon.vertices.data[i + 1],
-                              s->data.polygon.vertices.data[0]));
+    if (solid == (owner >= 0)) return;
 
-        twiceAreaSum += twiceArea;
+    // NOTE: A new solid tile becomes a rectangle of its own.
+    if (solid) {
+        frAddTilemapRect(s, x, y, 1, 1);
+
+        return;
     }
 
-    s->area = fabsf(0.5f * twiceAreaSum);
+    /*
+        NOTE: The rectangle that the tile belonged to is split into up to
+        four rectangles around the tile: the rows above and below the tile, 
+        and the tiles to the left and the right of the tile in its row.
+    */
+    int rectX = owner % width, rectY = owner / width;
+
+    int rectWidth = s->data.tilemap.rects[owner].width;
+    int rectHeight = s->data.tilemap.rects[owner].height;
+
+    frRemoveTilemapRect(s, owner);
+
+    if (y > rectY) frAddTilemapRect(s, rectX, rectY, rectWidth, y - rectY);
+
+    if (x > rectX) frAddTilemapRect(s, rectX, y, x - rectX, 1);
+
+    if (x < rectX + rectWidth - 1)
+        frAddTilemapRect(s, x + 1, y, rectX + rectWidth - (x + 1), 1);
+
+    if (y < rectY + rectHeight - 1)
+        frAddTilemapRect(s,
+                         rectX,
+                         y + 1,
+                         rectWidth,
+                         rectY + rectHeight - (y + 1));
 }
 
 /* Private Functions ======================================================> */
 
+/* 
+    Allocates a 'chain' (or 'heightfield') collision shape for `count` 
+    vertices, then connects the `vertices` with line segments, one after 
+    another (and the last one to the first one if `loop` is `true`).
+*/
+static frShape *frAllocateChain(frShapeType type,
+                                const frVector2 *vertices,
+                                int count,
+                                bool loop) {
+    int segmentCount = loop ? count : count - 1, leafCount = 1;
+
+    while (leafCount < segmentCount)
+        leafCount <<= 1;
+
+    /*
+        NOTE: The vertices, the normals and the nodes of the tree are
+        stored in a single block, which is never resized.
+    */
+    frVector2 *storage = malloc((count + segmentCount) * sizeof *storage
+                                + (2 * leafCount) * sizeof(frAABB));
+
+    if (storage == NULL) return NULL;
+
+    frShape *result = frAllocateShape(0);
+
+    result->type = type;
+
+    result->data.chain.vertices = storage;
+    result->data.chain.normals = storage + count;
+
+    result->data.chain.nodes = (frAABB *) (storage + count + segmentCount);
+
+    result->data.chain.count = count;
+    result->data.chain.segmentCount = segmentCount;
+    result->data.chain.leafCount = leafCount;
+
+    for (int i = 0; i < count; i++)
+        result->data.chain.vertices[i] = vertices[i];
+
+    frAABB *nodes = result->data.chain.nodes;
+
+    for (int i = 0; i < leafCount; i++) {
+        if (i >= segmentCount) {
+            nodes[leafCount + i] = (frAABB) { .width = -1.0f };
+
+            continue;
+        }
+
+        frVector2 v1 = vertices[i], v2 = vertices[(i + 1) % count];
+
+        result->data.chain.normals[i] = frVector2RightNormal(
+            frVector2Subtract(v2, v1));
+
+        nodes[leafCount + i] = (frAABB) { .x = fminf(v1.x, v2.x),
+                                          .y = fminf(v1.y, v2.y),
+                                          .width = fabsf(v2.x - v1.x),
+                                          .height = fabsf(v2.y - v1.y) };
+    }
+
+    frBuildAABBTree(nodes, leafCount);
+
+    return result;
+}
+
+/* 
+    Allocates a collision shape, along with the storage for 
+    `vertexCount` vertices and normals right after the shape itself.
+*/
+static frShape *frAllocateShape(int vertexCount) {
+    if (vertexCount < 0) vertexCount = 0;
+
+    /*
+        NOTE: Most shapes are boxes and triangles, so storing their vertices 
+        and normals in the same block as the shape itself avoids a second 
+        allocation (and a cache miss) without wasting any space on 
+        vertices they do not have.
+    */
+    frShape *result = calloc(1,
+                             sizeof *result
+                                 + (2 * vertexCount) * sizeof(frVector2));
+
+    if (vertexCount > 0) {
+        result->data.polygon.vertices = (frVector2 *) (result + 1);
+        result->data.polygon.normals = result->data.polygon.vertices
+                                       + vertexCount;
+
+        result->data.polygon.capacity = vertexCount;
+    }
+
+    return result;
+}
+
+/* Releases the memory allocated for the type-specific data of `s`. */
+static void frReleaseShapeData(frShape *s) {
+    if (s->type == FR_SHAPE_POLYGON) {
+        /*
+            NOTE: The vertices and normals only need to be released 
+            separately if they have outgrown the storage allocated 
+            along with `s`.
+        */
+        if (s->data.polygon.vertices != (frVector2 *) (s + 1))
+            free(s->data.polygon.vertices);
+    } else if (s->type == FR_SHAPE_CHAIN || s->type == FR_SHAPE_HEIGHTFIELD) {
+        free(s->data.chain.vertices);
+    } else if (s->type == FR_SHAPE_COMPOUND) {
+        free(s->data.compound.children);
+    } else if (s->type == FR_SHAPE_TILEMAP) {
+        int tileCount = s->data.tilemap.width * s->data.tilemap.height;
+
+        for (int i = 0; i < tileCount; i++)
+            frReleaseShape(s->data.tilemap.rects[i].shape);
+
+        free(s->data.tilemap.rects);
+    }
+}
+
 /* 
     Computes the convex hull for the given `input` points 
     with the gift wrapping (a.k.a. Jarvis march) algorithm.
@@ -411,3 +1301,209 @@ static void frJarvisMarch(const frVertices *input, frVertices *output) {
         output->data[output->count++] = input->data[nextIndex];
     }
 }
+
+/* 
+    Merges the solid tiles of `s` that are given by `tiles` into 
+    rectangles, by extending each rectangle to the right first 
+    and then downward, assuming `s` is a 'tilemap' collision shape.
+*/
+static void frMergeTilemapTiles(frShape *s, const bool *tiles) {
+    int width = s->data.tilemap.width, height = s->data.tilemap.height;
+
+    const int *owners = s->data.tilemap.owners;
+
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++) {
+            int i = y * width + x;
+
+            if (!tiles[i] || owners[i] >= 0) continue;
+
+            int rectWidth = 1, rectHeight = 1;
+
+            while (x + rectWidth < width
+                   && rectWidth < FR_GEOMETRY_MAX_TILE_RECT_SIZE
+                   && tiles[i + rectWidth] && owners[i + rectWidth] < 0)
+                rectWidth++;
+
+            for (; y + rectHeight < height
+                   && rectHeight < FR_GEOMETRY_MAX_TILE_RECT_SIZE;
+                 rectHeight++) {
+                int j = i + rectHeight * width, k = 0;
+
+                while (k < rectWidth && tiles[j + k] && owners[j + k] < 0)
+                    k++;
+
+                if (k < rectWidth) break;
+            }
+
+            frAddTilemapRect(s, x, y, rectWidth, rectHeight);
+        }
+}
+
+/* 
+    Adds a rectangle of solid tiles to `s`, whose top-left tile is at 
+    column `x` and row `y`, assuming `s` is a 'tilemap' collision shape.
+*/
+static void frAddTilemapRect(frShape *s, int x, int y, int width, int height) {
+    int i = y * s->data.tilemap.width + x;
+
+    float tileSize = s->data.tilemap.tileSize;
+
+    frShape *shape = frCreateRectangle(s->material,
+                                       width * tileSize,
+                                       height * tileSize);
+
+    s->data.tilemap.rects[i] = (frTileRect) { .width = width,
+                                              .height = height,
+                                              .shape = shape };
+
+    for (int j = 0; j < height; j++)
+        for (int k = 0; k < width; k++)
+            s->data.tilemap.owners[i + j * s->data.tilemap.width + k] = i;
+}
+
+/* 
+    Removes the rectangle of solid tiles with the given `i`ndex from `s`,
+    assuming `s` is a 'tilemap' collision shape.
+*/
+static void frRemoveTilemapRect(frShape *s, int i) {
+    frTileRect *rect = &s->data.tilemap.rects[i];
+
+    for (int j = 0; j < rect->height; j++)
+        for (int k = 0; k < rect->width; k++)
+            s->data.tilemap.owners[i + j * s->data.tilemap.width + k] = -1;
+
+    frReleaseShape(rect->shape);
+
+    *rect = frStructZero(frTileRect);
+}
+
+/* 
+    Builds the inner nodes of a complete binary tree of bounding boxes 
+    with `leafCount` leaves, whose leaves are already stored in `nodes`.
+*/
+static void frBuildAABBTree(frAABB *nodes, int leafCount) {
+    for (int i = leafCount - 1; i >= 1; i--) {
+        frAABB left = nodes[2 * i], right = nodes[2 * i + 1];
+
+        if (right.width < 0.0f) {
+            nodes[i] = left;
+
+            continue;
+        }
+
+        float minX = fminf(left.x, right.x), minY = fminf(left.y, right.y);
+
+        float maxX = fmaxf(left.x + left.width, right.x + right.width);
+        float maxY = fmaxf(left.y + left.height, right.y + right.height);
+
+        nodes[i] = (frAABB) { .x = minX,
+                              .y = minY,
+                              .width = maxX - minX,
+                              .height = maxY - minY };
+    }
+}
+
+/* 
+    Query a complete binary tree of bounding boxes with `leafCount` leaves
+    for the leaves that overlap `aabb`, in ascending order.
+*/
+static void frQueryAABBTree(const frAABB *nodes,
+                            int leafCount,
+                            frAABB aabb,
+                            frHashQueryFunc func,
+                            void *userData) {
+    /*
+        NOTE: The children of the `i`-th node are the `2i`-th and 
+        the `(2i + 1)`-th nodes, and the leaves are stored in order 
+        from the `leafCount`-th node; the tree cannot be deeper than 
+        32 levels, so neither can `stack`.
+    */
+    int stack[64], stackSize = 0;
+
+    stack[stackSize++] = 1;
+
+    while (stackSize > 0) {
+        int index = stack[--stackSize];
+
+        frAABB node = nodes[index];
+
+        if (node.width < 0.0f || node.x > aabb.x + aabb.width
+            || node.x + node.width < aabb.x || node.y > aabb.y + aabb.height
+            || node.y + node.height < aabb.y)
+            continue;
+
+        if (index >= leafCount) {
+            func((frContextNode) { .id = index - leafCount, .ctx = userData });
+
+            continue;
+        }
+
+        stack[stackSize++] = 2 * index + 1;
+        stack[stackSize++] = 2 * index;
+    }
+}
+
+/* Returns `true` if `s` is a 'chain' or 'heightfield' collision shape. */
+static bool frIsChainShape(const frShape *s) {
+    return s != NULL
+           && (s->type == FR_SHAPE_CHAIN || s->type == FR_SHAPE_HEIGHTFIELD);
+}
+
+/* 
+    Makes sure that `s` has enough storage for `vertexCount` vertices and
+    normals, assuming `s` is a 'polygon' collision shape.
+*/
+static bool frReservePolygonStorage(frShape *s, int vertexCount) {
+    if (vertexCount <= s->data.polygon.capacity) return true;
+
+    frVector2 *newVertices = malloc((2 * vertexCount) * sizeof *newVertices);
+
+    if (newVertices == NULL) return false;
+
+    if (s->data.polygon.vertices != (frVector2 *) (s + 1))
+        free(s->data.polygon.vertices);
+
+    s->data.polygon.vertices = newVertices;
+    s->data.polygon.normals = newVertices + vertexCount;
+
+    s->data.polygon.capacity = vertexCount;
+
+    return true;
+}
+
+/* 
+    Sets the vertices of `s` to the given convex `hull`,
+    assuming `s` is a 'polygon' collision shape.
+*/
+static void frSetPolygonHull(frShape *s, const frVertices *hull) {
+    frVector2 *vertices = s->data.polygon.vertices;
+    frVector2 *normals = s->data.polygon.normals;
+
+    s->data.polygon.count = hull->count;
+
+    for (int i = 0; i < hull->count; i++)
+        vertices[i] = hull->data[i];
+
+    for (int j = hull->count - 1, i = 0; i < hull->count; j = i, i++)
+        normals[i] = frVector2LeftNormal(
+            frVector2Subtract(vertices[i], vertices[j]));
+
+    float twiceAreaSum = 0.0f;
+
+    for (int i = 0; i < hull->count - 1; i++) {
+        /*
+            NOTE: Divides the convex hull into multiple triangles,
+            then computes the area for each triangle.
+        */
+
+        float twiceArea = frVector2Cross(frVector2Subtract(vertices[i],
+                                                           vertices[0]),
+                                         frVector2Subtract(vertices[i + 1],
+                                                           vertices[0]));
+
+        twiceAreaSum += twiceArea;
+    }
+
+    s->area = fabsf(0.5f * twiceAreaSum);
+}
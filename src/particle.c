@@ -0,0 +1,696 @@
+/* 
+    Copyright (c) 2021-2024 Jaedeok Kim <jdeokkim@protonmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a 
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation 
+    the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+    and/or sell copies of the Software, and to permit persons to whom the 
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included 
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Includes ===============================================================> */
+
+#include <string.h>
+
+#include "ferox.h"
+
+/* Typedefs ===============================================================> */
+
+/* 
+    A structure that represents the per-particle arrays of
+    a particle system, stored as a structure of arrays.
+*/
+typedef struct frParticleArrays_ {
+    frVector2 *positions, *velocities;
+    float *radii, *inverseMasses;
+    int *ids;
+} frParticleArrays;
+
+/* A structure that represents a group of lightweight, non-rotating circles. */
+struct frParticleSystem_ {
+    void *block;
+    frParticleArrays data, scratch;
+    int *indices;
+    int count, capacity;
+    frMaterial material;
+    frParticleCoupling coupling;
+    float maxRadius, cellSize;
+    frVector2 min, max, down;
+    int *cellStarts, *cellStamps, *buckets;
+    int tableSize, stamp;
+    int minCellX, minCellY, maxCellX, maxCellY;
+    frShape *probe;
+};
+
+/* Constants ==============================================================> */
+
+/* 
+    A constant that represents how much heavier the lower particle of 
+    a vertical pair of particles is treated as.
+*/
+static const float PARTICLE_MASS_SCALE = 4.0f;
+
+/* Private Function Prototypes ============================================> */
+
+/* 
+    Sorts the particles of `ps` by the cells of a uniform grid over 
+    their bounds, so that the particles in the same cell (and in 
+    the neighboring cells of a row) are stored next to each other.
+*/
+static void frBuildParticleGrid(frParticleSystem *ps);
+
+/* Returns the bucket of the grid cell at (`x`, `y`) for `ps`. */
+static int frGetParticleBucket(const frParticleSystem *ps, int x, int y);
+
+/* Resolves the collisions between all pairs of particles in `ps`. */
+static void frResolveParticleCollisions(frParticleSystem *ps);
+
+/* 
+    Resolves the collision between the `i`-th and the `j`-th particles
+    in `ps`, if they are overlapping.
+*/
+static void frResolveParticlePair(frParticleSystem *ps, int i, int j);
+
+/* Resolves the collisions between the particles in `ps` and `b`. */
+static void frResolveParticleBodyCollisions(frParticleSystem *ps, frBody *b);
+
+/* 
+    Resolves the collision between the `i`-th particle in `ps` and `b`,
+    if they are overlapping.
+*/
+static void frResolveParticleBody(frParticleSystem *ps,
+                                  frBody *b,
+                                  frAABB aabb,
+                                  int i);
+
+/* Public Functions =======================================================> */
+
+/* 
+    Creates a particle system that can hold up to `capacity` particles
+    made of `material`.
+*/
+frParticleSystem *frCreateParticleSystem(frMaterial material, int capacity) {
+    if (capacity <= 0 || material.density <= 0.0f) return NULL;
+
+    int tableSize = 1;
+
+    while (tableSize < capacity)
+        tableSize <<= 1;
+
+    frParticleSystem *result = calloc(1, sizeof *result);
+
+    if (result == NULL) return NULL;
+
+    /*
+        NOTE: The particles are double-buffered, so that the grid build
+        can move them into their sorted order in a single pass.
+    */
+    result->block = malloc(capacity
+                           * (4 * sizeof(frVector2) + 4 * sizeof(float)
+                              + 3 * sizeof(int)));
+
+    result->cellStarts = malloc((tableSize + 1) * sizeof(int));
+    result->cellStamps = malloc(tableSize * sizeof(int));
+    result->buckets = malloc(capacity * sizeof(int));
+
+    result->probe = frCreateCircle(material, 1.0f);
+
+    if (result->block == NULL || result->cellStarts == NULL
+        || result->cellStamps == NULL || result->buckets == NULL
+        || result->probe == NULL) {
+        frReleaseParticleSystem(result);
+
+        return NULL;
+    }
+
+    frVector2 *vectors = result->block;
+
+    float *scalars = (float *) (vectors + 4 * capacity);
+
+    result->data.positions = vectors;
+    result->data.velocities = vectors + capacity;
+
+    result->scratch.positions = vectors + 2 * capacity;
+    result->scratch.velocities = vectors + 3 * capacity;
+
+    result->data.radii = scalars;
+    result->data.inverseMasses = scalars + capacity;
+
+    result->scratch.radii = scalars + 2 * capacity;
+    result->scratch.inverseMasses = scalars + 3 * capacity;
+
+    int *ids = (int *) (scalars + 4 * capacity);
+
+    result->data.ids = ids;
+    result->scratch.ids = ids + capacity;
+
+    result->indices = ids + 2 * capacity;
+
+    /*
+        NOTE: The IDs after the last particle are the ones that are free,
+        and `indices` maps each ID in use to the index of its particle.
+    */
+    for (int i = 0; i < capacity; i++)
+        result->data.ids[i] = result->indices[i] = i;
+
+    result->capacity = capacity;
+    result->material = material;
+    result->coupling = FR_PARTICLE_COUPLING_TWO_WAY;
+
+    result->tableSize = tableSize;
+
+    return result;
+}
+
+/* Releases the memory allocated for `ps`. */
+void frReleaseParticleSystem(frParticleSystem *ps) {
+    if (ps == NULL) return;
+
+    free(ps->block);
+
+    free(ps->cellStarts), free(ps->cellStamps), free(ps->buckets);
+
+    frReleaseShape(ps->probe);
+
+    free(ps);
+}
+
+/* 
+    Adds a particle with the given `position`, `velocity` and `radius`
+    to `ps`, then returns its ID (or `-1` if `ps` is full).
+*/
+int frAddParticle(frParticleSystem *ps,
+                  frVector2 position,
+                  frVector2 velocity,
+                  float radius) {
+    if (ps == NULL || ps->count >= ps->capacity || radius <= 0.0f) return -1;
+
+    int i = ps->count++;
+
+    ps->data.positions[i] = position;
+    ps->data.velocities[i] = velocity;
+    ps->data.radii[i] = radius;
+
+    ps->data.inverseMasses[i] = 1.0f
+                                / (ps->material.density * M_PI
+                                   * (radius * radius));
+
+    if (ps->maxRadius < radius) ps->maxRadius = radius;
+
+    ps->indices[ps->data.ids[i]] = i;
+
+    return ps->data.ids[i];
+}
+
+/* 
+    Removes the particle with the given `id` from `ps`,
+    moving the last particle of `ps` into its place.
+*/
+void frRemoveParticle(frParticleSystem *ps, int id) {
+    int i = frGetParticleIndex(ps, id);
+
+    if (i < 0) return;
+
+    int j = --ps->count;
+
+    ps->data.positions[i] = ps->data.positions[j];
+    ps->data.velocities[i] = ps->data.velocities[j];
+    ps->data.radii[i] = ps->data.radii[j];
+    ps->data.inverseMasses[i] = ps->data.inverseMasses[j];
+
+    // NOTE: The ID of the removed particle becomes the first free ID.
+    ps->data.ids[i] = ps->data.ids[j], ps->data.ids[j] = id;
+
+    ps->indices[ps->data.ids[i]] = i, ps->indices[id] = j;
+}
+
+/* Erases all particles from `ps`. */
+void frClearParticles(frParticleSystem *ps) {
+    if (ps != NULL) ps->count = 0, ps->maxRadius = 0.0f;
+}
+
+/* Returns the number of particles in `ps`. */
+int frGetParticleCount(const frParticleSystem *ps) {
+    return (ps != NULL) ? ps->count : 0;
+}
+
+/* 
+    Returns the current index of the particle with the given `id` in `ps`,
+    or `-1` if there is no such particle.
+*/
+int frGetParticleIndex(const frParticleSystem *ps, int id) {
+    if (ps == NULL || id < 0 || id >= ps->capacity) return -1;
+
+    int i = ps->indices[id];
+
+    return (i < ps->count && ps->data.ids[i] == id) ? i : -1;
+}
+
+/* Returns the positions of all particles in `ps`. */
+const frVector2 *frGetParticlePositions(const frParticleSystem *ps) {
+    return (ps != NULL) ? ps->data.positions : NULL;
+}
+
+/* Returns the velocities of all particles in `ps`. */
+const frVector2 *frGetParticleVelocities(const frParticleSystem *ps) {
+    return (ps != NULL) ? ps->data.velocities : NULL;
+}
+
+/* Returns the radii of all particles in `ps`. */
+const float *frGetParticleRadii(const frParticleSystem *ps) {
+    return (ps != NULL) ? ps->data.radii : NULL;
+}
+
+/* Returns how the particles in `ps` interact with rigid bodies. */
+frParticleCoupling frGetParticleCoupling(const frParticleSystem *ps) {
+    return (ps != NULL) ? ps->coupling : FR_PARTICLE_COUPLING_TWO_WAY;
+}
+
+/* Sets how the particles in `ps` interact with rigid bodies. */
+void frSetParticleCoupling(frParticleSystem *ps, frParticleCoupling coupling) {
+    if (ps != NULL) ps->coupling = coupling;
+}
+
+/* Sets the `v`elocity of the particle with the given `id` in `ps`. */
+void frSetParticleVelocity(frParticleSystem *ps, int id, frVector2 v) {
+    int i = frGetParticleIndex(ps, id);
+
+    if (i >= 0) ps->data.velocities[i] = v;
+}
+
+/* 
+    Proceeds the simulation of `ps` over the time step `dt`,
+    pushing the particles out of the rigid bodies in `w`
+    (and the rigid bodies away from the particles).
+*/
+void frStepParticleSystem(frParticleSystem *ps, frWorld *w, float dt) {
+    if (ps == NULL || ps->count <= 0 || dt <= 0.0f) return;
+
+    frVector2 gravity = frGetWorldGravity(w);
+
+    ps->min.x = ps->min.y = FLT_MAX, ps->max.x = ps->max.y = -FLT_MAX;
+
+    for (int i = 0; i < ps->count; i++) {
+        frVector2 *position = &ps->data.positions[i];
+        frVector2 *velocity = &ps->data.velocities[i];
+
+        velocity->x += gravity.x * dt, velocity->y += gravity.y * dt;
+
+        position->x += velocity->x * dt, position->y += velocity->y * dt;
+
+        // NOTE: The bounds of the grid are found along the way.
+        if (ps->min.x > position->x) ps->min.x = position->x;
+        if (ps->min.y > position->y) ps->min.y = position->y;
+
+        if (ps->max.x < position->x) ps->max.x = position->x;
+        if (ps->max.y < position->y) ps->max.y = position->y;
+    }
+
+    frBuildParticleGrid(ps);
+
+    ps->down = frVector2Normalize(gravity);
+
+    int bodyCount = frGetBodyCountInWorld(w);
+
+    for (int k = 0; k < FR_PARTICLE_ITERATION_COUNT; k++) {
+        frResolveParticleCollisions(ps);
+
+        for (int i = 0; i < bodyCount; i++)
+            frResolveParticleBodyCollisions(ps, frGetBodyInWorld(w, i));
+    }
+}
+
+/* Private Functions ======================================================> */
+
+/* 
+    Sorts the particles of `ps` by the cells of a uniform grid over 
+    their bounds, so that the particles in the same cell (and in 
+    the neighboring cells of a row) are stored next to each other.
+*/
+static void frBuildParticleGrid(frParticleSystem *ps) {
+    // NOTE: Two overlapping particles are always in adjacent cells.
+    ps->cellSize = 2.0f * ps->maxRadius;
+
+    memset(ps->cellStarts, 0, (ps->tableSize + 1) * sizeof(int));
+    memset(ps->cellStamps, 0, ps->tableSize * sizeof(int));
+
+    ps->stamp = 0;
+
+    float inverseCellSize = 1.0f / ps->cellSize;
+
+    ps->minCellX = (int) floorf(ps->min.x * inverseCellSize);
+    ps->minCellY = (int) floorf(ps->min.y * inverseCellSize);
+
+    ps->maxCellX = (int) floorf(ps->max.x * inverseCellSize);
+    ps->maxCellY = (int) floorf(ps->max.y * inverseCellSize);
+
+    for (int i = 0; i < ps->count; i++) {
+        frVector2 position = ps->data.positions[i];
+
+        int bucket = frGetParticleBucket(ps,
+                                         (int) floorf(position.x
+                                                      * inverseCellSize),
+                                         (int) floorf(position.y
+                                                      * inverseCellSize));
+
+        ps->buckets[i] = bucket, ps->cellStarts[bucket + 1]++;
+    }
+
+    for (int i = 0; i < ps->tableSize; i++)
+        ps->cellStarts[i + 1] += ps->cellStarts[i];
+
+    /*
+        NOTE: `cellStamps` counts the particles already moved into
+        each cell here, and is cleared again before it is used for
+        the queries.
+    */
+    for (int i = 0; i < ps->count; i++) {
+        int bucket = ps->buckets[i];
+
+        int j = ps->cellStarts[bucket] + ps->cellStamps[bucket]++;
+
+        ps->scratch.positions[j] = ps->data.positions[i];
+        ps->scratch.velocities[j] = ps->data.velocities[i];
+        ps->scratch.radii[j] = ps->data.radii[i];
+        ps->scratch.inverseMasses[j] = ps->data.inverseMasses[i];
+
+        ps->scratch.ids[j] = ps->data.ids[i], ps->indices[ps->data.ids[i]] = j;
+    }
+
+    // NOTE: The free IDs must stay after the last particle.
+    memcpy(ps->scratch.ids + ps->count,
+           ps->data.ids + ps->count,
+           (ps->capacity - ps->count) * sizeof(int));
+
+    memset(ps->cellStamps, 0, ps->tableSize * sizeof(int));
+
+    frParticleArrays tmp = ps->data;
+
+    ps->data = ps->scratch, ps->scratch = tmp;
+}
+
+/* Returns the bucket of the grid cell at (`x`, `y`) for `ps`. */
+static int frGetParticleBucket(const frParticleSystem *ps, int x, int y) {
+    unsigned int width = (unsigned int) (ps->maxCellX - ps->minCellX) + 1u;
+
+    /*
+        NOTE: The cells are numbered row by row, and the rows wrap around
+        the buckets if the grid has more cells than there are buckets
+        (the cells sharing a bucket are told apart by their distances).
+    */
+    unsigned int key = (unsigned int) (y - ps->minCellY) * width
+                       + (unsigned int) (x - ps->minCellX);
+
+    return (int) (key & (unsigned int) (ps->tableSize - 1));
+}
+
+/* Resolves the collisions between all pairs of particles in `ps`. */
+static void frResolveParticleCollisions(frParticleSystem *ps) {
+    float inverseCellSize = 1.0f / ps->cellSize;
+
+    for (int i = 0; i < ps->count; i++) {
+        frVector2 position = ps->data.positions[i];
+
+        int cellX = (int) floorf(position.x * inverseCellSize);
+        int cellY = (int) floorf(position.y * inverseCellSize);
+
+        /*
+            NOTE: Two of the neighboring cells may share a bucket,
+            so each bucket is marked with the index of the particle
+            whose neighbors are being visited.
+        */
+        int stamp = ++ps->stamp;
+
+        for (int y = cellY - 1; y <= cellY + 1; y++) {
+            for (int x = cellX - 1; x <= cellX + 1; x++) {
+                int bucket = frGetParticleBucket(ps, x, y);
+
+                if (ps->cellStamps[bucket] == stamp) continue;
+
+                ps->cellStamps[bucket] = stamp;
+
+                for (int j = ps->cellStarts[bucket];
+                     j < ps->cellStarts[bucket + 1];
+                     j++)
+                    if (i < j) frResolveParticlePair(ps, i, j);
+            }
+        }
+    }
+}
+
+/* 
+    Resolves the collision between the `i`-th and the `j`-th particles
+    in `ps`, if they are overlapping.
+*/
+static void frResolveParticlePair(frParticleSystem *ps, int i, int j) {
+    frVector2 *positions = ps->data.positions;
+    frVector2 *velocities = ps->data.velocities;
+
+    float dx = positions[j].x - positions[i].x;
+    float dy = positions[j].y - positions[i].y;
+
+    float radiusSum = ps->data.radii[i] + ps->data.radii[j];
+
+    float distanceSqr = dx * dx + dy * dy;
+
+    if (distanceSqr >= radiusSum * radiusSum) return;
+
+    float distance = sqrtf(distanceSqr);
+
+    float nx = 0.0f, ny = 1.0f;
+
+    if (distance > 0.0f) nx = dx / distance, ny = dy / distance;
+
+    float inverseMass1 = ps->data.inverseMasses[i];
+    float inverseMass2 = ps->data.inverseMasses[j];
+
+    float height = nx * ps->down.x + ny * ps->down.y;
+
+    /*
+        NOTE: The lower particle of the pair (along the gravity) is treated
+        as if it were heavier, so that a tall stack of particles holds up
+        with only a few iterations.
+    */
+    if (height > 0.0f) inverseMass2 /= 1.0f + PARTICLE_MASS_SCALE * height;
+    else inverseMass1 /= 1.0f - PARTICLE_MASS_SCALE * height;
+
+    float inverseMassSum = inverseMass1 + inverseMass2;
+
+    float correction = (radiusSum - distance) / inverseMassSum;
+
+    float correction1 = correction * inverseMass1;
+    float correction2 = correction * inverseMass2;
+
+    positions[i].x -= nx * correction1, positions[i].y -= ny * correction1;
+    positions[j].x += nx * correction2, positions[j].y += ny * correction2;
+
+    float normalSpeed = (velocities[j].x - velocities[i].x) * nx
+                        + (velocities[j].y - velocities[i].y) * ny;
+
+    if (normalSpeed >= 0.0f) return;
+
+    float impulse = -normalSpeed / inverseMassSum;
+
+    velocities[i].x -= nx * (impulse * inverseMass1);
+    velocities[i].y -= ny * (impulse * inverseMass1);
+
+    velocities[j].x += nx * (impulse * inverseMass2);
+    velocities[j].y += ny * (impulse * inverseMass2);
+}
+
+/* Resolves the collisions between the particles in `ps` and `b`. */
+static void frResolveParticleBodyCollisions(frParticleSystem *ps, frBody *b) {
+    if (frGetBodyShape(b) == NULL) return;
+
+    frAABB aabb = frGetBodyAABB(b);
+
+    float inverseCellSize = 1.0f / ps->cellSize;
+
+    /*
+        NOTE: The particles may have been pushed out of their cells 
+        since the grid was built, so one more cell is visited
+        on each side of `b`.
+    */
+    float margin = ps->maxRadius + ps->cellSize;
+
+    /*
+        NOTE: Every particle was put into a cell within the bounds 
+        of the grid, so the cells outside the bounds are skipped.
+    */
+    float minX = fmaxf(floorf((aabb.x - margin) * inverseCellSize),
+                       ps->minCellX);
+    float minY = fmaxf(floorf((aabb.y - margin) * inverseCellSize),
+                       ps->minCellY);
+
+    float maxX = fminf(floorf((aabb.x + aabb.width + margin)
+                              * inverseCellSize),
+                       ps->maxCellX);
+    float maxY = fminf(floorf((aabb.y + aabb.height + margin)
+                              * inverseCellSize),
+                       ps->maxCellY);
+
+    if (minX > maxX || minY > maxY) return;
+
+    // NOTE: Visiting every particle is cheaper for a large body.
+    if ((maxX - minX + 1.0f) * (maxY - minY + 1.0f) >= ps->count) {
+        for (int i = 0; i < ps->count; i++)
+            frResolveParticleBody(ps, b, aabb, i);
+
+        return;
+    }
+
+    int stamp = ++ps->stamp;
+
+    for (int y = (int) minY; y <= (int) maxY; y++) {
+        for (int x = (int) minX; x <= (int) maxX; x++) {
+            int bucket = frGetParticleBucket(ps, x, y);
+
+            if (ps->cellStamps[bucket] == stamp) continue;
+
+            ps->cellStamps[bucket] = stamp;
+
+            for (int i = ps->cellStarts[bucket];
+                 i < ps->cellStarts[bucket + 1];
+                 i++)
+                frResolveParticleBody(ps, b, aabb, i);
+        }
+    }
+}
+
+/* 
+    Resolves the collision between the `i`-th particle in `ps` and `b`,
+    if they are overlapping.
+*/
+static void frResolveParticleBody(frParticleSystem *ps,
+                                  frBody *b,
+                                  frAABB aabb,
+                                  int i) {
+    frVector2 position = ps->data.positions[i];
+
+    float radius = ps->data.radii[i];
+
+    if (position.x + radius < aabb.x
+        || position.x - radius > aabb.x + aabb.width
+        || position.y + radius < aabb.y
+        || position.y - radius > aabb.y + aabb.height)
+        return;
+
+    if (frGetCircleRadius(ps->probe) != radius)
+        frSetCircleRadius(ps->probe, radius);
+
+    const frShape *s = frGetBodyShape(b);
+
+    frCollision collision = { .count = 0 };
+
+    if (!frComputeShapeCollision(s,
+                                 frGetBodyTransform(b),
+                                 ps->probe,
+                                 (frTransform) { .position = position,
+                                                 .rotation.cos_ = 1.0f },
+                                 &collision))
+        return;
+
+    // NOTE: `collision.direction` points from `b` to the particle.
+    frVector2 normal = collision.direction;
+
+    frContact contact = collision.contacts[0];
+
+    if (collision.count > 1 && contact.depth < collision.contacts[1].depth)
+        contact = collision.contacts[1];
+
+    position = frVector2Add(position,
+                            frVector2ScalarMultiply(normal, contact.depth));
+
+    ps->data.positions[i] = position;
+
+    frVector2 relativePosition = frVector2Subtract(contact.point,
+                                                   frGetBodyPosition(b));
+
+    float angularVelocity = frGetBodyAngularVelocity(b);
+
+    frVector2 bodyVelocity = frGetBodyVelocity(b);
+
+    bodyVelocity.x -= angularVelocity * relativePosition.y;
+    bodyVelocity.y += angularVelocity * relativePosition.x;
+
+    frVector2 relativeVelocity = frVector2Subtract(ps->data.velocities[i],
+                                                   bodyVelocity);
+
+    float normalSpeed = frVector2Dot(relativeVelocity, normal);
+
+    if (normalSpeed >= 0.0f) return;
+
+    frVector2 tangentVelocity = frVector2Subtract(
+        relativeVelocity, frVector2ScalarMultiply(normal, normalSpeed));
+
+    float tangentSpeed = frVector2Magnitude(tangentVelocity);
+
+    frVector2 tangent = (tangentSpeed > 0.0f)
+                            ? frVector2ScalarMultiply(tangentVelocity,
+                                                      1.0f / tangentSpeed)
+                            : frStructZero(frVector2);
+
+    float restitution = fminf(ps->material.restitution,
+                              frGetShapeRestitution(s));
+    float friction = 0.5f * (ps->material.friction + frGetShapeFriction(s));
+
+    if (restitution < 0.0f) restitution = 0.0f;
+    if (friction < 0.0f) friction = 0.0f;
+
+    float inverseMass = ps->data.inverseMasses[i];
+
+    float normalMass = inverseMass, tangentMass = inverseMass;
+
+    // NOTE: A one-way particle sees `b` as if it had an infinite mass.
+    bool coupled = (ps->coupling == FR_PARTICLE_COUPLING_TWO_WAY);
+
+    /*
+        NOTE: So does a two-way particle for a sleeping `b`, unless it hits 
+        `b` hard enough to wake it up, in which case the island of `b` 
+        wakes up along with it at the next step.
+    */
+    if (coupled && frIsBodySleeping(b))
+        coupled = (-(1.0f + restitution) * normalSpeed
+                   * (frGetBodyInverseMass(b) / inverseMass))
+                  > FR_WORLD_SLEEP_LINEAR_THRESHOLD;
+
+    if (coupled) {
+        float normalCross = frVector2Cross(relativePosition, normal);
+        float tangentCross = frVector2Cross(relativePosition, tangent);
+
+        float bodyInverseMass = frGetBodyInverseMass(b);
+        float bodyInverseInertia = frGetBodyInverseInertia(b);
+
+        normalMass += bodyInverseMass
+                      + bodyInverseInertia * (normalCross * normalCross);
+        tangentMass += bodyInverseMass
+                       + bodyInverseInertia * (tangentCross * tangentCross);
+    }
+
+    float normalScalar = -(1.0f + restitution) * normalSpeed / normalMass;
+
+    float tangentScalar = fminf(tangentSpeed / tangentMass,
+                                friction * normalScalar);
+
+    frVector2 impulse = frVector2Subtract(
+        frVector2ScalarMultiply(normal, normalScalar),
+        frVector2ScalarMultiply(tangent, tangentScalar));
+
+    ps->data.velocities[i] = frVector2Add(
+        ps->data.velocities[i], frVector2ScalarMultiply(impulse, inverseMass));
+
+    if (coupled)
+        frApplyImpulseToBody(b, contact.point, frVector2Negate(impulse));
+}
@@ -22,6 +22,7 @@
 
 /* Includes ===============================================================> */
 
+#include "external/ferox_utils.h"
 #include "ferox.h"
 
 /* Typedefs ===============================================================> */
@@ -45,7 +46,10 @@ struct frBody_ {
     frBodyType type;
     frBodyFlags flags;
     frAABB aabb;
+    frWorld *world;
     void *ctx;
+    float sleepTime;
+    bool sleeping;
 };
 
 /* Constants ==============================================================> */
@@ -61,6 +65,63 @@ static void frComputeBodyMass(frBody *b);
 /* Normalizes the `angle` to a range `[0, 2π]`. */
 static FR_API_INLINE float frNormalizeAngle(float angle);
 
+/* Sets the `angle` of `b` without waking `b` up, in radians. */
+static void frRotateBody(frBody *b, float angle);
+
+/* 
+    Stores the `velocity` and the `angularVelocity` of the `i`-th body 
+    of `sb`, unless its mass and its moment of inertia are infinite.
+*/
+static FR_API_INLINE void frStoreSolverVelocity(frSolverBodies *sb,
+                                                int i,
+                                                frVector2 velocity,
+                                                float angularVelocity);
+
+/* 
+    Checks whether each of the first `n` `points` lies inside 
+    the capsule-shaped `b`, then stores the results to `results`.
+*/
+static int frCapsuleContainsPoints(const frBody *b,
+                                   const frVector2 *points,
+                                   int n,
+                                   bool *results);
+
+/* 
+    Checks whether each of the first `n` `points` lies inside 
+    the circle-shaped `b`, then stores the results to `results`.
+*/
+static int frCircleContainsPoints(const frBody *b,
+                                  const frVector2 *points,
+                                  int n,
+                                  bool *results);
+
+/* 
+    Checks whether each of the first `n` `points` lies inside any child 
+    shape of the compound-shaped `b`, then stores the results to `results`.
+*/
+static int frCompoundContainsPoints(const frBody *b,
+                                    const frVector2 *points,
+                                    int n,
+                                    bool *results);
+
+/* 
+    Checks whether each of the first `n` `points` lies inside 
+    the polygon-shaped `b`, then stores the results to `results`.
+*/
+static int frPolygonContainsPoints(const frBody *b,
+                                   const frVector2 *points,
+                                   int n,
+                                   bool *results);
+
+/* 
+    Checks whether each of the first `n` `points` lies inside a solid tile 
+    of the tilemap-shaped `b`, then stores the results to `results`.
+*/
+static int frTilemapContainsPoints(const frBody *b,
+                                   const frVector2 *points,
+                                   int n,
+                                   bool *results);
+
 /* Public Functions =======================================================> */
 
 /* Creates a rigid body at `position`. */
@@ -175,11 +236,21 @@ frAABB frGetBodyAABB(const frBody *b) {
     return (b != NULL && b->shape != NULL) ? b->aabb : frStructZero(frAABB);
 }
 
+/* Returns the world that `b` has been added to. */
+frWorld *frGetBodyWorld(const frBody *b) {
+    return (b != NULL) ? b->world : NULL;
+}
+
 /* Returns the user data of `b`. */
 void *frGetBodyUserData(const frBody *b) {
     return (b != NULL) ? b->ctx : NULL;
 }
 
+/* Checks if `b` is sleeping. */
+bool frIsBodySleeping(const frBody *b) {
+    return (b != NULL) ? b->sleeping : false;
+}
+
 /* Sets the `type` of `b`. */
 void frSetBodyType(frBody *b, frBodyType type) {
     if (b == NULL) return;
@@ -187,6 +258,8 @@ void frSetBodyType(frBody *b, frBodyType type) {
     b->type = type;
 
     frComputeBodyMass(b);
+
+    frSetBodySleeping(b, false);
 }
 
 /* Sets the property `flags` of `b`. */
@@ -196,6 +269,8 @@ void frSetBodyFlags(frBody *b, frBodyFlags flags) {
     b->flags = flags;
 
     frComputeBodyMass(b);
+
+    frSetBodySleeping(b, false);
 }
 
 /* 
@@ -210,31 +285,52 @@ void frSetBodyShape(frBody *b, frShape *s) {
     b->aabb = (s != NULL) ? frGetShapeAABB(s, b->tx) : frStructZero(frAABB);
 
     frComputeBodyMass(b);
+
+    frSetBodySleeping(b, false);
+
+    if (b->world != NULL) frInvalidateBodyInWorld(b->world, b);
+}
+
+/* Sets the transform of `b` to `tx`. */
+void frSetBodyTransform(frBody *b, frTransform tx) {
+    if (b == NULL) return;
+
+    b->tx.position = tx.position;
+
+    if (b->tx.angle != tx.angle) frRotateBody(b, tx.angle);
+
+    b->aabb = frGetShapeAABB(b->shape, b->tx);
+
+    frSetBodySleeping(b, false);
+
+    if (b->world != NULL) frInvalidateBodyInWorld(b->world, b);
 }
 
 /* Sets the position of `b` to `position`. */
 void frSetBodyPosition(frBody *b, frVector2 position) {
     if (b == NULL) return;
 
+    b->aabb.x += position.x - b->tx.position.x;
+    b->aabb.y += position.y - b->tx.position.y;
+
     b->tx.position = position;
 
-    b->aabb.x += position.x, b->aabb.y += position.y;
+    frSetBodySleeping(b, false);
+
+    if (b->world != NULL) frInvalidateBodyInWorld(b->world, b);
 }
 
 /* Sets the `angle` of `b`, in radians. */
 void frSetBodyAngle(frBody *b, float angle) {
     if (b == NULL || b->tx.angle == angle) return;
 
-    b->tx.angle = frNormalizeAngle(angle);
-
-    /*
-        NOTE: These values must be cached in order to 
-        avoid expensive computations as much as possible.
-    */
-    b->tx.rotation.sin_ = sinf(b->tx.angle);
-    b->tx.rotation.cos_ = cosf(b->tx.angle);
+    frRotateBody(b, angle);
 
     b->aabb = frGetShapeAABB(b->shape, b->tx);
+
+    frSetBodySleeping(b, false);
+
+    if (b->world != NULL) frInvalidateBodyInWorld(b->world, b);
 }
 
 /* Sets the gravity `scale` of `b`. */
@@ -244,12 +340,20 @@ void frSetBodyGravityScale(frBody *b, float scale) {
 
 /* Sets the `velocity` of `b`. */
 void frSetBodyVelocity(frBody *b, frVector2 velocity) {
-    if (b != NULL) b->mtn.velocity = velocity;
+    if (b == NULL) return;
+
+    b->mtn.velocity = velocity;
+
+    frSetBodySleeping(b, false);
 }
 
 /* Sets the `angularVelocity` of `b`. */
 void frSetBodyAngularVelocity(frBody *b, float angularVelocity) {
-    if (b != NULL) b->mtn.angularVelocity = angularVelocity;
+    if (b == NULL) return;
+
+    b->mtn.angularVelocity = angularVelocity;
+
+    frSetBodySleeping(b, false);
 }
 
 /* Sets the user data of `b` to `ctx`. */
@@ -257,34 +361,65 @@ void frSetBodyUserData(frBody *b, void *userData) {
     if (b != NULL) b->ctx = userData;
 }
 
+/* Sets the world of `b` to `w`. */
+void frSetBodyWorld(frBody *b, frWorld *w) {
+    if (b != NULL) b->world = w;
+}
+
+/* 
+    Puts `b` to sleep if `sleeping` is `true`, or wakes `b` up otherwise.
+    Only a dynamic body can fall asleep, and its velocities are cleared.
+*/
+void frSetBodySleeping(frBody *b, bool sleeping) {
+    if (b == NULL || (sleeping && b->type != FR_BODY_DYNAMIC)) return;
+
+    if (sleeping) {
+        b->mtn.velocity = frStructZero(frVector2);
+        b->mtn.angularVelocity = 0.0f;
+    }
+
+    b->sleeping = sleeping, b->sleepTime = 0.0f;
+}
+
 /* Checks if the given `point` lies inside `b`. */
 bool frBodyContainsPoint(const frBody *b, frVector2 point) {
-    if (b == NULL) return false;
+    bool result = false;
+
+    (void) frBodyContainsPoints(b, &point, 1, &result);
+
+    return result;
+}
 
-    const frShape *s = b->shape;
+/* 
+    Checks whether each of the first `n` `points` lies inside `b`, then 
+    stores the results to `results` and returns the number of points inside.
+*/
+int frBodyContainsPoints(const frBody *b,
+                         const frVector2 *points,
+                         int n,
+                         bool *results) {
+    if (b == NULL || points == NULL || n <= 0 || results == NULL) return 0;
 
-    frTransform tx = b->tx;
-    frShapeType type = frGetShapeType(s);
+    switch (frGetShapeType(b->shape)) {
+        case FR_SHAPE_CIRCLE:
+            return frCircleContainsPoints(b, points, n, results);
 
-    if (type == FR_SHAPE_CIRCLE) {
-        float deltaX = point.x - tx.position.x;
-        float deltaY = point.y - tx.position.y;
+        case FR_SHAPE_POLYGON:
+            return frPolygonContainsPoints(b, points, n, results);
 
-        float radius = frGetCircleRadius(s);
+        case FR_SHAPE_CAPSULE:
+            return frCapsuleContainsPoints(b, points, n, results);
 
-        return (deltaX * deltaX) + (deltaY * deltaY) <= radius * radius;
-    } else if (type == FR_SHAPE_POLYGON) {
-        frRay ray = { .origin = point,
-                      .direction = { .x = 1.0f },
-                      .maxDistance = FLT_MAX };
+        case FR_SHAPE_TILEMAP:
+            return frTilemapContainsPoints(b, points, n, results);
 
-        frRaycastHit raycastHit = { .distance = 0.0f };
+        case FR_SHAPE_COMPOUND:
+            return frCompoundContainsPoints(b, points, n, results);
 
-        bool result = frComputeRaycast(b, ray, &raycastHit);
+        default:
+            memset(results, 0, n * sizeof *results);
 
-        return raycastHit.inside;
-    } else {
-        return false;
+            return 0;
     }
 }
 
@@ -303,6 +438,9 @@ void frApplyForceToBody(frBody *b, frVector2 point, frVector2 force) {
 
     b->mtn.force = frVector2Add(b->mtn.force, force);
     b->mtn.torque += frVector2Cross(localPoint, force);
+
+    // NOTE: The sleep timer of an awake body only depends on its velocity.
+    if (b->sleeping) frSetBodySleeping(b, false);
 }
 
 /* Applies a gravity force to `b` with the `g`ravity acceleration vector. */
@@ -327,86 +465,131 @@ void frApplyImpulseToBody(frBody *b, frVector2 point, frVector2 impulse) {
 
     b->mtn.angularVelocity += b->mtn.inverseInertia
                               * frVector2Cross(localPoint, impulse);
+
+    if (b->sleeping) frSetBodySleeping(b, false);
 }
 
-/* Applies accumulated impulses to `b1` and `b2`. */
-void frApplyAccumulatedImpulses(frBody *b1,
-                                frBody *b2,
-                                frCollision *collision) {
-    if (b1 == NULL || b2 == NULL || collision == NULL) return;
+/* Applies the accumulated impulses of `constraint` to the bodies in `sb`. */
+void frApplyAccumulatedImpulses(frSolverBodies *sb,
+                                const frContactConstraint *constraint) {
+    if (sb == NULL || constraint == NULL) return;
 
-    if (b1->mtn.inverseMass + b2->mtn.inverseMass <= 0.0f) {
-        if (b1->type == FR_BODY_STATIC)
-            b1->mtn.velocity.x = b1->mtn.velocity
-                                     .y = b1->mtn.angularVelocity = 0.0f;
+    int i1 = constraint->firstIndex, i2 = constraint->secondIndex;
 
-        if (b2->type == FR_BODY_STATIC)
-            b2->mtn.velocity.x = b2->mtn.velocity
-                                     .y = b2->mtn.angularVelocity = 0.0f;
+    float inverseMass1 = sb->inverseMasses[i1];
+    float inverseMass2 = sb->inverseMasses[i2];
 
-        return;
+    float inverseInertia1 = sb->inverseInertias[i1];
+    float inverseInertia2 = sb->inverseInertias[i2];
+
+    frVector2 velocity1 = sb->velocities[i1];
+    frVector2 velocity2 = sb->velocities[i2];
+
+    float angularVelocity1 = sb->angularVelocities[i1];
+    float angularVelocity2 = sb->angularVelocities[i2];
+
+    for (int i = 0; i < constraint->count; i++) {
+        const frContactConstraintPoint *point = &constraint->points[i];
+
+        frVector2 accImpulse = frVector2Add(
+            frVector2ScalarMultiply(constraint->normal, point->normalScalar),
+            frVector2ScalarMultiply(constraint->tangent,
+                                    point->tangentScalar));
+
+        velocity1 = frVector2Subtract(
+            velocity1, frVector2ScalarMultiply(accImpulse, inverseMass1));
+
+        angularVelocity1 -= inverseInertia1
+                            * frVector2Cross(point->relPosition1, accImpulse);
+
+        velocity2 = frVector2Add(
+            velocity2, frVector2ScalarMultiply(accImpulse, inverseMass2));
+
+        angularVelocity2 += inverseInertia2
+                            * frVector2Cross(point->relPosition2, accImpulse);
     }
 
-    frVector2 ctxTangent = frVector2RightNormal(collision->direction);
+    frStoreSolverVelocity(sb, i1, velocity1, angularVelocity1);
+    frStoreSolverVelocity(sb, i2, velocity2, angularVelocity2);
+}
 
-    for (int i = 0; i < collision->count; i++) {
-        frVector2 contactPoint = collision->contacts[i].point;
+/* Copies the motion data of `b` to the `i`-th body of `sb`. */
+void frGatherSolverBody(frSolverBodies *sb, int i, const frBody *b) {
+    if (sb == NULL || b == NULL) return;
 
-        frVector2 relPosition1 = frVector2Subtract(contactPoint,
-                                                   b1->tx.position);
-        frVector2 relPosition2 = frVector2Subtract(contactPoint,
-                                                   b2->tx.position);
+    sb->positions[i] = b->tx.position;
+    sb->velocities[i] = b->mtn.velocity;
 
-        float relPositionCross1 = frVector2Cross(relPosition1,
-                                                 collision->direction);
-        float relPositionCross2 = frVector2Cross(relPosition2,
-                                                 collision->direction);
+    sb->angularVelocities[i] = b->mtn.angularVelocity;
 
-        float normalMass = (b1->mtn.inverseMass + b2->mtn.inverseMass)
-                           + b1->mtn.inverseInertia
-                                 * (relPositionCross1 * relPositionCross1)
-                           + b2->mtn.inverseInertia
-                                 * (relPositionCross2 * relPositionCross2);
+    sb->inverseMasses[i] = b->mtn.inverseMass;
+    sb->inverseInertias[i] = b->mtn.inverseInertia;
+}
 
-        collision->contacts[i].cache.normalMass = 1.0f / normalMass;
+/* 
+    Packs the contact constraint at `index` of `constraints` into 
+    the `lane`-th lane of `batch`, along with the inverse masses 
+    of its bodies in `sb`.
+*/
+void frPackCollisionBatch(frContactBatch *batch,
+                          int lane,
+                          const frSolverBodies *sb,
+                          const frContactConstraint *constraints,
+                          int index) {
+    if (batch == NULL || lane < 0 || lane >= 4 || sb == NULL
+        || constraints == NULL || index < 0)
+        return;
 
-        frVector2 accNormalImpulse = frVector2ScalarMultiply(
-            collision->direction, collision->contacts[i].cache.normalScalar);
+    const frContactConstraint *constraint = &constraints[index];
 
-        relPositionCross1 = frVector2Cross(relPosition1, ctxTangent);
-        relPositionCross2 = frVector2Cross(relPosition2, ctxTangent);
+    int i1 = constraint->firstIndex, i2 = constraint->secondIndex;
 
-        float tangentMass = (b1->mtn.inverseMass + b2->mtn.inverseMass)
-                            + b1->mtn.inverseInertia
-                                  * (relPositionCross1 * relPositionCross1)
-                            + b2->mtn.inverseInertia
-                                  * (relPositionCross2 * relPositionCross2);
+    batch->indices[lane] = index;
 
-        collision->contacts[i].cache.tangentMass = 1.0f / tangentMass;
+    batch->firstIndices[lane] = i1, batch->secondIndices[lane] = i2;
 
-        frVector2 accTangentImpulse = frVector2ScalarMultiply(
-            ctxTangent, collision->contacts[i].cache.tangentScalar);
+    batch->inverseMass1[lane] = sb->inverseMasses[i1];
+    batch->inverseMass2[lane] = sb->inverseMasses[i2];
 
-        {
-            frVector2 accImpulse = frVector2Add(accNormalImpulse,
-                                                accTangentImpulse);
+    batch->inverseInertia1[lane] = sb->inverseInertias[i1];
+    batch->inverseInertia2[lane] = sb->inverseInertias[i2];
 
-            b1->mtn.velocity = frVector2Subtract(
-                b1->mtn.velocity,
-                frVector2ScalarMultiply(accImpulse, b1->mtn.inverseMass));
+    batch->normalX[lane] = constraint->normal.x;
+    batch->normalY[lane] = constraint->normal.y;
 
-            b1->mtn.angularVelocity -= b1->mtn.inverseInertia
-                                       * frVector2Cross(relPosition1,
-                                                        accImpulse);
+    batch->tangentX[lane] = constraint->tangent.x;
+    batch->tangentY[lane] = constraint->tangent.y;
 
-            b2->mtn.velocity = frVector2Add(
-                b2->mtn.velocity,
-                frVector2ScalarMultiply(accImpulse, b2->mtn.inverseMass));
+    batch->friction[lane] = constraint->friction;
 
-            b2->mtn.angularVelocity += b2->mtn.inverseInertia
-                                       * frVector2Cross(relPosition2,
-                                                        accImpulse);
-        }
+    /*
+        NOTE: A missing contact point is packed as a point with
+        zero effective masses, so it never applies an impulse.
+    */
+    for (int i = 0; i < 2; i++) {
+        frContactConstraintPoint point = { .normalMass = 0.0f };
+
+        if (i < constraint->count) point = constraint->points[i];
+
+        batch->points[i].relPosition1X[lane] = point.relPosition1.x;
+        batch->points[i].relPosition1Y[lane] = point.relPosition1.y;
+
+        batch->points[i].relPosition2X[lane] = point.relPosition2.x;
+        batch->points[i].relPosition2Y[lane] = point.relPosition2.y;
+
+        batch->points[i].relNormal1X[lane] = point.relNormal1.x;
+        batch->points[i].relNormal1Y[lane] = point.relNormal1.y;
+
+        batch->points[i].relNormal2X[lane] = point.relNormal2.x;
+        batch->points[i].relNormal2Y[lane] = point.relNormal2.y;
+
+        batch->points[i].normalMass[lane] = point.normalMass;
+        batch->points[i].tangentMass[lane] = point.tangentMass;
+
+        batch->points[i].bias[lane] = point.bias;
+
+        batch->points[i].normalScalar[lane] = point.normalScalar;
+        batch->points[i].tangentScalar[lane] = point.tangentScalar;
     }
 }
 
@@ -436,118 +619,530 @@ void frIntegrateForBodyPosition(frBody *b, float dt) {
     b->tx.position.x += b->mtn.velocity.x * dt;
     b->tx.position.y += b->mtn.velocity.y * dt;
 
+    /*
+        NOTE: Moving `b` by its own velocities must not wake it up, 
+        or its sleep timer would be reset on every step.
+    */
     if (b->mtn.angularVelocity != 0.0f)
-        frSetBodyAngle(b, b->tx.angle + (b->mtn.angularVelocity * dt));
+        frRotateBody(b, b->tx.angle + (b->mtn.angularVelocity * dt));
 
     b->aabb = frGetShapeAABB(b->shape, b->tx);
 }
 
-/* Resolves the collision between `b1` and `b2`. */
-void frResolveCollision(frBody *b1,
-                        frBody *b2,
-                        frCollision *collision,
-                        float inverseDt) {
-    if (b1 == NULL || b2 == NULL
-        || b1->mtn.inverseMass + b2->mtn.inverseMass <= 0.0f
-        || collision == NULL || inverseDt <= 0.0f)
-        return;
+/* 
+    Updates the sleep timer of `b` with `dt`, which is reset to zero 
+    while `b` moves faster than the sleep thresholds, then returns it.
+*/
+float frUpdateBodySleepTime(frBody *b, float dt) {
+    if (b == NULL) return 0.0f;
+
+    float linearSpeedSquared = frVector2Dot(b->mtn.velocity, b->mtn.velocity);
+
+    if (linearSpeedSquared > (FR_WORLD_SLEEP_LINEAR_THRESHOLD
+                              * FR_WORLD_SLEEP_LINEAR_THRESHOLD)
+        || fabsf(b->mtn.angularVelocity) > FR_WORLD_SLEEP_ANGULAR_THRESHOLD)
+        b->sleepTime = 0.0f;
+    else
+        b->sleepTime += dt;
+
+    return b->sleepTime;
+}
+
+/* 
+    Prepares the collision between the bodies at `i1` and `i2` of `sb` 
+    for the constraint solver, then stores the result to `constraint`.
+*/
+void frPrepareCollision(const frSolverBodies *sb,
+                        int i1,
+                        int i2,
+                        const frCollision *collision,
+                        float inverseDt,
+                        frContactConstraint *constraint) {
+    if (sb == NULL || collision == NULL || constraint == NULL) return;
+
+    constraint->firstIndex = i1, constraint->secondIndex = i2;
+
+    constraint->normal = collision->direction;
+    constraint->tangent = frVector2RightNormal(collision->direction);
+
+    constraint->friction = collision->friction;
+
+    float inverseMass1 = sb->inverseMasses[i1];
+    float inverseMass2 = sb->inverseMasses[i2];
+
+    /*
+        NOTE: A pair of bodies with infinite masses 
+        does not need to be resolved at all.
+    */
+    constraint->count = (inverseMass1 + inverseMass2 > 0.0f) ? collision->count
+                                                             : 0;
 
-    frVector2 ctxTangent = frVector2RightNormal(collision->direction);
+    float inverseInertia1 = sb->inverseInertias[i1];
+    float inverseInertia2 = sb->inverseInertias[i2];
 
-    for (int i = 0; i < collision->count; i++) {
-        frVector2 contactPoint = collision->contacts[i].point;
+    for (int i = 0; i < constraint->count; i++) {
+        const frContact *contact = &collision->contacts[i];
 
-        frVector2 relPosition1 = frVector2Subtract(contactPoint,
-                                                   b1->tx.position);
-        frVector2 relPosition2 = frVector2Subtract(contactPoint,
-                                                   b2->tx.position);
+        frContactConstraintPoint *point = &constraint->points[i];
+
+        point->relPosition1 = frVector2Subtract(contact->point,
+                                                sb->positions[i1]);
+        point->relPosition2 = frVector2Subtract(contact->point,
+                                                sb->positions[i2]);
+
+        point->relNormal1 = frVector2LeftNormal(point->relPosition1);
+        point->relNormal2 = frVector2LeftNormal(point->relPosition2);
+
+        float relPositionCross1 = frVector2Cross(point->relPosition1,
+                                                 constraint->normal);
+        float relPositionCross2 = frVector2Cross(point->relPosition2,
+                                                 constraint->normal);
+
+        float normalMass = (inverseMass1 + inverseMass2)
+                           + inverseInertia1
+                                 * (relPositionCross1 * relPositionCross1)
+                           + inverseInertia2
+                                 * (relPositionCross2 * relPositionCross2);
+
+        point->normalMass = 1.0f / normalMass;
+
+        relPositionCross1 = frVector2Cross(point->relPosition1,
+                                           constraint->tangent);
+        relPositionCross2 = frVector2Cross(point->relPosition2,
+                                           constraint->tangent);
+
+        float tangentMass = (inverseMass1 + inverseMass2)
+                            + inverseInertia1
+                                  * (relPositionCross1 * relPositionCross1)
+                            + inverseInertia2
+                                  * (relPositionCross2 * relPositionCross2);
 
-        frVector2 relNormal1 = frVector2LeftNormal(relPosition1);
-        frVector2 relNormal2 = frVector2LeftNormal(relPosition2);
+        point->tangentMass = 1.0f / tangentMass;
+
+        point->bias = -(FR_WORLD_BAUMGARTE_FACTOR * inverseDt)
+                      * fminf(0.0f, -contact->depth + FR_WORLD_BAUMGARTE_SLOP);
 
         frVector2 relVelocity = frVector2Subtract(
-            frVector2Add(b2->mtn.velocity,
-                         frVector2ScalarMultiply(relNormal2,
-                                                 b2->mtn.angularVelocity)),
-            frVector2Add(b1->mtn.velocity,
-                         frVector2ScalarMultiply(relNormal1,
-                                                 b1->mtn.angularVelocity)));
+            frVector2Add(sb->velocities[i2],
+                         frVector2ScalarMultiply(point->relNormal2,
+                                                 sb->angularVelocities[i2])),
+            frVector2Add(sb->velocities[i1],
+                         frVector2ScalarMultiply(point->relNormal1,
+                                                 sb->angularVelocities[i1])));
+
+        float relVelocityDot = frVector2Dot(relVelocity, constraint->normal);
+
+        /*
+            NOTE: The bodies should separate at their approaching speed
+            before the warm start, scaled by the restitution coefficient,
+            unless the position correction already pushes them apart faster.
+        */
+        if (relVelocityDot < 0.0f)
+            point->bias = fmaxf(point->bias,
+                                -collision->restitution * relVelocityDot);
+
+        point->normalScalar = contact->cache.normalScalar;
+        point->tangentScalar = contact->cache.tangentScalar;
+    }
+}
 
-        float relVelocityDot = frVector2Dot(relVelocity, collision->direction);
+/* Resolves the collision of `constraint` between the bodies in `sb`. */
+void frResolveCollision(frSolverBodies *sb, frContactConstraint *constraint) {
+    if (sb == NULL || constraint == NULL) return;
 
-        float biasScalar = -(FR_WORLD_BAUMGARTE_FACTOR * inverseDt)
-                           * fminf(0.0f,
-                                   -collision->contacts[i].depth
-                                       + FR_WORLD_BAUMGARTE_SLOP);
+    int i1 = constraint->firstIndex, i2 = constraint->secondIndex;
 
-        float normalScalar = ((-(1.0f + collision->restitution)
-                               * relVelocityDot)
-                              + biasScalar)
-                             * collision->contacts[i].cache.normalMass;
+    float inverseMass1 = sb->inverseMasses[i1];
+    float inverseMass2 = sb->inverseMasses[i2];
 
-        {
-            float oldNormalScalar = collision->contacts[i].cache.normalScalar;
+    float inverseInertia1 = sb->inverseInertias[i1];
+    float inverseInertia2 = sb->inverseInertias[i2];
 
-            collision->contacts[i].cache.normalScalar =
-                fmaxf(0.0f, oldNormalScalar + normalScalar);
+    frVector2 velocity1 = sb->velocities[i1];
+    frVector2 velocity2 = sb->velocities[i2];
 
-            normalScalar = collision->contacts[i].cache.normalScalar
-                           - oldNormalScalar;
-        }
+    float angularVelocity1 = sb->angularVelocities[i1];
+    float angularVelocity2 = sb->angularVelocities[i2];
+
+    frVector2 normal = constraint->normal, tangent = constraint->tangent;
+
+    for (int i = 0; i < constraint->count; i++) {
+        frContactConstraintPoint *point = &constraint->points[i];
+
+        frVector2 relVelocity = frVector2Subtract(
+            frVector2Add(velocity2,
+                         frVector2ScalarMultiply(point->relNormal2,
+                                                 angularVelocity2)),
+            frVector2Add(velocity1,
+                         frVector2ScalarMultiply(point->relNormal1,
+                                                 angularVelocity1)));
+
+        float normalScalar = (-frVector2Dot(relVelocity, normal) + point->bias)
+                             * point->normalMass;
+
+        {
+            float oldNormalScalar = point->normalScalar;
 
-        frVector2 normalImpulse = frVector2ScalarMultiply(collision->direction,
-                                                          normalScalar);
+            point->normalScalar = fmaxf(0.0f, oldNormalScalar + normalScalar);
 
-        relVelocity = frVector2Subtract(
-            frVector2Add(b2->mtn.velocity,
-                         frVector2ScalarMultiply(relNormal2,
-                                                 b2->mtn.angularVelocity)),
-            frVector2Add(b1->mtn.velocity,
-                         frVector2ScalarMultiply(relNormal1,
-                                                 b1->mtn.angularVelocity)));
+            normalScalar = point->normalScalar - oldNormalScalar;
+        }
 
-        float tangentScalar = -frVector2Dot(relVelocity, ctxTangent)
-                              * collision->contacts[i].cache.tangentMass;
+        float tangentScalar = -frVector2Dot(relVelocity, tangent)
+                              * point->tangentMass;
 
         {
-            float maxTangentScalar = fabsf(
-                collision->friction
-                * collision->contacts[i].cache.normalScalar);
+            float maxTangentScalar = fabsf(constraint->friction
+                                           * point->normalScalar);
 
-            float oldTangentScalar = collision->contacts[i].cache.tangentScalar;
+            float oldTangentScalar = point->tangentScalar;
 
-            collision->contacts[i].cache.tangentScalar = fminf(
+            point->tangentScalar = fminf(
                 fmaxf(oldTangentScalar + tangentScalar, -maxTangentScalar),
                 maxTangentScalar);
 
-            tangentScalar = collision->contacts[i].cache.tangentScalar
-                            - oldTangentScalar;
+            tangentScalar = point->tangentScalar - oldTangentScalar;
         }
 
-        frVector2 tangentImpulse = frVector2ScalarMultiply(ctxTangent,
-                                                           tangentScalar);
+        frVector2 totalImpulse = frVector2Add(
+            frVector2ScalarMultiply(normal, normalScalar),
+            frVector2ScalarMultiply(tangent, tangentScalar));
 
-        {
-            frVector2 totalImpulse = frVector2Add(normalImpulse,
-                                                  tangentImpulse);
+        velocity1 = frVector2Subtract(
+            velocity1, frVector2ScalarMultiply(totalImpulse, inverseMass1));
+
+        angularVelocity1 -= inverseInertia1
+                            * frVector2Cross(point->relPosition1,
+                                             totalImpulse);
+
+        velocity2 = frVector2Add(
+            velocity2, frVector2ScalarMultiply(totalImpulse, inverseMass2));
+
+        angularVelocity2 += inverseInertia2
+                            * frVector2Cross(point->relPosition2,
+                                             totalImpulse);
+    }
+
+    frStoreSolverVelocity(sb, i1, velocity1, angularVelocity1);
+    frStoreSolverVelocity(sb, i2, velocity2, angularVelocity2);
+}
+
+/* 
+    Resolves the collisions of every lane of `batch` at once, 
+    between the bodies in `sb`.
+*/
+void frResolveCollisionBatch(frSolverBodies *sb, frContactBatch *batch) {
+    if (sb == NULL || batch == NULL) return;
+
+    float velocityX1[4], velocityY1[4], angularVelocity1[4];
+    float velocityX2[4], velocityY2[4], angularVelocity2[4];
+
+    /*
+        NOTE: An empty lane refers to the bodies of the first lane, 
+        but all of its effective masses are zero, so it never applies 
+        an impulse.
+    */
+    for (int k = 0; k < 4; k++) {
+        int i1 = batch->firstIndices[k], i2 = batch->secondIndices[k];
+
+        velocityX1[k] = sb->velocities[i1].x;
+        velocityY1[k] = sb->velocities[i1].y;
+
+        angularVelocity1[k] = sb->angularVelocities[i1];
+
+        velocityX2[k] = sb->velocities[i2].x;
+        velocityY2[k] = sb->velocities[i2].y;
+
+        angularVelocity2[k] = sb->angularVelocities[i2];
+    }
+
+#ifdef FR_USE_SSE2
+    {
+        __m128 velocityX1_ = _mm_loadu_ps(velocityX1);
+        __m128 velocityY1_ = _mm_loadu_ps(velocityY1);
+
+        __m128 angularVelocity1_ = _mm_loadu_ps(angularVelocity1);
+
+        __m128 velocityX2_ = _mm_loadu_ps(velocityX2);
+        __m128 velocityY2_ = _mm_loadu_ps(velocityY2);
+
+        __m128 angularVelocity2_ = _mm_loadu_ps(angularVelocity2);
+
+        __m128 inverseMass1 = _mm_loadu_ps(batch->inverseMass1);
+        __m128 inverseMass2 = _mm_loadu_ps(batch->inverseMass2);
+
+        __m128 inverseInertia1 = _mm_loadu_ps(batch->inverseInertia1);
+        __m128 inverseInertia2 = _mm_loadu_ps(batch->inverseInertia2);
+
+        __m128 normalX = _mm_loadu_ps(batch->normalX);
+        __m128 normalY = _mm_loadu_ps(batch->normalY);
+
+        __m128 tangentX = _mm_loadu_ps(batch->tangentX);
+        __m128 tangentY = _mm_loadu_ps(batch->tangentY);
+
+        __m128 friction = _mm_loadu_ps(batch->friction);
+
+        __m128 zero = _mm_setzero_ps();
+
+        // NOTE: This clears the sign bit of each lane, like `fabsf()`.
+        __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
 
-            b1->mtn.velocity = frVector2Subtract(
-                b1->mtn.velocity,
-                frVector2ScalarMultiply(totalImpulse, b1->mtn.inverseMass));
+        for (int i = 0; i < 2; i++) {
+            __m128 relPosition1X = _mm_loadu_ps(
+                batch->points[i].relPosition1X);
+            __m128 relPosition1Y = _mm_loadu_ps(
+                batch->points[i].relPosition1Y);
 
-            b1->mtn.angularVelocity -= b1->mtn.inverseInertia
-                                       * frVector2Cross(relPosition1,
-                                                        totalImpulse);
+            __m128 relPosition2X = _mm_loadu_ps(
+                batch->points[i].relPosition2X);
+            __m128 relPosition2Y = _mm_loadu_ps(
+                batch->points[i].relPosition2Y);
 
-            b2->mtn.velocity = frVector2Add(
-                b2->mtn.velocity,
-                frVector2ScalarMultiply(totalImpulse, b2->mtn.inverseMass));
+            __m128 relVelocityX = _mm_sub_ps(
+                _mm_add_ps(velocityX2_,
+                           _mm_mul_ps(_mm_loadu_ps(
+                                          batch->points[i].relNormal2X),
+                                      angularVelocity2_)),
+                _mm_add_ps(velocityX1_,
+                           _mm_mul_ps(_mm_loadu_ps(
+                                          batch->points[i].relNormal1X),
+                                      angularVelocity1_)));
 
-            b2->mtn.angularVelocity += b2->mtn.inverseInertia
-                                       * frVector2Cross(relPosition2,
-                                                        totalImpulse);
+            __m128 relVelocityY = _mm_sub_ps(
+                _mm_add_ps(velocityY2_,
+                           _mm_mul_ps(_mm_loadu_ps(
+                                          batch->points[i].relNormal2Y),
+                                      angularVelocity2_)),
+                _mm_add_ps(velocityY1_,
+                           _mm_mul_ps(_mm_loadu_ps(
+                                          batch->points[i].relNormal1Y),
+                                      angularVelocity1_)));
+
+            __m128 normalScalar = _mm_mul_ps(
+                _mm_sub_ps(_mm_loadu_ps(batch->points[i].bias),
+                           _mm_add_ps(_mm_mul_ps(relVelocityX, normalX),
+                                      _mm_mul_ps(relVelocityY, normalY))),
+                _mm_loadu_ps(batch->points[i].normalMass));
+
+            {
+                __m128 oldNormalScalar = _mm_loadu_ps(
+                    batch->points[i].normalScalar);
+
+                __m128 newNormalScalar = _mm_max_ps(
+                    zero, _mm_add_ps(oldNormalScalar, normalScalar));
+
+                _mm_storeu_ps(batch->points[i].normalScalar, newNormalScalar);
+
+                normalScalar = _mm_sub_ps(newNormalScalar, oldNormalScalar);
+            }
+
+            __m128 tangentScalar = _mm_mul_ps(
+                _mm_sub_ps(zero,
+                           _mm_add_ps(_mm_mul_ps(relVelocityX, tangentX),
+                                      _mm_mul_ps(relVelocityY, tangentY))),
+                _mm_loadu_ps(batch->points[i].tangentMass));
+
+            {
+                __m128 maxTangentScalar = _mm_and_ps(
+                    _mm_mul_ps(friction,
+                               _mm_loadu_ps(batch->points[i].normalScalar)),
+                    absMask);
+
+                __m128 oldTangentScalar = _mm_loadu_ps(
+                    batch->points[i].tangentScalar);
+
+                __m128 newTangentScalar = _mm_min_ps(
+                    _mm_max_ps(_mm_add_ps(oldTangentScalar, tangentScalar),
+                               _mm_sub_ps(zero, maxTangentScalar)),
+                    maxTangentScalar);
+
+                _mm_storeu_ps(batch->points[i].tangentScalar,
+                              newTangentScalar);
+
+                tangentScalar = _mm_sub_ps(newTangentScalar,
+                                           oldTangentScalar);
+            }
+
+            __m128 impulseX = _mm_add_ps(_mm_mul_ps(normalX, normalScalar),
+                                         _mm_mul_ps(tangentX, tangentScalar));
+            __m128 impulseY = _mm_add_ps(_mm_mul_ps(normalY, normalScalar),
+                                         _mm_mul_ps(tangentY, tangentScalar));
+
+            velocityX1_ = _mm_sub_ps(velocityX1_,
+                                     _mm_mul_ps(impulseX, inverseMass1));
+            velocityY1_ = _mm_sub_ps(velocityY1_,
+                                     _mm_mul_ps(impulseY, inverseMass1));
+
+            angularVelocity1_ = _mm_sub_ps(
+                angularVelocity1_,
+                _mm_mul_ps(inverseInertia1,
+                           _mm_sub_ps(_mm_mul_ps(relPosition1X, impulseY),
+                                      _mm_mul_ps(relPosition1Y, impulseX))));
+
+            velocityX2_ = _mm_add_ps(velocityX2_,
+                                     _mm_mul_ps(impulseX, inverseMass2));
+            velocityY2_ = _mm_add_ps(velocityY2_,
+                                     _mm_mul_ps(impulseY, inverseMass2));
+
+            angularVelocity2_ = _mm_add_ps(
+                angularVelocity2_,
+                _mm_mul_ps(inverseInertia2,
+                           _mm_sub_ps(_mm_mul_ps(relPosition2X, impulseY),
+                                      _mm_mul_ps(relPosition2Y, impulseX))));
+        }
+
+        _mm_storeu_ps(velocityX1, velocityX1_);
+        _mm_storeu_ps(velocityY1, velocityY1_);
+
+        _mm_storeu_ps(angularVelocity1, angularVelocity1_);
+
+        _mm_storeu_ps(velocityX2, velocityX2_);
+        _mm_storeu_ps(velocityY2, velocityY2_);
+
+        _mm_storeu_ps(angularVelocity2, angularVelocity2_);
+    }
+#else
+    for (int k = 0; k < 4; k++) {
+        for (int i = 0; i < 2; i++) {
+            float relVelocityX = (velocityX2[k]
+                                  + batch->points[i].relNormal2X[k]
+                                        * angularVelocity2[k])
+                                 - (velocityX1[k]
+                                    + batch->points[i].relNormal1X[k]
+                                          * angularVelocity1[k]);
+
+            float relVelocityY = (velocityY2[k]
+                                  + batch->points[i].relNormal2Y[k]
+                                        * angularVelocity2[k])
+                                 - (velocityY1[k]
+                                    + batch->points[i].relNormal1Y[k]
+                                          * angularVelocity1[k]);
+
+            float normalScalar = (batch->points[i].bias[k]
+                                  - (relVelocityX * batch->normalX[k]
+                                     + relVelocityY * batch->normalY[k]))
+                                 * batch->points[i].normalMass[k];
+
+            {
+                float oldNormalScalar = batch->points[i].normalScalar[k];
+
+                batch->points[i].normalScalar[k] =
+                    fmaxf(0.0f, oldNormalScalar + normalScalar);
+
+                normalScalar = batch->points[i].normalScalar[k]
+                               - oldNormalScalar;
+            }
+
+            float tangentScalar = -(relVelocityX * batch->tangentX[k]
+                                    + relVelocityY * batch->tangentY[k])
+                                  * batch->points[i].tangentMass[k];
+
+            {
+                float maxTangentScalar = fabsf(
+                    batch->friction[k] * batch->points[i].normalScalar[k]);
+
+                float oldTangentScalar = batch->points[i].tangentScalar[k];
+
+                batch->points[i].tangentScalar[k] = fminf(
+                    fmaxf(oldTangentScalar + tangentScalar, -maxTangentScalar),
+                    maxTangentScalar);
+
+                tangentScalar = batch->points[i].tangentScalar[k]
+                                - oldTangentScalar;
+            }
+
+            float impulseX = batch->normalX[k] * normalScalar
+                             + batch->tangentX[k] * tangentScalar;
+            float impulseY = batch->normalY[k] * normalScalar
+                             + batch->tangentY[k] * tangentScalar;
+
+            velocityX1[k] -= impulseX * batch->inverseMass1[k];
+            velocityY1[k] -= impulseY * batch->inverseMass1[k];
+
+            angularVelocity1[k] -= batch->inverseInertia1[k]
+                                   * (batch->points[i].relPosition1X[k]
+                                          * impulseY
+                                      - batch->points[i].relPosition1Y[k]
+                                            * impulseX);
+
+            velocityX2[k] += impulseX * batch->inverseMass2[k];
+            velocityY2[k] += impulseY * batch->inverseMass2[k];
+
+            angularVelocity2[k] += batch->inverseInertia2[k]
+                                   * (batch->points[i].relPosition2X[k]
+                                          * impulseY
+                                      - batch->points[i].relPosition2Y[k]
+                                            * impulseX);
         }
     }
+#endif
+
+    for (int k = 0; k < 4; k++) {
+        if (batch->indices[k] < 0) continue;
+
+        int i1 = batch->firstIndices[k], i2 = batch->secondIndices[k];
+
+        frStoreSolverVelocity(sb,
+                              i1,
+                              (frVector2) { .x = velocityX1[k],
+                                            .y = velocityY1[k] },
+                              angularVelocity1[k]);
+
+        frStoreSolverVelocity(sb,
+                              i2,
+                              (frVector2) { .x = velocityX2[k],
+                                            .y = velocityY2[k] },
+                              angularVelocity2[k]);
+    }
+}
+
+/* 
+    Copies the effective masses and the accumulated impulses 
+    of `constraint` back to `collision`.
+*/
+void frSaveAccumulatedImpulses(const frContactConstraint *constraint,
+                               frCollision *collision) {
+    if (constraint == NULL || collision == NULL) return;
+
+    for (int i = 0; i < constraint->count; i++) {
+        const frContactConstraintPoint *point = &constraint->points[i];
+
+        collision->contacts[i].cache.normalMass = point->normalMass;
+        collision->contacts[i].cache.normalScalar = point->normalScalar;
+
+        collision->contacts[i].cache.tangentMass = point->tangentMass;
+        collision->contacts[i].cache.tangentScalar = point->tangentScalar;
+    }
+}
+
+/* 
+    Copies the accumulated impulses of every lane of `batch` back to
+    the contact constraints in `constraints` they were packed from.
+*/
+void frUnpackCollisionBatch(const frContactBatch *batch,
+                            frContactConstraint *constraints) {
+    if (batch == NULL || constraints == NULL) return;
+
+    for (int k = 0; k < 4; k++) {
+        if (batch->indices[k] < 0) continue;
+
+        frContactConstraint *constraint = &constraints[batch->indices[k]];
+
+        for (int i = 0; i < constraint->count; i++) {
+            constraint->points[i].normalScalar =
+                batch->points[i].normalScalar[k];
+            constraint->points[i].tangentScalar =
+                batch->points[i].tangentScalar[k];
+        }
+    }
+}
+
+/* Copies the velocities of the `i`-th body of `sb` back to `b`. */
+void frScatterSolverBody(const frSolverBodies *sb, int i, frBody *b) {
+    if (sb == NULL || b == NULL) return;
+
+    b->mtn.velocity = sb->velocities[i];
+    b->mtn.angularVelocity = sb->angularVelocities[i];
 }
 
 /* Private Functions ======================================================> */
@@ -589,3 +1184,273 @@ static void frComputeBodyMass(frBody *b) {
 static FR_API_INLINE float frNormalizeAngle(float angle) {
     return angle - (TWO_PI * floorf((angle + -M_PI) * INVERSE_TWO_PI));
 }
+
+/* Sets the `angle` of `b` without waking `b` up, in radians. */
+static void frRotateBody(frBody *b, float angle) {
+    b->tx.angle = frNormalizeAngle(angle);
+
+    /*
+        NOTE: These values must be cached in order to 
+        avoid expensive computations as much as possible.
+    */
+    b->tx.rotation.sin_ = sinf(b->tx.angle);
+    b->tx.rotation.cos_ = cosf(b->tx.angle);
+}
+
+/* 
+    Stores the `velocity` and the `angularVelocity` of the `i`-th body 
+    of `sb`, unless its mass and its moment of inertia are infinite.
+*/
+static FR_API_INLINE void frStoreSolverVelocity(frSolverBodies *sb,
+                                                int i,
+                                                frVector2 velocity,
+                                                float angularVelocity) {
+    /*
+        NOTE: A body that cannot be moved may be shared by islands 
+        solved at the same time, so its velocities are never written.
+    */
+    if (sb->inverseMasses[i] <= 0.0f && sb->inverseInertias[i] <= 0.0f)
+        return;
+
+    sb->velocities[i] = velocity, sb->angularVelocities[i] = angularVelocity;
+}
+
+/* 
+    Checks whether each of the first `n` `points` lies inside 
+    the capsule-shaped `b`, then stores the results to `results`.
+*/
+static int frCapsuleContainsPoints(const frBody *b,
+                                   const frVector2 *points,
+                                   int n,
+                                   bool *results) {
+    float halfLength = 0.5f * frGetCapsuleLength(b->shape);
+    float radius = frGetCapsuleRadius(b->shape);
+
+    float radiusSqr = radius * radius;
+
+    int result = 0;
+
+    /*
+        NOTE: A point lies inside a capsule if and only if it lies within 
+        the radius of the line segment, which is tested here in the local 
+        space of `b` where the line segment lies along the y-axis.
+    */
+    for (int i = 0; i < n; i++) {
+        frVector2 delta = frVector2Subtract(points[i], b->tx.position);
+
+        float x = delta.x * b->tx.rotation.cos_
+                  + delta.y * b->tx.rotation.sin_;
+        float y = delta.y * b->tx.rotation.cos_
+                  - delta.x * b->tx.rotation.sin_;
+
+        y -= fminf(fmaxf(y, -halfLength), halfLength);
+
+        results[i] = (x * x) + (y * y) <= radiusSqr;
+
+        result += results[i];
+    }
+
+    return result;
+}
+
+/* 
+    Checks whether each of the first `n` `points` lies inside 
+    the circle-shaped `b`, then stores the results to `results`.
+*/
+static int frCircleContainsPoints(const frBody *b,
+                                  const frVector2 *points,
+                                  int n,
+                                  bool *results) {
+    frVector2 center = b->tx.position;
+
+    float radius = frGetCircleRadius(b->shape);
+    float radiusSqr = radius * radius;
+
+    int i = 0, result = 0;
+
+#ifdef FR_USE_SSE2
+    {
+        __m128 centerX = _mm_set1_ps(center.x);
+        __m128 centerY = _mm_set1_ps(center.y);
+
+        __m128 radiusSqr_ = _mm_set1_ps(radiusSqr);
+
+        for (; i + 4 <= n; i += 4) {
+            /* NOTE: Four points are de-interleaved into `x` and `y` lanes. */
+            __m128 lo = _mm_loadu_ps(&points[i].x);
+            __m128 hi = _mm_loadu_ps(&points[i + 2].x);
+
+            __m128 deltaX = _mm_sub_ps(
+                _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)),
+                centerX);
+
+            __m128 deltaY = _mm_sub_ps(
+                _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)),
+                centerY);
+
+            int mask = _mm_movemask_ps(
+                _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(deltaX, deltaX),
+                                        _mm_mul_ps(deltaY, deltaY)),
+                             radiusSqr_));
+
+            for (int j = 0; j < 4; j++) {
+                results[i + j] = (mask >> j) & 1;
+
+                result += results[i + j];
+            }
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        float deltaX = points[i].x - center.x;
+        float deltaY = points[i].y - center.y;
+
+        results[i] = (deltaX * deltaX) + (deltaY * deltaY) <= radiusSqr;
+
+        result += results[i];
+    }
+
+    return result;
+}
+
+/* 
+    Checks whether each of the first `n` `points` lies inside any child 
+    shape of the compound-shaped `b`, then stores the results to `results`.
+*/
+static int frCompoundContainsPoints(const frBody *b,
+                                    const frVector2 *points,
+                                    int n,
+                                    bool *results) {
+    memset(results, 0, n * sizeof *results);
+
+    /*
+        NOTE: Each child shape is tested as if it were the only shape 
+        of `b`, against the points that are not inside `b` yet.
+    */
+    frBody child = *b;
+
+    int result = 0;
+
+    for (int i = 0; i < frGetCompoundChildCount(b->shape); i++) {
+        child.shape = (frShape *) frGetCompoundChild(b->shape, i);
+        child.tx = frGetCompoundChildTransform(b->shape, b->tx, i);
+
+        for (int j = 0; j < n; j++) {
+            if (results[j] || !frBodyContainsPoint(&child, points[j]))
+                continue;
+
+            results[j] = true, result++;
+        }
+    }
+
+    return result;
+}
+
+/* 
+    Checks whether each of the first `n` `points` lies inside 
+    the polygon-shaped `b`, then stores the results to `results`.
+*/
+static int frPolygonContainsPoints(const frBody *b,
+                                   const frVector2 *points,
+                                   int n,
+                                   bool *results) {
+    const frVector2 *vertices = frGetPolygonVertices(b->shape);
+    const frVector2 *normals = frGetPolygonNormals(b->shape);
+
+    int vertexCount = frGetPolygonVertexCount(b->shape);
+
+    frVector2 worldNormals[FR_GEOMETRY_MAX_VERTEX_COUNT];
+
+    float offsets[FR_GEOMETRY_MAX_VERTEX_COUNT];
+
+    /*
+        NOTE: A point lies inside a convex polygon if and only if it lies
+        behind (or on) the supporting line of every edge, which is tested
+        here against the edges transformed to world space.
+    */
+    for (int j = 0; j < vertexCount; j++) {
+        worldNormals[j] = frVector2RotateTx(normals[j], b->tx);
+
+        offsets[j] = frVector2Dot(worldNormals[j],
+                                  frVector2Transform(vertices[j], b->tx));
+    }
+
+    int i = 0, result = 0;
+
+#ifdef FR_USE_SSE2
+    for (; i + 4 <= n; i += 4) {
+        __m128 lo = _mm_loadu_ps(&points[i].x);
+        __m128 hi = _mm_loadu_ps(&points[i + 2].x);
+
+        __m128 x = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 y = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+
+        __m128 outside = _mm_setzero_ps();
+
+        for (int j = 0; j < vertexCount; j++) {
+            __m128 dot = _mm_add_ps(
+                _mm_mul_ps(x, _mm_set1_ps(worldNormals[j].x)),
+                _mm_mul_ps(y, _mm_set1_ps(worldNormals[j].y)));
+
+            outside = _mm_or_ps(outside,
+                                _mm_cmpgt_ps(dot, _mm_set1_ps(offsets[j])));
+        }
+
+        int mask = _mm_movemask_ps(outside);
+
+        for (int j = 0; j < 4; j++) {
+            results[i + j] = !((mask >> j) & 1);
+
+            result += results[i + j];
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        results[i] = true;
+
+        for (int j = 0; j < vertexCount; j++) {
+            if (frVector2Dot(worldNormals[j], points[i]) > offsets[j]) {
+                results[i] = false;
+
+                break;
+            }
+        }
+
+        result += results[i];
+    }
+
+    return result;
+}
+
+/* 
+    Checks whether each of the first `n` `points` lies inside a solid tile 
+    of the tilemap-shaped `b`, then stores the results to `results`.
+*/
+static int frTilemapContainsPoints(const frBody *b,
+                                   const frVector2 *points,
+                                   int n,
+                                   bool *results) {
+    float inverseTileSize = 1.0f / frGetTilemapTileSize(b->shape);
+
+    int result = 0;
+
+    // NOTE: Each point is looked up directly in the tile grid of `b`.
+    for (int i = 0; i < n; i++) {
+        frVector2 delta = frVector2Subtract(points[i], b->tx.position);
+
+        float x = delta.x * b->tx.rotation.cos_
+                  + delta.y * b->tx.rotation.sin_;
+        float y = delta.y * b->tx.rotation.cos_
+                  - delta.x * b->tx.rotation.sin_;
+
+        results[i] = frGetTilemapTile(b->shape,
+                                      (int) floorf(x * inverseTileSize),
+                                      (int) floorf(y * inverseTileSize));
+
+        result += results[i];
+    }
+
+    return result;
+}
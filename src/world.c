@@ -38,21 +38,89 @@ typedef enum frWorldOpType_ {
     FR_OPT_REMOVE_BODY
 } frWorldOpType;
 
+/* 
+    A structure that represents a group of contact constraints 
+    that share no body whose velocity can be changed with the others.
+*/
+typedef struct frIsland_ {
+    int firstConstraint, constraintCount;
+    int firstBatch, batchCount;
+    int firstUnbatched, unbatchedCount;
+} frIsland;
+
 /* A structure that represents the key-value pair of the contact cache. */
 typedef struct frContactCacheEntry_ {
     frBodyPair key;
     frCollision value;
+    int firstIndex, secondIndex;
 } frContactCacheEntry;
 
+/* 
+    A structure that represents the entries of a rigid body 
+    in the spatial hash of a world.
+*/
+typedef struct frBodyProxy_ {
+    int index;
+    frAABB aabb;
+    bool moved;
+} frBodyProxy;
+
+/* A structure that represents the key-value pair of the body proxy cache. */
+typedef struct frBodyProxyEntry_ {
+    frBody *key;
+    frBodyProxy value;
+} frBodyProxyEntry;
+
+/* A structure that represents a range of cells in a spatial hash. */
+typedef struct frCellRange_ {
+    frVector2 min, max;
+} frCellRange;
+
+/* A structure that represents an element of a set of rigid bodies. */
+typedef struct frBodySetEntry_ {
+    frBody *key;
+    bool value;
+} frBodySetEntry;
+
+/* 
+    A structure that represents a region of interest in a world, 
+    which keeps track of the bodies entering and leaving it.
+*/
+typedef struct frWatcher_ {
+    frAABB aabb;
+    frCellRange range;
+    frBodySetEntry *visible;
+    frDynArray(frBody *) entered, left;
+    bool active;
+} frWatcher;
+
 /* A structure that represents a simulation container. */
 struct frWorld_ {
     frDynArray(frBody *) bodies;
     frRingBuffer(frContextNode) rbf;
     frSpatialHash *hash;
+    frBodyProxyEntry *proxies;
+    frDynArray(frBody *) movedBodies;
+    int hashUpdateCount;
     frContactCacheEntry *cache;
     float accumulator, timestamp;
     frCollisionHandler handler;
     frVector2 gravity;
+    frDynArray(frWatcher) watchers;
+    frSpatialHash *watcherHash;
+    bool watcherHashOutdated;
+    int watcherCount;
+    frDynArray(frParticleSystem *) particleSystems;
+    frSolverBodies solverBodies;
+    frDynArray(frContactConstraint) constraints;
+    frDynArray(frContactBatch) batches;
+    frDynArray(unsigned int) batchMasks;
+    frDynArray(int) unbatched;
+    frDynArray(int) islandParents, islandIds;
+    frDynArray(int) islandConstraints;
+    frDynArray(frIsland) islands;
+    frDynArray(bool) islandAwake;
+    frDynArray(float) islandSleepTimes;
 };
 
 /* 
@@ -72,9 +140,129 @@ typedef struct frRaycastHashQueryCtx_ {
     frRaycastQueryFunc func;
     frWorld *world;
     frRay ray;
+    frRaycastHit *raycastHit;
     void *ctx;
 } frRaycastHashQueryCtx;
 
+/* 
+    A structure that represents the context data 
+    for `frShapeCastHashQueryCallback()`.
+*/
+typedef struct frShapeCastHashQueryCtx_ {
+    frWorld *world;
+    const frShape *shape;
+    frTransform tx;
+    frVector2 translation;
+    frRaycastHit *raycastHit;
+    frBodyFilterFunc filter;
+    void *userData;
+} frShapeCastHashQueryCtx;
+
+/* 
+    A structure that represents the context data 
+    for the callback functions of `frQueryWorldAABB()`, 
+    `frQueryWorldPoint()`, `frQueryWorldShape()` 
+    and `frQueryWorldWithinDistance()`.
+*/
+typedef struct frOverlapHashQueryCtx_ {
+    frWorld *world;
+    frAABB aabb;
+    frVector2 point;
+    const frShape *shape;
+    frTransform tx;
+    float distance;
+    frBody **bodies;
+    int count, maxCount;
+} frOverlapHashQueryCtx;
+
+/* 
+    A structure that represents the context data 
+    for `frCandidateHashQueryCallback()`.
+*/
+typedef struct frCandidateHashQueryCtx_ {
+    frDynArray(int) candidates;
+} frCandidateHashQueryCtx;
+
+/* A structure that represents a body found by `frQueryWorldNearest()`. */
+typedef struct frNearestBody_ {
+    frBody *body;
+    float distance;
+} frNearestBody;
+
+/* 
+    A structure that represents the context data 
+    for `frNearestHashQueryCallback()`.
+*/
+typedef struct frNearestHashQueryCtx_ {
+    frWorld *world;
+    frVector2 point;
+    frBodyFilterFunc filter;
+    void *userData;
+    frNearestBody *heap;
+    int count, maxCount;
+    float maxDistance;
+} frNearestHashQueryCtx;
+
+/* A structure that represents a query point sorted by its cell position. */
+typedef struct frPointCellEntry_ {
+    frVector2 cell;
+    int index;
+} frPointCellEntry;
+
+/* 
+    A structure that represents the context data 
+    for `frWatcherHashQueryCallback()`.
+*/
+typedef struct frWatcherHashQueryCtx_ {
+    frWorld *world;
+    frBody *body;
+    frAABB aabb;
+} frWatcherHashQueryCtx;
+
+/* 
+    A structure that represents the context data 
+    for `frOcclusionHashQueryCallback()`.
+*/
+typedef struct frOcclusionHashQueryCtx_ {
+    frWorld *world;
+    const frBody *target;
+    frRay ray;
+    bool occluded;
+} frOcclusionHashQueryCtx;
+
+/* A structure that represents an impulse to be applied to a body. */
+typedef struct frBodyImpulse_ {
+    frBody *body;
+    frVector2 impulse;
+} frBodyImpulse;
+
+/* 
+    A structure that represents the context data 
+    for `frWatcherBodyHashQueryCallback()`.
+*/
+typedef struct frWatcherBodyHashQueryCtx_ {
+    frWorld *world;
+    int watcherIndex;
+} frWatcherBodyHashQueryCtx;
+
+/* 
+    A structure that represents the context data 
+    for `frTilemapPointHashQueryCallback()`.
+*/
+typedef struct frTilemapPointHashQueryCtx_ {
+    const frShape *tilemap;
+    frVector2 point;
+    float distanceSqr;
+} frTilemapPointHashQueryCtx;
+
+/* Constants ==============================================================> */
+
+/* 
+    The largest distance used for the bounds of a ray packet, 
+    which keeps the bounds finite even for rays of `FLT_MAX` length.
+*/
+static const float RAY_PACKET_MAX_DISTANCE = 1e18f;
+
 /* Private Function Prototypes ============================================> */
 
 /* 
@@ -84,20 +272,248 @@ typedef struct frRaycastHashQueryCtx_ {
 static bool frPreStepHashQueryCallback(frContextNode ctx);
 
 /* 
-    A callback function for `frQuerySpatialHash()` 
-    that will be called during `frComputeRaycastForWorld()`.
+    A callback function for `frQuerySpatialHashRay()` 
+    that will be called during `frComputeWorldRaycast()`.
 */
 static bool frRaycastHashQueryCallback(frContextNode ctx);
 
+/* 
+    A callback function for `frQuerySpatialHashRay()` 
+    that will be called during `frComputeWorldRaycastClosest()`.
+*/
+static bool frRaycastClosestHashQueryCallback(frContextNode ctx);
+
+/* 
+    A callback function for `frQuerySpatialHashRay()` 
+    that will be called during `frComputeWorldRaycastAny()`.
+*/
+static bool frRaycastAnyHashQueryCallback(frContextNode ctx);
+
+/* 
+    Casts the ray in `queryCtx` against the body at `bodyIndex`,
+    assuming that the direction of the ray is already normalized.
+*/
+static bool frComputeRaycastForBody(const frRaycastHashQueryCtx *queryCtx,
+                                    int bodyIndex,
+                                    frRaycastHit *raycastHit);
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frComputeWorldShapeCast()`.
+*/
+static bool frShapeCastHashQueryCallback(frContextNode ctx);
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frComputeWorldRaycastBatch()` 
+    and `frQueryWorldPoints()`.
+*/
+static bool frCandidateHashQueryCallback(frContextNode ctx);
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frQueryWorldAABB()`.
+*/
+static bool frAABBHashQueryCallback(frContextNode ctx);
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frQueryWorldPoint()`.
+*/
+static bool frPointHashQueryCallback(frContextNode ctx);
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frQueryWorldShape()`.
+*/
+static bool frShapeHashQueryCallback(frContextNode ctx);
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frQueryWorldWithinDistance()`.
+*/
+static bool frDistanceHashQueryCallback(frContextNode ctx);
+
+/* 
+    A callback function for `frQuerySpatialHashNearest()` 
+    that will be called during `frQueryWorldNearest()`.
+*/
+static bool frNearestHashQueryCallback(frContextNode ctx);
+
+/* Compares the cell positions of two query points. */
+static int frComparePointCellEntries(const void *x, const void *y);
+
+/* Returns the distance between `point` and `b`. */
+static float frGetBodyPointDistance(const frBody *b, frVector2 point);
+
+/* 
+    Returns the distance between `point` and `s` with the transform `tx`,
+    assuming `point` does not lie inside `s`.
+*/
+static float frGetShapePointDistance(const frShape *s,
+                                     frTransform tx,
+                                     frVector2 point);
+
+/* 
+    Moves the root of the max-heap `heap` with `count` elements down 
+    until the heap property is restored.
+*/
+static void frSiftDownNearestBodies(frNearestBody *heap, int count);
+
+/* Returns `true` if `aabb1` and `aabb2` overlap. */
+static bool frCheckAABBOverlap(frAABB aabb1, frAABB aabb2);
+
+/* Returns the AABB of the first `n` `rays`. */
+static frAABB frGetRayPacketAABB(const frRay *rays, int n);
+
+/* 
+    Casts the first `n` `rays` against `candidates` (the indices of 
+    the bodies in `w`), then stores the closest hit for each ray to `hits`.
+*/
+static int frComputeRayPacket(const frWorld *w,
+                              const frRay *rays,
+                              int n,
+                              const int *candidates,
+                              int candidateCount,
+                              frRaycastHit *hits);
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frUpdateBodyWatchers()`.
+*/
+static bool frWatcherHashQueryCallback(frContextNode ctx);
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frAddWatcherToWorld()` 
+    and `frSetWatcherAABB()`.
+*/
+static bool frWatcherBodyHashQueryCallback(frContextNode ctx);
+
+/* 
+    A callback function for `frQuerySpatialHashRay()` 
+    that will be called during `frApplyRadialImpulse()`.
+*/
+static bool frOcclusionHashQueryCallback(frContextNode ctx);
+
+/* 
+    A callback function for `frQueryTilemapRects()` 
+    that will be called during `frGetBodyPointDistance()`.
+*/
+static bool frTilemapPointHashQueryCallback(frContextNode ctx);
+
+/* 
+    A callback function for `frShapeCastHashQueryCallback()` 
+    that will be called during `frPredictTrajectory()`.
+*/
+static bool frTrajectoryBodyFilter(const frBody *b, void *ctx);
+
+/* Returns the range of cells in `w` that `aabb` overlaps. */
+static frCellRange frGetCellRange(const frWorld *w, frAABB aabb);
+
+/* Returns `true` if `range1` and `range2` cover the same cells. */
+static bool frCheckCellRangeEqual(frCellRange range1, frCellRange range2);
+
+/* 
+    Makes `b` visible (or invisible) to the watcher at `watcherIndex` in `w`,
+    then records the change to the enter (or leave) set of the watcher.
+*/
+static void frSetBodyVisibility(frWorld *w,
+                                int watcherIndex,
+                                frBody *b,
+                                bool visible);
+
+/* 
+    Updates the visibility of `b` in `w` to the watchers that can see 
+    either its `oldAABB` or its `newAABB`.
+*/
+static void frUpdateBodyWatchers(frWorld *w,
+                                 frBody *b,
+                                 frAABB oldAABB,
+                                 frAABB newAABB);
+
+/* 
+    Rebuilds the spatial hash of the watchers in `w`,
+    but only if the spatial hash has been marked as outdated.
+*/
+static void frUpdateWatcherHash(frWorld *w);
+
+/* Checks if `b` is neither static nor sleeping. */
+static bool frIsBodyAwake(const frBody *b);
+
 /* Finds all pairs of bodies in `w` that are colliding. */
 static void frPreStepWorld(frWorld *w);
 
 /* 
-    Clears the accumulated forces on each body in `w`, 
-    then clears the spatial hash of `w`. 
+    Copies the motion data of each body in `w` 
+    to the solver bodies of `w`.
+*/
+static void frGatherSolverBodies(frWorld *w);
+
+/* 
+    Copies the velocities of the solver bodies of `w` 
+    back to each body in `w`.
+*/
+static void frScatterSolverBodies(frWorld *w);
+
+/* Returns the index of the root of the island of the `i`-th body. */
+static int frFindIslandRoot(int *parents, int i);
+
+/* 
+    Returns the index of the body at `i1` or `i2` in `sb` whose velocity 
+    can be changed, or `-1` if there is no such body.
+*/
+static int frGetIslandBodyIndex(const frSolverBodies *sb, int i1, int i2);
+
+/* 
+    Splits the cached contacts of `w` into islands, where the bodies 
+    that cannot be moved separate the islands, then wakes up every island 
+    with an awake body and collects the contacts of the awake islands.
+*/
+static void frBuildIslands(frWorld *w);
+
+/* 
+    Packs the contact constraints of each island of `w` into batches 
+    of four, none of which share a body whose velocity can be changed.
+*/
+static void frBatchCollisions(frWorld *w);
+
+/* Resolves the contact constraints of the `island` of `w`. */
+static void frSolveIsland(frWorld *w, const frIsland *island);
+
+/* 
+    Updates the sleep timer of each awake body in `w` with `dt`, 
+    then puts every island that has been resting long enough to sleep.
+*/
+static void frUpdateSleepingBodies(frWorld *w, float dt);
+
+/* 
+    Adds (or removes) the pending bodies to `w`, then clears 
+    the accumulated forces on each body in `w`.
 */
 static void frPostStepWorld(frWorld *w);
 
+/* 
+    Erases the cached contacts of the body at `index` in `w`, then moves 
+    the cached contacts of the body at `lastIndex` to `index`.
+*/
+static void frRemoveBodyFromCache(frWorld *w, int index, int lastIndex);
+
+/* 
+    Erases the entries of the body at `index` in `w` from the spatial hash 
+    of `w`, then moves the entries of the body at `lastIndex` to `index`.
+*/
+static void frRemoveBodyFromHash(frWorld *w, int index, int lastIndex);
+
+/* Marks `b` in `w` as moved, so that its entries will be updated. */
+static void frMarkBodyMoved(frWorld *w, const frBody *b);
+
+/* 
+    Moves the entries of each body in `w` that has been marked as moved 
+    to the cells that its current AABB overlaps.
+*/
+static void frUpdateWorldHash(frWorld *w);
+
 /* Public Functions =======================================================> */
 
 /* 
@@ -114,6 +530,26 @@ frWorld *frCreateWorld(frVector2 gravity, float cellSize) {
 
     frInitRingBuffer(result->rbf, FR_WORLD_MAX_OBJECT_COUNT);
 
+    frInitDynArray(result->movedBodies);
+
+    frInitDynArray(result->watchers);
+
+    result->watcherHash = frCreateSpatialHash(cellSize);
+
+    frInitDynArray(result->particleSystems);
+
+    frInitDynArray(result->constraints);
+    frInitDynArray(result->batches);
+    frInitDynArray(result->batchMasks);
+    frInitDynArray(result->unbatched);
+
+    frInitDynArray(result->islandParents);
+    frInitDynArray(result->islandIds);
+    frInitDynArray(result->islandConstraints);
+    frInitDynArray(result->islands);
+    frInitDynArray(result->islandAwake);
+    frInitDynArray(result->islandSleepTimes);
+
     return result;
 }
 
@@ -126,11 +562,42 @@ void frReleaseWorld(frWorld *w) {
 
     frReleaseSpatialHash(w->hash);
 
+    hmfree(w->proxies);
+
+    frReleaseDynArray(w->movedBodies);
+
     frReleaseDynArray(w->bodies);
     frReleaseRingBuffer(w->rbf);
 
     hmfree(w->cache);
 
+    for (int i = 0; i < frGetDynArrayLength(w->watchers); i++)
+        (void) frRemoveWatcherFromWorld(w, i);
+
+    frReleaseSpatialHash(w->watcherHash);
+
+    frReleaseDynArray(w->watchers);
+
+    for (int i = 0; i < frGetDynArrayLength(w->particleSystems); i++)
+        frReleaseParticleSystem(frGetDynArrayValue(w->particleSystems, i));
+
+    frReleaseDynArray(w->particleSystems);
+
+    // NOTE: All arrays of the solver bodies share a single block.
+    free(w->solverBodies.positions);
+
+    frReleaseDynArray(w->constraints);
+    frReleaseDynArray(w->batches);
+    frReleaseDynArray(w->batchMasks);
+    frReleaseDynArray(w->unbatched);
+
+    frReleaseDynArray(w->islandParents);
+    frReleaseDynArray(w->islandIds);
+    frReleaseDynArray(w->islandConstraints);
+    frReleaseDynArray(w->islands);
+    frReleaseDynArray(w->islandAwake);
+    frReleaseDynArray(w->islandSleepTimes);
+
     free(w);
 }
 
@@ -138,8 +605,25 @@ void frReleaseWorld(frWorld *w) {
 void frClearWorld(frWorld *w) {
     if (w == NULL) return;
 
+    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++) {
+        frBody *body = frGetDynArrayValue(w->bodies, i);
+
+        for (int j = 0; j < frGetDynArrayLength(w->watchers); j++)
+            if (frGetDynArrayValue(w->watchers, j).active)
+                frSetBodyVisibility(w, j, body, false);
+
+        frSetBodyWorld(body, NULL);
+    }
+
+    // NOTE: The cached contacts refer to the bodies by their indices.
+    hmfree(w->cache);
+
     frClearSpatialHash(w->hash);
 
+    hmfree(w->proxies);
+
+    frSetDynArrayLength(w->movedBodies, 0);
+
     frSetDynArrayLength(w->bodies, 0);
 }
 
@@ -163,16 +647,47 @@ bool frRemoveBodyFromWorld(frWorld *w, frBody *b) {
                                                 .ctx = b }));
 }
 
-/* Checks if the given `b`ody is in `w`. */
-bool frIsBodyInWorld(const frWorld *w, frBody *b) {
-    if (w == NULL || b == NULL) return false;
+/* 
+    Adds `ps` to `w`, so that `ps` is simulated along with the rigid bodies 
+    of `w` (and released along with `w`).
+*/
+bool frAddParticleSystemToWorld(frWorld *w, frParticleSystem *ps) {
+    if (w == NULL || ps == NULL) return false;
 
-    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
-        if (frGetDynArrayValue(w->bodies, i) == b) return true;
+    for (int i = 0; i < frGetDynArrayLength(w->particleSystems); i++)
+        if (frGetDynArrayValue(w->particleSystems, i) == ps) return false;
+
+    frDynArrayPush(w->particleSystems, ps);
+
+    return true;
+}
+
+/* Removes `ps` from `w`. */
+bool frRemoveParticleSystemFromWorld(frWorld *w, frParticleSystem *ps) {
+    if (w == NULL || ps == NULL) return false;
+
+    int lastIndex = frGetDynArrayLength(w->particleSystems) - 1;
+
+    for (int i = 0; i <= lastIndex; i++)
+        if (frGetDynArrayValue(w->particleSystems, i) == ps) {
+            frDynArraySwap(frParticleSystem *,
+                           w->particleSystems,
+                           i,
+                           lastIndex);
+
+            frSetDynArrayLength(w->particleSystems, lastIndex);
+
+            return true;
+        }
 
     return false;
 }
 
+/* Checks if the given `b`ody is in `w`. */
+bool frIsBodyInWorld(const frWorld *w, frBody *b) {
+    return (w != NULL && b != NULL) && (frGetBodyWorld(b) == w);
+}
+
 /* Returns a rigid body at the given `i`ndex in `w`. */
 frBody *frGetBodyInWorld(const frWorld *w, int i) {
     if (w == NULL || i < 0 || i >= frGetDynArrayLength(w->bodies)) return NULL;
@@ -190,6 +705,27 @@ frVector2 frGetWorldGravity(const frWorld *w) {
     return (w != NULL) ? w->gravity : frStructZero(frVector2);
 }
 
+/* 
+    Notifies `w` that the transform or the shape of `b` has changed,
+    so that the broad phase of `w` can be updated before the next query.
+*/
+void frInvalidateBodyInWorld(frWorld *w, const frBody *b) {
+    if (w != NULL && b != NULL) frMarkBodyMoved(w, b);
+}
+
+/* 
+    Returns the total number of times that the entries of a body 
+    in the spatial hash of `w` have been updated after moving.
+*/
+int frGetWorldHashUpdateCount(const frWorld *w) {
+    return (w != NULL) ? w->hashUpdateCount : 0;
+}
+
+/* Returns the number of islands that were solved during the last step of `w`. */
+int frGetWorldIslandCount(const frWorld *w) {
+    return (w != NULL) ? frGetDynArrayLength(w->islands) : 0;
+}
+
 /* Sets the collision event `handler` of `w`. */
 void frSetWorldCollisionHandler(frWorld *w, frCollisionHandler handler) {
     if (w != NULL) w->handler = handler;
@@ -214,16 +750,26 @@ void frStepWorld(frWorld *w, float dt) {
     }
 
     for (int i = 0; i < frGetDynArrayLength(w->bodies); i++) {
-        frApplyGravityToBody(frGetDynArrayValue(w->bodies, i), w->gravity);
+        frBody *body = frGetDynArrayValue(w->bodies, i);
 
-        frIntegrateForBodyVelocity(frGetDynArrayValue(w->bodies, i), dt);
-    }
+        if (frIsBodySleeping(body)) continue;
+
+        frApplyGravityToBody(body, w->gravity);
 
-    int entryCount = hmlen(w->cache);
+        frIntegrateForBodyVelocity(body, dt);
+    }
 
-    for (int j = 0; j < entryCount; j++) {
+    /*
+        NOTE: `hmdel()` moves the last entry into the deleted one,
+        so the entries are visited in reverse order.
+    */
+    for (int j = hmlen(w->cache) - 1; j >= 0; j--) {
         frBodyPair key = w->cache[j].key;
 
+        // NOTE: The contacts between resting bodies are kept as they are.
+        if (!frIsBodyAwake(key.first) && !frIsBodyAwake(key.second))
+            continue;
+
         const frCollision *value = &w->cache[j].value;
 
         for (int k = 0; k < value->count; k++)
@@ -234,22 +780,69 @@ void frStepWorld(frWorld *w, float dt) {
             }
     }
 
-    for (int j = 0; j < hmlen(w->cache); j++)
-        frApplyAccumulatedImpulses(w->cache[j].key.first,
-                                   w->cache[j].key.second,
-                                   &w->cache[j].value);
+    frGatherSolverBodies(w);
+
+    frBuildIslands(w);
+
+    if (frGetDynArrayCapacity(w->constraints) < hmlen(w->cache))
+        frSetDynArrayCapacity(w->constraints, hmlen(w->cache));
+
+    frSetDynArrayLength(w->constraints, hmlen(w->cache));
 
     float inverseDt = 1.0f / dt;
 
-    for (int i = 0; i < FR_WORLD_ITERATION_COUNT; i++)
-        for (int j = 0; j < hmlen(w->cache); j++)
-            frResolveCollision(w->cache[j].key.first,
-                               w->cache[j].key.second,
-                               &w->cache[j].value,
-                               inverseDt);
+    // NOTE: Only the contacts of the awake islands are resolved.
+    for (int l = 0; l < frGetDynArrayLength(w->islandConstraints); l++) {
+        int j = frGetDynArrayValue(w->islandConstraints, l);
 
-    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
-        frIntegrateForBodyPosition(frGetDynArrayValue(w->bodies, i), dt);
+        frPrepareCollision(&w->solverBodies,
+                           w->cache[j].firstIndex,
+                           w->cache[j].secondIndex,
+                           &w->cache[j].value,
+                           inverseDt,
+                           &w->constraints.buffer[j]);
+    }
+
+    frBatchCollisions(w);
+
+    int islandCount = frGetDynArrayLength(w->islands);
+
+    /*
+        NOTE: No two islands share a body whose velocity can be changed,
+        so they can be solved in any order (or at the same time, when 
+        compiled with OpenMP) and still give the same results.
+    */
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) if (islandCount > 1)
+#endif
+    for (int i = 0; i < islandCount; i++)
+        frSolveIsland(w, &w->islands.buffer[i]);
+
+    frScatterSolverBodies(w);
+
+    /*
+        NOTE: The particles push the bodies after the constraint solver,
+        so that their impulses are not undone before the bodies move.
+    */
+    for (int i = 0; i < frGetDynArrayLength(w->particleSystems); i++)
+        frStepParticleSystem(frGetDynArrayValue(w->particleSystems, i), w, dt);
+
+    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++) {
+        frBody *body = frGetDynArrayValue(w->bodies, i);
+
+        if (!frIsBodyAwake(body)) continue;
+
+        frIntegrateForBodyPosition(body, dt);
+
+        /*
+            NOTE: The entries of the moved bodies will be updated 
+            by the first query (or the next step) that needs them, 
+            and the sleeping bodies keep their entries as they are.
+        */
+        frMarkBodyMoved(w, body);
+    }
+
+    frUpdateSleepingBodies(w, dt);
 
     for (int j = 0; j < hmlen(w->cache); j++) {
         frCollision *collision = &w->cache[j].value;
@@ -262,190 +855,2156 @@ void frStepWorld(frWorld *w, float dt) {
 }
 
 /* 
-    Proceeds the simulation over the time step `dt`, in seconds,
-    which will always run independent of the framerate.
+    Adds a watcher for the region `aabb` to `w`, which sees every body 
+    whose AABB overlaps `aabb`, then returns its ID,
+    or `-1` if no more watchers can be added.
 */
-void frUpdateWorld(frWorld *w, float dt) {
-    if (w == NULL || dt <= 0.0f) return;
+int frAddWatcherToWorld(frWorld *w, frAABB aabb) {
+    if (w == NULL) return -1;
 
-    float currentTime = frGetCurrentTime();
+    int result = 0;
 
-    if (w->timestamp <= 0.0f) {
-        w->timestamp = currentTime;
+    for (; result < frGetDynArrayLength(w->watchers); result++)
+        if (!frGetDynArrayValue(w->watchers, result).active) break;
 
-        return;
-    }
+    if (result >= FR_WORLD_MAX_OBJECT_COUNT) return -1;
 
-    float elapsedTime = currentTime - w->timestamp;
+    frWatcher watcher = { .aabb = aabb,
+                          .range = frGetCellRange(w, aabb),
+                          .active = true };
 
-    w->timestamp = currentTime, w->accumulator += elapsedTime;
+    frInitDynArray(watcher.entered);
+    frInitDynArray(watcher.left);
 
-    for (; w->accumulator >= dt; w->accumulator -= dt)
-        frStepWorld(w, dt);
-}
+    if (result < frGetDynArrayLength(w->watchers))
+        w->watchers.buffer[result] = watcher;
+    else
+        frDynArrayPush(w->watchers, watcher);
 
-/* 
+    w->watcherHashOutdated = true, w->watcherCount++;
+
+    frUpdateWorldHash(w);
+
+    frQuerySpatialHash(w->hash,
+                       aabb,
+                       frWatcherBodyHashQueryCallback,
+                       &(frWatcherBodyHashQueryCtx) { .world = w,
+                                                      .watcherIndex = result });
+
+    return result;
+}
+
+/* Removes the watcher with the given `id` from `w`. */
+bool frRemoveWatcherFromWorld(frWorld *w, int id) {
+    if (w == NULL || id < 0 || id >= frGetDynArrayLength(w->watchers)
+        || !frGetDynArrayValue(w->watchers, id).active)
+        return false;
+
+    frWatcher *watcher = &w->watchers.buffer[id];
+
+    hmfree(watcher->visible);
+
+    frReleaseDynArray(watcher->entered);
+    frReleaseDynArray(watcher->left);
+
+    watcher->active = false;
+
+    w->watcherHashOutdated = true, w->watcherCount--;
+
+    return true;
+}
+
+/* 
+    Sets the region of the watcher with the given `id` in `w` to `aabb`, 
+    then updates its enter and leave sets.
+*/
+bool frSetWatcherAABB(frWorld *w, int id, frAABB aabb) {
+    if (w == NULL || id < 0 || id >= frGetDynArrayLength(w->watchers)
+        || !frGetDynArrayValue(w->watchers, id).active)
+        return false;
+
+    frUpdateWorldHash(w);
+
+    frWatcher *watcher = &w->watchers.buffer[id];
+
+    frCellRange range = frGetCellRange(w, aabb);
+
+    watcher->aabb = aabb;
+
+    if (!frCheckCellRangeEqual(range, watcher->range)) {
+        watcher->range = range;
+
+        w->watcherHashOutdated = true;
+    }
+
+    for (int i = hmlen(watcher->visible) - 1; i >= 0; i--) {
+        frBody *body = watcher->visible[i].key;
+
+        if (!frCheckAABBOverlap(aabb, hmget(w->proxies, body).aabb))
+            frSetBodyVisibility(w, id, body, false);
+    }
+
+    frQuerySpatialHash(w->hash,
+                       aabb,
+                       frWatcherBodyHashQueryCallback,
+                       &(frWatcherBodyHashQueryCtx) { .world = w,
+                                                      .watcherIndex = id });
+
+    return true;
+}
+
+/* 
+    Returns the bodies that have entered the watcher with the given `id` 
+    in `w` since its events were last cleared, and stores their number
+    to `count`.
+*/
+frBody *const *frGetWatcherEnterSet(const frWorld *w, int id, int *count) {
+    if (w == NULL || id < 0 || id >= frGetDynArrayLength(w->watchers)
+        || !frGetDynArrayValue(w->watchers, id).active) {
+        if (count != NULL) *count = 0;
+
+        return NULL;
+    }
+
+    const frWatcher *watcher = &w->watchers.buffer[id];
+
+    if (count != NULL) *count = frGetDynArrayLength(watcher->entered);
+
+    return watcher->entered.buffer;
+}
+
+/* 
+    Returns the bodies that have left the watcher with the given `id` 
+    in `w` since its events were last cleared, and stores their number
+    to `count`.
+*/
+frBody *const *frGetWatcherLeaveSet(const frWorld *w, int id, int *count) {
+    if (w == NULL || id < 0 || id >= frGetDynArrayLength(w->watchers)
+        || !frGetDynArrayValue(w->watchers, id).active) {
+        if (count != NULL) *count = 0;
+
+        return NULL;
+    }
+
+    const frWatcher *watcher = &w->watchers.buffer[id];
+
+    if (count != NULL) *count = frGetDynArrayLength(watcher->left);
+
+    return watcher->left.buffer;
+}
+
+/* Clears the enter and leave sets of the watcher with the given `id` in `w`. */
+void frClearWatcherEvents(frWorld *w, int id) {
+    if (w == NULL || id < 0 || id >= frGetDynArrayLength(w->watchers)
+        || !frGetDynArrayValue(w->watchers, id).active)
+        return;
+
+    frSetDynArrayLength(w->watchers.buffer[id].entered, 0);
+    frSetDynArrayLength(w->watchers.buffer[id].left, 0);
+}
+
+/* Checks if `b` is visible to the watcher with the given `id` in `w`. */
+bool frIsBodyInWatcher(const frWorld *w, int id, frBody *b) {
+    if (w == NULL || b == NULL || id < 0
+        || id >= frGetDynArrayLength(w->watchers)
+        || !frGetDynArrayValue(w->watchers, id).active)
+        return false;
+
+    return hmgeti(w->watchers.buffer[id].visible, b) >= 0;
+}
+
+/* 
+    Applies an impulse of `magnitude` pointing away from `center` to each 
+    dynamic body in `w` within `radius` of `center` that passes `filter` 
+    (which may be `NULL`), scaled down by `falloff` over the distance; 
+    if `occlusion` is `true`, the bodies behind static bodies are shielded.
+    Returns the number of bodies affected.
+*/
+int frApplyRadialImpulse(frWorld *w,
+                         frVector2 center,
+                         float radius,
+                         float magnitude,
+                         frFalloffType falloff,
+                         bool occlusion,
+                         frBodyFilterFunc filter,
+                         void *userData) {
+    if (w == NULL || radius <= 0.0f) return 0;
+
+    frUpdateWorldHash(w);
+
+    frCandidateHashQueryCtx queryCtx;
+
+    frInitDynArray(queryCtx.candidates);
+
+    frQuerySpatialHash(w->hash,
+                       (frAABB) { .x = center.x - radius,
+                                  .y = center.y - radius,
+                                  .width = 2.0f * radius,
+                                  .height = 2.0f * radius },
+                       frCandidateHashQueryCallback,
+                       &queryCtx);
+
+    frDynArray(frBodyImpulse) impulses;
+
+    frInitDynArray(impulses);
+
+    for (int i = 0; i < frGetDynArrayLength(queryCtx.candidates); i++) {
+        frBody *body = frGetDynArrayValue(
+            w->bodies, frGetDynArrayValue(queryCtx.candidates, i));
+
+        if (frGetBodyType(body) != FR_BODY_DYNAMIC
+            || (filter != NULL && !filter(body, userData)))
+            continue;
+
+        float distance = frGetBodyPointDistance(body, center);
+
+        if (distance > radius) continue;
+
+        frVector2 direction = frVector2Subtract(frGetBodyPosition(body),
+                                                center);
+
+        float directionLength = frVector2Magnitude(direction);
+
+        /* NOTE: There is no way to push a body centered on `center`. */
+        if (directionLength <= 0.0f) continue;
+
+        direction = frVector2ScalarMultiply(direction, 1.0f / directionLength);
+
+        if (occlusion) {
+            frOcclusionHashQueryCtx occlusionCtx = {
+                .world = w,
+                .target = body,
+                .ray = { .origin = center,
+                         .direction = direction,
+                         .maxDistance = directionLength }
+            };
+
+            frQuerySpatialHashRay(w->hash,
+                                  &occlusionCtx.ray,
+                                  frOcclusionHashQueryCallback,
+                                  &occlusionCtx);
+
+            if (occlusionCtx.occluded) continue;
+        }
+
+        float scale = 1.0f - (distance / radius);
+
+        if (falloff == FR_FALLOFF_NONE) scale = 1.0f;
+        else if (falloff == FR_FALLOFF_QUADRATIC) scale *= scale;
+
+        frBodyImpulse impulse = {
+            .body = body,
+            .impulse = frVector2ScalarMultiply(direction, magnitude * scale)
+        };
+
+        frDynArrayPush(impulses, impulse);
+    }
+
+    /* 
+        NOTE: The impulses are applied all at once, after every body 
+        has been tested against the same state of `w`.
+    */
+    for (int i = 0; i < frGetDynArrayLength(impulses); i++) {
+        frBody *body = frGetDynArrayValue(impulses, i).body;
+
+        frApplyImpulseToBody(body,
+                             frGetBodyPosition(body),
+                             frGetDynArrayValue(impulses, i).impulse);
+    }
+
+    int result = frGetDynArrayLength(impulses);
+
+    frReleaseDynArray(impulses);
+    frReleaseDynArray(queryCtx.candidates);
+
+    return result;
+}
+
+/* 
+    Predicts the path of `s` launched from `position` with `velocity` 
+    under the gravity of `w` (scaled by `gravityScale`) for up to `maxSteps`
+    steps of `dt`, sweeping it against the static bodies (and the kinematic
+    bodies as well, if `kinematic` is `true`) in `w`. Stores the positions
+    along the path to `path`, which must have room for `maxSteps + 1` points, 
+    and the information about the first impact (if any) to `raycastHit`, 
+    whose `distance` is measured along the path, then returns 
+    the number of points stored.
+*/
+int frPredictTrajectory(frWorld *w,
+                        const frShape *s,
+                        frVector2 position,
+                        frVector2 velocity,
+                        float gravityScale,
+                        float dt,
+                        int maxSteps,
+                        bool kinematic,
+                        frVector2 *path,
+                        frRaycastHit *raycastHit) {
+    if (raycastHit != NULL) *raycastHit = (frRaycastHit) { .distance = 0.0f };
+
+    if (w == NULL || s == NULL || dt <= 0.0f || maxSteps < 0 || path == NULL)
+        return 0;
+
+    frUpdateWorldHash(w);
+
+    frVector2 gravity = frVector2ScalarMultiply(w->gravity, gravityScale);
+
+    frTransform tx = { .position = position, .rotation.cos_ = 1.0f };
+
+    float pathLength = 0.0f;
+
+    int result = 0;
+
+    path[result++] = position;
+
+    for (int i = 1; i <= maxSteps; i++) {
+        /*
+            NOTE: The closed form of the semi-implicit Euler method used by
+            `frStepWorld()` gives the position after `i` steps directly,
+            without accumulating rounding errors over the steps:
+
+            => `v_i = v_0 + i * g * dt`
+            => `x_i = x_0 + i * v_0 * dt + (i * (i + 1) / 2) * g * dt^2`
+        */
+        float k = 0.5f * i * (i + 1) * dt * dt;
+
+        frVector2 nextPosition = {
+            .x = position.x + (i * dt * velocity.x) + (k * gravity.x),
+            .y = position.y + (i * dt * velocity.y) + (k * gravity.y)
+        };
+
+        frVector2 translation = frVector2Subtract(nextPosition, tx.position);
+
+        frRaycastHit stepHit = { .distance = FLT_MAX };
+
+        frAABB aabb = frGetShapeAABB(s, tx);
+
+        if (translation.x < 0.0f) aabb.x += translation.x;
+        if (translation.y < 0.0f) aabb.y += translation.y;
+
+        aabb.width += fabsf(translation.x), aabb.height += fabsf(translation.y);
+
+        frQuerySpatialHash(w->hash,
+                           aabb,
+                           frShapeCastHashQueryCallback,
+                           &(frShapeCastHashQueryCtx) {
+                               .world = w,
+                               .shape = s,
+                               .tx = tx,
+                               .translation = translation,
+                               .raycastHit = &stepHit,
+                               .filter = frTrajectoryBodyFilter,
+                               .userData = &kinematic });
+
+        if (stepHit.body != NULL) {
+            float magnitude = frVector2Magnitude(translation);
+
+            if (magnitude > 0.0f)
+                tx.position = frVector2Add(
+                    tx.position,
+                    frVector2ScalarMultiply(translation,
+                                            stepHit.distance / magnitude));
+
+            path[result++] = tx.position;
+
+            if (raycastHit != NULL) {
+                *raycastHit = stepHit;
+
+                raycastHit->distance = pathLength + stepHit.distance;
+            }
+
+            break;
+        }
+
+        pathLength += frVector2Magnitude(translation);
+
+        tx.position = path[result++] = nextPosition;
+    }
+
+    return result;
+}
+
+/* 
+    Proceeds the simulation over the time step `dt`, in seconds,
+    which will always run independent of the framerate.
+*/
+void frUpdateWorld(frWorld *w, float dt) {
+    if (w == NULL || dt <= 0.0f) return;
+
+    float currentTime = frGetCurrentTime();
+
+    if (w->timestamp <= 0.0f) {
+        w->timestamp = currentTime;
+
+        return;
+    }
+
+    float elapsedTime = currentTime - w->timestamp;
+
+    w->timestamp = currentTime, w->accumulator += elapsedTime;
+
+    for (; w->accumulator >= dt; w->accumulator -= dt)
+        frStepWorld(w, dt);
+}
+
+/* 
     Casts a `ray` against all objects in `w`, 
-    then calls `func` for each object that collides with `ray`. 
+    then calls `func` for each object that collides with `ray`,
+    in the order of the cells visited along `ray`.
+*/
+void frComputeWorldRaycast(frWorld *w,
+                           frRay ray,
+                           frRaycastQueryFunc func,
+                           void *userData) {
+    if (w == NULL || func == NULL) return;
+
+    frUpdateWorldHash(w);
+
+    ray.direction = frVector2Normalize(ray.direction);
+
+    frRaycastHashQueryCtx queryCtx = { .ctx = userData,
+                                       .ray = ray,
+                                       .world = w,
+                                       .func = func };
+
+    frQuerySpatialHashRay(w->hash,
+                          &queryCtx.ray,
+                          frRaycastHashQueryCallback,
+                          &queryCtx);
+}
+
+/* 
+    Casts a `ray` against all objects in `w`, then stores the information
+    about the closest hit to `raycastHit`.
+*/
+bool frComputeWorldRaycastClosest(frWorld *w,
+                                  frRay ray,
+                                  frRaycastHit *raycastHit) {
+    if (w == NULL || raycastHit == NULL) return false;
+
+    frUpdateWorldHash(w);
+
+    ray.direction = frVector2Normalize(ray.direction);
+
+    *raycastHit = (frRaycastHit) { .distance = FLT_MAX };
+
+    frRaycastHashQueryCtx queryCtx = { .ray = ray,
+                                       .world = w,
+                                       .raycastHit = raycastHit };
+
+    frQuerySpatialHashRay(w->hash,
+                          &queryCtx.ray,
+                          frRaycastClosestHashQueryCallback,
+                          &queryCtx);
+
+    return (raycastHit->body != NULL);
+}
+
+/* 
+    Casts a `ray` against all objects in `w` until any of them is hit,
+    then stores the information about that hit to `raycastHit`.
+*/
+bool frComputeWorldRaycastAny(frWorld *w,
+                              frRay ray,
+                              frRaycastHit *raycastHit) {
+    if (w == NULL) return false;
+
+    frUpdateWorldHash(w);
+
+    ray.direction = frVector2Normalize(ray.direction);
+
+    frRaycastHit anyHit = { .distance = FLT_MAX };
+
+    frRaycastHashQueryCtx queryCtx = { .ray = ray,
+                                       .world = w,
+                                       .raycastHit = &anyHit };
+
+    frQuerySpatialHashRay(w->hash,
+                          &queryCtx.ray,
+                          frRaycastAnyHashQueryCallback,
+                          &queryCtx);
+
+    if (raycastHit != NULL) *raycastHit = anyHit;
+
+    return (anyHit.body != NULL);
+}
+
+/* 
+    Sweeps `s` with the transform `tx` along `translation` against 
+    all objects in `w` that pass `filter` (which may be `NULL`), then 
+    stores the information about the first time of impact to `raycastHit`.
+*/
+bool frComputeWorldShapeCast(frWorld *w,
+                             const frShape *s,
+                             frTransform tx,
+                             frVector2 translation,
+                             frBodyFilterFunc filter,
+                             void *userData,
+                             frRaycastHit *raycastHit) {
+    if (w == NULL || s == NULL || raycastHit == NULL) return false;
+
+    frUpdateWorldHash(w);
+
+    *raycastHit = (frRaycastHit) { .distance = FLT_MAX };
+
+    frAABB aabb = frGetShapeAABB(s, tx);
+
+    /* NOTE: `aabb` is extended so that it covers the whole sweep. */
+    if (translation.x < 0.0f) aabb.x += translation.x;
+    if (translation.y < 0.0f) aabb.y += translation.y;
+
+    aabb.width += fabsf(translation.x), aabb.height += fabsf(translation.y);
+
+    frQuerySpatialHash(w->hash,
+                       aabb,
+                       frShapeCastHashQueryCallback,
+                       &(frShapeCastHashQueryCtx) { .world = w,
+                                                    .shape = s,
+                                                    .tx = tx,
+                                                    .translation = translation,
+                                                    .raycastHit = raycastHit,
+                                                    .filter = filter,
+                                                    .userData = userData });
+
+    return (raycastHit->body != NULL);
+}
+
+/* 
+    Casts each of the first `n` `rays` against all objects in `w`, 
+    then stores the information about its closest hit to `hits`,
+    and returns the number of rays that hit anything.
+*/
+int frComputeWorldRaycastBatch(frWorld *w,
+                               const frRay *rays,
+                               int n,
+                               frRaycastHit *hits) {
+    if (w == NULL || rays == NULL || n <= 0 || hits == NULL) return 0;
+
+    frUpdateWorldHash(w);
+
+    int packetCount = (n + FR_WORLD_RAYCAST_PACKET_SIZE - 1)
+                      / FR_WORLD_RAYCAST_PACKET_SIZE;
+
+    int *offsets = malloc((packetCount + 1) * sizeof *offsets);
+
+    frCandidateHashQueryCtx queryCtx;
+
+    frInitDynArray(queryCtx.candidates);
+
+    /*
+        NOTE: The candidates of all packets are gathered up front, 
+        since the spatial hash cannot be queried by more than one thread 
+        at a time.
+    */
+    for (int i = 0; i < packetCount; i++) {
+        int firstIndex = i * FR_WORLD_RAYCAST_PACKET_SIZE;
+
+        offsets[i] = frGetDynArrayLength(queryCtx.candidates);
+
+        frQuerySpatialHash(
+            w->hash,
+            frGetRayPacketAABB(rays + firstIndex,
+                               (n - firstIndex < FR_WORLD_RAYCAST_PACKET_SIZE)
+                                   ? n - firstIndex
+                                   : FR_WORLD_RAYCAST_PACKET_SIZE),
+            frCandidateHashQueryCallback,
+            &queryCtx);
+    }
+
+    offsets[packetCount] = frGetDynArrayLength(queryCtx.candidates);
+
+    int result = 0;
+
+    /*
+        NOTE: Compiling with OpenMP enabled (e.g. `-fopenmp`) splits 
+        the packets across threads.
+    */
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) reduction(+ : result)
+#endif
+    for (int i = 0; i < packetCount; i++) {
+        int firstIndex = i * FR_WORLD_RAYCAST_PACKET_SIZE;
+
+        result += frComputeRayPacket(
+            w,
+            rays + firstIndex,
+            (n - firstIndex < FR_WORLD_RAYCAST_PACKET_SIZE)
+                ? n - firstIndex
+                : FR_WORLD_RAYCAST_PACKET_SIZE,
+            queryCtx.candidates.buffer + offsets[i],
+            offsets[i + 1] - offsets[i],
+            hits + firstIndex);
+    }
+
+    frReleaseDynArray(queryCtx.candidates);
+
+    free(offsets);
+
+    return result;
+}
+
+/* 
+    Finds all bodies in `w` whose AABBs overlap `aabb`, then stores 
+    up to `maxCount` of them to `bodies` and returns their number.
+*/
+int frQueryWorldAABB(frWorld *w, frAABB aabb, frBody **bodies, int maxCount) {
+    if (w == NULL || bodies == NULL || maxCount <= 0) return 0;
+
+    frUpdateWorldHash(w);
+
+    frOverlapHashQueryCtx queryCtx = { .world = w,
+                                       .aabb = aabb,
+                                       .bodies = bodies,
+                                       .maxCount = maxCount };
+
+    frQuerySpatialHash(w->hash, aabb, frAABBHashQueryCallback, &queryCtx);
+
+    return queryCtx.count;
+}
+
+/* 
+    Finds all bodies in `w` that contain `point`, then stores 
+    up to `maxCount` of them to `bodies` and returns their number.
+*/
+int frQueryWorldPoint(frWorld *w,
+                      frVector2 point,
+                      frBody **bodies,
+                      int maxCount) {
+    if (w == NULL || bodies == NULL || maxCount <= 0) return 0;
+
+    frUpdateWorldHash(w);
+
+    frOverlapHashQueryCtx queryCtx = { .world = w,
+                                       .point = point,
+                                       .bodies = bodies,
+                                       .maxCount = maxCount };
+
+    frQuerySpatialHash(w->hash,
+                       (frAABB) { .x = point.x, .y = point.y },
+                       frPointHashQueryCallback,
+                       &queryCtx);
+
+    return queryCtx.count;
+}
+
+/* 
+    Finds all bodies in `w` that overlap `s` with the transform `tx`, 
+    then stores up to `maxCount` of them to `bodies` and returns their number.
+*/
+int frQueryWorldShape(frWorld *w,
+                      const frShape *s,
+                      frTransform tx,
+                      frBody **bodies,
+                      int maxCount) {
+    if (w == NULL || s == NULL || bodies == NULL || maxCount <= 0) return 0;
+
+    frUpdateWorldHash(w);
+
+    frOverlapHashQueryCtx queryCtx = { .world = w,
+                                       .aabb = frGetShapeAABB(s, tx),
+                                       .shape = s,
+                                       .tx = tx,
+                                       .bodies = bodies,
+                                       .maxCount = maxCount };
+
+    frQuerySpatialHash(w->hash,
+                       queryCtx.aabb,
+                       frShapeHashQueryCallback,
+                       &queryCtx);
+
+    return queryCtx.count;
+}
+
+/* 
+    Finds all bodies in `w` within `distance` of `s` with the transform `tx`,
+    then stores up to `maxCount` of them to `bodies` and returns their number.
+*/
+int frQueryWorldWithinDistance(frWorld *w,
+                               const frShape *s,
+                               frTransform tx,
+                               float distance,
+                               frBody **bodies,
+                               int maxCount) {
+    if (w == NULL || s == NULL || distance < 0.0f || bodies == NULL
+        || maxCount <= 0)
+        return 0;
+
+    frUpdateWorldHash(w);
+
+    frAABB aabb = frGetShapeAABB(s, tx);
+
+    /* NOTE: Only the bodies in the enlarged AABB of `s` can be close enough. */
+    aabb.x -= distance, aabb.y -= distance;
+
+    aabb.width += 2.0f * distance, aabb.height += 2.0f * distance;
+
+    frOverlapHashQueryCtx queryCtx = { .world = w,
+                                       .aabb = aabb,
+                                       .shape = s,
+                                       .tx = tx,
+                                       .distance = distance,
+                                       .bodies = bodies,
+                                       .maxCount = maxCount };
+
+    frQuerySpatialHash(w->hash, aabb, frDistanceHashQueryCallback, &queryCtx);
+
+    return queryCtx.count;
+}
+
+/* 
+    Finds a body in `w` containing each of the first `n` `points`, then 
+    stores it (or `NULL` if there is none) to `bodies` and returns 
+    the number of points inside any body.
+*/
+int frQueryWorldPoints(frWorld *w,
+                       const frVector2 *points,
+                       int n,
+                       frBody **bodies) {
+    if (w == NULL || points == NULL || n <= 0 || bodies == NULL) return 0;
+
+    frUpdateWorldHash(w);
+
+    float inverseCellSize = 1.0f / frGetSpatialHashCellSize(w->hash);
+
+    frPointCellEntry *entries = malloc(n * sizeof *entries);
+    frVector2 *sortedPoints = malloc(n * sizeof *sortedPoints);
+
+    bool *results = malloc(n * sizeof *results);
+
+    for (int i = 0; i < n; i++) {
+        entries[i].cell.x = floorf(points[i].x * inverseCellSize);
+        entries[i].cell.y = floorf(points[i].y * inverseCellSize);
+
+        entries[i].index = i;
+
+        bodies[i] = NULL;
+    }
+
+    /*
+        NOTE: Sorting the points by their cell positions groups them 
+        into runs, so that the spatial hash is queried only once 
+        for each cell, and each candidate is tested against 
+        all points of a run at a time.
+    */
+    qsort(entries, n, sizeof *entries, frComparePointCellEntries);
+
+    for (int i = 0; i < n; i++)
+        sortedPoints[i] = points[entries[i].index];
+
+    frCandidateHashQueryCtx queryCtx;
+
+    frInitDynArray(queryCtx.candidates);
+
+    int result = 0;
+
+    for (int first = 0, last = 0; first < n; first = last) {
+        frVector2 minVertex = sortedPoints[first];
+        frVector2 maxVertex = sortedPoints[first];
+
+        for (last = first + 1; last < n; last++) {
+            if (entries[first].cell.x != entries[last].cell.x
+                || entries[first].cell.y != entries[last].cell.y)
+                break;
+
+            frVector2 point = sortedPoints[last];
+
+            if (minVertex.x > point.x) minVertex.x = point.x;
+            if (minVertex.y > point.y) minVertex.y = point.y;
+
+            if (maxVertex.x < point.x) maxVertex.x = point.x;
+            if (maxVertex.y < point.y) maxVertex.y = point.y;
+        }
+
+        frAABB aabb = { .x = minVertex.x,
+                        .y = minVertex.y,
+                        .width = maxVertex.x - minVertex.x,
+                        .height = maxVertex.y - minVertex.y };
+
+        frSetDynArrayLength(queryCtx.candidates, 0);
+
+        frQuerySpatialHash(w->hash,
+                           aabb,
+                           frCandidateHashQueryCallback,
+                           &queryCtx);
+
+        int runLength = last - first, remainingCount = runLength;
+
+        for (int i = 0; i < frGetDynArrayLength(queryCtx.candidates)
+                        && remainingCount > 0;
+             i++) {
+            frBody *body = frGetDynArrayValue(
+                w->bodies, frGetDynArrayValue(queryCtx.candidates, i));
+
+            if (!frCheckAABBOverlap(aabb, frGetBodyAABB(body))
+                || frBodyContainsPoints(body,
+                                        sortedPoints + first,
+                                        runLength,
+                                        results + first)
+                       <= 0)
+                continue;
+
+            for (int j = first; j < last; j++) {
+                if (!results[j] || bodies[entries[j].index] != NULL) continue;
+
+                bodies[entries[j].index] = body, remainingCount--;
+            }
+        }
+
+        result += runLength - remainingCount;
+    }
+
+    frReleaseDynArray(queryCtx.candidates);
+
+    free(results), free(sortedPoints), free(entries);
+
+    return result;
+}
+
+/* 
+    Finds up to `k` bodies in `w` closest to `point` that pass `filter`
+    (which may be `NULL`), then stores them to `bodies` in order of 
+    increasing distance and returns their number.
+*/
+int frQueryWorldNearest(frWorld *w,
+                        frVector2 point,
+                        int k,
+                        frBodyFilterFunc filter,
+                        void *userData,
+                        frBody **bodies) {
+    if (w == NULL || k <= 0 || bodies == NULL) return 0;
+
+    frUpdateWorldHash(w);
+
+    frNearestBody *heap = malloc(k * sizeof *heap);
+
+    frNearestHashQueryCtx queryCtx = { .world = w,
+                                       .point = point,
+                                       .filter = filter,
+                                       .userData = userData,
+                                       .heap = heap,
+                                       .maxCount = k,
+                                       .maxDistance = FLT_MAX };
+
+    frQuerySpatialHashNearest(w->hash,
+                              point,
+                              &queryCtx.maxDistance,
+                              frNearestHashQueryCallback,
+                              &queryCtx);
+
+    int result = queryCtx.count;
+
+    /* NOTE: Popping the farthest body each time sorts the bodies in place. */
+    for (int i = result - 1; i >= 0; i--) {
+        bodies[i] = queryCtx.heap[0].body;
+
+        queryCtx.heap[0] = queryCtx.heap[i];
+
+        frSiftDownNearestBodies(queryCtx.heap, i);
+    }
+
+    free(heap);
+
+    return result;
+}
+
+/* Private Functions ======================================================> */
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frPreStepWorld()`. 
+*/
+static bool frPreStepHashQueryCallback(frContextNode queryResult) {
+    frPreStepHashQueryCtx *queryCtx = queryResult.ctx;
+
+    int firstIndex = queryCtx->bodyIndex, secondIndex = queryResult.id;
+
+    if (firstIndex == secondIndex) return false;
+
+    frWorld *world = queryCtx->world;
+
+    /*
+        NOTE: Static and sleeping bodies do not look for collisions 
+        by themselves, so a pair of an awake body and one of them 
+        is always found by the awake body.
+    */
+    if (firstIndex > secondIndex) {
+        if (frIsBodyAwake(frGetDynArrayValue(world->bodies, secondIndex)))
+            return false;
+
+        firstIndex = secondIndex, secondIndex = queryCtx->bodyIndex;
+    }
+
+    frBody *b1 = frGetDynArrayValue(world->bodies, firstIndex);
+    frBody *b2 = frGetDynArrayValue(world->bodies, secondIndex);
+
+    if (frGetBodyInverseMass(b1) + frGetBodyInverseMass(b2) <= 0.0f)
+        return false;
+
+    frBodyPair key = { .first = b1, .second = b2 };
+
+    frCollision collision = { .count = 0 };
+
+    if (!frComputeCollision(b1, b2, &collision)) {
+        /*
+            NOTE: `hmdel()` returns `0` if `key` is not 
+            in `world->cache`!
+        */
+
+        hmdel(world->cache, key);
+
+        return false;
+    }
+
+    frContactCacheEntry *entry = hmgetp_null(world->cache, key);
+
+    const frShape *s1 = frGetBodyShape(b1), *s2 = frGetBodyShape(b2);
+
+    for (int i = 0; i < collision.count; i++)
+        collision.contacts[i].timestamp = world->timestamp;
+
+    if (entry != NULL) {
+        collision.friction = entry->value.friction;
+        collision.restitution = entry->value.restitution;
+
+        for (int i = 0; i < collision.count; i++) {
+            int newIndex = i, oldIndex = -1;
+
+            for (int j = 0; j < entry->value.count; j++) {
+                int newContactId = collision.contacts[newIndex].id;
+                int oldContactId = entry->value.contacts[j].id;
+
+                if (newContactId == oldContactId) {
+                    oldIndex = j;
+
+                    break;
+                }
+            }
+
+            if (oldIndex < 0) continue;
+
+            const frContact *oldContact = &entry->value.contacts[oldIndex];
+
+            frContact *newContact = &collision.contacts[newIndex];
+
+            float oldNormalScalar = oldContact->cache.normalScalar;
+            float oldTangentScalar = oldContact->cache.tangentScalar;
+
+            newContact->cache.normalScalar = oldNormalScalar;
+            newContact->cache.tangentScalar = oldTangentScalar;
+        }
+    } else {
+        collision.friction = 0.5f
+                             * (frGetShapeFriction(s1)
+                                + frGetShapeFriction(s2));
+        collision.restitution = fminf(frGetShapeRestitution(s1),
+                                      frGetShapeRestitution(s2));
+
+        if (collision.friction < 0.0f) collision.friction = 0.0f;
+        if (collision.restitution < 0.0f) collision.restitution = 0.0f;
+    }
+
+    hmputs(queryCtx->world->cache,
+           ((frContactCacheEntry) { .key = key,
+                                    .value = collision,
+                                    .firstIndex = firstIndex,
+                                    .secondIndex = secondIndex }));
+
+    return true;
+}
+
+/* 
+    A callback function for `frQuerySpatialHashRay()` 
+    that will be called during `frComputeWorldRaycast()`.
+*/
+static bool frRaycastHashQueryCallback(frContextNode ctxNode) {
+    frRaycastHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    frRaycastHit raycastHit = { .distance = 0.0f };
+
+    if (!frComputeRaycastForBody(queryCtx, ctxNode.id, &raycastHit))
+        return false;
+
+    queryCtx->func(raycastHit, queryCtx->ctx);
+
+    return true;
+}
+
+/* 
+    A callback function for `frQuerySpatialHashRay()` 
+    that will be called during `frComputeWorldRaycastClosest()`.
+*/
+static bool frRaycastClosestHashQueryCallback(frContextNode ctxNode) {
+    frRaycastHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    frRaycastHit raycastHit = { .distance = 0.0f };
+
+    if (!frComputeRaycastForBody(queryCtx, ctxNode.id, &raycastHit))
+        return false;
+
+    /*
+        NOTE: Shortening the ray stops the traversal as soon as 
+        the remaining cells are farther away than the closest hit so far.
+    */
+    queryCtx->ray.maxDistance = raycastHit.distance;
+
+    *(queryCtx->raycastHit) = raycastHit;
+
+    return true;
+}
+
+/* 
+    A callback function for `frQuerySpatialHashRay()` 
+    that will be called during `frComputeWorldRaycastAny()`.
+*/
+static bool frRaycastAnyHashQueryCallback(frContextNode ctxNode) {
+    frRaycastHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    frRaycastHit raycastHit = { .distance = 0.0f };
+
+    if (!frComputeRaycastForBody(queryCtx, ctxNode.id, &raycastHit))
+        return false;
+
+    // NOTE: A negative distance ends the traversal right away.
+    queryCtx->ray.maxDistance = -1.0f;
+
+    *(queryCtx->raycastHit) = raycastHit;
+
+    return true;
+}
+
+/* 
+    Casts the ray in `queryCtx` against the body at `bodyIndex`,
+    assuming that the direction of the ray is already normalized.
+*/
+static bool frComputeRaycastForBody(const frRaycastHashQueryCtx *queryCtx,
+                                    int bodyIndex,
+                                    frRaycastHit *raycastHit) {
+    frBody *body = frGetDynArrayValue(queryCtx->world->bodies, bodyIndex);
+
+    if (!frComputeShapeRaycast(frGetBodyShape(body),
+                               frGetBodyTransform(body),
+                               queryCtx->ray,
+                               raycastHit))
+        return false;
+
+    raycastHit->body = body;
+
+    return true;
+}
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frComputeWorldShapeCast()`.
+*/
+static bool frShapeCastHashQueryCallback(frContextNode ctxNode) {
+    frShapeCastHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    frBody *body = frGetDynArrayValue(queryCtx->world->bodies, ctxNode.id);
+
+    if (queryCtx->filter != NULL && !queryCtx->filter(body, queryCtx->userData))
+        return false;
+
+    frRaycastHit raycastHit = { .distance = 0.0f };
+
+    if (!frComputeShapeCast(queryCtx->shape,
+                            queryCtx->tx,
+                            queryCtx->translation,
+                            frGetBodyShape(body),
+                            frGetBodyTransform(body),
+                            &raycastHit)
+        || raycastHit.distance >= queryCtx->raycastHit->distance)
+        return false;
+
+    float magnitude = frVector2Magnitude(queryCtx->translation);
+
+    /*
+        NOTE: Shortening the sweep to the first time of impact so far
+        lets `frComputeShapeCast()` give up early on farther bodies.
+    */
+    if (magnitude > 0.0f)
+        queryCtx->translation = frVector2ScalarMultiply(
+            queryCtx->translation, raycastHit.distance / magnitude);
+
+    raycastHit.body = body;
+
+    *(queryCtx->raycastHit) = raycastHit;
+
+    return true;
+}
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frComputeWorldRaycastBatch()` 
+    and `frQueryWorldPoints()`.
+*/
+static bool frCandidateHashQueryCallback(frContextNode ctxNode) {
+    frCandidateHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    frDynArrayPush(queryCtx->candidates, ctxNode.id);
+
+    return true;
+}
+
+/* Returns the AABB of the first `n` `rays`. */
+static frAABB frGetRayPacketAABB(const frRay *rays, int n) {
+    frVector2 minVertex = { .x = FLT_MAX, .y = FLT_MAX };
+    frVector2 maxVertex = { .x = -FLT_MAX, .y = -FLT_MAX };
+
+    for (int i = 0; i < n; i++) {
+        frVector2 endpoint = frVector2Add(
+            rays[i].origin,
+            frVector2ScalarMultiply(frVector2Normalize(rays[i].direction),
+                                    fminf(rays[i].maxDistance,
+                                          RAY_PACKET_MAX_DISTANCE)));
+
+        minVertex.x = fminf(minVertex.x, fminf(rays[i].origin.x, endpoint.x));
+        minVertex.y = fminf(minVertex.y, fminf(rays[i].origin.y, endpoint.y));
+
+        maxVertex.x = fmaxf(maxVertex.x, fmaxf(rays[i].origin.x, endpoint.x));
+        maxVertex.y = fmaxf(maxVertex.y, fmaxf(rays[i].origin.y, endpoint.y));
+    }
+
+    return (frAABB) { .x = minVertex.x,
+                      .y = minVertex.y,
+                      .width = maxVertex.x - minVertex.x,
+                      .height = maxVertex.y - minVertex.y };
+}
+
+/* 
+    Casts the first `n` `rays` against `candidates` (the indices of 
+    the bodies in `w`), then stores the closest hit for each ray to `hits`.
+*/
+static int frComputeRayPacket(const frWorld *w,
+                              const frRay *rays,
+                              int n,
+                              const int *candidates,
+                              int candidateCount,
+                              frRaycastHit *hits) {
+    frRay packet[FR_WORLD_RAYCAST_PACKET_SIZE];
+
+    frVector2 inverseDirections[FR_WORLD_RAYCAST_PACKET_SIZE];
+
+    for (int i = 0; i < n; i++) {
+        packet[i] = rays[i];
+
+        packet[i].direction = frVector2Normalize(packet[i].direction);
+
+        // NOTE: A zero component yields an infinite slab distance.
+        inverseDirections[i] = (frVector2) { .x = 1.0f / packet[i].direction.x,
+                                             .y = 1.0f / packet[i].direction.y };
+
+        hits[i] = (frRaycastHit) { .distance = FLT_MAX };
+    }
+
+    for (int j = 0; j < candidateCount; j++) {
+        frBody *body = frGetDynArrayValue(w->bodies, candidates[j]);
+
+        const frShape *s = frGetBodyShape(body);
+
+        frTransform tx = frGetBodyTransform(body);
+
+        frAABB aabb = frGetBodyAABB(body);
+
+        for (int i = 0; i < n; i++) {
+            float x1 = (aabb.x - packet[i].origin.x) * inverseDirections[i].x;
+            float x2 = (aabb.x + aabb.width - packet[i].origin.x)
+                        * inverseDirections[i].x;
+
+            float y1 = (aabb.y - packet[i].origin.y) * inverseDirections[i].y;
+            float y2 = (aabb.y + aabb.height - packet[i].origin.y)
+                        * inverseDirections[i].y;
+
+            float minDistance = fmaxf(fminf(x1, x2), fminf(y1, y2));
+            float maxDistance = fminf(fmaxf(x1, x2), fmaxf(y1, y2));
+
+            if (minDistance > maxDistance || maxDistance < 0.0f
+                || minDistance > packet[i].maxDistance)
+                continue;
+
+            frRaycastHit raycastHit = { .distance = 0.0f };
+
+            if (!frComputeShapeRaycast(s, tx, packet[i], &raycastHit))
+                continue;
+
+            raycastHit.body = body;
+
+            // NOTE: Farther bodies can now be rejected by the slab test.
+            packet[i].maxDistance = raycastHit.distance;
+
+            hits[i] = raycastHit;
+        }
+    }
+
+    int result = 0;
+
+    for (int i = 0; i < n; i++)
+        result += (hits[i].body != NULL);
+
+    return result;
+}
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frQueryWorldAABB()`.
+*/
+static bool frAABBHashQueryCallback(frContextNode ctxNode) {
+    frOverlapHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    if (queryCtx->count >= queryCtx->maxCount) return false;
+
+    frBody *body = frGetDynArrayValue(queryCtx->world->bodies, ctxNode.id);
+
+    if (!frCheckAABBOverlap(queryCtx->aabb, frGetBodyAABB(body)))
+        return false;
+
+    queryCtx->bodies[queryCtx->count++] = body;
+
+    return true;
+}
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frQueryWorldPoint()`.
+*/
+static bool frPointHashQueryCallback(frContextNode ctxNode) {
+    frOverlapHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    if (queryCtx->count >= queryCtx->maxCount) return false;
+
+    frBody *body = frGetDynArrayValue(queryCtx->world->bodies, ctxNode.id);
+
+    if (!frBodyContainsPoint(body, queryCtx->point)) return false;
+
+    queryCtx->bodies[queryCtx->count++] = body;
+
+    return true;
+}
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frQueryWorldShape()`.
+*/
+static bool frShapeHashQueryCallback(frContextNode ctxNode) {
+    frOverlapHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    if (queryCtx->count >= queryCtx->maxCount) return false;
+
+    frBody *body = frGetDynArrayValue(queryCtx->world->bodies, ctxNode.id);
+
+    if (!frCheckAABBOverlap(queryCtx->aabb, frGetBodyAABB(body))
+        || !frComputeShapeCollision(queryCtx->shape,
+                                    queryCtx->tx,
+                                    frGetBodyShape(body),
+                                    frGetBodyTransform(body),
+                                    NULL))
+        return false;
+
+    queryCtx->bodies[queryCtx->count++] = body;
+
+    return true;
+}
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frQueryWorldWithinDistance()`.
+*/
+static bool frDistanceHashQueryCallback(frContextNode ctxNode) {
+    frOverlapHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    if (queryCtx->count >= queryCtx->maxCount) return false;
+
+    frBody *body = frGetDynArrayValue(queryCtx->world->bodies, ctxNode.id);
+
+    if (!frCheckAABBOverlap(queryCtx->aabb, frGetBodyAABB(body))
+        || frComputeShapeDistance(queryCtx->shape,
+                                  queryCtx->tx,
+                                  frGetBodyShape(body),
+                                  frGetBodyTransform(body),
+                                  NULL,
+                                  NULL)
+               > queryCtx->distance)
+        return false;
+
+    queryCtx->bodies[queryCtx->count++] = body;
+
+    return true;
+}
+
+/* 
+    A callback function for `frQuerySpatialHashNearest()` 
+    that will be called during `frQueryWorldNearest()`.
+*/
+static bool frNearestHashQueryCallback(frContextNode ctxNode) {
+    frNearestHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    frBody *body = frGetDynArrayValue(queryCtx->world->bodies, ctxNode.id);
+
+    if (queryCtx->filter != NULL && !queryCtx->filter(body, queryCtx->userData))
+        return false;
+
+    {
+        frAABB aabb = frGetBodyAABB(body);
+
+        float deltaX = fmaxf(fmaxf(aabb.x - queryCtx->point.x,
+                                   queryCtx->point.x - (aabb.x + aabb.width)),
+                             0.0f);
+
+        float deltaY = fmaxf(fmaxf(aabb.y - queryCtx->point.y,
+                                   queryCtx->point.y - (aabb.y + aabb.height)),
+                             0.0f);
+
+        /* NOTE: The AABB of `body` gives a cheap lower bound first. */
+        if ((deltaX * deltaX) + (deltaY * deltaY)
+            > queryCtx->maxDistance * queryCtx->maxDistance)
+            return false;
+    }
+
+    float distance = frGetBodyPointDistance(body, queryCtx->point);
+
+    if (distance > queryCtx->maxDistance) return false;
+
+    if (queryCtx->count < queryCtx->maxCount) {
+        int i = queryCtx->count++;
+
+        /* NOTE: The new body moves up the max-heap to its place. */
+        for (; i > 0; i = (i - 1) >> 1) {
+            int parentIndex = (i - 1) >> 1;
+
+            if (queryCtx->heap[parentIndex].distance >= distance) break;
+
+            queryCtx->heap[i] = queryCtx->heap[parentIndex];
+        }
+
+        queryCtx->heap[i] = (frNearestBody) { .body = body,
+                                              .distance = distance };
+    } else if (distance < queryCtx->heap[0].distance) {
+        queryCtx->heap[0] = (frNearestBody) { .body = body,
+                                              .distance = distance };
+
+        frSiftDownNearestBodies(queryCtx->heap, queryCtx->count);
+    } else {
+        return false;
+    }
+
+    /*
+        NOTE: Once `k` bodies have been found, only the bodies closer 
+        than the farthest of them are worth looking for.
+    */
+    if (queryCtx->count >= queryCtx->maxCount)
+        queryCtx->maxDistance = queryCtx->heap[0].distance;
+
+    return true;
+}
+
+/* Compares the cell positions of two query points. */
+static int frComparePointCellEntries(const void *x, const void *y) {
+    const frPointCellEntry *e1 = x, *e2 = y;
+
+    if (e1->cell.y != e2->cell.y) return (e1->cell.y < e2->cell.y) ? -1 : 1;
+    if (e1->cell.x != e2->cell.x) return (e1->cell.x < e2->cell.x) ? -1 : 1;
+
+    return e1->index - e2->index;
+}
+
+/* Returns the distance between `point` and `b`. */
+static float frGetBodyPointDistance(const frBody *b, frVector2 point) {
+    const frShape *s = frGetBodyShape(b);
+
+    // NOTE: The distance to a circle is negative for a point inside it.
+    if (frGetShapeType(s) != FR_SHAPE_CIRCLE && frBodyContainsPoint(b, point))
+        return 0.0f;
+
+    return frGetShapePointDistance(s, frGetBodyTransform(b), point);
+}
+
+/* 
+    Returns the distance between `point` and `s` with the transform `tx`,
+    assuming `point` does not lie inside `s`.
+*/
+static float frGetShapePointDistance(const frShape *s,
+                                     frTransform tx,
+                                     frVector2 point) {
+    if (frGetShapeType(s) == FR_SHAPE_CIRCLE) {
+        float distance = frVector2Distance(point, tx.position)
+                         - frGetCircleRadius(s);
+
+        return (distance > 0.0f) ? distance : 0.0f;
+    }
+
+    if (frGetShapeType(s) == FR_SHAPE_COMPOUND) {
+        float result = FLT_MAX;
+
+        for (int i = 0; i < frGetCompoundChildCount(s); i++) {
+            float distance = frGetShapePointDistance(
+                frGetCompoundChild(s, i),
+                frGetCompoundChildTransform(s, tx, i),
+                point);
+
+            if (result > distance) result = distance;
+        }
+
+        return result;
+    }
+
+    if (frGetShapeType(s) == FR_SHAPE_CAPSULE) {
+        frVector2 direction = frVector2RotateTx((frVector2) { .y = 1.0f },
+                                                tx);
+
+        float halfLength = 0.5f * frGetCapsuleLength(s);
+
+        float t = frVector2Dot(frVector2Subtract(point, tx.position),
+                               direction);
+
+        t = fminf(fmaxf(t, -halfLength), halfLength);
+
+        return frVector2Distance(
+                   point,
+                   frVector2Add(tx.position,
+                                frVector2ScalarMultiply(direction, t)))
+               - frGetCapsuleRadius(s);
+    }
+
+    if (frGetShapeType(s) == FR_SHAPE_TILEMAP) {
+        frVector2 delta = frVector2Subtract(point, tx.position);
+
+        frTilemapPointHashQueryCtx queryCtx = {
+            .tilemap = s,
+            .point = { .x = delta.x * tx.rotation.cos_
+                            + delta.y * tx.rotation.sin_,
+                       .y = delta.y * tx.rotation.cos_
+                            - delta.x * tx.rotation.sin_ },
+            .distanceSqr = FLT_MAX
+        };
+
+        float tileSize = frGetTilemapTileSize(s);
+
+        // NOTE: The rectangles are measured in the local space of `s`.
+        frQueryTilemapRects(
+            s,
+            (frAABB) { .width = frGetTilemapWidth(s) * tileSize,
+                       .height = frGetTilemapHeight(s) * tileSize },
+            frTilemapPointHashQueryCallback,
+            &queryCtx);
+
+        return sqrtf(queryCtx.distanceSqr);
+    }
+
+    bool isChain = (frGetShapeType(s) == FR_SHAPE_CHAIN
+                    || frGetShapeType(s) == FR_SHAPE_HEIGHTFIELD);
+
+    const frVector2 *vertices = isChain ? frGetChainVertices(s)
+                                        : frGetPolygonVertices(s);
+
+    int vertexCount = isChain ? frGetChainVertexCount(s)
+                              : frGetPolygonVertexCount(s);
+
+    // NOTE: The last line segment of an open chain does not wrap around.
+    int segmentCount = isChain ? frGetChainSegmentCount(s) : vertexCount;
+
+    float minDistanceSqr = FLT_MAX;
+
+    for (int i = 0; i < segmentCount; i++) {
+        frVector2 v1 = frVector2Transform(vertices[i], tx);
+        frVector2 v2 = frVector2Transform(vertices[(i + 1) % vertexCount],
+                                          tx);
+
+        frVector2 edge = frVector2Subtract(v2, v1);
+
+        float edgeLengthSqr = frVector2MagnitudeSqr(edge);
+
+        float t = (edgeLengthSqr > 0.0f)
+                      ? frVector2Dot(frVector2Subtract(point, v1), edge)
+                            / edgeLengthSqr
+                      : 0.0f;
+
+        t = fminf(fmaxf(t, 0.0f), 1.0f);
+
+        float distanceSqr = frVector2DistanceSqr(
+            point,
+            frVector2Add(v1, frVector2ScalarMultiply(edge, t)));
+
+        if (minDistanceSqr > distanceSqr) minDistanceSqr = distanceSqr;
+    }
+
+    return sqrtf(minDistanceSqr);
+}
+
+/* 
+    Moves the root of the max-heap `heap` with `count` elements down 
+    until the heap property is restored.
+*/
+static void frSiftDownNearestBodies(frNearestBody *heap, int count) {
+    frNearestBody root = heap[0];
+
+    int i = 0;
+
+    for (;;) {
+        int childIndex = (i << 1) + 1;
+
+        if (childIndex >= count) break;
+
+        if (childIndex + 1 < count
+            && heap[childIndex + 1].distance > heap[childIndex].distance)
+            childIndex++;
+
+        if (heap[childIndex].distance <= root.distance) break;
+
+        heap[i] = heap[childIndex], i = childIndex;
+    }
+
+    heap[i] = root;
+}
+
+/* Returns `true` if `aabb1` and `aabb2` overlap. */
+static bool frCheckAABBOverlap(frAABB aabb1, frAABB aabb2) {
+    return (aabb1.x <= aabb2.x + aabb2.width)
+           && (aabb2.x <= aabb1.x + aabb1.width)
+           && (aabb1.y <= aabb2.y + aabb2.height)
+           && (aabb2.y <= aabb1.y + aabb1.height);
+}
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frUpdateBodyWatchers()`.
+*/
+static bool frWatcherHashQueryCallback(frContextNode ctxNode) {
+    frWatcherHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    frAABB aabb = frGetDynArrayValue(queryCtx->world->watchers, ctxNode.id)
+                      .aabb;
+
+    frSetBodyVisibility(queryCtx->world,
+                        ctxNode.id,
+                        queryCtx->body,
+                        frCheckAABBOverlap(aabb, queryCtx->aabb));
+
+    return true;
+}
+
+/* 
+    A callback function for `frQuerySpatialHash()` 
+    that will be called during `frAddWatcherToWorld()` 
+    and `frSetWatcherAABB()`.
+*/
+static bool frWatcherBodyHashQueryCallback(frContextNode ctxNode) {
+    frWatcherBodyHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    frWorld *w = queryCtx->world;
+
+    frBody *body = frGetDynArrayValue(w->bodies, ctxNode.id);
+
+    /*
+        NOTE: The visibility of a body always follows the AABB recorded 
+        in the spatial hash, so that the next update of the spatial hash 
+        can find every watcher whose visibility must change.
+    */
+    frSetBodyVisibility(
+        w,
+        queryCtx->watcherIndex,
+        body,
+        frCheckAABBOverlap(
+            frGetDynArrayValue(w->watchers, queryCtx->watcherIndex).aabb,
+            hmget(w->proxies, body).aabb));
+
+    return true;
+}
+
+/* 
+    A callback function for `frQuerySpatialHashRay()` 
+    that will be called during `frApplyRadialImpulse()`.
+*/
+static bool frOcclusionHashQueryCallback(frContextNode ctxNode) {
+    frOcclusionHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    frBody *body = frGetDynArrayValue(queryCtx->world->bodies, ctxNode.id);
+
+    if (body == queryCtx->target || frGetBodyType(body) != FR_BODY_STATIC)
+        return false;
+
+    frRaycastHit raycastHit = { .distance = 0.0f };
+
+    if (!frComputeRaycast(body, queryCtx->ray, &raycastHit)) return false;
+
+    /* NOTE: A single static body in the way is enough. */
+    queryCtx->occluded = true, queryCtx->ray.maxDistance = -1.0f;
+
+    return true;
+}
+
+/* 
+    A callback function for `frQueryTilemapRects()` 
+    that will be called during `frGetBodyPointDistance()`.
+*/
+static bool frTilemapPointHashQueryCallback(frContextNode ctxNode) {
+    frTilemapPointHashQueryCtx *queryCtx = ctxNode.ctx;
+
+    frAABB rect = frGetTilemapRect(queryCtx->tilemap, ctxNode.id);
+
+    frVector2 delta = {
+        .x = queryCtx->point.x
+             - fminf(fmaxf(queryCtx->point.x, rect.x), rect.x + rect.width),
+        .y = queryCtx->point.y
+             - fminf(fmaxf(queryCtx->point.y, rect.y), rect.y + rect.height)
+    };
+
+    float distanceSqr = frVector2MagnitudeSqr(delta);
+
+    if (queryCtx->distanceSqr > distanceSqr)
+        queryCtx->distanceSqr = distanceSqr;
+
+    return true;
+}
+
+/* 
+    A callback function for `frShapeCastHashQueryCallback()` 
+    that will be called during `frPredictTrajectory()`.
+*/
+static bool frTrajectoryBodyFilter(const frBody *b, void *ctx) {
+    frBodyType type = frGetBodyType(b);
+
+    return (type == FR_BODY_STATIC)
+           || (type == FR_BODY_KINEMATIC && *(const bool *) ctx);
+}
+
+/* Returns the range of cells in `w` that `aabb` overlaps. */
+static frCellRange frGetCellRange(const frWorld *w, frAABB aabb) {
+    float inverseCellSize = 1.0f / frGetSpatialHashCellSize(w->hash);
+
+    return (frCellRange) {
+        .min = { .x = floorf(aabb.x * inverseCellSize),
+                 .y = floorf(aabb.y * inverseCellSize) },
+        .max = { .x = floorf((aabb.x + aabb.width) * inverseCellSize),
+                 .y = floorf((aabb.y + aabb.height) * inverseCellSize) }
+    };
+}
+
+/* Returns `true` if `range1` and `range2` cover the same cells. */
+static bool frCheckCellRangeEqual(frCellRange range1, frCellRange range2) {
+    return (range1.min.x == range2.min.x && range1.min.y == range2.min.y)
+           && (range1.max.x == range2.max.x && range1.max.y == range2.max.y);
+}
+
+/* 
+    Makes `b` visible (or invisible) to the watcher at `watcherIndex` in `w`,
+    then records the change to the enter (or leave) set of the watcher.
+*/
+static void frSetBodyVisibility(frWorld *w,
+                                int watcherIndex,
+                                frBody *b,
+                                bool visible) {
+    frWatcher *watcher = &w->watchers.buffer[watcherIndex];
+
+    if ((hmgeti(watcher->visible, b) >= 0) == visible) return;
+
+    if (visible) hmput(watcher->visible, b, true);
+    else (void) hmdel(watcher->visible, b);
+
+    /* 
+        NOTE: A body that leaves and then enters again (or the other way 
+        around) before the events are cleared has not changed at all.
+    */
+    if (visible) {
+        for (int i = 0; i < frGetDynArrayLength(watcher->left); i++)
+            if (frGetDynArrayValue(watcher->left, i) == b) {
+                frDynArraySwap(frBody *,
+                               watcher->left,
+                               i,
+                               frGetDynArrayLength(watcher->left) - 1);
+
+                frSetDynArrayLength(watcher->left,
+                                    frGetDynArrayLength(watcher->left) - 1);
+
+                return;
+            }
+
+        frDynArrayPush(watcher->entered, b);
+    } else {
+        for (int i = 0; i < frGetDynArrayLength(watcher->entered); i++)
+            if (frGetDynArrayValue(watcher->entered, i) == b) {
+                frDynArraySwap(frBody *,
+                               watcher->entered,
+                               i,
+                               frGetDynArrayLength(watcher->entered) - 1);
+
+                frSetDynArrayLength(watcher->entered,
+                                    frGetDynArrayLength(watcher->entered) - 1);
+
+                return;
+            }
+
+        frDynArrayPush(watcher->left, b);
+    }
+}
+
+/* 
+    Updates the visibility of `b` in `w` to the watchers that can see 
+    either its `oldAABB` or its `newAABB`.
+*/
+static void frUpdateBodyWatchers(frWorld *w,
+                                 frBody *b,
+                                 frAABB oldAABB,
+                                 frAABB newAABB) {
+    frWatcherHashQueryCtx queryCtx = { .world = w,
+                                       .body = b,
+                                       .aabb = newAABB };
+
+    /*
+        NOTE: Only the watchers in the cells that `b` has left 
+        or entered can see `b` appear or disappear.
+    */
+    frQuerySpatialHash(w->watcherHash,
+                       newAABB,
+                       frWatcherHashQueryCallback,
+                       &queryCtx);
+
+    if (!frCheckCellRangeEqual(frGetCellRange(w, oldAABB),
+                               frGetCellRange(w, newAABB)))
+        frQuerySpatialHash(w->watcherHash,
+                           oldAABB,
+                           frWatcherHashQueryCallback,
+                           &queryCtx);
+}
+
+/* 
+    Rebuilds the spatial hash of the watchers in `w`,
+    but only if the spatial hash has been marked as outdated.
 */
-void frComputeWorldRaycast(frWorld *w,
-                           frRay ray,
-                           frRaycastQueryFunc func,
-                           void *userData) {
-    if (w == NULL || func == NULL) return;
+static void frUpdateWatcherHash(frWorld *w) {
+    if (!w->watcherHashOutdated) return;
 
-    frClearSpatialHash(w->hash);
+    frClearSpatialHash(w->watcherHash);
 
-    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
-        frInsertIntoSpatialHash(w->hash,
-                                frGetBodyAABB(frGetDynArrayValue(w->bodies, i)),
-                                i);
+    for (int i = 0; i < frGetDynArrayLength(w->watchers); i++)
+        if (frGetDynArrayValue(w->watchers, i).active)
+            frInsertIntoSpatialHash(w->watcherHash,
+                                    frGetDynArrayValue(w->watchers, i).aabb,
+                                    i);
 
-    frVector2 minVertex = ray.origin,
-              maxVertex = frVector2Add(
-                  ray.origin,
-                  frVector2ScalarMultiply(frVector2Normalize(ray.direction),
-                                          ray.maxDistance));
+    w->watcherHashOutdated = false;
+}
 
-    frQuerySpatialHash(w->hash,
-                       (frAABB) { .x = fminf(minVertex.x, maxVertex.x),
-                                  .y = fminf(minVertex.y, maxVertex.y),
-                                  .width = fabsf(maxVertex.x - minVertex.x),
-                                  .height = fabsf(maxVertex.y - minVertex.y) },
-                       frRaycastHashQueryCallback,
-                       &(frRaycastHashQueryCtx) { .ctx = userData,
-                                                  .ray = ray,
-                                                  .world = w,
-                                                  .func = func });
+/* Checks if `b` is neither static nor sleeping. */
+static bool frIsBodyAwake(const frBody *b) {
+    return frGetBodyType(b) != FR_BODY_STATIC && !frIsBodySleeping(b);
 }
 
-/* Private Functions ======================================================> */
+/* Finds all pairs of bodies in `w` that are colliding. */
+static void frPreStepWorld(frWorld *w) {
+    frUpdateWorldHash(w);
+
+    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++) {
+        frBody *body = frGetDynArrayValue(w->bodies, i);
+
+        if (!frIsBodyAwake(body)) continue;
+
+        frQuerySpatialHash(w->hash,
+                           frGetBodyAABB(body),
+                           frPreStepHashQueryCallback,
+                           &(frPreStepHashQueryCtx) { .world = w,
+                                                      .bodyIndex = i });
+    }
+}
 
 /* 
-    A callback function for `frQuerySpatialHash()` 
-    that will be called during `frPreStepWorld()`. 
+    Copies the motion data of each body in `w` 
+    to the solver bodies of `w`.
 */
-static bool frPreStepHashQueryCallback(frContextNode queryResult) {
-    frPreStepHashQueryCtx *queryCtx = queryResult.ctx;
+static void frGatherSolverBodies(frWorld *w) {
+    frSolverBodies *sb = &w->solverBodies;
 
-    int firstIndex = queryCtx->bodyIndex, secondIndex = queryResult.id;
+    sb->count = frGetDynArrayLength(w->bodies);
 
-    if (firstIndex >= secondIndex) return false;
+    if (sb->capacity < sb->count) {
+        int capacity = (2 * sb->capacity > sb->count) ? 2 * sb->capacity
+                                                       : sb->count;
 
-    frWorld *world = queryCtx->world;
+        free(sb->positions);
 
-    frBody *b1 = frGetDynArrayValue(world->bodies, firstIndex);
-    frBody *b2 = frGetDynArrayValue(world->bodies, secondIndex);
+        /*
+            NOTE: The `frVector2` arrays come first in the block,
+            so that every array in the block is properly aligned.
+        */
+        unsigned char *block = malloc(capacity
+                                      * (2 * sizeof *sb->positions
+                                         + 3 * sizeof *sb->inverseMasses));
 
-    if (frGetBodyInverseMass(b1) + frGetBodyInverseMass(b2) <= 0.0f)
-        return false;
+        sb->positions = (frVector2 *) block;
+        sb->velocities = sb->positions + capacity;
 
-    frBodyPair key = { .first = b1, .second = b2 };
+        sb->angularVelocities = (float *) (sb->velocities + capacity);
 
-    frCollision collision = { .count = 0 };
+        sb->inverseMasses = sb->angularVelocities + capacity;
+        sb->inverseInertias = sb->inverseMasses + capacity;
 
-    if (!frComputeCollision(b1, b2, &collision)) {
-        /*
-            NOTE: `hmdel()` returns `0` if `key` is not 
-            in `world->cache`!
-        */
+        sb->capacity = capacity;
+    }
 
-        hmdel(world->cache, key);
+    for (int i = 0; i < sb->count; i++)
+        frGatherSolverBody(sb, i, frGetDynArrayValue(w->bodies, i));
+}
 
-        return false;
+/* 
+    Copies the velocities of the solver bodies of `w` 
+    back to each body in `w`.
+*/
+static void frScatterSolverBodies(frWorld *w) {
+    for (int i = 0; i < w->solverBodies.count; i++)
+        frScatterSolverBody(&w->solverBodies,
+                            i,
+                            frGetDynArrayValue(w->bodies, i));
+}
+
+/* Returns the index of the root of the island of the `i`-th body. */
+static int frFindIslandRoot(int *parents, int i) {
+    // NOTE: Every body on the path is moved closer to the root.
+    while (parents[i] != i)
+        parents[i] = parents[parents[i]], i = parents[i];
+
+    return i;
+}
+
+/* 
+    Returns the index of the body at `i1` or `i2` in `sb` whose velocity 
+    can be changed, or `-1` if there is no such body.
+*/
+static int frGetIslandBodyIndex(const frSolverBodies *sb, int i1, int i2) {
+    if (sb->inverseMasses[i1] > 0.0f || sb->inverseInertias[i1] > 0.0f)
+        return i1;
+
+    if (sb->inverseMasses[i2] > 0.0f || sb->inverseInertias[i2] > 0.0f)
+        return i2;
+
+    return -1;
+}
+
+/* 
+    Splits the cached contacts of `w` into islands, where the bodies 
+    that cannot be moved separate the islands, then wakes up every island 
+    with an awake body and collects the contacts of the awake islands.
+*/
+static void frBuildIslands(frWorld *w) {
+    const frSolverBodies *sb = &w->solverBodies;
+
+    if (frGetDynArrayCapacity(w->islandParents) < sb->count) {
+        frSetDynArrayCapacity(w->islandParents, sb->count);
+        frSetDynArrayCapacity(w->islandIds, sb->count);
+        frSetDynArrayCapacity(w->islandAwake, sb->count);
+        frSetDynArrayCapacity(w->islandSleepTimes, sb->count);
     }
 
-    frContactCacheEntry *entry = hmgetp_null(world->cache, key);
+    int *parents = w->islandParents.buffer, *ids = w->islandIds.buffer;
 
-    const frShape *s1 = frGetBodyShape(b1), *s2 = frGetBodyShape(b2);
+    bool *awake = w->islandAwake.buffer;
 
-    for (int i = 0; i < collision.count; i++)
-        collision.contacts[i].timestamp = world->timestamp;
+    for (int i = 0; i < sb->count; i++)
+        parents[i] = i, ids[i] = -1, awake[i] = false;
 
-    if (entry != NULL) {
-        collision.friction = entry->value.friction;
-        collision.restitution = entry->value.restitution;
+    int cacheCount = hmlen(w->cache);
 
-        for (int i = 0; i < collision.count; i++) {
-            int newIndex = i, oldIndex = -1;
+    for (int j = 0; j < cacheCount; j++) {
+        if (w->cache[j].value.count <= 0) continue;
 
-            for (int j = 0; j < entry->value.count; j++) {
-                int newContactId = collision.contacts[newIndex].id;
-                int oldContactId = entry->value.contacts[j].id;
+        int i1 = w->cache[j].firstIndex, i2 = w->cache[j].secondIndex;
 
-                if (newContactId == oldContactId) {
-                    oldIndex = j;
+        if (sb->inverseMasses[i1] <= 0.0f && sb->inverseInertias[i1] <= 0.0f)
+            continue;
 
-                    break;
-                }
-            }
+        if (sb->inverseMasses[i2] <= 0.0f && sb->inverseInertias[i2] <= 0.0f)
+            continue;
 
-            if (oldIndex < 0) continue;
+        int root1 = frFindIslandRoot(parents, i1);
+        int root2 = frFindIslandRoot(parents, i2);
 
-            const frContact *oldContact = &entry->value.contacts[oldIndex];
+        if (root1 < root2) parents[root2] = root1;
+        else if (root2 < root1) parents[root1] = root2;
+    }
 
-            frContact *newContact = &collision.contacts[newIndex];
+    for (int i = 0; i < sb->count; i++) {
+        if (sb->inverseMasses[i] <= 0.0f && sb->inverseInertias[i] <= 0.0f)
+            continue;
 
-            float oldNormalScalar = oldContact->cache.normalScalar;
-            float oldTangentScalar = oldContact->cache.tangentScalar;
+        if (!frIsBodySleeping(frGetDynArrayValue(w->bodies, i)))
+            awake[frFindIslandRoot(parents, i)] = true;
+    }
 
-            newContact->cache.normalScalar = oldNormalScalar;
-            newContact->cache.tangentScalar = oldTangentScalar;
+    // NOTE: A moving kinematic body wakes up the islands it touches.
+    for (int j = 0; j < cacheCount; j++) {
+        if (w->cache[j].value.count <= 0) continue;
+
+        int i1 = w->cache[j].firstIndex, i2 = w->cache[j].secondIndex;
+
+        int i = frGetIslandBodyIndex(sb, i1, i2);
+
+        if (i < 0) continue;
+
+        const frBody *other = frGetDynArrayValue(w->bodies,
+                                                 (i == i1) ? i2 : i1);
+
+        if (frGetBodyType(other) != FR_BODY_KINEMATIC) continue;
+
+        frVector2 velocity = frGetBodyVelocity(other);
+
+        if (velocity.x != 0.0f || velocity.y != 0.0f
+            || frGetBodyAngularVelocity(other) != 0.0f)
+            awake[frFindIslandRoot(parents, i)] = true;
+    }
+
+    for (int i = 0; i < sb->count; i++) {
+        frBody *body = frGetDynArrayValue(w->bodies, i);
+
+        if (frIsBodySleeping(body) && awake[frFindIslandRoot(parents, i)])
+            frSetBodySleeping(body, false);
+    }
+
+    frSetDynArrayLength(w->islands, 0);
+
+    /*
+        NOTE: The islands are numbered in the order of their first 
+        contacts, and the contacts of an island keep their order, 
+        so that the islands do not depend on timing.
+    */
+    for (int j = 0; j < cacheCount; j++) {
+        if (w->cache[j].value.count <= 0) continue;
+
+        int i = frGetIslandBodyIndex(sb,
+                                     w->cache[j].firstIndex,
+                                     w->cache[j].secondIndex);
+
+        if (i < 0) continue;
+
+        int root = frFindIslandRoot(parents, i);
+
+        if (!awake[root]) continue;
+
+        if (ids[root] < 0) {
+            ids[root] = frGetDynArrayLength(w->islands);
+
+            frDynArrayPush(w->islands, ((frIsland) { .constraintCount = 0 }));
         }
-    } else {
-        collision.friction = 0.5f
-                             * (frGetShapeFriction(s1)
-                                + frGetShapeFriction(s2));
-        collision.restitution = fminf(frGetShapeRestitution(s1),
-                                      frGetShapeRestitution(s2));
 
-        if (collision.friction < 0.0f) collision.friction = 0.0f;
-        if (collision.restitution < 0.0f) collision.restitution = 0.0f;
+        w->islands.buffer[ids[root]].constraintCount++;
     }
 
-    hmputs(queryCtx->world->cache,
-           ((frContactCacheEntry) { .key = key, .value = collision }));
+    int islandConstraintCount = 0;
 
-    return true;
+    for (int i = 0; i < frGetDynArrayLength(w->islands); i++) {
+        frIsland *island = &w->islands.buffer[i];
+
+        island->firstConstraint = islandConstraintCount;
+
+        islandConstraintCount += island->constraintCount;
+
+        island->constraintCount = 0;
+    }
+
+    if (frGetDynArrayCapacity(w->islandConstraints) < islandConstraintCount)
+        frSetDynArrayCapacity(w->islandConstraints, islandConstraintCount);
+
+    frSetDynArrayLength(w->islandConstraints, islandConstraintCount);
+
+    for (int j = 0; j < cacheCount; j++) {
+        if (w->cache[j].value.count <= 0) continue;
+
+        int i = frGetIslandBodyIndex(sb,
+                                     w->cache[j].firstIndex,
+                                     w->cache[j].secondIndex);
+
+        if (i < 0) continue;
+
+        int root = frFindIslandRoot(parents, i);
+
+        if (!awake[root]) continue;
+
+        frIsland *island = &w->islands.buffer[ids[root]];
+
+        w->islandConstraints.buffer[island->firstConstraint
+                                    + island->constraintCount++] = j;
+    }
 }
 
 /* 
-    A callback function for `frQuerySpatialHash()` 
-    that will be called during `frComputeRaycastForWorld()`.
+    Packs the contact constraints of each island of `w` into batches 
+    of four, none of which share a body whose velocity can be changed.
 */
-static bool frRaycastHashQueryCallback(frContextNode ctxNode) {
-    frRaycastHashQueryCtx *queryCtx = ctxNode.ctx;
+static void frBatchCollisions(frWorld *w) {
+    const frSolverBodies *sb = &w->solverBodies;
 
-    const frBody *body = frGetDynArrayValue(queryCtx->world->bodies,
-                                            ctxNode.id);
+    if (frGetDynArrayCapacity(w->batchMasks) < sb->count)
+        frSetDynArrayCapacity(w->batchMasks, sb->count);
 
-    frRaycastHit raycastHit = { .distance = 0.0f };
+    /*
+        NOTE: The `k`-th bit of the mask of a body is set if the body 
+        is in the open batch of the `k`-th color, and every color 
+        has at most one open batch at a time.
+    */
+    unsigned int *masks = w->batchMasks.buffer;
 
-    if (!frComputeRaycast(body, queryCtx->ray, &raycastHit)) return false;
+    memset(masks, 0, sb->count * sizeof *masks);
 
-    queryCtx->func(raycastHit, queryCtx->ctx);
+    int openBatches[CHAR_BIT * sizeof *masks];
+    int openLanes[CHAR_BIT * sizeof *masks];
 
-    return true;
+    frSetDynArrayLength(w->batches, 0);
+    frSetDynArrayLength(w->unbatched, 0);
+
+    for (int i = 0; i < frGetDynArrayLength(w->islands); i++) {
+        frIsland *island = &w->islands.buffer[i];
+
+        island->firstBatch = frGetDynArrayLength(w->batches);
+        island->firstUnbatched = frGetDynArrayLength(w->unbatched);
+
+        // NOTE: A batch never holds the contact constraints of two islands.
+        for (int k = 0; k < (int) (CHAR_BIT * sizeof *masks); k++)
+            openBatches[k] = -1, openLanes[k] = 0;
+
+        for (int l = 0; l < island->constraintCount; l++) {
+            int j = w->islandConstraints.buffer[island->firstConstraint + l];
+
+            const frContactConstraint *constraint = &w->constraints.buffer[j];
+
+            int i1 = constraint->firstIndex, i2 = constraint->secondIndex;
+
+            /*
+                NOTE: The velocities of a body with infinite mass 
+                and inertia are never changed, so it can be shared 
+                by the lanes of a batch.
+            */
+            bool movable1 = sb->inverseMasses[i1] > 0.0f
+                            || sb->inverseInertias[i1] > 0.0f;
+            bool movable2 = sb->inverseMasses[i2] > 0.0f
+                            || sb->inverseInertias[i2] > 0.0f;
+
+            unsigned int usedMask = (movable1 ? masks[i1] : 0u)
+                                    | (movable2 ? masks[i2] : 0u);
+
+            if (usedMask == UINT_MAX) {
+                frDynArrayPush(w->unbatched, j);
+
+                continue;
+            }
+
+            int color = 0;
+
+            while (usedMask & (1u << color))
+                color++;
+
+            if (openBatches[color] < 0) {
+                frContactBatch batch = { .indices = { -1, -1, -1, -1 } };
+
+                /*
+                    NOTE: The empty lanes of a batch refer to the bodies 
+                    of its first lane, not to any body of another island.
+                */
+                for (int k = 0; k < 4; k++)
+                    batch.firstIndices[k] = i1, batch.secondIndices[k] = i2;
+
+                openBatches[color] = frGetDynArrayLength(w->batches);
+
+                frDynArrayPush(w->batches, batch);
+            }
+
+            frContactBatch *batch = &w->batches.buffer[openBatches[color]];
+
+            frPackCollisionBatch(batch,
+                                 openLanes[color],
+                                 sb,
+                                 w->constraints.buffer,
+                                 j);
+
+            if (movable1) masks[i1] |= (1u << color);
+            if (movable2) masks[i2] |= (1u << color);
+
+            if (++openLanes[color] < 4) continue;
+
+            // NOTE: The bodies in a full batch are free to join a new one.
+            for (int k = 0; k < 4; k++) {
+                masks[batch->firstIndices[k]] &= ~(1u << color);
+                masks[batch->secondIndices[k]] &= ~(1u << color);
+            }
+
+            openBatches[color] = -1, openLanes[color] = 0;
+        }
+
+        island->batchCount = frGetDynArrayLength(w->batches)
+                             - island->firstBatch;
+        island->unbatchedCount = frGetDynArrayLength(w->unbatched)
+                                 - island->firstUnbatched;
+    }
 }
 
-/* Finds all pairs of bodies in `w` that are colliding. */
-static void frPreStepWorld(frWorld *w) {
-    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
-        frInsertIntoSpatialHash(w->hash,
-                                frGetBodyAABB(frGetDynArrayValue(w->bodies, i)),
-                                i);
+/* Resolves the contact constraints of the `island` of `w`. */
+static void frSolveIsland(frWorld *w, const frIsland *island) {
+    frContactConstraint *constraints = w->constraints.buffer;
 
-    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
-        frQuerySpatialHash(w->hash,
-                           frGetBodyAABB(frGetDynArrayValue(w->bodies, i)),
-                           frPreStepHashQueryCallback,
-                           &(frPreStepHashQueryCtx) { .world = w,
-                                                      .bodyIndex = i });
+    const int *indices = w->islandConstraints.buffer
+                         + island->firstConstraint;
+
+    for (int l = 0; l < island->constraintCount; l++)
+        frApplyAccumulatedImpulses(&w->solverBodies, &constraints[indices[l]]);
+
+    frContactBatch *batches = w->batches.buffer + island->firstBatch;
+
+    const int *unbatched = w->unbatched.buffer + island->firstUnbatched;
+
+    for (int i = 0; i < FR_WORLD_ITERATION_COUNT; i++) {
+        for (int j = 0; j < island->batchCount; j++)
+            frResolveCollisionBatch(&w->solverBodies, &batches[j]);
+
+        for (int j = 0; j < island->unbatchedCount; j++)
+            frResolveCollision(&w->solverBodies, &constraints[unbatched[j]]);
+    }
+
+    for (int j = 0; j < island->batchCount; j++)
+        frUnpackCollisionBatch(&batches[j], constraints);
+
+    for (int l = 0; l < island->constraintCount; l++)
+        frSaveAccumulatedImpulses(&constraints[indices[l]],
+                                  &w->cache[indices[l]].value);
+}
+
+/* 
+    Updates the sleep timer of each awake body in `w` with `dt`, 
+    then puts every island that has been resting long enough to sleep.
+*/
+static void frUpdateSleepingBodies(frWorld *w, float dt) {
+    int *parents = w->islandParents.buffer;
+
+    float *sleepTimes = w->islandSleepTimes.buffer;
+
+    int bodyCount = w->solverBodies.count;
+
+    for (int i = 0; i < bodyCount; i++)
+        sleepTimes[i] = FLT_MAX;
+
+    // NOTE: An island is as restless as the most restless body in it.
+    for (int i = 0; i < bodyCount; i++) {
+        frBody *body = frGetDynArrayValue(w->bodies, i);
+
+        if (frGetBodyType(body) != FR_BODY_DYNAMIC || frIsBodySleeping(body))
+            continue;
+
+        float sleepTime = frUpdateBodySleepTime(body, dt);
+
+        int root = frFindIslandRoot(parents, i);
+
+        if (sleepTimes[root] > sleepTime) sleepTimes[root] = sleepTime;
+    }
+
+    for (int i = 0; i < bodyCount; i++) {
+        frBody *body = frGetDynArrayValue(w->bodies, i);
+
+        if (frGetBodyType(body) != FR_BODY_DYNAMIC || frIsBodySleeping(body))
+            continue;
+
+        if (sleepTimes[frFindIslandRoot(parents, i)] >= FR_WORLD_SLEEP_TIME)
+            frSetBodySleeping(body, true);
+    }
 }
 
 /* 
-    Clears the accumulated forces on each body in `w`, 
-    then clears the spatial hash of `w`. 
+    Adds (or removes) the pending bodies to `w`, then clears 
+    the accumulated forces on each body in `w`.
 */
 static void frPostStepWorld(frWorld *w) {
     frContextNode node = { .id = FR_OPT_UNKNOWN };
@@ -453,13 +3012,41 @@ static void frPostStepWorld(frWorld *w) {
     while (frRemoveFromRingBuffer(w->rbf, &node)) {
         switch (node.id) {
             case FR_OPT_ADD_BODY:
+                if (frGetBodyWorld(node.ctx) != NULL) break;
+
                 frDynArrayPush(w->bodies, node.ctx);
 
+                frSetBodyWorld(node.ctx, w);
+
+                frBodyProxy proxy = { .index = frGetDynArrayLength(w->bodies)
+                                               - 1,
+                                      .aabb = frGetBodyAABB(node.ctx) };
+
+                hmput(w->proxies, (frBody *) node.ctx, proxy);
+
+                frInsertIntoSpatialHash(w->hash, proxy.aabb, proxy.index);
+
+                // NOTE: The watchers must also be told about the new body.
+                frMarkBodyMoved(w, node.ctx);
+
                 break;
 
             case FR_OPT_REMOVE_BODY:
                 for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
                     if (frGetDynArrayValue(w->bodies, i) == node.ctx) {
+                        for (int j = 0; j < frGetDynArrayLength(w->watchers);
+                             j++)
+                            if (frGetDynArrayValue(w->watchers, j).active)
+                                frSetBodyVisibility(w, j, node.ctx, false);
+
+                        frSetBodyWorld(node.ctx, NULL);
+
+                        frRemoveBodyFromCache(
+                            w, i, frGetDynArrayLength(w->bodies) - 1);
+
+                        frRemoveBodyFromHash(
+                            w, i, frGetDynArrayLength(w->bodies) - 1);
+
                         frDynArraySwap(frBody *,
                                        w->bodies,
                                        i,
@@ -481,5 +3068,107 @@ static void frPostStepWorld(frWorld *w) {
     for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
         frClearBodyForces(frGetDynArrayValue(w->bodies, i));
 
-    frClearSpatialHash(w->hash);
+    // NOTE: The watchers must see the bodies where they are after this step.
+    if (w->watcherCount > 0) frUpdateWorldHash(w);
+}
+
+/* 
+    Erases the cached contacts of the body at `index` in `w`, then moves 
+    the cached contacts of the body at `lastIndex` to `index`.
+*/
+static void frRemoveBodyFromCache(frWorld *w, int index, int lastIndex) {
+    for (int j = hmlen(w->cache) - 1; j >= 0; j--) {
+        frContactCacheEntry *entry = &w->cache[j];
+
+        if (entry->firstIndex == index || entry->secondIndex == index) {
+            frBodyPair key = entry->key;
+
+            // NOTE: The bodies resting on the removed body must fall.
+            frSetBodySleeping((entry->firstIndex == index) ? key.second
+                                                           : key.first,
+                              false);
+
+            hmdel(w->cache, key);
+
+            continue;
+        }
+
+        if (entry->firstIndex == lastIndex) entry->firstIndex = index;
+        if (entry->secondIndex == lastIndex) entry->secondIndex = index;
+    }
+}
+
+/* 
+    Erases the entries of the body at `index` in `w` from the spatial hash 
+    of `w`, then moves the entries of the body at `lastIndex` to `index`.
+*/
+static void frRemoveBodyFromHash(frWorld *w, int index, int lastIndex) {
+    frBody *body = frGetDynArrayValue(w->bodies, index);
+
+    frRemoveFromSpatialHash(w->hash, hmget(w->proxies, body).aabb, index);
+
+    (void) hmdel(w->proxies, body);
+
+    if (index == lastIndex) return;
+
+    frBodyProxyEntry *entry = hmgetp_null(
+        w->proxies, frGetDynArrayValue(w->bodies, lastIndex));
+
+    frRemoveFromSpatialHash(w->hash, entry->value.aabb, lastIndex);
+    frInsertIntoSpatialHash(w->hash, entry->value.aabb, index);
+
+    entry->value.index = index;
+}
+
+/* Marks `b` in `w` as moved, so that its entries will be updated. */
+static void frMarkBodyMoved(frWorld *w, const frBody *b) {
+    frBodyProxyEntry *entry = hmgetp_null(w->proxies, (frBody *) b);
+
+    if (entry == NULL || entry->value.moved) return;
+
+    entry->value.moved = true;
+
+    frDynArrayPush(w->movedBodies, entry->key);
+}
+
+/* 
+    Moves the entries of each body in `w` that has been marked as moved 
+    to the cells that its current AABB overlaps.
+*/
+static void frUpdateWorldHash(frWorld *w) {
+    if (w->watcherCount > 0) frUpdateWatcherHash(w);
+
+    for (int i = 0; i < frGetDynArrayLength(w->movedBodies); i++) {
+        frBody *body = frGetDynArrayValue(w->movedBodies, i);
+
+        // NOTE: `body` might have been removed after being marked as moved.
+        frBodyProxyEntry *entry = hmgetp_null(w->proxies, body);
+
+        if (entry == NULL || !entry->value.moved) continue;
+
+        frBodyProxy *proxy = &entry->value;
+
+        frAABB aabb = frGetBodyAABB(body);
+
+        frCellRange oldRange = frGetCellRange(w, proxy->aabb);
+        frCellRange newRange = frGetCellRange(w, aabb);
+
+        /*
+            NOTE: Most bodies only move a little in each step, 
+            so their entries can stay in the same cells.
+        */
+        if (!frCheckCellRangeEqual(oldRange, newRange)) {
+            frRemoveFromSpatialHash(w->hash, proxy->aabb, proxy->index);
+            frInsertIntoSpatialHash(w->hash, aabb, proxy->index);
+        }
+
+        if (w->watcherCount > 0)
+            frUpdateBodyWatchers(w, body, proxy->aabb, aabb);
+
+        proxy->aabb = aabb, proxy->moved = false;
+
+        w->hashUpdateCount++;
+    }
+
+    frSetDynArrayLength(w->movedBodies, 0);
 }
@@ -0,0 +1,187 @@
+/*
+    Copyright (c) 2021-2024 Jaedeok Kim <jdeokkim@protonmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a 
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation 
+    the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+    and/or sell copies of the Software, and to permit persons to whom the 
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included 
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Includes ===============================================================> */
+
+#include <string.h>
+
+#include "ferox.h"
+#include "greatest.h"
+
+/* Constants ==============================================================> */
+
+static const int BITMAP_WIDTH = 8, BITMAP_HEIGHT = 8;
+
+/* Private Function Prototypes ============================================> */
+
+static void onBitmapLoad(unsigned char *alpha);
+
+TEST utBakeBitmap(void);
+TEST utBakedShapeBlob(void);
+
+/* Public Functions =======================================================> */
+
+SUITE(baking) {
+    RUN_TEST(utBakeBitmap);
+    RUN_TEST(utBakedShapeBlob);
+}
+
+/* Private Functions ======================================================> */
+
+static void onBitmapLoad(unsigned char *alpha) {
+    memset(alpha, 0, BITMAP_WIDTH * BITMAP_HEIGHT);
+
+    // NOTE: An 'L' shape of 28 pixels and a 2 x 2 block, both with a notch.
+    for (int y = 0; y < BITMAP_HEIGHT; y++)
+        for (int x = 0; x < BITMAP_WIDTH; x++)
+            if (x < 2 || y >= 6) alpha[y * BITMAP_WIDTH + x] = 255;
+
+    alpha[1 * BITMAP_WIDTH + 5] = alpha[1 * BITMAP_WIDTH + 6] = 200;
+    alpha[2 * BITMAP_WIDTH + 5] = alpha[2 * BITMAP_WIDTH + 6] = 200;
+
+    alpha[0 * BITMAP_WIDTH + 5] = 64;
+}
+
+TEST utBakeBitmap(void) {
+    unsigned char alpha[BITMAP_WIDTH * BITMAP_HEIGHT];
+
+    onBitmapLoad(alpha);
+
+    ASSERT_EQ(NULL, frBakeBitmap(NULL, BITMAP_WIDTH, BITMAP_HEIGHT, 127, 0.5f));
+    ASSERT_EQ(NULL, frBakeBitmap(alpha, 0, BITMAP_HEIGHT, 127, 0.5f));
+    ASSERT_EQ(NULL,
+              frBakeBitmap(alpha, BITMAP_WIDTH, BITMAP_HEIGHT, 255, 0.5f));
+
+    frBakedShape *b = frBakeBitmap(alpha,
+                                   BITMAP_WIDTH,
+                                   BITMAP_HEIGHT,
+                                   127,
+                                   0.5f);
+
+    ASSERT_NEQ(NULL, b);
+
+    // NOTE: The 'L' shape is not convex, so it must be split.
+    ASSERT_GTE(frGetBakedShapePieceCount(b), 3);
+
+    float areaSum = 0.0f;
+
+    frShape *shapes[16] = { NULL };
+    frTransform offsets[16] = { { .angle = 0.0f } };
+
+    for (int i = 0; i < frGetBakedShapePieceCount(b); i++) {
+        const frVertices *vertices = frGetBakedShapePiece(b, i);
+
+        ASSERT_GTE(vertices->count, 3);
+        ASSERT_GTE(FR_GEOMETRY_MAX_VERTEX_COUNT, vertices->count);
+
+        shapes[i] = frCreatePolygon((frMaterial) { .density = 1.0f },
+                                    vertices);
+
+        // NOTE: Each piece is convex, so its convex hull is the piece itself.
+        ASSERT_EQ(vertices->count, frGetPolygonVertexCount(shapes[i]));
+
+        offsets[i].position = frGetBakedShapePiecePosition(b, i);
+
+        areaSum += frGetShapeArea(shapes[i]);
+    }
+
+    ASSERT_IN_RANGE(frPixelsToUnits(frPixelsToUnits(32.0f)), areaSum, 1e-6f);
+
+    {
+        frShape *s = frCreateCompound((frMaterial) { .density = 1.0f },
+                                      shapes,
+                                      offsets,
+                                      frGetBakedShapePieceCount(b));
+
+        frAABB aabb = frGetShapeAABB(s,
+                                     (frTransform) { .rotation.cos_ = 1.0f });
+
+        ASSERT_IN_RANGE(frPixelsToUnits(-4.0f), aabb.x, 1e-6f);
+        ASSERT_IN_RANGE(frPixelsToUnits(-4.0f), aabb.y, 1e-6f);
+        ASSERT_IN_RANGE(frPixelsToUnits(8.0f), aabb.width, 1e-6f);
+        ASSERT_IN_RANGE(frPixelsToUnits(8.0f), aabb.height, 1e-6f);
+
+        frReleaseShape(s);
+    }
+
+    for (int i = 0; i < frGetBakedShapePieceCount(b); i++)
+        frReleaseShape(shapes[i]);
+
+    ASSERT_EQ(NULL, frGetBakedShapePiece(b, frGetBakedShapePieceCount(b)));
+
+    frReleaseBakedShape(b);
+
+    PASS();
+}
+
+TEST utBakedShapeBlob(void) {
+    unsigned char alpha[BITMAP_WIDTH * BITMAP_HEIGHT];
+
+    onBitmapLoad(alpha);
+
+    frBakedShape *b1 = frBakeBitmap(alpha,
+                                    BITMAP_WIDTH,
+                                    BITMAP_HEIGHT,
+                                    127,
+                                    0.5f);
+
+    size_t size = frSaveBakedShape(b1, NULL, 0);
+
+    ASSERT_GT(size, 0);
+
+    unsigned char *buffer = malloc(size);
+
+    ASSERT_EQ(size, frSaveBakedShape(b1, buffer, size));
+
+    ASSERT_EQ(NULL, frLoadBakedShape(buffer, size - 1));
+
+    frBakedShape *b2 = frLoadBakedShape(buffer, size);
+
+    ASSERT_NEQ(NULL, b2);
+
+    ASSERT_EQ(frGetBakedShapePieceCount(b1), frGetBakedShapePieceCount(b2));
+
+    for (int i = 0; i < frGetBakedShapePieceCount(b1); i++) {
+        const frVertices *v1 = frGetBakedShapePiece(b1, i);
+        const frVertices *v2 = frGetBakedShapePiece(b2, i);
+
+        ASSERT_EQ(v1->count, v2->count);
+
+        ASSERT_MEM_EQ(v1->data, v2->data, v1->count * sizeof *(v1->data));
+
+        frVector2 p1 = frGetBakedShapePiecePosition(b1, i);
+        frVector2 p2 = frGetBakedShapePiecePosition(b2, i);
+
+        ASSERT_EQ(p1.x, p2.x);
+        ASSERT_EQ(p1.y, p2.y);
+    }
+
+    buffer[0] = 'X';
+
+    ASSERT_EQ(NULL, frLoadBakedShape(buffer, size));
+
+    free(buffer);
+
+    frReleaseBakedShape(b1), frReleaseBakedShape(b2);
+
+    PASS();
+}
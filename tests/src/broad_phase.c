@@ -29,20 +29,176 @@
 
 /* TODO: ... */
 
+/* Typedefs ===============================================================> */
+
+typedef struct QueryResult_ {
+    int ids[8];
+    int count;
+} QueryResult;
+
 /* Constants ==============================================================> */
 
-/* TODO: ... */
+static const float CELL_SIZE = 2.0f;
 
 /* Private Function Prototypes ============================================> */
 
-/* TODO: ... */
+static bool onHashQuery(frContextNode ctxNode);
+
+TEST utSpatialHashRay(void);
+TEST utSpatialHashBounds(void);
 
 /* Public Functions =======================================================> */
 
 SUITE(broad_phase) {
-    /* TODO: ... */
+    RUN_TEST(utSpatialHashRay);
+    RUN_TEST(utSpatialHashBounds);
 }
 
 /* Private Functions ======================================================> */
 
-/* TODO: ... */
+static bool onHashQuery(frContextNode ctxNode) {
+    QueryResult *result = ctxNode.ctx;
+
+    if (result->count < 8) result->ids[result->count++] = ctxNode.id;
+
+    return true;
+}
+
+TEST utSpatialHashRay(void) {
+    frSpatialHash *sh = frCreateSpatialHash(CELL_SIZE);
+
+    frInsertIntoSpatialHash(sh,
+                            (frAABB) { .x = 9.0f,
+                                       .y = -1.0f,
+                                       .width = 2.0f,
+                                       .height = 2.0f },
+                            0);
+
+    frInsertIntoSpatialHash(sh,
+                            (frAABB) { .x = -11.0f,
+                                       .y = -1.0f,
+                                       .width = 2.0f,
+                                       .height = 2.0f },
+                            1);
+
+    frInsertIntoSpatialHash(sh,
+                            (frAABB) { .x = 4.5f,
+                                       .y = -0.5f,
+                                       .width = 1.0f,
+                                       .height = 1.0f },
+                            2);
+
+    frInsertIntoSpatialHash(sh,
+                            (frAABB) { .x = 4.5f,
+                                       .y = 8.5f,
+                                       .width = 1.0f,
+                                       .height = 1.0f },
+                            3);
+
+    {
+        frRay ray = { .origin = { .x = -16.0f, .y = 0.5f },
+                      .direction = { .x = 1.0f },
+                      .maxDistance = FLT_MAX };
+
+        QueryResult result = { .count = 0 };
+
+        frQuerySpatialHashRay(sh, &ray, onHashQuery, &result);
+
+        ASSERT_EQ(3, result.count);
+
+        ASSERT_EQ(1, result.ids[0]);
+        ASSERT_EQ(2, result.ids[1]);
+        ASSERT_EQ(0, result.ids[2]);
+    }
+
+    {
+        frRay ray = { .origin = { .x = 16.0f, .y = -0.5f },
+                      .direction = { .x = -1.0f },
+                      .maxDistance = 8.0f };
+
+        QueryResult result = { .count = 0 };
+
+        frQuerySpatialHashRay(sh, &ray, onHashQuery, &result);
+
+        ASSERT_EQ(1, result.count);
+        ASSERT_EQ(0, result.ids[0]);
+    }
+
+    {
+        frRay ray = { .origin = { .x = 5.0f, .y = 32.0f },
+                      .direction = { .y = -1.0f },
+                      .maxDistance = FLT_MAX };
+
+        QueryResult result = { .count = 0 };
+
+        frQuerySpatialHashRay(sh, &ray, onHashQuery, &result);
+
+        ASSERT_EQ(2, result.count);
+
+        ASSERT_EQ(3, result.ids[0]);
+        ASSERT_EQ(2, result.ids[1]);
+    }
+
+    frReleaseSpatialHash(sh);
+
+    PASS();
+}
+
+TEST utSpatialHashBounds(void) {
+    frSpatialHash *sh = frCreateSpatialHash(CELL_SIZE);
+
+    frAABB nearKey = { .x = 0.5f, .y = 0.5f, .width = 1.0f, .height = 1.0f };
+    frAABB farKey = { .x = 1000.5f, .y = 0.5f, .width = 1.0f, .height = 1.0f };
+
+    frInsertIntoSpatialHash(sh, nearKey, 0);
+    frInsertIntoSpatialHash(sh, farKey, 1);
+
+    {
+        frAABB bounds = frGetSpatialHashBounds(sh);
+
+        ASSERT_IN_RANGE(1002.0f, bounds.width, FLT_EPSILON);
+        ASSERT_IN_RANGE(2.0f, bounds.height, FLT_EPSILON);
+    }
+
+    {
+        // NOTE: The bounds shrink back once the far cell is empty.
+        frRemoveFromSpatialHash(sh, farKey, 1);
+
+        frAABB bounds = frGetSpatialHashBounds(sh);
+
+        ASSERT_IN_RANGE(0.0f, bounds.x, FLT_EPSILON);
+        ASSERT_IN_RANGE(2.0f, bounds.width, FLT_EPSILON);
+        ASSERT_IN_RANGE(2.0f, bounds.height, FLT_EPSILON);
+
+        frRay ray = { .origin = { .x = -16.0f, .y = 1.0f },
+                      .direction = { .x = 1.0f },
+                      .maxDistance = FLT_MAX };
+
+        QueryResult result = { .count = 0 };
+
+        frQuerySpatialHashRay(sh, &ray, onHashQuery, &result);
+
+        ASSERT_EQ(1, result.count);
+        ASSERT_EQ(0, result.ids[0]);
+    }
+
+    {
+        frRemoveFromSpatialHash(sh, nearKey, 0);
+
+        frAABB bounds = frGetSpatialHashBounds(sh);
+
+        ASSERT_IN_RANGE(0.0f, bounds.width, FLT_EPSILON);
+        ASSERT_IN_RANGE(0.0f, bounds.height, FLT_EPSILON);
+
+        frInsertIntoSpatialHash(sh, farKey, 1);
+
+        bounds = frGetSpatialHashBounds(sh);
+
+        ASSERT_IN_RANGE(1000.0f, bounds.x, FLT_EPSILON);
+        ASSERT_IN_RANGE(2.0f, bounds.width, FLT_EPSILON);
+    }
+
+    frReleaseSpatialHash(sh);
+
+    PASS();
+}
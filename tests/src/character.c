@@ -0,0 +1,129 @@
+/*
+    Copyright (c) 2021-2024 Jaedeok Kim <jdeokkim@protonmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a 
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation 
+    the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+    and/or sell copies of the Software, and to permit persons to whom the 
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included 
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Includes ===============================================================> */
+
+#include "ferox.h"
+#include "greatest.h"
+
+/* Constants ==============================================================> */
+
+static const float CELL_SIZE = 2.0f, DELTA_TIME = 1.0f / 60.0f;
+
+/* Private Function Prototypes ============================================> */
+
+TEST utCharacterMove(void);
+
+/* Public Functions =======================================================> */
+
+SUITE(character) {
+    RUN_TEST(utCharacterMove);
+}
+
+/* Private Functions ======================================================> */
+
+TEST utCharacterMove(void) {
+    frWorld *w = frCreateWorld(FR_WORLD_DEFAULT_GRAVITY, CELL_SIZE);
+
+    frShape *s1 = frCreateRectangle((frMaterial) { .density = 1.0f },
+                                    16.0f,
+                                    1.0f);
+    frShape *s2 = frCreateCircle((frMaterial) { .density = 1.0f }, 0.5f);
+    frShape *s3 = frCreateRectangle((frMaterial) { .density = 1.0f },
+                                    1.0f,
+                                    1.0f);
+
+    frBody *b1 = frCreateBodyFromShape(FR_BODY_STATIC,
+                                       (frVector2) { .x = 8.0f, .y = 8.0f },
+                                       s1);
+    frBody *b2 = frCreateBodyFromShape(FR_BODY_KINEMATIC,
+                                       (frVector2) { .x = 4.0f, .y = 5.0f },
+                                       s2);
+    frBody *b3 = frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                       (frVector2) { .x = 8.0f, .y = 6.9f },
+                                       s3);
+
+    ASSERT_EQ(NULL, frCreateCharacter(b1));
+
+    frCharacter *c = frCreateCharacter(b2);
+
+    ASSERT_NEQ(NULL, c);
+
+    frAddBodyToWorld(w, b1), frAddBodyToWorld(w, b2);
+
+    frStepWorld(w, DELTA_TIME);
+
+    {
+        frMoveCharacter(c, (frVector2) { .y = 4.0f }, DELTA_TIME);
+
+        frVector2 position = frGetBodyPosition(b2);
+
+        ASSERT_IN_RANGE(6.98f, position.y, 0.01f);
+
+        ASSERT_EQ(FR_CHARACTER_GROUNDED, frGetCharacterState(c));
+        ASSERT_EQ(b1, frGetCharacterGround(c));
+
+        ASSERT_IN_RANGE(-1.0f, frGetCharacterGroundNormal(c).y, 0.01f);
+    }
+
+    {
+        frVector2 delta = frMoveCharacter(c,
+                                          (frVector2) { .x = 1.0f, .y = 0.1f },
+                                          DELTA_TIME);
+
+        ASSERT_IN_RANGE(1.0f, delta.x, 0.01f);
+        ASSERT_IN_RANGE(0.0f, delta.y, 0.01f);
+
+        ASSERT_EQ(FR_CHARACTER_GROUNDED, frGetCharacterState(c));
+    }
+
+    {
+        frMoveCharacter(c, (frVector2) { .y = -1.0f }, DELTA_TIME);
+
+        ASSERT_EQ(FR_CHARACTER_AIRBORNE, frGetCharacterState(c));
+
+        frMoveCharacter(c, (frVector2) { .y = 1.0f }, DELTA_TIME);
+
+        ASSERT_EQ(FR_CHARACTER_GROUNDED, frGetCharacterState(c));
+    }
+
+    frAddBodyToWorld(w, b3);
+
+    frStepWorld(w, DELTA_TIME);
+
+    {
+        frVector2 delta = frMoveCharacter(c,
+                                          (frVector2) { .x = 4.0f },
+                                          DELTA_TIME);
+
+        ASSERT_IN_RANGE(1.98f, delta.x, 0.05f);
+        ASSERT_GT(frGetBodyVelocity(b3).x, 0.0f);
+    }
+
+    frReleaseCharacter(c);
+
+    frReleaseShape(s1), frReleaseShape(s2), frReleaseShape(s3);
+
+    frReleaseWorld(w);
+
+    PASS();
+}
@@ -32,6 +32,13 @@
 TEST utCircleVsCircle(void);
 TEST utCircleVsPolygon(void);
 TEST utPolygonVsPolygon(void);
+TEST utCapsuleCollision(void);
+TEST utChainCollision(void);
+TEST utTilemapCollision(void);
+TEST utCompoundCollision(void);
+TEST utShapeCast(void);
+TEST utShapeDistance(void);
+TEST utSupportIndex(void);
 
 /* Public Functions =======================================================> */
 
@@ -39,6 +46,13 @@ SUITE(collision) {
     RUN_TEST(utCircleVsCircle);
     RUN_TEST(utCircleVsPolygon);
     RUN_TEST(utPolygonVsPolygon);
+    RUN_TEST(utCapsuleCollision);
+    RUN_TEST(utChainCollision);
+    RUN_TEST(utTilemapCollision);
+    RUN_TEST(utCompoundCollision);
+    RUN_TEST(utShapeCast);
+    RUN_TEST(utShapeDistance);
+    RUN_TEST(utSupportIndex);
 }
 
 /* Private Functions ======================================================> */
@@ -204,4 +218,565 @@ TEST utPolygonVsPolygon(void) {
     /* TODO: ... */
 
     PASS();
-}
\ No newline at end of file
+}
+
+TEST utCapsuleCollision(void) {
+    frShape *s1 = frCreateCapsule(frStructZero(frMaterial), 2.0f, 0.5f);
+    frShape *s2 = frCreateCircle(frStructZero(frMaterial), 0.5f);
+    frShape *s3 = frCreateCapsule(frStructZero(frMaterial), 2.0f, 0.5f);
+    frShape *s4 = frCreateRectangle(frStructZero(frMaterial), 4.0f, 1.0f);
+
+    frTransform tx1 = { .rotation.cos_ = 1.0f };
+
+    frTransform tx2 = { .position = { .x = 0.8f }, .rotation.cos_ = 1.0f };
+
+    frTransform tx3 = { .position = { .x = 0.9f, .y = 0.5f },
+                        .rotation.cos_ = 1.0f };
+
+    frTransform tx4 = { .position = { .y = 1.9f }, .rotation.cos_ = 1.0f };
+
+    frCollision collision = { .count = 0 };
+
+    {
+        ASSERT_EQ(true, frComputeShapeCollision(s1, tx1, s2, tx2, &collision));
+
+        ASSERT_EQ(1, collision.count);
+
+        ASSERT_IN_RANGE(1.0f, collision.direction.x, FLT_EPSILON);
+        ASSERT_IN_RANGE(0.2f, collision.contacts[0].depth, 1e-5f);
+
+        ASSERT_IN_RANGE(0.5f, collision.contacts[0].point.x, 1e-5f);
+    }
+
+    {
+        ASSERT_EQ(true, frComputeShapeCollision(s1, tx1, s3, tx3, &collision));
+
+        ASSERT_EQ(2, collision.count);
+
+        ASSERT_IN_RANGE(1.0f, collision.direction.x, FLT_EPSILON);
+
+        ASSERT_IN_RANGE(0.1f, collision.contacts[0].depth, 1e-5f);
+        ASSERT_IN_RANGE(0.1f, collision.contacts[1].depth, 1e-5f);
+    }
+
+    {
+        ASSERT_EQ(true, frComputeShapeCollision(s1, tx1, s4, tx4, &collision));
+
+        ASSERT_EQ(1, collision.count);
+
+        ASSERT_IN_RANGE(1.0f, collision.direction.y, FLT_EPSILON);
+        ASSERT_IN_RANGE(0.1f, collision.contacts[0].depth, 1e-5f);
+
+        tx1.angle = 0.5f * M_PI;
+
+        tx1.rotation.sin_ = 1.0f, tx1.rotation.cos_ = 0.0f;
+
+        tx4.position.y = 0.9f;
+
+        ASSERT_EQ(true, frComputeShapeCollision(s4, tx4, s1, tx1, &collision));
+
+        ASSERT_EQ(2, collision.count);
+
+        ASSERT_IN_RANGE(-1.0f, collision.direction.y, FLT_EPSILON);
+
+        ASSERT_IN_RANGE(0.1f, collision.contacts[0].depth, 1e-5f);
+        ASSERT_IN_RANGE(0.1f, collision.contacts[1].depth, 1e-5f);
+
+        tx4.position.y = 1.1f;
+
+        ASSERT_EQ(false, frComputeShapeCollision(s1, tx1, s4, tx4, NULL));
+    }
+
+    {
+        frRaycastHit raycastHit = { .distance = 0.0f };
+
+        frTransform tx = { .rotation.cos_ = 1.0f };
+
+        frRay ray = { .origin = { .x = -3.0f },
+                      .direction = { .x = 1.0f },
+                      .maxDistance = 8.0f };
+
+        ASSERT_EQ(true, frComputeShapeRaycast(s1, tx, ray, &raycastHit));
+
+        ASSERT_IN_RANGE(2.5f, raycastHit.distance, 1e-5f);
+        ASSERT_IN_RANGE(-1.0f, raycastHit.normal.x, 1e-5f);
+
+        ray = (frRay) { .origin = { .y = -5.0f },
+                        .direction = { .y = 1.0f },
+                        .maxDistance = 8.0f };
+
+        ASSERT_EQ(true, frComputeShapeRaycast(s1, tx, ray, &raycastHit));
+
+        ASSERT_IN_RANGE(3.5f, raycastHit.distance, 1e-5f);
+        ASSERT_IN_RANGE(-1.0f, raycastHit.normal.y, 1e-5f);
+    }
+
+    frReleaseShape(s1), frReleaseShape(s2);
+    frReleaseShape(s3), frReleaseShape(s4);
+
+    PASS();
+}
+
+TEST utChainCollision(void) {
+    frVector2 vertices[] = { { .x = -2.0f },
+                             { .x = 0.0f },
+                             { .x = 2.0f } };
+
+    frShape *s1 = frCreateChain(frStructZero(frMaterial), vertices, 3, false);
+    frShape *s2 = frCreateRectangle(frStructZero(frMaterial), 1.0f, 1.0f);
+    frShape *s3 = frCreateCircle(frStructZero(frMaterial), 0.5f);
+
+    float heights[] = { 0.0f, 0.0f, 1.0f, 1.0f };
+
+    frShape *s4 = frCreateHeightfield(frStructZero(frMaterial),
+                                      heights,
+                                      4,
+                                      1.0f);
+
+    frTransform tx1 = { .rotation.cos_ = 1.0f };
+
+    frTransform tx2 = { .position = { .y = -0.4f }, .rotation.cos_ = 1.0f };
+
+    frCollision collision = { .count = 0 };
+
+    {
+        // NOTE: The box lies across the vertex between two line segments.
+        ASSERT_EQ(true, frComputeShapeCollision(s1, tx1, s2, tx2, &collision));
+
+        ASSERT_EQ(2, collision.count);
+
+        ASSERT_IN_RANGE(0.0f, collision.direction.x, 1e-5f);
+        ASSERT_IN_RANGE(-1.0f, collision.direction.y, 1e-5f);
+
+        ASSERT_IN_RANGE(0.1f, collision.contacts[0].depth, 1e-5f);
+        ASSERT_IN_RANGE(0.1f, collision.contacts[1].depth, 1e-5f);
+
+        ASSERT_EQ(true, frComputeShapeCollision(s2, tx2, s1, tx1, &collision));
+
+        ASSERT_IN_RANGE(1.0f, collision.direction.y, 1e-5f);
+
+        // NOTE: The line segments do not collide with shapes behind them.
+        tx2.position.y = 0.4f;
+
+        ASSERT_EQ(false, frComputeShapeCollision(s1, tx1, s2, tx2, NULL));
+    }
+
+    {
+        frTransform tx = { .position = { .x = 0.9f, .y = -0.4f },
+                           .rotation.cos_ = 1.0f };
+
+        // NOTE: The circle touches the foot of the slope from the left.
+        ASSERT_EQ(true, frComputeShapeCollision(s4, tx1, s3, tx, &collision));
+
+        ASSERT_LT(collision.direction.x, 0.0f);
+        ASSERT_LT(collision.direction.y, 0.0f);
+
+        tx.position = (frVector2) { .x = 2.5f, .y = -1.4f };
+
+        ASSERT_EQ(true, frComputeShapeCollision(s4, tx1, s3, tx, &collision));
+
+        ASSERT_IN_RANGE(-1.0f, collision.direction.y, 1e-5f);
+        ASSERT_IN_RANGE(0.1f, collision.contacts[0].depth, 1e-5f);
+    }
+
+    {
+        frRaycastHit raycastHit = { .distance = 0.0f };
+
+        frRay ray = { .origin = { .x = 1.0f, .y = -4.0f },
+                      .direction = { .y = 1.0f },
+                      .maxDistance = 8.0f };
+
+        ASSERT_EQ(true, frComputeShapeRaycast(s1, tx1, ray, &raycastHit));
+
+        ASSERT_IN_RANGE(4.0f, raycastHit.distance, 1e-5f);
+        ASSERT_IN_RANGE(-1.0f, raycastHit.normal.y, 1e-5f);
+
+        ray.origin.y = 4.0f, ray.direction.y = -1.0f;
+
+        ASSERT_EQ(false, frComputeShapeRaycast(s1, tx1, ray, &raycastHit));
+    }
+
+    frReleaseShape(s1), frReleaseShape(s2);
+    frReleaseShape(s3), frReleaseShape(s4);
+
+    PASS();
+}
+
+TEST utTilemapCollision(void) {
+    /*
+        NOTE: The floor is split into two rectangles at `x = 2.0f`, 
+        with a wall on the right end of it.
+    */
+    bool tiles[] = { false, false, false, false, true,
+                     true,  true,  true,  true,  true };
+
+    frShape *s1 = frCreateTilemap(frStructZero(frMaterial), tiles, 5, 2, 1.0f);
+    frShape *s2 = frCreateRectangle(frStructZero(frMaterial), 1.0f, 1.0f);
+
+    frSetTilemapTile(s1, 2, 1, false), frSetTilemapTile(s1, 2, 1, true);
+
+    frTransform tx1 = { .rotation.cos_ = 1.0f };
+
+    frTransform tx2 = { .position = { .x = 2.1f, .y = 0.6f },
+                        .rotation.cos_ = 1.0f };
+
+    frCollision collision = { .count = 0 };
+
+    {
+        // NOTE: The box lies across the seam between two rectangles.
+        ASSERT_EQ(true, frComputeShapeCollision(s1, tx1, s2, tx2, &collision));
+
+        ASSERT_EQ(2, collision.count);
+
+        ASSERT_IN_RANGE(0.0f, collision.direction.x, 1e-5f);
+        ASSERT_IN_RANGE(-1.0f, collision.direction.y, 1e-5f);
+
+        ASSERT_IN_RANGE(0.1f, collision.contacts[0].depth, 1e-5f);
+
+        ASSERT_EQ(true, frComputeShapeCollision(s2, tx2, s1, tx1, &collision));
+
+        ASSERT_IN_RANGE(1.0f, collision.direction.y, 1e-5f);
+
+        // NOTE: The box is pushed out of the wall to the left.
+        tx2.position = (frVector2) { .x = 3.6f, .y = 0.4f };
+
+        ASSERT_EQ(true, frComputeShapeCollision(s1, tx1, s2, tx2, &collision));
+
+        ASSERT_IN_RANGE(-1.0f, collision.direction.x, 1e-5f);
+        ASSERT_IN_RANGE(0.1f, collision.contacts[0].depth, 1e-5f);
+    }
+
+    {
+        frRaycastHit raycastHit = { .distance = 0.0f };
+
+        frRay ray = { .origin = { .x = 0.5f, .y = 0.5f },
+                      .direction = { .x = 1.0f },
+                      .maxDistance = 8.0f };
+
+        ASSERT_EQ(true, frComputeShapeRaycast(s1, tx1, ray, &raycastHit));
+
+        ASSERT_IN_RANGE(3.5f, raycastHit.distance, 1e-5f);
+        ASSERT_IN_RANGE(-1.0f, raycastHit.normal.x, 1e-5f);
+
+        ray.origin = (frVector2) { .x = 1.5f, .y = -2.0f };
+        ray.direction = (frVector2) { .y = 1.0f };
+
+        ASSERT_EQ(true, frComputeShapeRaycast(s1, tx1, ray, &raycastHit));
+
+        ASSERT_IN_RANGE(3.0f, raycastHit.distance, 1e-5f);
+        ASSERT_IN_RANGE(-1.0f, raycastHit.normal.y, 1e-5f);
+
+        ray.origin.y = 1.5f;
+
+        ASSERT_EQ(false, frComputeShapeRaycast(s1, tx1, ray, &raycastHit));
+        ASSERT_EQ(true, raycastHit.inside);
+
+        // NOTE: A destroyed tile no longer blocks the ray.
+        frSetTilemapTile(s1, 4, 0, false);
+
+        ray.origin = (frVector2) { .x = 0.5f, .y = 0.5f };
+        ray.direction = (frVector2) { .x = 1.0f };
+
+        ASSERT_EQ(false, frComputeShapeRaycast(s1, tx1, ray, &raycastHit));
+    }
+
+    frReleaseShape(s1), frReleaseShape(s2);
+
+    PASS();
+}
+
+TEST utCompoundCollision(void) {
+    frShape *shapes[] = { frCreateRectangle(frStructZero(frMaterial),
+                                            1.0f,
+                                            1.0f),
+                          frCreateCircle(frStructZero(frMaterial), 0.5f) };
+
+    frTransform offsets[] = { { .position = { .x = -1.0f } },
+                              { .position = { .x = 1.0f } } };
+
+    frShape *s1 = frCreateCompound(frStructZero(frMaterial),
+                                   shapes,
+                                   offsets,
+                                   2);
+    frShape *s2 = frCreateRectangle(frStructZero(frMaterial), 4.0f, 1.0f);
+
+    frTransform tx1 = { .rotation.cos_ = 1.0f };
+
+    frTransform tx2 = { .position = { .y = 0.9f }, .rotation.cos_ = 1.0f };
+
+    frCollision collision = { .count = 0 };
+
+    {
+        // NOTE: The box and the circle both rest on the floor below.
+        ASSERT_EQ(true, frComputeShapeCollision(s1, tx1, s2, tx2, &collision));
+
+        ASSERT_EQ(2, collision.count);
+
+        ASSERT_IN_RANGE(1.0f, collision.direction.y, 1e-5f);
+
+        ASSERT_IN_RANGE(0.1f, collision.contacts[0].depth, 1e-5f);
+        ASSERT_IN_RANGE(0.1f, collision.contacts[1].depth, 1e-5f);
+
+        ASSERT_EQ(true, frComputeShapeCollision(s2, tx2, s1, tx1, &collision));
+
+        ASSERT_IN_RANGE(-1.0f, collision.direction.y, 1e-5f);
+
+        // NOTE: The circle is the closest child to the box on the right.
+        tx2.position.x = 8.0f, tx2.position.y = 0.0f;
+
+        ASSERT_EQ(false, frComputeShapeCollision(s1, tx1, s2, tx2, NULL));
+
+        ASSERT_IN_RANGE(4.5f,
+                        frComputeShapeDistance(s1, tx1, s2, tx2, NULL, NULL),
+                        1e-5f);
+    }
+
+    {
+        frRaycastHit raycastHit = { .distance = 0.0f };
+
+        frRay ray = { .origin = { .x = -4.0f },
+                      .direction = { .x = 1.0f },
+                      .maxDistance = 8.0f };
+
+        ASSERT_EQ(true, frComputeShapeRaycast(s1, tx1, ray, &raycastHit));
+
+        ASSERT_IN_RANGE(2.5f, raycastHit.distance, 1e-5f);
+        ASSERT_IN_RANGE(-1.0f, raycastHit.normal.x, 1e-5f);
+
+        ray.origin.x = 4.0f, ray.direction.x = -1.0f;
+
+        ASSERT_EQ(true, frComputeShapeRaycast(s1, tx1, ray, &raycastHit));
+
+        ASSERT_IN_RANGE(2.5f, raycastHit.distance, 1e-5f);
+
+        ray.origin.x = 1.0f;
+
+        ASSERT_EQ(false, frComputeShapeRaycast(s1, tx1, ray, &raycastHit));
+        ASSERT_EQ(true, raycastHit.inside);
+    }
+
+    {
+        frRaycastHit raycastHit = { .distance = 0.0f };
+
+        tx2.position = (frVector2) { .x = 1.0f, .y = 4.0f };
+
+        ASSERT_EQ(true,
+                  frComputeShapeCast(s1,
+                                     tx1,
+                                     (frVector2) { .y = 8.0f },
+                                     s2,
+                                     tx2,
+                                     &raycastHit));
+
+        ASSERT_IN_RANGE(3.0f, raycastHit.distance, 0.01f);
+        ASSERT_IN_RANGE(-1.0f, raycastHit.normal.y, 1e-3f);
+    }
+
+    frReleaseShape(s1), frReleaseShape(s2);
+    frReleaseShape(shapes[0]), frReleaseShape(shapes[1]);
+
+    PASS();
+}
+
+TEST utShapeCast(void) {
+    frShape *s1 = frCreateCircle(frStructZero(frMaterial), 0.5f);
+    frShape *s2 = frCreateRectangle(frStructZero(frMaterial), 1.0f, 1.0f);
+    frShape *s3 = frCreateRectangle(frStructZero(frMaterial), 2.0f, 2.0f);
+
+    frTransform tx1 = { .rotation.cos_ = 1.0f };
+
+    frTransform tx2 = { .rotation.sin_ = sinf(0.25f * M_PI),
+                        .rotation.cos_ = cosf(0.25f * M_PI),
+                        .angle = 0.25f * M_PI };
+
+    frTransform tx3 = { .position = { .x = 5.0f }, .rotation.cos_ = 1.0f };
+
+    frRaycastHit raycastHit = { .distance = 0.0f };
+
+    {
+        ASSERT_EQ(true,
+                  frComputeShapeCast(s1,
+                                     tx1,
+                                     (frVector2) { .x = 10.0f },
+                                     s3,
+                                     tx3,
+                                     &raycastHit));
+
+        ASSERT_EQ(false, raycastHit.inside);
+
+        ASSERT_IN_RANGE(3.495f, raycastHit.distance, 0.005f);
+
+        ASSERT_IN_RANGE(-1.0f, raycastHit.normal.x, 0.001f);
+        ASSERT_IN_RANGE(0.0f, raycastHit.normal.y, 0.001f);
+
+        ASSERT_IN_RANGE(4.0f, raycastHit.point.x, 0.005f);
+    }
+
+    {
+        ASSERT_EQ(false,
+                  frComputeShapeCast(s1,
+                                     tx1,
+                                     (frVector2) { .y = 10.0f },
+                                     s3,
+                                     tx3,
+                                     NULL));
+
+        ASSERT_EQ(false,
+                  frComputeShapeCast(s1,
+                                     tx1,
+                                     (frVector2) { .x = 3.0f },
+                                     s3,
+                                     tx3,
+                                     NULL));
+    }
+
+    {
+        tx3.position = (frVector2) { .x = 0.3f, .y = 5.0f };
+
+        ASSERT_EQ(true,
+                  frComputeShapeCast(s2,
+                                     tx2,
+                                     (frVector2) { .y = 10.0f },
+                                     s3,
+                                     tx3,
+                                     &raycastHit));
+
+        float distance = 4.0f - sqrtf(0.5f);
+
+        ASSERT_IN_RANGE(distance - 0.0025f, raycastHit.distance, 0.0025f);
+
+        ASSERT_IN_RANGE(0.0f, raycastHit.normal.x, 0.001f);
+        ASSERT_IN_RANGE(-1.0f, raycastHit.normal.y, 0.001f);
+    }
+
+    {
+        tx3.position = (frVector2) { .x = 1.0f };
+
+        ASSERT_EQ(true,
+                  frComputeShapeCast(s1,
+                                     tx1,
+                                     (frVector2) { .x = 10.0f },
+                                     s3,
+                                     tx3,
+                                     &raycastHit));
+
+        ASSERT_EQ(true, raycastHit.inside);
+        ASSERT_IN_RANGE(0.0f, raycastHit.distance, FLT_EPSILON);
+    }
+
+    frReleaseShape(s1), frReleaseShape(s2), frReleaseShape(s3);
+
+    PASS();
+}
+
+TEST utShapeDistance(void) {
+    frShape *s1 = frCreateCircle(frStructZero(frMaterial), 0.5f);
+    frShape *s2 = frCreateRectangle(frStructZero(frMaterial), 1.0f, 1.0f);
+    frShape *s3 = frCreateRectangle(frStructZero(frMaterial), 2.0f, 2.0f);
+
+    frTransform tx1 = { .rotation.cos_ = 1.0f };
+
+    frTransform tx2 = { .rotation.sin_ = sinf(0.25f * M_PI),
+                        .rotation.cos_ = cosf(0.25f * M_PI),
+                        .angle = 0.25f * M_PI };
+
+    frTransform tx3 = { .position = { .x = 5.0f }, .rotation.cos_ = 1.0f };
+
+    frVector2 p1 = { .x = 0.0f }, p2 = { .x = 0.0f };
+
+    {
+        ASSERT_IN_RANGE(3.5f,
+                        frComputeShapeDistance(s1, tx1, s3, tx3, &p1, &p2),
+                        0.001f);
+
+        ASSERT_IN_RANGE(0.5f, p1.x, 0.001f);
+        ASSERT_IN_RANGE(0.0f, p1.y, 0.001f);
+
+        ASSERT_IN_RANGE(4.0f, p2.x, 0.001f);
+        ASSERT_IN_RANGE(0.0f, p2.y, 0.001f);
+    }
+
+    {
+        ASSERT_IN_RANGE(4.0f - sqrtf(0.5f),
+                        frComputeShapeDistance(s2, tx2, s3, tx3, &p1, &p2),
+                        0.001f);
+
+        ASSERT_IN_RANGE(sqrtf(0.5f), p1.x, 0.001f);
+        ASSERT_IN_RANGE(0.0f, p1.y, 0.001f);
+
+        ASSERT_IN_RANGE(4.0f, p2.x, 0.001f);
+        ASSERT_IN_RANGE(0.0f, p2.y, 0.001f);
+    }
+
+    {
+        tx3.position = (frVector2) { .x = 1.0f };
+
+        ASSERT_EQ(0.0f, frComputeShapeDistance(s1, tx1, s3, tx3, NULL, NULL));
+        ASSERT_EQ(0.0f, frComputeShapeDistance(s2, tx2, s3, tx3, NULL, NULL));
+    }
+
+    frReleaseShape(s1), frReleaseShape(s2), frReleaseShape(s3);
+
+    PASS();
+}
+
+TEST utSupportIndex(void) {
+    frVertices vertices = { .count = FR_GEOMETRY_MAX_VERTEX_COUNT };
+
+    for (int i = 0; i < vertices.count; i++) {
+        float angle = (2.0f * M_PI * i) / vertices.count;
+
+        // NOTE: Stretches the polygon so that its vertices are uneven.
+        vertices.data[i] = (frVector2) { .x = 2.0f * cosf(angle + 0.1f * i),
+                                         .y = sinf(angle + 0.1f * i) };
+    }
+
+    frShape *s1 = frCreatePolygon(frStructZero(frMaterial), &vertices);
+    frShape *s2 = frCreateCircle(frStructZero(frMaterial), 0.5f);
+
+    const frVector2 *polygonVertices = frGetPolygonVertices(s1);
+
+    int vertexCount = frGetPolygonVertexCount(s1);
+
+    ASSERT_EQ(FR_GEOMETRY_MAX_VERTEX_COUNT, vertexCount);
+
+    for (int i = 0; i < 64; i++) {
+        float angle = (2.0f * M_PI * i) / 64.0f;
+
+        frTransform tx = { .position = { .x = 1.0f, .y = -2.0f },
+                           .rotation.sin_ = sinf(0.7f * angle),
+                           .rotation.cos_ = cosf(0.7f * angle),
+                           .angle = 0.7f * angle };
+
+        frVector2 v = { .x = cosf(angle), .y = sinf(angle) };
+
+        int supportIndex = frGetPolygonSupportIndex(s1, tx, v);
+
+        ASSERT(supportIndex >= 0 && supportIndex < vertexCount);
+
+        float maxDot = -FLT_MAX;
+
+        for (int j = 0; j < vertexCount; j++) {
+            float dot = frVector2Dot(frVector2Transform(polygonVertices[j],
+                                                        tx),
+                                     v);
+
+            if (maxDot < dot) maxDot = dot;
+        }
+
+        ASSERT_IN_RANGE(
+            maxDot,
+            frVector2Dot(frVector2Transform(polygonVertices[supportIndex], tx),
+                         v),
+            0.0001f);
+    }
+
+    ASSERT_EQ(-1,
+              frGetPolygonSupportIndex(s2,
+                                       frStructZero(frTransform),
+                                       (frVector2) { .x = 1.0f }));
+
+    frReleaseShape(s1), frReleaseShape(s2);
+
+    PASS();
+}
@@ -31,9 +31,12 @@ GREATEST_MAIN_DEFS();
 
 /* Public Function Prototypes =============================================> */
 
+SUITE_EXTERN(baking);
 SUITE_EXTERN(broad_phase);
+SUITE_EXTERN(character);
 SUITE_EXTERN(collision);
 SUITE_EXTERN(geometry);
+SUITE_EXTERN(particle);
 SUITE_EXTERN(rigid_body);
 SUITE_EXTERN(utils);
 SUITE_EXTERN(world);
@@ -43,9 +46,12 @@ SUITE_EXTERN(world);
 int main(int argc, char *argv[]) {
     GREATEST_MAIN_BEGIN();
 
+    RUN_SUITE(baking);
     RUN_SUITE(broad_phase);
+    RUN_SUITE(character);
     RUN_SUITE(collision);
     RUN_SUITE(geometry);
+    RUN_SUITE(particle);
     RUN_SUITE(rigid_body);
     RUN_SUITE(utils);
     RUN_SUITE(world);
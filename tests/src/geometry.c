@@ -29,14 +29,425 @@
 
 /* Private Function Prototypes ============================================> */
 
-/* TODO: ... */
+static bool onChainQuery(frContextNode ctxNode);
+
+TEST utPolygonVertices(void);
+TEST utShapeTypeChange(void);
+TEST utCapsuleDimensions(void);
+TEST utChainSegments(void);
+TEST utTilemapRects(void);
+TEST utCompoundShape(void);
 
 /* Public Functions =======================================================> */
 
 SUITE(geometry) {
-    /* TODO: ... */
+    RUN_TEST(utPolygonVertices);
+    RUN_TEST(utShapeTypeChange);
+    RUN_TEST(utCapsuleDimensions);
+    RUN_TEST(utChainSegments);
+    RUN_TEST(utTilemapRects);
+    RUN_TEST(utCompoundShape);
 }
 
 /* Private Functions ======================================================> */
 
-/* TODO: ... */
+static bool onChainQuery(frContextNode ctxNode) {
+    int *indices = ctxNode.ctx;
+
+    indices[++indices[0]] = ctxNode.id;
+
+    return true;
+}
+
+TEST utPolygonVertices(void) {
+    frShape *s = frCreateRectangle(frStructZero(frMaterial), 2.0f, 2.0f);
+
+    {
+        ASSERT_EQ(4, frGetPolygonVertexCount(s));
+
+        ASSERT_IN_RANGE(4.0f, frGetShapeArea(s), FLT_EPSILON);
+    }
+
+    {
+        frVertices vertices = { .count = 6 };
+
+        for (int i = 0; i < vertices.count; i++)
+            vertices.data[i] = frVector2Rotate((frVector2) { .x = 1.0f },
+                                               (M_PI / 3.0f) * i);
+
+        frSetPolygonVertices(s, &vertices);
+
+        ASSERT_EQ(6, frGetPolygonVertexCount(s));
+
+        const frVector2 *newVertices = frGetPolygonVertices(s);
+        const frVector2 *newNormals = frGetPolygonNormals(s);
+
+        for (int i = 0; i < frGetPolygonVertexCount(s); i++) {
+            ASSERT_IN_RANGE(1.0f,
+                            frVector2Magnitude(newVertices[i]),
+                            1e-5f);
+
+            ASSERT_IN_RANGE(1.0f,
+                            frVector2Magnitude(newNormals[i]),
+                            1e-5f);
+        }
+
+        ASSERT_IN_RANGE(1.5f * sqrtf(3.0f), frGetShapeArea(s), 1e-5f);
+    }
+
+    {
+        frSetRectangleDimensions(s, 1.0f, 3.0f);
+
+        ASSERT_EQ(4, frGetPolygonVertexCount(s));
+
+        ASSERT_IN_RANGE(3.0f, frGetShapeArea(s), FLT_EPSILON);
+    }
+
+    frReleaseShape(s);
+
+    PASS();
+}
+
+TEST utShapeTypeChange(void) {
+    frShape *s = frCreateCircle(frStructZero(frMaterial), 1.0f);
+
+    {
+        // NOTE: The polygon setters must not touch the data of a circle.
+        frSetRectangleDimensions(s, 2.0f, 2.0f);
+
+        ASSERT_EQ(FR_SHAPE_CIRCLE, frGetShapeType(s));
+        ASSERT_EQ(0, frGetPolygonVertexCount(s));
+
+        ASSERT_IN_RANGE(1.0f, frGetCircleRadius(s), FLT_EPSILON);
+    }
+
+    {
+        frSetShapeType(s, FR_SHAPE_POLYGON);
+
+        ASSERT_EQ(0, frGetPolygonVertexCount(s));
+
+        frSetRectangleDimensions(s, 2.0f, 2.0f);
+
+        ASSERT_EQ(4, frGetPolygonVertexCount(s));
+
+        ASSERT_IN_RANGE(4.0f, frGetShapeArea(s), FLT_EPSILON);
+    }
+
+    {
+        frSetShapeType(s, FR_SHAPE_CIRCLE);
+
+        ASSERT_EQ(0, frGetPolygonVertexCount(s));
+
+        frSetCircleRadius(s, 2.0f);
+
+        ASSERT_IN_RANGE(2.0f, frGetCircleRadius(s), FLT_EPSILON);
+    }
+
+    frReleaseShape(s);
+
+    s = frCreateCapsule(frStructZero(frMaterial), 2.0f, 1.0f);
+
+    {
+        frSetRectangleDimensions(s, 2.0f, 2.0f);
+
+        ASSERT_IN_RANGE(2.0f, frGetCapsuleLength(s), FLT_EPSILON);
+        ASSERT_IN_RANGE(1.0f, frGetCapsuleRadius(s), FLT_EPSILON);
+    }
+
+    frReleaseShape(s);
+
+    PASS();
+}
+
+TEST utCapsuleDimensions(void) {
+    ASSERT_EQ(NULL, frCreateCapsule(frStructZero(frMaterial), 0.0f, 1.0f));
+
+    frShape *s = frCreateCapsule((frMaterial) { .density = 1.0f }, 2.0f, 1.0f);
+
+    {
+        ASSERT_EQ(FR_SHAPE_CAPSULE, frGetShapeType(s));
+
+        ASSERT_IN_RANGE(2.0f, frGetCapsuleLength(s), FLT_EPSILON);
+        ASSERT_IN_RANGE(1.0f, frGetCapsuleRadius(s), FLT_EPSILON);
+
+        ASSERT_IN_RANGE(4.0f + M_PI, frGetShapeArea(s), 1e-5f);
+
+        /*
+            NOTE: The moment of inertia of a capsule lies between 
+            those of its line segment and its bounding box.
+        */
+        float inertia = frGetShapeInertia(s);
+
+        ASSERT_GT(inertia, frGetShapeMass(s) * 4.0f / 12.0f);
+        ASSERT_LT(inertia, frGetShapeMass(s) * (4.0f + 16.0f) / 12.0f);
+    }
+
+    {
+        frTransform tx = { .position = { .x = 1.0f, .y = 1.0f },
+                           .rotation.sin_ = 1.0f,
+                           .angle = 0.5f * M_PI };
+
+        frAABB aabb = frGetShapeAABB(s, tx);
+
+        ASSERT_IN_RANGE(-1.0f, aabb.x, 1e-5f);
+        ASSERT_IN_RANGE(0.0f, aabb.y, 1e-5f);
+
+        ASSERT_IN_RANGE(4.0f, aabb.width, 1e-5f);
+        ASSERT_IN_RANGE(2.0f, aabb.height, 1e-5f);
+    }
+
+    {
+        frSetCapsuleDimensions(s, 1.0f, 0.5f);
+
+        ASSERT_IN_RANGE(1.0f, frGetCapsuleLength(s), FLT_EPSILON);
+        ASSERT_IN_RANGE(1.0f + 0.25f * M_PI, frGetShapeArea(s), 1e-5f);
+    }
+
+    frReleaseShape(s);
+
+    PASS();
+}
+
+TEST utChainSegments(void) {
+    frVector2 vertices[] = { { .x = 0.0f },
+                             { .x = 1.0f },
+                             { .x = 2.0f, .y = -1.0f },
+                             { .x = 3.0f, .y = -1.0f } };
+
+    ASSERT_EQ(NULL,
+              frCreateChain(frStructZero(frMaterial), vertices, 1, false));
+    ASSERT_EQ(NULL,
+              frCreateChain(frStructZero(frMaterial), vertices, 2, true));
+
+    frShape *s = frCreateChain(frStructZero(frMaterial), vertices, 4, false);
+
+    {
+        ASSERT_EQ(FR_SHAPE_CHAIN, frGetShapeType(s));
+
+        ASSERT_EQ(4, frGetChainVertexCount(s));
+        ASSERT_EQ(3, frGetChainSegmentCount(s));
+
+        ASSERT_IN_RANGE(0.0f, frGetShapeMass(s), FLT_EPSILON);
+
+        // NOTE: The line segments face upward, toward negative y.
+        const frVector2 *normals = frGetChainNormals(s);
+
+        ASSERT_IN_RANGE(-1.0f, normals[0].y, FLT_EPSILON);
+
+        ASSERT_IN_RANGE(-sqrtf(0.5f), normals[1].x, 1e-5f);
+        ASSERT_IN_RANGE(-sqrtf(0.5f), normals[1].y, 1e-5f);
+
+        frAABB aabb = frGetShapeAABB(s,
+                                     (frTransform) { .rotation.cos_ = 1.0f });
+
+        ASSERT_IN_RANGE(0.0f, aabb.x, 1e-5f);
+        ASSERT_IN_RANGE(-1.0f, aabb.y, 1e-5f);
+
+        ASSERT_IN_RANGE(3.0f, aabb.width, 1e-5f);
+        ASSERT_IN_RANGE(1.0f, aabb.height, 1e-5f);
+    }
+
+    {
+        int indices[4] = { 0 };
+
+        frQueryChainSegments(s,
+                             (frAABB) { .x = 0.5f,
+                                        .y = -0.75f,
+                                        .width = 1.0f,
+                                        .height = 1.0f },
+                             onChainQuery,
+                             indices);
+
+        ASSERT_EQ(2, indices[0]);
+
+        ASSERT_EQ(0, indices[1]);
+        ASSERT_EQ(1, indices[2]);
+    }
+
+    frReleaseShape(s);
+
+    float heights[] = { 0.0f, 1.0f, 0.5f, 2.0f, 1.0f };
+
+    s = frCreateHeightfield(frStructZero(frMaterial), heights, 5, 0.5f);
+
+    {
+        ASSERT_EQ(FR_SHAPE_HEIGHTFIELD, frGetShapeType(s));
+
+        ASSERT_EQ(4, frGetChainSegmentCount(s));
+
+        const frVector2 *vertices = frGetChainVertices(s);
+
+        ASSERT_IN_RANGE(1.5f, vertices[3].x, FLT_EPSILON);
+        ASSERT_IN_RANGE(-2.0f, vertices[3].y, FLT_EPSILON);
+
+        int indices[5] = { 0 };
+
+        frQueryChainSegments(s,
+                             (frAABB) { .x = 0.75f,
+                                        .y = -3.0f,
+                                        .width = 0.5f,
+                                        .height = 3.0f },
+                             onChainQuery,
+                             indices);
+
+        ASSERT_EQ(2, indices[0]);
+
+        ASSERT_EQ(1, indices[1]);
+        ASSERT_EQ(2, indices[2]);
+    }
+
+    frReleaseShape(s);
+
+    PASS();
+}
+
+TEST utTilemapRects(void) {
+    bool tiles[] = { true, true,  true,  true,
+                     true, true,  false, false,
+                     true, true,  false, false };
+
+    ASSERT_EQ(NULL,
+              frCreateTilemap(frStructZero(frMaterial), tiles, 0, 3, 1.0f));
+
+    frShape *s = frCreateTilemap(frStructZero(frMaterial), tiles, 4, 3, 0.5f);
+
+    frAABB bounds = { .width = 2.0f, .height = 1.5f };
+
+    {
+        ASSERT_EQ(FR_SHAPE_TILEMAP, frGetShapeType(s));
+
+        ASSERT_EQ(true, frGetTilemapTile(s, 3, 0));
+        ASSERT_EQ(false, frGetTilemapTile(s, 2, 1));
+        ASSERT_EQ(false, frGetTilemapTile(s, 4, 0));
+
+        // NOTE: The top row is merged first, then the 2x2 block below it.
+        int indices[5] = { 0 };
+
+        frQueryTilemapRects(s, bounds, onChainQuery, indices);
+
+        ASSERT_EQ(2, indices[0]);
+
+        ASSERT_EQ(0, indices[1]);
+        ASSERT_EQ(4, indices[2]);
+
+        frAABB rect = frGetTilemapRect(s, 4);
+
+        ASSERT_IN_RANGE(0.0f, rect.x, FLT_EPSILON);
+        ASSERT_IN_RANGE(0.5f, rect.y, FLT_EPSILON);
+
+        ASSERT_IN_RANGE(1.0f, rect.width, FLT_EPSILON);
+        ASSERT_IN_RANGE(1.0f, rect.height, FLT_EPSILON);
+    }
+
+    {
+        // NOTE: Clearing a tile splits the rectangle around it.
+        frSetTilemapTile(s, 1, 0, false);
+
+        ASSERT_EQ(false, frGetTilemapTile(s, 1, 0));
+
+        int indices[5] = { 0 };
+
+        frQueryTilemapRects(s, bounds, onChainQuery, indices);
+
+        ASSERT_EQ(3, indices[0]);
+
+        ASSERT_EQ(0, indices[1]);
+        ASSERT_EQ(2, indices[2]);
+        ASSERT_EQ(4, indices[3]);
+
+        ASSERT_IN_RANGE(1.0f, frGetTilemapRect(s, 2).width, FLT_EPSILON);
+
+        frSetTilemapTile(s, 1, 0, true);
+
+        ASSERT_EQ(true, frGetTilemapTile(s, 1, 0));
+
+        indices[0] = 0;
+
+        frQueryTilemapRects(s,
+                            (frAABB) { .x = 0.6f, .width = 0.2f },
+                            onChainQuery,
+                            indices);
+
+        ASSERT_EQ(1, indices[0]);
+        ASSERT_EQ(1, indices[1]);
+    }
+
+    frReleaseShape(s);
+
+    PASS();
+}
+
+TEST utCompoundShape(void) {
+    frMaterial material = { .density = 1.0f };
+
+    frShape *shapes[] = { frCreateRectangle(material, 1.0f, 1.0f),
+                          frCreateRectangle(material, 1.0f, 1.0f),
+                          frCreateChain(material,
+                                        (frVector2[]) { { .x = 0.0f },
+                                                        { .x = 1.0f } },
+                                        2,
+                                        false) };
+
+    frTransform offsets[] = { { .position = { .x = -1.0f } },
+                              { .position = { .x = 1.0f } },
+                              { .position = { .x = 0.0f } } };
+
+    // NOTE: Only convex collision shapes can be the children.
+    ASSERT_EQ(NULL, frCreateCompound(material, shapes, offsets, 3));
+
+    frShape *s = frCreateCompound(material, shapes, offsets, 2);
+
+    {
+        ASSERT_EQ(FR_SHAPE_COMPOUND, frGetShapeType(s));
+
+        ASSERT_EQ(2, frGetCompoundChildCount(s));
+        ASSERT_EQ(shapes[1], frGetCompoundChild(s, 1));
+
+        ASSERT_IN_RANGE(2.0f, frGetShapeArea(s), 1e-5f);
+        ASSERT_IN_RANGE(2.0f, frGetShapeMass(s), 1e-5f);
+
+        // NOTE: Each box is 1.0f away from the origin of `s`.
+        ASSERT_IN_RANGE(2.0f * (1.0f / 6.0f + 1.0f),
+                        frGetShapeInertia(s),
+                        1e-5f);
+
+        frTransform tx = { .position = { .x = 2.0f },
+                           .rotation.sin_ = 1.0f,
+                           .angle = 0.5f * M_PI };
+
+        frAABB aabb = frGetShapeAABB(s, tx);
+
+        ASSERT_IN_RANGE(1.5f, aabb.x, 1e-5f);
+        ASSERT_IN_RANGE(-1.5f, aabb.y, 1e-5f);
+
+        ASSERT_IN_RANGE(1.0f, aabb.width, 1e-5f);
+        ASSERT_IN_RANGE(3.0f, aabb.height, 1e-5f);
+
+        frTransform childTx = frGetCompoundChildTransform(s, tx, 1);
+
+        ASSERT_IN_RANGE(2.0f, childTx.position.x, 1e-5f);
+        ASSERT_IN_RANGE(1.0f, childTx.position.y, 1e-5f);
+    }
+
+    {
+        int indices[3] = { 0 };
+
+        frQueryCompoundChildren(s,
+                                (frAABB) { .x = 0.75f,
+                                           .y = -0.25f,
+                                           .width = 0.5f,
+                                           .height = 0.5f },
+                                onChainQuery,
+                                indices);
+
+        ASSERT_EQ(1, indices[0]);
+        ASSERT_EQ(1, indices[1]);
+    }
+
+    frReleaseShape(s);
+
+    for (int i = 0; i < 3; i++)
+        frReleaseShape(shapes[i]);
+
+    PASS();
+}
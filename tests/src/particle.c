@@ -0,0 +1,321 @@
+/*
+    Copyright (c) 2021-2024 Jaedeok Kim <jdeokkim@protonmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a 
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation 
+    the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+    and/or sell copies of the Software, and to permit persons to whom the 
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included 
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Includes ===============================================================> */
+
+#include "ferox.h"
+#include "greatest.h"
+
+/* Constants ==============================================================> */
+
+static const float CELL_SIZE = 2.0f, DELTA_TIME = 1.0f / 60.0f;
+
+/* Private Function Prototypes ============================================> */
+
+TEST utParticleSystem(void);
+TEST utParticleIds(void);
+TEST utParticleCollision(void);
+TEST utParticleCoupling(void);
+TEST utParticleSleep(void);
+
+/* Public Functions =======================================================> */
+
+SUITE(particle) {
+    RUN_TEST(utParticleSystem);
+    RUN_TEST(utParticleIds);
+    RUN_TEST(utParticleCollision);
+    RUN_TEST(utParticleCoupling);
+    RUN_TEST(utParticleSleep);
+}
+
+/* Private Functions ======================================================> */
+
+TEST utParticleSystem(void) {
+    ASSERT_EQ(NULL,
+              frCreateParticleSystem((frMaterial) { .density = 0.0f }, 4));
+
+    frParticleSystem *ps = frCreateParticleSystem(
+        (frMaterial) { .density = 1.0f }, 2);
+
+    ASSERT_NEQ(NULL, ps);
+
+    frVector2 velocity = frStructZero(frVector2);
+
+    ASSERT_EQ(0, frAddParticle(ps, (frVector2) { .x = 1.0f }, velocity, 0.5f));
+    ASSERT_EQ(1, frAddParticle(ps, (frVector2) { .x = 2.0f }, velocity, 0.25f));
+    ASSERT_EQ(-1, frAddParticle(ps, (frVector2) { .x = 3.0f }, velocity, 0.5f));
+
+    ASSERT_EQ(2, frGetParticleCount(ps));
+
+    frRemoveParticle(ps, 0);
+
+    ASSERT_EQ(1, frGetParticleCount(ps));
+
+    ASSERT_EQ(2.0f, frGetParticlePositions(ps)[0].x);
+    ASSERT_EQ(0.25f, frGetParticleRadii(ps)[0]);
+
+    frClearParticles(ps);
+
+    ASSERT_EQ(0, frGetParticleCount(ps));
+
+    frReleaseParticleSystem(ps);
+
+    PASS();
+}
+
+TEST utParticleIds(void) {
+    frWorld *w = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+
+    frParticleSystem *ps = frCreateParticleSystem(
+        (frMaterial) { .density = 1.0f }, 16);
+
+    int ids[16];
+
+    // NOTE: The particles are added from right to left, then sorted.
+    for (int i = 0; i < 16; i++)
+        ids[i] = frAddParticle(ps,
+                               (frVector2) { .x = 32.0f - 2.0f * i },
+                               frStructZero(frVector2),
+                               0.1f + 0.01f * i);
+
+    frAddParticleSystemToWorld(w, ps);
+
+    frStepWorld(w, DELTA_TIME);
+
+    {
+        const float *radii = frGetParticleRadii(ps);
+
+        for (int i = 0; i < 16; i++) {
+            int index = frGetParticleIndex(ps, ids[i]);
+
+            ASSERT(index >= 0);
+
+            ASSERT_IN_RANGE(0.1f + 0.01f * i, radii[index], FLT_EPSILON);
+        }
+    }
+
+    {
+        frSetParticleVelocity(ps, ids[3], (frVector2) { .y = 1.0f });
+
+        ASSERT_EQ(
+            1.0f,
+            frGetParticleVelocities(ps)[frGetParticleIndex(ps, ids[3])].y);
+
+        frRemoveParticle(ps, ids[5]);
+
+        ASSERT_EQ(15, frGetParticleCount(ps));
+        ASSERT_EQ(-1, frGetParticleIndex(ps, ids[5]));
+
+        frStepWorld(w, DELTA_TIME);
+
+        const float *radii = frGetParticleRadii(ps);
+
+        for (int i = 0; i < 16; i++) {
+            if (i == 5) continue;
+
+            ASSERT_IN_RANGE(0.1f + 0.01f * i,
+                            radii[frGetParticleIndex(ps, ids[i])],
+                            FLT_EPSILON);
+        }
+
+        // NOTE: The ID of a removed particle can be used again.
+        ASSERT_EQ(ids[5],
+                  frAddParticle(ps,
+                                frStructZero(frVector2),
+                                frStructZero(frVector2),
+                                0.5f));
+    }
+
+    frReleaseWorld(w);
+
+    PASS();
+}
+
+TEST utParticleCollision(void) {
+    frWorld *w = frCreateWorld(FR_WORLD_DEFAULT_GRAVITY, CELL_SIZE);
+
+    frBody *b = frCreateBodyFromShape(
+        FR_BODY_STATIC,
+        (frVector2) { .x = 4.0f, .y = 8.0f },
+        frCreateRectangle((frMaterial) { .density = 1.0f }, 8.0f, 1.0f));
+
+    frParticleSystem *ps = frCreateParticleSystem(
+        (frMaterial) { .density = 1.0f, .friction = 0.5f }, 64);
+
+    for (int i = 0; i < 64; i++)
+        frAddParticle(ps,
+                      (frVector2) { .x = 3.0f + 0.25f * (i % 8),
+                                    .y = 5.0f - 0.25f * (i / 8) },
+                      frStructZero(frVector2),
+                      0.1f);
+
+    frAddBodyToWorld(w, b);
+
+    ASSERT(frAddParticleSystemToWorld(w, ps));
+    ASSERT_FALSE(frAddParticleSystemToWorld(w, ps));
+
+    for (int i = 0; i < 180; i++)
+        frStepWorld(w, DELTA_TIME);
+
+    const frVector2 *positions = frGetParticlePositions(ps);
+
+    for (int i = 0; i < frGetParticleCount(ps); i++) {
+        // NOTE: The top of the ground is at `y = 7.5`.
+        ASSERT_LT(positions[i].y, 7.5f - 0.09f);
+
+        for (int j = i + 1; j < frGetParticleCount(ps); j++)
+            ASSERT_GT(frVector2Distance(positions[i], positions[j]), 0.19f);
+    }
+
+    // NOTE: `w` releases `ps` along with its bodies.
+    frShape *s = frGetBodyShape(b);
+
+    frReleaseWorld(w);
+
+    frReleaseShape(s);
+
+    PASS();
+}
+
+TEST utParticleCoupling(void) {
+    frVector2 velocities[2] = { { .x = 0.0f } };
+
+    for (int k = 0; k < 2; k++) {
+        frWorld *w = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+
+        frShape *s = frCreateRectangle((frMaterial) { .density = 1.0f },
+                                       1.0f,
+                                       1.0f);
+
+        frBody *b = frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                          (frVector2) { .x = 4.0f, .y = 4.0f },
+                                          s);
+
+        frParticleSystem *ps = frCreateParticleSystem(
+            (frMaterial) { .density = 1.0f }, 1);
+
+        frSetParticleCoupling(ps,
+                              (k == 0) ? FR_PARTICLE_COUPLING_ONE_WAY
+                                       : FR_PARTICLE_COUPLING_TWO_WAY);
+
+        frAddParticle(ps,
+                      (frVector2) { .x = 3.0f, .y = 4.0f },
+                      (frVector2) { .x = 10.0f },
+                      0.25f);
+
+        frAddBodyToWorld(w, b), frAddParticleSystemToWorld(w, ps);
+
+        for (int i = 0; i < 10; i++)
+            frStepWorld(w, DELTA_TIME);
+
+        velocities[k] = frGetBodyVelocity(b);
+
+        // NOTE: The particle is slowed down by `b` in both cases.
+        ASSERT_LT(frGetParticleVelocities(ps)[0].x, 10.0f);
+
+        frRemoveParticleSystemFromWorld(w, ps);
+
+        frReleaseParticleSystem(ps);
+
+        frReleaseWorld(w);
+
+        frReleaseShape(s);
+    }
+
+    ASSERT_EQ(0.0f, velocities[0].x);
+    ASSERT_GT(velocities[1].x, 0.0f);
+
+    PASS();
+}
+
+TEST utParticleSleep(void) {
+    frWorld *w = frCreateWorld(FR_WORLD_DEFAULT_GRAVITY, CELL_SIZE);
+
+    frMaterial material = { .density = 1.0f, .friction = 0.5f };
+
+    frShape *s1 = frCreateRectangle(material, 8.0f, 1.0f);
+    frShape *s2 = frCreateRectangle(material, 1.0f, 1.0f);
+
+    frBody *b1 = frCreateBodyFromShape(FR_BODY_STATIC,
+                                       (frVector2) { .y = 8.0f },
+                                       s1);
+
+    frBody *b2 = frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                       (frVector2) { .y = 7.0f },
+                                       s2);
+
+    frBody *b3 = frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                       (frVector2) { .y = 6.0f },
+                                       s2);
+
+    frParticleSystem *ps = frCreateParticleSystem(material, 8);
+
+    frAddBodyToWorld(w, b1), frAddBodyToWorld(w, b2), frAddBodyToWorld(w, b3);
+
+    frAddParticleSystemToWorld(w, ps);
+
+    for (int i = 0; i < 120; i++)
+        frStepWorld(w, DELTA_TIME);
+
+    ASSERT_EQ(true, frIsBodySleeping(b3));
+
+    {
+        // NOTE: The top of `b3` is at `y = 5.5`.
+        for (int i = 0; i < 4; i++)
+            frAddParticle(ps,
+                          (frVector2) { .x = -0.3f + 0.2f * i, .y = 5.4f },
+                          frStructZero(frVector2),
+                          0.05f);
+
+        for (int i = 0; i < 60; i++)
+            frStepWorld(w, DELTA_TIME);
+
+        // NOTE: The particles resting on `b3` do not keep it awake.
+        ASSERT_EQ(true, frIsBodySleeping(b2));
+        ASSERT_EQ(true, frIsBodySleeping(b3));
+
+        for (int i = 0; i < 4; i++)
+            ASSERT_LT(frGetParticlePositions(ps)[i].y, 5.5f);
+    }
+
+    {
+        frAddParticle(ps,
+                      (frVector2) { .y = 5.35f },
+                      (frVector2) { .y = 10.0f },
+                      0.1f);
+
+        frStepWorld(w, DELTA_TIME);
+
+        ASSERT_EQ(false, frIsBodySleeping(b3));
+
+        frStepWorld(w, DELTA_TIME);
+
+        // NOTE: `b2` is in the same island as `b3`.
+        ASSERT_EQ(false, frIsBodySleeping(b2));
+    }
+
+    frReleaseShape(s1), frReleaseShape(s2);
+
+    frReleaseWorld(w);
+
+    PASS();
+}
@@ -27,14 +27,57 @@
 
 /* Private Function Prototypes ============================================> */
 
-/* TODO: ... */
+TEST utBodyContainsPoints(void);
 
 /* Public Functions =======================================================> */
 
 SUITE(rigid_body) {
-    /* TODO: ... */
+    RUN_TEST(utBodyContainsPoints);
 }
 
 /* Private Functions ======================================================> */
 
-/* TODO: ... */
+TEST utBodyContainsPoints(void) {
+    frBody *b = frCreateBodyFromShape(
+        FR_BODY_STATIC,
+        (frVector2) { .x = 1.0f, .y = 1.0f },
+        frCreateRectangle(frStructZero(frMaterial), 2.0f, 2.0f));
+
+    const frVector2 points[] = {
+        { .x = 1.0f, .y = 1.0f }, { .x = 0.0f, .y = 0.0f },
+        { .x = 2.0f, .y = 1.5f }, { .x = 2.01f, .y = 1.0f },
+        { .x = 1.0f, .y = -0.01f }, { .x = 0.5f, .y = 1.9f },
+        { .x = 3.0f, .y = 3.0f }
+    };
+
+    const bool expected[] = { true, true, true, false, false, true, false };
+
+    bool results[7] = { false };
+
+    {
+        ASSERT_EQ(4, frBodyContainsPoints(b, points, 7, results));
+
+        for (int i = 0; i < 7; i++) {
+            ASSERT_EQ(expected[i], results[i]);
+            ASSERT_EQ(expected[i], frBodyContainsPoint(b, points[i]));
+        }
+    }
+
+    {
+        frSetBodyAngle(b, 0.25f * M_PI);
+
+        ASSERT_EQ(true,
+                  frBodyContainsPoint(b,
+                                      (frVector2) { .x = 1.0f,
+                                                    .y = 1.0f + 1.4f }));
+
+        ASSERT_EQ(false,
+                  frBodyContainsPoint(b, (frVector2) { .x = 0.0f, .y = 0.0f }));
+    }
+
+    frReleaseShape(frGetBodyShape(b));
+
+    frReleaseBody(b);
+
+    PASS();
+}
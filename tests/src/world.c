@@ -27,18 +27,1084 @@
 
 /* Constants ==============================================================> */
 
-/* TODO: ... */
+static const float CELL_SIZE = 2.0f, DELTA_TIME = 1.0f / 60.0f;
 
 /* Private Function Prototypes ============================================> */
 
-/* TODO: ... */
+static void onRaycastQuery(frRaycastHit raycastHit, void *ctx);
+
+static bool onBodyFilter(const frBody *b, void *ctx);
+
+TEST utWorldRaycast(void);
+TEST utWorldRaycastClosest(void);
+TEST utWorldRaycastBatch(void);
+TEST utWorldRaycastAny(void);
+TEST utWorldShapeCast(void);
+TEST utWorldQuery(void);
+TEST utWorldQueryNearest(void);
+TEST utWorldWatcher(void);
+TEST utWorldRadialImpulse(void);
+TEST utWorldPredictTrajectory(void);
+TEST utWorldRemoveBody(void);
+TEST utWorldRestitution(void);
+TEST utWorldStack(void);
+TEST utWorldIslands(void);
+TEST utWorldSleep(void);
 
 /* Public Functions =======================================================> */
 
 SUITE(world) {
-    /* TODO: ... */
+    RUN_TEST(utWorldRaycast);
+    RUN_TEST(utWorldRaycastClosest);
+    RUN_TEST(utWorldRaycastBatch);
+    RUN_TEST(utWorldRaycastAny);
+    RUN_TEST(utWorldShapeCast);
+    RUN_TEST(utWorldQuery);
+    RUN_TEST(utWorldQueryNearest);
+    RUN_TEST(utWorldWatcher);
+    RUN_TEST(utWorldRadialImpulse);
+    RUN_TEST(utWorldPredictTrajectory);
+    RUN_TEST(utWorldRemoveBody);
+    RUN_TEST(utWorldRestitution);
+    RUN_TEST(utWorldStack);
+    RUN_TEST(utWorldIslands);
+    RUN_TEST(utWorldSleep);
 }
 
 /* Private Functions ======================================================> */
 
-/* TODO: ... */
+static void onRaycastQuery(frRaycastHit raycastHit, void *ctx) {
+    (*(int *) ctx)++;
+}
+
+static bool onBodyFilter(const frBody *b, void *ctx) {
+    return b != ctx;
+}
+
+TEST utWorldRaycast(void) {
+    frWorld *w = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+
+    frBody *b = frCreateBodyFromShape(FR_BODY_STATIC,
+                                      (frVector2) { .x = 4.0f, .y = 4.0f },
+                                      frCreateCircle(frStructZero(frMaterial),
+                                                     1.0f));
+
+    frRay ray = { .origin = { .x = 0.0f, .y = 4.0f },
+                  .direction = { .x = 1.0f },
+                  .maxDistance = 16.0f };
+
+    int hitCount = 0;
+
+    {
+        ASSERT_EQ(true, frAddBodyToWorld(w, b));
+
+        frStepWorld(w, DELTA_TIME);
+
+        ASSERT_EQ(true, frIsBodyInWorld(w, b));
+
+        frComputeWorldRaycast(w, ray, onRaycastQuery, &hitCount);
+
+        ASSERT_EQ(1, hitCount);
+    }
+
+    {
+        frSetBodyPosition(b, (frVector2) { .x = 12.0f, .y = 12.0f });
+
+        hitCount = 0;
+
+        frComputeWorldRaycast(w, ray, onRaycastQuery, &hitCount);
+
+        ASSERT_EQ(0, hitCount);
+
+        frSetBodyPosition(b, (frVector2) { .x = 12.0f, .y = 4.0f });
+
+        frComputeWorldRaycast(w, ray, onRaycastQuery, &hitCount);
+
+        ASSERT_EQ(1, hitCount);
+    }
+
+    frReleaseShape(frGetBodyShape(b));
+
+    frReleaseWorld(w);
+
+    PASS();
+}
+
+TEST utWorldRaycastClosest(void) {
+    frWorld *w = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+
+    frShape *s = frCreateRectangle(frStructZero(frMaterial), 2.0f, 2.0f);
+
+    for (int i = 0; i < 4; i++)
+        frAddBodyToWorld(w,
+                         frCreateBodyFromShape(FR_BODY_STATIC,
+                                               (frVector2) { .x = 24.0f
+                                                                  - 6.0f * i,
+                                                             .y = 1.0f },
+                                               s));
+
+    frStepWorld(w, DELTA_TIME);
+
+    frRaycastHit raycastHit = { .distance = 0.0f };
+
+    {
+        frRay ray = { .origin = { .x = 0.0f, .y = 1.5f },
+                      .direction = { .x = 1.0f },
+                      .maxDistance = 64.0f };
+
+        ASSERT_EQ(true, frComputeWorldRaycastClosest(w, ray, &raycastHit));
+
+        ASSERT_EQ(frGetBodyInWorld(w, 3), raycastHit.body);
+
+        ASSERT_IN_RANGE(5.0f, raycastHit.distance, FLT_EPSILON);
+        ASSERT_IN_RANGE(-1.0f, raycastHit.normal.x, FLT_EPSILON);
+    }
+
+    {
+        frRay ray = { .origin = { .x = 32.0f, .y = 1.5f },
+                      .direction = { .x = -1.0f },
+                      .maxDistance = 64.0f };
+
+        ASSERT_EQ(true, frComputeWorldRaycastClosest(w, ray, &raycastHit));
+
+        ASSERT_EQ(frGetBodyInWorld(w, 0), raycastHit.body);
+
+        ASSERT_IN_RANGE(7.0f, raycastHit.distance, FLT_EPSILON);
+        ASSERT_IN_RANGE(1.0f, raycastHit.normal.x, FLT_EPSILON);
+    }
+
+    {
+        frRay ray = { .origin = { .x = 0.0f, .y = 4.0f },
+                      .direction = { .x = 1.0f },
+                      .maxDistance = 64.0f };
+
+        ASSERT_EQ(false, frComputeWorldRaycastClosest(w, ray, &raycastHit));
+    }
+
+    frReleaseShape(s);
+
+    frReleaseWorld(w);
+
+    PASS();
+}
+
+TEST utWorldRaycastBatch(void) {
+    frWorld *w = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+
+    frShape *s1 = frCreateRectangle(frStructZero(frMaterial), 1.0f, 2.0f);
+    frShape *s2 = frCreateCircle(frStructZero(frMaterial), 0.75f);
+
+    for (int i = 0; i < 16; i++) {
+        frVector2 position = { .x = 8.0f * cosf(0.4f * i) * (1 + (i & 1)),
+                               .y = 8.0f * sinf(0.4f * i) * (1 + (i & 1)) };
+
+        frAddBodyToWorld(w,
+                         frCreateBodyFromShape(FR_BODY_STATIC,
+                                               position,
+                                               (i & 1) ? s1 : s2));
+    }
+
+    frStepWorld(w, DELTA_TIME);
+
+    frRay rays[64];
+
+    frRaycastHit hits[64];
+
+    for (int i = 0; i < 64; i++)
+        rays[i] = (frRay) { .origin = { .x = 0.5f, .y = -0.5f },
+                            .direction = { .x = cosf(0.1f * i),
+                                           .y = sinf(0.1f * i) },
+                            .maxDistance = (i & 1) ? FLT_MAX : 12.0f };
+
+    int hitCount = frComputeWorldRaycastBatch(w, rays, 64, hits);
+
+    ASSERT_GT(hitCount, 0);
+
+    for (int i = 0; i < 64; i++) {
+        frRaycastHit raycastHit = { .distance = 0.0f };
+
+        bool result = frComputeWorldRaycastClosest(w, rays[i], &raycastHit);
+
+        ASSERT_EQ(result, hits[i].body != NULL);
+
+        if (!result) continue;
+
+        hitCount--;
+
+        ASSERT_EQ(raycastHit.body, hits[i].body);
+        ASSERT_IN_RANGE(raycastHit.distance, hits[i].distance, FLT_EPSILON);
+    }
+
+    ASSERT_EQ(0, hitCount);
+
+    frReleaseShape(s1), frReleaseShape(s2);
+
+    frReleaseWorld(w);
+
+    PASS();
+}
+
+TEST utWorldRaycastAny(void) {
+    frWorld *w = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+
+    frShape *s = frCreateCircle(frStructZero(frMaterial), 1.0f);
+
+    for (int i = 0; i < 4; i++)
+        frAddBodyToWorld(w,
+                         frCreateBodyFromShape(FR_BODY_STATIC,
+                                               (frVector2) { .x = 4.0f * i,
+                                                             .y = 0.0f },
+                                               s));
+
+    frStepWorld(w, DELTA_TIME);
+
+    {
+        frRay ray = { .origin = { .x = 16.0f, .y = 0.0f },
+                      .direction = { .x = -2.0f },
+                      .maxDistance = 16.0f };
+
+        ASSERT_EQ(true, frComputeWorldRaycastAny(w, ray, NULL));
+
+        frRaycastHit raycastHit = { .distance = 0.0f };
+
+        ASSERT_EQ(true, frComputeWorldRaycastAny(w, ray, &raycastHit));
+
+        ASSERT_NEQ(NULL, raycastHit.body);
+        ASSERT_GTE(ray.maxDistance, raycastHit.distance);
+    }
+
+    {
+        frRay ray = { .origin = { .x = 16.0f, .y = 0.0f },
+                      .direction = { .x = -1.0f },
+                      .maxDistance = 2.5f };
+
+        ASSERT_EQ(false, frComputeWorldRaycastAny(w, ray, NULL));
+    }
+
+    {
+        frRay ray = { .origin = { .x = 2.0f, .y = -8.0f },
+                      .direction = { .y = 1.0f },
+                      .maxDistance = FLT_MAX };
+
+        ASSERT_EQ(false, frComputeWorldRaycastAny(w, ray, NULL));
+    }
+
+    frReleaseShape(s);
+
+    frReleaseWorld(w);
+
+    PASS();
+}
+
+TEST utWorldShapeCast(void) {
+    frWorld *w = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+
+    frShape *s1 = frCreateRectangle(frStructZero(frMaterial), 16.0f, 1.0f);
+    frShape *s2 = frCreateCircle(frStructZero(frMaterial), 0.5f);
+
+    frBody *b1 = frCreateBodyFromShape(FR_BODY_STATIC,
+                                       (frVector2) { .y = 8.0f },
+                                       s1);
+
+    frBody *b2 = frCreateBodyFromShape(FR_BODY_STATIC,
+                                       (frVector2) { .x = 2.0f, .y = 4.0f },
+                                       s2);
+
+    frAddBodyToWorld(w, b1), frAddBodyToWorld(w, b2);
+
+    frStepWorld(w, DELTA_TIME);
+
+    frShape *s = frCreateCircle(frStructZero(frMaterial), 0.5f);
+
+    frRaycastHit raycastHit = { .distance = 0.0f };
+
+    {
+        frTransform tx = { .position = { .x = 2.5f }, .rotation.cos_ = 1.0f };
+
+        ASSERT_EQ(true,
+                  frComputeWorldShapeCast(w,
+                                          s,
+                                          tx,
+                                          (frVector2) { .y = 16.0f },
+                                          NULL,
+                                          NULL,
+                                          &raycastHit));
+
+        ASSERT_EQ(b2, raycastHit.body);
+    }
+
+    {
+        frTransform tx = { .position = { .x = -2.0f }, .rotation.cos_ = 1.0f };
+
+        ASSERT_EQ(true,
+                  frComputeWorldShapeCast(w,
+                                          s,
+                                          tx,
+                                          (frVector2) { .y = 16.0f },
+                                          NULL,
+                                          NULL,
+                                          &raycastHit));
+
+        ASSERT_EQ(b1, raycastHit.body);
+
+        ASSERT_IN_RANGE(6.995f, raycastHit.distance, 0.005f);
+    }
+
+    {
+        frTransform tx = { .position = { .x = -2.0f }, .rotation.cos_ = 1.0f };
+
+        ASSERT_EQ(false,
+                  frComputeWorldShapeCast(w,
+                                          s,
+                                          tx,
+                                          (frVector2) { .x = -16.0f },
+                                          NULL,
+                                          NULL,
+                                          &raycastHit));
+    }
+
+    frReleaseShape(s), frReleaseShape(s1), frReleaseShape(s2);
+
+    frReleaseWorld(w);
+
+    PASS();
+}
+
+TEST utWorldQuery(void) {
+    frWorld *w = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+
+    frShape *s1 = frCreateRectangle(frStructZero(frMaterial), 2.0f, 2.0f);
+    frShape *s2 = frCreateCircle(frStructZero(frMaterial), 1.0f);
+
+    frBody *b1 = frCreateBodyFromShape(FR_BODY_STATIC,
+                                       (frVector2) { .x = 1.0f, .y = 1.0f },
+                                       s1);
+
+    frBody *b2 = frCreateBodyFromShape(FR_BODY_STATIC,
+                                       (frVector2) { .x = 4.0f, .y = 1.0f },
+                                       s2);
+
+    frSetBodyAngle(b1, 0.25f * M_PI);
+
+    frAddBodyToWorld(w, b1), frAddBodyToWorld(w, b2);
+
+    frStepWorld(w, DELTA_TIME);
+
+    frBody *bodies[2] = { NULL };
+
+    {
+        frAABB aabb = { .x = 2.25f, .y = 0.0f, .width = 4.0f, .height = 4.0f };
+
+        ASSERT_EQ(2, frQueryWorldAABB(w, aabb, bodies, 2));
+        ASSERT_EQ(1, frQueryWorldAABB(w, aabb, bodies, 1));
+
+        aabb.x = 3.0f;
+
+        ASSERT_EQ(1, frQueryWorldAABB(w, aabb, bodies, 2));
+        ASSERT_EQ(b2, bodies[0]);
+    }
+
+    {
+        ASSERT_EQ(1,
+                  frQueryWorldPoint(w,
+                                    (frVector2) { .x = 1.0f, .y = 2.25f },
+                                    bodies,
+                                    2));
+
+        ASSERT_EQ(b1, bodies[0]);
+
+        ASSERT_EQ(0,
+                  frQueryWorldPoint(w,
+                                    (frVector2) { .x = 2.2f, .y = 2.2f },
+                                    bodies,
+                                    2));
+    }
+
+    {
+        frShape *s = frCreateCircle(frStructZero(frMaterial), 0.5f);
+
+        frTransform tx = { .position = { .x = 2.75f, .y = 1.0f },
+                           .rotation.cos_ = 1.0f };
+
+        ASSERT_EQ(2, frQueryWorldShape(w, s, tx, bodies, 2));
+
+        tx.position = (frVector2) { .x = 2.3f, .y = 2.3f };
+
+        ASSERT_EQ(0, frQueryWorldShape(w, s, tx, bodies, 2));
+
+        tx.position = (frVector2) { .x = 3.0f, .y = 1.9f };
+
+        ASSERT_EQ(1, frQueryWorldShape(w, s, tx, bodies, 2));
+        ASSERT_EQ(b2, bodies[0]);
+
+        frReleaseShape(s);
+    }
+
+    {
+        frShape *s = frCreateCircle(frStructZero(frMaterial), 0.1f);
+
+        frTransform tx = { .position = { .x = 2.7f, .y = 1.0f },
+                           .rotation.cos_ = 1.0f };
+
+        ASSERT_EQ(0, frQueryWorldWithinDistance(w, s, tx, 0.1f, bodies, 2));
+
+        ASSERT_EQ(1, frQueryWorldWithinDistance(w, s, tx, 0.19f, bodies, 2));
+        ASSERT_EQ(b1, bodies[0]);
+
+        ASSERT_EQ(2, frQueryWorldWithinDistance(w, s, tx, 0.25f, bodies, 2));
+
+        frReleaseShape(s);
+    }
+
+    {
+        const frVector2 points[] = {
+            { .x = 4.5f, .y = 1.0f }, { .x = 1.0f, .y = 2.25f },
+            { .x = 2.2f, .y = 2.2f }, { .x = 1.0f, .y = 1.0f },
+            { .x = 3.1f, .y = 1.0f }, { .x = 9.0f, .y = 9.0f }
+        };
+
+        frBody *results[6] = { NULL };
+
+        ASSERT_EQ(4, frQueryWorldPoints(w, points, 6, results));
+
+        ASSERT_EQ(b2, results[0]);
+        ASSERT_EQ(b1, results[1]);
+        ASSERT_EQ(NULL, results[2]);
+        ASSERT_EQ(b1, results[3]);
+        ASSERT_EQ(b2, results[4]);
+        ASSERT_EQ(NULL, results[5]);
+    }
+
+    frReleaseShape(s1), frReleaseShape(s2);
+
+    frReleaseWorld(w);
+
+    PASS();
+}
+
+TEST utWorldQueryNearest(void) {
+    frWorld *w = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+
+    frShape *s = frCreateCircle(frStructZero(frMaterial), 0.5f);
+
+    frBody *bodies[4] = { NULL };
+
+    for (int i = 0; i < 4; i++) {
+        bodies[i] = frCreateBodyFromShape(FR_BODY_STATIC,
+                                          (frVector2) { .x = 3.0f * i,
+                                                        .y = 1.0f },
+                                          s);
+
+        frAddBodyToWorld(w, bodies[i]);
+    }
+
+    frStepWorld(w, DELTA_TIME);
+
+    frBody *results[4] = { NULL };
+
+    {
+        frVector2 point = { .x = 7.0f, .y = 1.0f };
+
+        ASSERT_EQ(2, frQueryWorldNearest(w, point, 2, NULL, NULL, results));
+
+        ASSERT_EQ(bodies[2], results[0]);
+        ASSERT_EQ(bodies[3], results[1]);
+
+        ASSERT_EQ(4, frQueryWorldNearest(w, point, 8, NULL, NULL, results));
+
+        ASSERT_EQ(bodies[1], results[2]);
+        ASSERT_EQ(bodies[0], results[3]);
+    }
+
+    {
+        frVector2 point = { .x = -40.0f, .y = 1.0f };
+
+        ASSERT_EQ(1,
+                  frQueryWorldNearest(w,
+                                      point,
+                                      1,
+                                      onBodyFilter,
+                                      bodies[0],
+                                      results));
+
+        ASSERT_EQ(bodies[1], results[0]);
+    }
+
+    frReleaseShape(s);
+
+    frReleaseWorld(w);
+
+    PASS();
+}
+
+TEST utWorldWatcher(void) {
+    frWorld *w = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+
+    frBody *b = frCreateBodyFromShape(FR_BODY_KINEMATIC,
+                                      (frVector2) { .x = 10.0f, .y = 1.0f },
+                                      frCreateCircle(frStructZero(frMaterial),
+                                                     0.5f));
+
+    frAddBodyToWorld(w, b);
+
+    frStepWorld(w, DELTA_TIME);
+
+    int id = frAddWatcherToWorld(w,
+                                 (frAABB) { .x = 0.5f,
+                                            .y = 0.5f,
+                                            .width = 3.0f,
+                                            .height = 3.0f });
+
+    int enterCount = 0, leaveCount = 0;
+
+    {
+        ASSERT_EQ(0, id);
+
+        frStepWorld(w, DELTA_TIME);
+
+        (void) frGetWatcherEnterSet(w, id, &enterCount);
+
+        ASSERT_EQ(0, enterCount);
+        ASSERT_EQ(false, frIsBodyInWatcher(w, id, b));
+
+        // NOTE: `b` shares a cell with the watcher, but not its region.
+        frSetBodyPosition(b, (frVector2) { .x = 4.3f, .y = 1.0f });
+
+        frStepWorld(w, DELTA_TIME);
+
+        (void) frGetWatcherEnterSet(w, id, &enterCount);
+
+        ASSERT_EQ(0, enterCount);
+        ASSERT_EQ(false, frIsBodyInWatcher(w, id, b));
+    }
+
+    {
+        frSetBodyPosition(b, (frVector2) { .x = 3.0f, .y = 1.0f });
+
+        frStepWorld(w, DELTA_TIME);
+
+        frBody *const *entered = frGetWatcherEnterSet(w, id, &enterCount);
+
+        ASSERT_EQ(1, enterCount);
+        ASSERT_EQ(b, entered[0]);
+
+        ASSERT_EQ(true, frIsBodyInWatcher(w, id, b));
+
+        frClearWatcherEvents(w, id);
+
+        frSetBodyPosition(b, (frVector2) { .x = 8.0f, .y = 1.0f });
+
+        frStepWorld(w, DELTA_TIME);
+
+        frBody *const *left = frGetWatcherLeaveSet(w, id, &leaveCount);
+
+        ASSERT_EQ(1, leaveCount);
+        ASSERT_EQ(b, left[0]);
+
+        frClearWatcherEvents(w, id);
+    }
+
+    {
+        frSetBodyPosition(b, (frVector2) { .x = 3.0f, .y = 1.0f });
+
+        frStepWorld(w, DELTA_TIME);
+
+        frSetBodyPosition(b, (frVector2) { .x = 8.0f, .y = 1.0f });
+
+        frStepWorld(w, DELTA_TIME);
+
+        (void) frGetWatcherEnterSet(w, id, &enterCount);
+        (void) frGetWatcherLeaveSet(w, id, &leaveCount);
+
+        ASSERT_EQ(0, enterCount);
+        ASSERT_EQ(0, leaveCount);
+    }
+
+    frBody *c = frCreateBodyFromShape(FR_BODY_STATIC,
+                                      (frVector2) { .x = 2.0f, .y = 2.0f },
+                                      frGetBodyShape(b));
+
+    {
+        // NOTE: A body added inside the watcher enters it right away.
+        frAddBodyToWorld(w, c);
+
+        frStepWorld(w, DELTA_TIME);
+
+        frBody *const *entered = frGetWatcherEnterSet(w, id, &enterCount);
+
+        ASSERT_EQ(1, enterCount);
+        ASSERT_EQ(c, entered[0]);
+
+        ASSERT_EQ(true, frIsBodyInWatcher(w, id, c));
+
+        frClearWatcherEvents(w, id);
+    }
+
+    {
+        ASSERT_EQ(true,
+                  frSetWatcherAABB(w,
+                                   id,
+                                   (frAABB) { .x = 6.5f,
+                                              .y = 0.5f,
+                                              .width = 3.0f,
+                                              .height = 3.0f }));
+
+        (void) frGetWatcherEnterSet(w, id, &enterCount);
+
+        ASSERT_EQ(1, enterCount);
+
+        ASSERT_EQ(true, frRemoveWatcherFromWorld(w, id));
+        ASSERT_EQ(false, frIsBodyInWatcher(w, id, b));
+    }
+
+    frReleaseShape(frGetBodyShape(b));
+
+    frReleaseWorld(w);
+
+    PASS();
+}
+
+TEST utWorldRadialImpulse(void) {
+    frWorld *w = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+
+    frShape *s1 = frCreateCircle((frMaterial) { .density = 1.0f }, 0.5f);
+    frShape *s2 = frCreateRectangle((frMaterial) { .density = 1.0f },
+                                    0.5f,
+                                    4.0f);
+
+    frBody *b1 = frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                       (frVector2) { .x = 3.0f },
+                                       s1);
+
+    frBody *b2 = frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                       (frVector2) { .x = -3.0f },
+                                       s1);
+
+    frBody *b3 = frCreateBodyFromShape(FR_BODY_STATIC,
+                                       (frVector2) { .x = -1.5f },
+                                       s2);
+
+    frAddBodyToWorld(w, b1), frAddBodyToWorld(w, b2), frAddBodyToWorld(w, b3);
+
+    frStepWorld(w, DELTA_TIME);
+
+    {
+        ASSERT_EQ(1,
+                  frApplyRadialImpulse(w,
+                                       frStructZero(frVector2),
+                                       5.0f,
+                                       1.0f,
+                                       FR_FALLOFF_LINEAR,
+                                       true,
+                                       NULL,
+                                       NULL));
+
+        ASSERT_IN_RANGE(0.5f / frGetBodyMass(b1),
+                        frGetBodyVelocity(b1).x,
+                        0.0001f);
+
+        ASSERT_IN_RANGE(0.0f, frGetBodyVelocity(b2).x, FLT_EPSILON);
+    }
+
+    {
+        frSetBodyVelocity(b1, frStructZero(frVector2));
+
+        ASSERT_EQ(2,
+                  frApplyRadialImpulse(w,
+                                       frStructZero(frVector2),
+                                       5.0f,
+                                       1.0f,
+                                       FR_FALLOFF_QUADRATIC,
+                                       false,
+                                       NULL,
+                                       NULL));
+
+        ASSERT_IN_RANGE(0.25f / frGetBodyMass(b1),
+                        frGetBodyVelocity(b1).x,
+                        0.0001f);
+
+        ASSERT_IN_RANGE(-0.25f / frGetBodyMass(b2),
+                        frGetBodyVelocity(b2).x,
+                        0.0001f);
+
+        ASSERT_EQ(0,
+                  frApplyRadialImpulse(w,
+                                       frStructZero(frVector2),
+                                       2.0f,
+                                       1.0f,
+                                       FR_FALLOFF_NONE,
+                                       false,
+                                       NULL,
+                                       NULL));
+    }
+
+    frReleaseShape(s1), frReleaseShape(s2);
+
+    frReleaseWorld(w);
+
+    PASS();
+}
+
+TEST utWorldPredictTrajectory(void) {
+    frWorld *w = frCreateWorld(FR_WORLD_DEFAULT_GRAVITY, CELL_SIZE);
+
+    frShape *s1 = frCreateCircle((frMaterial) { .density = 1.0f }, 0.25f);
+    frShape *s2 = frCreateRectangle((frMaterial) { .density = 1.0f },
+                                    64.0f,
+                                    1.0f);
+
+    frBody *b1 = frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                       frStructZero(frVector2),
+                                       s1);
+
+    frBody *b2 = frCreateBodyFromShape(FR_BODY_STATIC,
+                                       (frVector2) { .y = 8.0f },
+                                       s2);
+
+    frVector2 velocity = { .x = 4.0f, .y = -4.0f };
+
+    frAddBodyToWorld(w, b1), frAddBodyToWorld(w, b2);
+
+    frStepWorld(w, DELTA_TIME);
+
+    frSetBodyPosition(b1, frStructZero(frVector2));
+    frSetBodyVelocity(b1, velocity);
+
+    frVector2 path[121];
+
+    frRaycastHit raycastHit;
+
+    {
+        int count = frPredictTrajectory(w,
+                                        s1,
+                                        frStructZero(frVector2),
+                                        velocity,
+                                        1.0f,
+                                        DELTA_TIME,
+                                        120,
+                                        false,
+                                        path,
+                                        &raycastHit);
+
+        ASSERT_EQ(b2, raycastHit.body);
+
+        ASSERT_GT(count, 60);
+        ASSERT_LT(count, 121);
+
+        ASSERT_IN_RANGE(7.25f, path[count - 1].y, 0.01f);
+
+        ASSERT_IN_RANGE(0.0f, raycastHit.normal.x, 0.001f);
+        ASSERT_IN_RANGE(-1.0f, raycastHit.normal.y, 0.001f);
+
+        for (int i = 1; i <= 60; i++)
+            frStepWorld(w, DELTA_TIME);
+
+        ASSERT_IN_RANGE(path[60].x, frGetBodyPosition(b1).x, 0.001f);
+        ASSERT_IN_RANGE(path[60].y, frGetBodyPosition(b1).y, 0.001f);
+    }
+
+    {
+        ASSERT_EQ(11,
+                  frPredictTrajectory(w,
+                                      s1,
+                                      frStructZero(frVector2),
+                                      velocity,
+                                      0.0f,
+                                      DELTA_TIME,
+                                      10,
+                                      false,
+                                      path,
+                                      &raycastHit));
+
+        ASSERT_EQ(NULL, raycastHit.body);
+
+        ASSERT_IN_RANGE(10.0f * DELTA_TIME * velocity.x, path[10].x, 0.0001f);
+    }
+
+    frReleaseShape(s1), frReleaseShape(s2);
+
+    frReleaseWorld(w);
+
+    PASS();
+}
+
+TEST utWorldRemoveBody(void) {
+    frWorld *w = frCreateWorld(FR_WORLD_DEFAULT_GRAVITY, CELL_SIZE);
+
+    frShape *s1 = frCreateRectangle((frMaterial) { .density = 1.0f },
+                                    8.0f,
+                                    1.0f);
+    frShape *s2 = frCreateRectangle((frMaterial) { .density = 1.0f },
+                                    1.0f,
+                                    1.0f);
+
+    frBody *b1 = frCreateBodyFromShape(FR_BODY_STATIC,
+                                       (frVector2) { .y = 4.0f },
+                                       s1);
+
+    frBody *b2 = frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                       (frVector2) { .x = -2.0f, .y = 3.0f },
+                                       s2);
+
+    frBody *b3 = frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                       (frVector2) { .x = 2.0f, .y = 3.0f },
+                                       s2);
+
+    frAddBodyToWorld(w, b1), frAddBodyToWorld(w, b2), frAddBodyToWorld(w, b3);
+
+    for (int i = 0; i < 60; i++)
+        frStepWorld(w, DELTA_TIME);
+
+    // NOTE: `b3` takes the place of `b2` in `w`.
+    frRemoveBodyFromWorld(w, b2);
+
+    frStepWorld(w, DELTA_TIME);
+
+    frVector2 velocity = frGetBodyVelocity(b2);
+
+    for (int i = 0; i < 60; i++)
+        frStepWorld(w, DELTA_TIME);
+
+    ASSERT_EQ(2, frGetBodyCountInWorld(w));
+
+    ASSERT_EQ(velocity.y, frGetBodyVelocity(b2).y);
+
+    ASSERT_IN_RANGE(3.0f, frGetBodyPosition(b3).y, 0.05f);
+
+    frReleaseBody(b2);
+
+    frReleaseShape(s1), frReleaseShape(s2);
+
+    frReleaseWorld(w);
+
+    PASS();
+}
+
+TEST utWorldRestitution(void) {
+    frWorld *w = frCreateWorld(FR_WORLD_DEFAULT_GRAVITY, CELL_SIZE);
+
+    frMaterial material = { .density = 1.0f, .restitution = 1.0f };
+
+    frShape *s1 = frCreateRectangle(material, 8.0f, 1.0f);
+    frShape *s2 = frCreateCircle(material, 0.5f);
+
+    frBody *b1 = frCreateBodyFromShape(FR_BODY_STATIC,
+                                       (frVector2) { .y = 8.0f },
+                                       s1);
+
+    frBody *b2 = frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                       (frVector2) { .y = 4.0f },
+                                       s2);
+
+    frAddBodyToWorld(w, b1), frAddBodyToWorld(w, b2);
+
+    float minY = FLT_MAX, maxY = -FLT_MAX;
+
+    for (int i = 0; i < 120; i++) {
+        frStepWorld(w, DELTA_TIME);
+
+        float y = frGetBodyPosition(b2).y;
+
+        if (maxY < y) maxY = y;
+
+        // NOTE: `b2` hits `b1` after about 50 steps.
+        if (i > 60 && minY > y) minY = y;
+    }
+
+    // NOTE: The top of `b1` is at `y = 7.5`.
+    ASSERT_LT(maxY, 7.5f);
+
+    ASSERT_IN_RANGE(4.0f, minY, 0.25f);
+
+    frReleaseShape(s1), frReleaseShape(s2);
+
+    frReleaseWorld(w);
+
+    PASS();
+}
+
+TEST utWorldStack(void) {
+    frWorld *w = frCreateWorld(FR_WORLD_DEFAULT_GRAVITY, CELL_SIZE);
+
+    frMaterial material = { .density = 1.0f, .friction = 0.5f };
+
+    frShape *s1 = frCreateRectangle(material, 32.0f, 1.0f);
+    frShape *s2 = frCreateRectangle(material, 1.0f, 1.0f);
+
+    frAddBodyToWorld(w,
+                     frCreateBodyFromShape(FR_BODY_STATIC,
+                                           (frVector2) { .y = 8.0f },
+                                           s1));
+
+    // NOTE: The 40 contacts in these stacks fill several batches.
+    for (int i = 0; i < 40; i++)
+        frAddBodyToWorld(w,
+                         frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                               (frVector2) {
+                                                   .x = -12.0f + 3.0f * (i / 5),
+                                                   .y = 7.0f - 1.0f * (i % 5) },
+                                               s2));
+
+    for (int i = 0; i < 180; i++)
+        frStepWorld(w, DELTA_TIME);
+
+    for (int i = 1; i <= 40; i++) {
+        frBody *b = frGetBodyInWorld(w, i);
+
+        ASSERT_IN_RANGE(-12.0f + 3.0f * ((i - 1) / 5),
+                        frGetBodyPosition(b).x,
+                        0.05f);
+
+        ASSERT_IN_RANGE(7.0f - 1.0f * ((i - 1) % 5),
+                        frGetBodyPosition(b).y,
+                        0.1f);
+    }
+
+    frReleaseShape(s1), frReleaseShape(s2);
+
+    frReleaseWorld(w);
+
+    PASS();
+}
+
+TEST utWorldIslands(void) {
+    frMaterial material = { .density = 1.0f, .friction = 0.5f };
+
+    frShape *s1 = frCreateRectangle(material, 32.0f, 1.0f);
+    frShape *s2 = frCreateRectangle(material, 1.0f, 1.0f);
+
+    frVector2 positions[3][3];
+
+    /*
+        NOTE: The first world has a single pile of boxes, and the others 
+        have another pile far away from it, on a static (or kinematic) 
+        ground that must not join the two piles into one island.
+    */
+    for (int k = 0; k < 3; k++) {
+        frWorld *w = frCreateWorld(FR_WORLD_DEFAULT_GRAVITY, CELL_SIZE);
+
+        frAddBodyToWorld(w,
+                         frCreateBodyFromShape((k < 2) ? FR_BODY_STATIC
+                                                       : FR_BODY_KINEMATIC,
+                                               (frVector2) { .y = 8.0f },
+                                               s1));
+
+        for (int i = 0; i < ((k > 0) ? 6 : 3); i++)
+            frAddBodyToWorld(w,
+                             frCreateBodyFromShape(
+                                 FR_BODY_DYNAMIC,
+                                 (frVector2) { .x = -8.0f + 16.0f * (i / 3),
+                                               .y = 7.0f - 1.0f * (i % 3) },
+                                 s2));
+
+        for (int i = 0; i < 20; i++)
+            frStepWorld(w, DELTA_TIME);
+
+        ASSERT_EQ((k > 0) ? 2 : 1, frGetWorldIslandCount(w));
+
+        for (int i = 0; i < 3; i++)
+            positions[k][i] = frGetBodyPosition(frGetBodyInWorld(w, 1 + i));
+
+        frReleaseWorld(w);
+    }
+
+    // NOTE: Each island is solved exactly as if it were on its own.
+    for (int k = 1; k < 3; k++)
+        for (int i = 0; i < 3; i++) {
+            ASSERT_EQ(positions[0][i].x, positions[k][i].x);
+            ASSERT_EQ(positions[0][i].y, positions[k][i].y);
+        }
+
+    frReleaseShape(s1), frReleaseShape(s2);
+
+    PASS();
+}
+
+TEST utWorldSleep(void) {
+    frWorld *w = frCreateWorld(FR_WORLD_DEFAULT_GRAVITY, CELL_SIZE);
+
+    frMaterial material = { .density = 1.0f, .friction = 0.5f };
+
+    frShape *s1 = frCreateRectangle(material, 8.0f, 1.0f);
+    frShape *s2 = frCreateRectangle(material, 1.0f, 1.0f);
+
+    frBody *b1 = frCreateBodyFromShape(FR_BODY_STATIC,
+                                       (frVector2) { .y = 8.0f },
+                                       s1);
+
+    frBody *b2 = frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                       (frVector2) { .y = 7.0f },
+                                       s2);
+
+    frBody *b3 = frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                       (frVector2) { .y = 6.0f },
+                                       s2);
+
+    frAddBodyToWorld(w, b1), frAddBodyToWorld(w, b2), frAddBodyToWorld(w, b3);
+
+    {
+        for (int i = 0; i < 120; i++)
+            frStepWorld(w, DELTA_TIME);
+
+        ASSERT_EQ(false, frIsBodySleeping(b1));
+
+        ASSERT_EQ(true, frIsBodySleeping(b2));
+        ASSERT_EQ(true, frIsBodySleeping(b3));
+
+        ASSERT_EQ(0.0f, frGetBodyVelocity(b3).y);
+
+        frVector2 position = frGetBodyPosition(b3);
+
+        int updateCount = frGetWorldHashUpdateCount(w);
+
+        for (int i = 0; i < 60; i++)
+            frStepWorld(w, DELTA_TIME);
+
+        ASSERT_EQ(position.y, frGetBodyPosition(b3).y);
+
+        // NOTE: The spatial hash is left alone while every body is asleep.
+        ASSERT_EQ(updateCount, frGetWorldHashUpdateCount(w));
+    }
+
+    {
+        frApplyImpulseToBody(b3,
+                             frGetBodyPosition(b3),
+                             (frVector2) { .y = -1.0f });
+
+        ASSERT_EQ(false, frIsBodySleeping(b3));
+
+        frStepWorld(w, DELTA_TIME);
+
+        // NOTE: `b2` is in the same island as `b3`.
+        ASSERT_EQ(false, frIsBodySleeping(b2));
+
+        for (int i = 0; i < 180; i++)
+            frStepWorld(w, DELTA_TIME);
+
+        ASSERT_EQ(true, frIsBodySleeping(b2));
+        ASSERT_EQ(true, frIsBodySleeping(b3));
+
+        ASSERT_IN_RANGE(6.0f, frGetBodyPosition(b3).y, 0.05f);
+    }
+
+    {
+        frRemoveBodyFromWorld(w, b2);
+
+        frStepWorld(w, DELTA_TIME);
+
+        ASSERT_EQ(false, frIsBodySleeping(b3));
+
+        for (int i = 0; i < 60; i++)
+            frStepWorld(w, DELTA_TIME);
+
+        ASSERT_IN_RANGE(7.0f, frGetBodyPosition(b3).y, 0.05f);
+    }
+
+    frReleaseBody(b2);
+
+    frReleaseShape(s1), frReleaseShape(s2);
+
+    frReleaseWorld(w);
+
+    PASS();
+}